@@ -12,7 +12,7 @@
 #include "Infrastructure/Http/IHttpClient.hpp"
 #include "Infrastructure/Http/HttplibHttpClient.hpp"
 #include "Infrastructure/Http/MockHttpClient.hpp"
-#include "Infrastructure/Concurrency/ThreadExecutor.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
 #include "Infrastructure/Auth/AuthRepository.hpp"
 #include "Infrastructure/Security/SecureTokenStore.hpp"
 #include "Domain/UseCases/LoginUseCase.hpp"
@@ -23,6 +23,10 @@
 
 namespace {
 
+// Each in-flight request holds a worker for its blocking httplib call; a few
+// are plenty for an auth client and bound the thread count under bursts.
+const std::size_t kWorkerCount = 4;
+
 std::string toStd(NSString *s) {
     return s.UTF8String ? std::string(s.UTF8String) : std::string();
 }
@@ -37,7 +41,7 @@ NSString *toNS(const std::string &s) {
 @implementation PMVCAuthClient {
     // Declaration order == construction order; ARC destroys C++ ivars in reverse,
     // which keeps every reference valid (login → store/repo → keychain/client → executor).
-    std::unique_ptr<core::ThreadExecutor> _executor;
+    std::unique_ptr<core::WorkStealingExecutor> _executor;
     std::unique_ptr<core::IHttpClient> _client;
     std::unique_ptr<core::AuthRepository> _repository;
     std::unique_ptr<core::KeychainSecureStore> _keychain;
@@ -58,7 +62,8 @@ NSString *toNS(const std::string &s) {
             config.pinnedSpkiSha256Base64.push_back(toStd(pin));
         }
 
-        _executor = std::unique_ptr<core::ThreadExecutor>(new core::ThreadExecutor());
+        _executor = std::unique_ptr<core::WorkStealingExecutor>(
+            new core::WorkStealingExecutor(kWorkerCount));
         _client = std::unique_ptr<core::IHttpClient>(
             new core::HttplibHttpClient(config, *_executor));
         [self finishSetup];
@@ -68,7 +73,8 @@ NSString *toNS(const std::string &s) {
 
 - (instancetype)initWithMockData {
     if (self = [super init]) {
-        _executor = std::unique_ptr<core::ThreadExecutor>(new core::ThreadExecutor());
+        _executor = std::unique_ptr<core::WorkStealingExecutor>(
+            new core::WorkStealingExecutor(kWorkerCount));
         _client = std::unique_ptr<core::IHttpClient>(new core::MockHttpClient(*_executor));
         [self finishSetup];
     }
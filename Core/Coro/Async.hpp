@@ -0,0 +1,229 @@
+//
+//  Async.hpp
+//  PureMVC Core — coroutine facade (C++20, opt-in target puremvc_core_coro)
+//
+//  Async<T>: a lazy coroutine type for code built against Core with C++20.
+//  Nothing runs until the Async is awaited (or handed to spawn()/syncWait());
+//  awaiting one transfers control straight into it and its completion
+//  transfers straight back to the awaiter (symmetric transfer), so long
+//  chains of nested awaits neither grow the stack nor touch an executor.
+//
+//  Core reports errors in values, not exceptions; an exception escaping a
+//  coroutine terminates.
+//
+//  The C++14 headers know nothing about this file. It compiles to nothing
+//  below C++20, so it is inert when a C++14 build sweeps up every header.
+//
+
+#ifndef PUREMVC_CORE_CORO_ASYNC_HPP
+#define PUREMVC_CORE_CORO_ASYNC_HPP
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace core { namespace coro {
+
+template <typename T = void>
+class Async;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::coroutine_handle<> root; // outermost frame of the await chain; owns this one
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> finished) noexcept {
+            return finished.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+// The frame to destroy to free 'handle' along with every frame awaiting it:
+// the coroutine driving an Async chain, or 'handle' itself when it is not an
+// Async.
+template <typename P>
+std::coroutine_handle<> rootOf(std::coroutine_handle<P> handle) noexcept {
+    if constexpr (std::is_base_of<PromiseBase, P>::value) {
+        return handle.promise().root;
+    } else {
+        return handle;
+    }
+}
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Async<T> get_return_object() noexcept;
+    template <typename V>
+    void return_value(V&& v) {
+        value.emplace(std::forward<V>(v));
+    }
+    T take() { return std::move(*value); }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Async<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void take() const noexcept {}
+};
+
+} // namespace detail
+
+template <typename T>
+class [[nodiscard]] Async {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Async(Async&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Async& operator=(Async&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Async(const Async&) = delete;
+    Async& operator=(const Async&) = delete;
+    ~Async() { reset(); }
+
+    struct Awaiter {
+        Handle handle;
+        bool await_ready() const noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> awaiting) noexcept {
+            handle.promise().continuation = awaiting;
+            handle.promise().root = detail::rootOf(awaiting);
+            return handle;
+        }
+        T await_resume() { return handle.promise().take(); }
+    };
+
+    Awaiter operator co_await() && noexcept { return Awaiter{handle_}; }
+
+private:
+    friend struct detail::Promise<T>;
+    explicit Async(Handle handle) noexcept : handle_(handle) {}
+
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    Handle handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Async<T> Promise<T>::get_return_object() noexcept {
+    return Async<T>(Async<T>::Handle::from_promise(*this));
+}
+
+inline Async<void> Promise<void>::get_return_object() noexcept {
+    return Async<void>(Async<void>::Handle::from_promise(*this));
+}
+
+// Eagerly started, self-destroying coroutine used to drive an Async.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+inline Detached drive(Async<void> task) {
+    co_await std::move(task);
+}
+
+// Wakes syncWait() when the driver's frame goes away: once the task has
+// completed, or when the chain was destroyed unfinished (see resumeOn()).
+struct WakeOnExit {
+    std::mutex* mutex;
+    std::condition_variable* done;
+    bool* finished;
+
+    ~WakeOnExit() {
+        std::lock_guard<std::mutex> lock(*mutex);
+        *finished = true;
+        done->notify_one();
+    }
+};
+
+template <typename T>
+Detached driveInto(Async<T> task, std::optional<T>* out, std::mutex* mutex,
+                   std::condition_variable* done, bool* finished) {
+    WakeOnExit wake{mutex, done, finished};
+    out->emplace(co_await std::move(task));
+}
+
+inline Detached driveInto(Async<void> task, bool* completed, std::mutex* mutex,
+                          std::condition_variable* done, bool* finished) {
+    WakeOnExit wake{mutex, done, finished};
+    co_await std::move(task);
+    *completed = true;
+}
+
+} // namespace detail
+
+// Starts 'task' on the calling thread and returns at its first suspension;
+// the coroutine frame frees itself when it finishes.
+inline void spawn(Async<void> task) {
+    detail::drive(std::move(task));
+}
+
+// Runs 'task' and blocks the calling thread until it completes (wherever it
+// resumes). For tests and for main() of command-line tools. Terminates if
+// the task is destroyed before it completes, as it has nothing to return.
+template <typename T>
+T syncWait(Async<T> task) {
+    std::mutex mutex;
+    std::condition_variable done;
+    bool finished = false;
+    if constexpr (std::is_void<T>::value) {
+        bool completed = false;
+        detail::driveInto(std::move(task), &completed, &mutex, &done, &finished);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&finished]() { return finished; });
+        if (!completed) {
+            std::terminate();
+        }
+    } else {
+        std::optional<T> out;
+        detail::driveInto(std::move(task), &out, &mutex, &done, &finished);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&finished]() { return finished; });
+        if (!out) {
+            std::terminate();
+        }
+        return std::move(*out);
+    }
+}
+
+}} // namespace core::coro
+
+#endif // C++20 coroutines
+
+#endif // PUREMVC_CORE_CORO_ASYNC_HPP
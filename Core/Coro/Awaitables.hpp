@@ -0,0 +1,192 @@
+//
+//  Awaitables.hpp
+//  PureMVC Core — coroutine facade (C++20, opt-in target puremvc_core_coro)
+//
+//  co_await adapters over the callback ports:
+//
+//      HttpResponse response = co_await coro::send(client, request);
+//      LoginResult login     = co_await coro::login(repository, credentials);
+//      LoginOutcome outcome  = co_await coro::execute(useCase, credentials);
+//      co_await coro::resumeOn(executor);             // hop threads
+//
+//  Each awaiter lives in the awaiting coroutine's frame and hands the port a
+//  callback capturing only its own address, which fits std::function's and
+//  Task's inline buffers: an await adds no heap allocation. The coroutine
+//  resumes on whatever thread fires the callback (the HTTP executor's worker,
+//  say); follow with resumeOn() to choose one. A callback fired synchronously
+//  from inside the call continues the coroutine without suspending it.
+//
+
+#ifndef PUREMVC_CORE_CORO_AWAITABLES_HPP
+#define PUREMVC_CORE_CORO_AWAITABLES_HPP
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <string>
+#include <utility>
+#include "Coro/Async.hpp"
+#include "Domain/Ports/IAuthRepository.hpp"
+#include "Domain/Ports/IExecutor.hpp"
+#include "Domain/UseCases/LoginUseCase.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core { namespace coro {
+
+// The two LoginUseCase::Callback arguments as one value.
+struct LoginOutcome {
+    bool success = false;
+    std::string message;
+};
+
+namespace detail {
+
+// Shared rendezvous between await_suspend and the port's callback: whichever
+// of the two finishes second resumes (or continues) the coroutine.
+template <typename Result>
+class CallbackAwaiter {
+public:
+    bool await_ready() const noexcept { return false; }
+    Result await_resume() { return std::move(result_); }
+
+protected:
+    void complete(Result result) {
+        result_ = std::move(result);
+        if (rendezvous_.exchange(true, std::memory_order_acq_rel)) {
+            handle_.resume();
+        }
+    }
+
+    // Call after starting the operation; false means it already completed.
+    bool suspendIfPending() { return !rendezvous_.exchange(true, std::memory_order_acq_rel); }
+
+    std::coroutine_handle<> handle_;
+
+private:
+    Result result_{};
+    std::atomic<bool> rendezvous_{false};
+};
+
+class SendAwaiter : public CallbackAwaiter<HttpResponse> {
+public:
+    SendAwaiter(IHttpClient& client, const HttpRequest& request) : client_(client), request_(request) {}
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        client_.send(request_, [this](const HttpResponse& response) { complete(response); });
+        return suspendIfPending();
+    }
+
+private:
+    IHttpClient& client_;
+    const HttpRequest& request_; // outlives the co_await expression
+};
+
+class LoginAwaiter : public CallbackAwaiter<LoginResult> {
+public:
+    LoginAwaiter(IAuthRepository& repository, const LoginCredentials& credentials)
+        : repository_(repository), credentials_(credentials) {}
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        repository_.login(credentials_,
+                          [this](bool success, const AuthSession& session, const DomainError& error) {
+                              LoginResult result;
+                              result.success = success;
+                              result.session = session;
+                              result.error = error;
+                              complete(std::move(result));
+                          });
+        return suspendIfPending();
+    }
+
+private:
+    IAuthRepository& repository_;
+    const LoginCredentials& credentials_;
+};
+
+class ExecuteAwaiter : public CallbackAwaiter<LoginOutcome> {
+public:
+    ExecuteAwaiter(LoginUseCase& useCase, const LoginCredentials& credentials)
+        : useCase_(useCase), credentials_(credentials) {}
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        useCase_.execute(credentials_, [this](bool success, const std::string& message) {
+            complete(LoginOutcome{success, message});
+        });
+        return suspendIfPending();
+    }
+
+private:
+    LoginUseCase& useCase_;
+    const LoginCredentials& credentials_;
+};
+
+class ResumeOnAwaiter {
+public:
+    ResumeOnAwaiter(IExecutor& executor, TaskPriority priority) : executor_(executor), priority_(priority) {}
+
+    bool await_ready() const noexcept { return false; }
+    template <typename P>
+    void await_suspend(std::coroutine_handle<P> handle) {
+        executor_.run(Resume(handle, rootOf(handle)), priority_);
+    }
+    void await_resume() const noexcept {}
+
+private:
+    // The posted task owns the suspended coroutine: it resumes it when run.
+    // Destroyed unrun, it destroys the chain's root, which frees every frame
+    // of the chain (an Async owns the one it awaits).
+    class Resume {
+    public:
+        Resume(std::coroutine_handle<> handle, std::coroutine_handle<> root) : handle_(handle), root_(root) {}
+        Resume(Resume&& other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr)), root_(other.root_) {}
+        Resume& operator=(Resume&&) = delete;
+
+        ~Resume() {
+            if (handle_) {
+                root_.destroy();
+            }
+        }
+
+        void operator()() { std::exchange(handle_, nullptr).resume(); }
+
+    private:
+        std::coroutine_handle<> handle_; // null once run or moved from
+        std::coroutine_handle<> root_;
+    };
+
+    IExecutor& executor_;
+    TaskPriority priority_;
+};
+
+} // namespace detail
+
+inline detail::SendAwaiter send(IHttpClient& client, const HttpRequest& request) {
+    return detail::SendAwaiter(client, request);
+}
+
+inline detail::LoginAwaiter login(IAuthRepository& repository, const LoginCredentials& credentials) {
+    return detail::LoginAwaiter(repository, credentials);
+}
+
+inline detail::ExecuteAwaiter execute(LoginUseCase& useCase, const LoginCredentials& credentials) {
+    return detail::ExecuteAwaiter(useCase, credentials);
+}
+
+// Continues the coroutine as a task on 'executor'. If the executor destroys
+// that task without running it, the coroutine is destroyed where it waits,
+// along with the Async chain awaiting it: their locals are released and
+// nothing after the co_await runs.
+inline detail::ResumeOnAwaiter resumeOn(IExecutor& executor, TaskPriority priority = TaskPriority::normal) {
+    return detail::ResumeOnAwaiter(executor, priority);
+}
+
+}} // namespace core::coro
+
+#endif // C++20 coroutines
+
+#endif // PUREMVC_CORE_CORO_AWAITABLES_HPP
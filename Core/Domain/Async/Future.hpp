@@ -0,0 +1,391 @@
+//
+//  Future.hpp
+//  PureMVC Core — Domain (concurrency vocabulary)
+//
+//  Lightweight Future<T>/Promise<T> for composing the callback ports
+//  ("login, then fetch profile and settings in parallel") without nesting.
+//
+//  - The shared state is one allocation: value, continuation (a Task, so its
+//    captures live inline) and an intrusive reference count.
+//  - Continuations run inline on whichever thread completes the pair — the
+//    one calling setValue(), or the one calling then() on a ready future.
+//    then(executor, f) posts the continuation instead.
+//  - No exceptions: errors travel in T (HttpResponse::transportError,
+//    LoginResult::error), as everywhere else in Core. A Promise released
+//    without a value never completes; its continuations are destroyed unrun.
+//
+//  Future is single-consumer: then() and the combinators consume it. Promise
+//  is a copyable handle so it can sit in a std::function callback; the first
+//  setValue() wins. Continuations returning void yield Future<Unit>;
+//  continuations returning Future<U> are flattened to Future<U>.
+//
+
+#ifndef PUREMVC_CORE_FUTURE_HPP
+#define PUREMVC_CORE_FUTURE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Task.hpp"
+#include "../Ports/IExecutor.hpp"
+
+namespace core {
+
+// Value of a future that only signals completion.
+struct Unit {};
+
+template <typename T> class Future;
+template <typename T> class Promise;
+
+namespace detail {
+
+template <typename T>
+class FutureState {
+public:
+    FutureState() : refs_(1), flags_(0) {}
+
+    ~FutureState() {
+        if (flags_.load(std::memory_order_acquire) & kValue) {
+            value().~T();
+        }
+    }
+
+    FutureState(const FutureState&) = delete;
+    FutureState& operator=(const FutureState&) = delete;
+
+    void retain() { refs_.fetch_add(1, std::memory_order_relaxed); }
+    void release() {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    bool ready() const { return (flags_.load(std::memory_order_acquire) & kValue) != 0; }
+
+    template <typename V>
+    bool setValue(V&& v) {
+        if (flags_.fetch_or(kClaimed, std::memory_order_acq_rel) & kClaimed) {
+            return false;
+        }
+        ::new (static_cast<void*>(&storage_)) T(std::forward<V>(v));
+        if (flags_.fetch_or(kValue, std::memory_order_acq_rel) & kCallback) {
+            runCallback();
+        }
+        return true;
+    }
+
+    // The callback reads the value through this state; it runs exactly once,
+    // on whichever side arrives second.
+    void setCallback(Task callback) {
+        callback_ = std::move(callback);
+        if (flags_.fetch_or(kCallback, std::memory_order_acq_rel) & kValue) {
+            runCallback();
+        }
+    }
+
+    T& value() { return *reinterpret_cast<T*>(&storage_); }
+
+private:
+    static const unsigned kClaimed = 1u << 0;  // a setter won
+    static const unsigned kValue = 1u << 1;    // value constructed
+    static const unsigned kCallback = 1u << 2; // continuation stored
+
+    void runCallback() {
+        Task callback(std::move(callback_));
+        callback();
+    }
+
+    std::atomic<int> refs_;
+    std::atomic<unsigned> flags_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+    Task callback_;
+};
+
+// Intrusive owning pointer to a FutureState.
+template <typename T>
+class StateRef {
+public:
+    StateRef() noexcept : state_(nullptr) {}
+    explicit StateRef(FutureState<T>* adopted) noexcept : state_(adopted) {}
+    StateRef(const StateRef& other) noexcept : state_(other.state_) {
+        if (state_ != nullptr) {
+            state_->retain();
+        }
+    }
+    StateRef(StateRef&& other) noexcept : state_(other.state_) { other.state_ = nullptr; }
+    StateRef& operator=(StateRef other) noexcept {
+        std::swap(state_, other.state_);
+        return *this;
+    }
+    ~StateRef() {
+        if (state_ != nullptr) {
+            state_->release();
+        }
+    }
+
+    static StateRef share(FutureState<T>* state) {
+        state->retain();
+        return StateRef(state);
+    }
+
+    FutureState<T>* get() const noexcept { return state_; }
+    FutureState<T>* operator->() const noexcept { return state_; }
+    explicit operator bool() const noexcept { return state_ != nullptr; }
+
+private:
+    FutureState<T>* state_;
+};
+
+// What then() returns for a continuation result R.
+template <typename R> struct Lift { typedef R type; };
+template <> struct Lift<void> { typedef Unit type; };
+template <typename U> struct Lift<Future<U>> { typedef U type; };
+
+template <typename F, typename T>
+struct ContinuationResult {
+    typedef decltype(std::declval<F&>()(std::declval<T>())) type;
+};
+
+// Runs f(value) and completes 'next' with the (lifted) result.
+template <typename U, typename F, typename T>
+typename std::enable_if<std::is_void<typename ContinuationResult<F, T>::type>::value>::type
+fulfill(Promise<U>& next, F& f, T&& value) {
+    f(std::forward<T>(value));
+    next.setValue(Unit());
+}
+
+template <typename U, typename F, typename T>
+typename std::enable_if<!std::is_void<typename ContinuationResult<F, T>::type>::value &&
+                        std::is_same<typename ContinuationResult<F, T>::type, U>::value>::type
+fulfill(Promise<U>& next, F& f, T&& value) {
+    next.setValue(f(std::forward<T>(value)));
+}
+
+template <typename U>
+struct Forward {
+    Promise<U> next;
+    void operator()(U value) { next.setValue(std::move(value)); }
+};
+
+template <typename U, typename F, typename T>
+typename std::enable_if<std::is_same<typename ContinuationResult<F, T>::type, Future<U>>::value>::type
+fulfill(Promise<U>& next, F& f, T&& value) {
+    f(std::forward<T>(value)).then(Forward<U>{std::move(next)});
+}
+
+template <typename T, typename F, typename U>
+struct InlineContinuation {
+    FutureState<T>* state; // kept alive by whoever completes it
+    F f;
+    Promise<U> next;
+    void operator()() { fulfill(next, f, std::move(state->value())); }
+};
+
+template <typename T, typename F, typename U>
+struct PostedContinuation {
+    StateRef<T> state;
+    F f;
+    Promise<U> next;
+    void operator()() { fulfill(next, f, std::move(state->value())); }
+};
+
+template <typename T, typename F, typename U>
+struct ExecutorContinuation {
+    FutureState<T>* state;
+    IExecutor* executor;
+    F f;
+    Promise<U> next;
+    void operator()() {
+        executor->run(PostedContinuation<T, F, U>{StateRef<T>::share(state), std::move(f), std::move(next)});
+    }
+};
+
+} // namespace detail
+
+template <typename T>
+class Promise {
+public:
+    Promise() : state_(new detail::FutureState<T>()) {}
+
+    // Hands out the consumer side; call once.
+    Future<T> getFuture() { return Future<T>(state_); }
+
+    // Completes the future; returns false (and ignores 'value') if another
+    // setter got there first.
+    template <typename V>
+    bool setValue(V&& value) {
+        return state_->setValue(std::forward<V>(value));
+    }
+
+    bool isFulfilled() const { return state_->ready(); }
+
+private:
+    detail::StateRef<T> state_;
+};
+
+template <typename T>
+class Future {
+public:
+    typedef T value_type;
+
+    Future() noexcept {}
+    Future(Future&&) noexcept = default;
+    Future& operator=(Future&&) noexcept = default;
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+
+    // An already-completed future.
+    template <typename V>
+    static Future ready(V&& value) {
+        Promise<T> promise;
+        promise.setValue(std::forward<V>(value));
+        return promise.getFuture();
+    }
+
+    bool valid() const { return static_cast<bool>(state_); }
+    bool isReady() const { return state_ && state_->ready(); }
+
+    // Only once isReady(); the value stays owned by the future.
+    T& value() { return state_->value(); }
+
+    // Continuation on the completing thread. Consumes this future.
+    template <typename F>
+    Future<typename detail::Lift<typename detail::ContinuationResult<typename std::decay<F>::type, T>::type>::type>
+    then(F&& f) {
+        typedef typename std::decay<F>::type Fn;
+        typedef typename detail::Lift<typename detail::ContinuationResult<Fn, T>::type>::type U;
+        Promise<U> next;
+        Future<U> result = next.getFuture();
+        detail::StateRef<T> state(std::move(state_));
+        state->setCallback(detail::InlineContinuation<T, Fn, U>{state.get(), std::forward<F>(f), std::move(next)});
+        return result;
+    }
+
+    // Continuation posted to 'executor' once the value is available.
+    template <typename F>
+    Future<typename detail::Lift<typename detail::ContinuationResult<typename std::decay<F>::type, T>::type>::type>
+    then(IExecutor& executor, F&& f) {
+        typedef typename std::decay<F>::type Fn;
+        typedef typename detail::Lift<typename detail::ContinuationResult<Fn, T>::type>::type U;
+        Promise<U> next;
+        Future<U> result = next.getFuture();
+        detail::StateRef<T> state(std::move(state_));
+        state->setCallback(
+            detail::ExecutorContinuation<T, Fn, U>{state.get(), &executor, std::forward<F>(f), std::move(next)});
+        return result;
+    }
+
+private:
+    friend class Promise<T>;
+    explicit Future(const detail::StateRef<T>& state) : state_(state) {}
+
+    detail::StateRef<T> state_;
+};
+
+// ---------------------------------------------------------------------------
+// Combinators
+// ---------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename T>
+struct GatherVector {
+    GatherVector(std::size_t n) : values(n), remaining(n) {}
+    std::vector<T> values;
+    std::atomic<std::size_t> remaining;
+    Promise<std::vector<T>> promise;
+};
+
+template <typename T>
+struct GatherVectorSlot {
+    std::shared_ptr<GatherVector<T>> gather;
+    std::size_t index;
+    void operator()(T value) {
+        gather->values[index] = std::move(value);
+        if (gather->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            gather->promise.setValue(std::move(gather->values));
+        }
+    }
+};
+
+template <typename Tuple>
+struct GatherTuple {
+    Tuple values;
+    std::atomic<std::size_t> remaining{std::tuple_size<Tuple>::value};
+    Promise<Tuple> promise;
+};
+
+template <typename Tuple, std::size_t I>
+struct GatherTupleSlot {
+    std::shared_ptr<GatherTuple<Tuple>> gather;
+    void operator()(typename std::tuple_element<I, Tuple>::type value) {
+        std::get<I>(gather->values) = std::move(value);
+        if (gather->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            gather->promise.setValue(std::move(gather->values));
+        }
+    }
+};
+
+template <typename Tuple, std::size_t I>
+void attach(const std::shared_ptr<GatherTuple<Tuple>>&) {}
+
+template <typename Tuple, std::size_t I, typename Head, typename... Rest>
+void attach(const std::shared_ptr<GatherTuple<Tuple>>& gather, Future<Head>& head, Future<Rest>&... rest) {
+    head.then(GatherTupleSlot<Tuple, I>{gather});
+    attach<Tuple, I + 1>(gather, rest...);
+}
+
+template <typename T>
+struct FirstOf {
+    Promise<std::pair<std::size_t, T>> promise;
+    std::size_t index;
+    void operator()(T value) { promise.setValue(std::make_pair(index, std::move(value))); }
+};
+
+} // namespace detail
+
+// Completes with every value, in input order, once all have completed. T must
+// be default-constructible. An empty input completes immediately.
+template <typename T>
+Future<std::vector<T>> whenAll(std::vector<Future<T>> futures) {
+    if (futures.empty()) {
+        return Future<std::vector<T>>::ready(std::vector<T>());
+    }
+    std::shared_ptr<detail::GatherVector<T>> gather = std::make_shared<detail::GatherVector<T>>(futures.size());
+    Future<std::vector<T>> result = gather->promise.getFuture();
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i].then(detail::GatherVectorSlot<T>{gather, i});
+    }
+    return result;
+}
+
+// Heterogeneous fan-in: whenAll(profile, settings) -> Future<tuple<P, S>>.
+template <typename First, typename... Rest>
+Future<std::tuple<First, Rest...>> whenAll(Future<First> first, Future<Rest>... rest) {
+    typedef std::tuple<First, Rest...> Tuple;
+    std::shared_ptr<detail::GatherTuple<Tuple>> gather = std::make_shared<detail::GatherTuple<Tuple>>();
+    Future<Tuple> result = gather->promise.getFuture();
+    detail::attach<Tuple, 0>(gather, first, rest...);
+    return result;
+}
+
+// Completes with the index and value of the first future to complete; the
+// others still run, their values are dropped. Input must not be empty.
+template <typename T>
+Future<std::pair<std::size_t, T>> whenAny(std::vector<Future<T>> futures) {
+    Promise<std::pair<std::size_t, T>> promise;
+    Future<std::pair<std::size_t, T>> result = promise.getFuture();
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i].then(detail::FirstOf<T>{promise, i});
+    }
+    return result;
+}
+
+} // namespace core
+
+#endif // PUREMVC_CORE_FUTURE_HPP
@@ -0,0 +1,238 @@
+//
+//  Task.hpp
+//  PureMVC Core — Domain (concurrency vocabulary)
+//
+//  A move-only, type-erased void() callable with a large inline buffer. It is
+//  the unit of work for IExecutor: unlike std::function it never needs to copy
+//  its target (so move-only captures work) and it stores anything up to
+//  kInlineSize bytes in place, which covers the executor hops of the HTTP
+//  client and auth stack without touching the heap. Bigger (or throwing-move)
+//  callables still work; they just fall back to one heap allocation.
+//
+//  Task::around() lets a decorating executor run code before and after a task
+//  without boxing it: the decorator is stored next to the wrapped callable in
+//  the same buffer.
+//
+
+#ifndef PUREMVC_CORE_TASK_HPP
+#define PUREMVC_CORE_TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace core {
+
+class Task {
+public:
+    // Sized so that sizeof(Task) is 512 bytes: room for a full HttpClientConfig,
+    // HttpRequest and callback captured by value.
+    static const std::size_t kInlineSize = 512 - 16;
+
+    Task() noexcept : ops_(nullptr) {}
+    Task(std::nullptr_t) noexcept : ops_(nullptr) {}
+
+    template <typename F,
+              typename Fn = typename std::decay<F>::type,
+              typename = typename std::enable_if<!std::is_same<Fn, Task>::value>::type>
+    Task(F&& f) : ops_(nullptr) {
+        emplace<Fn>(std::forward<F>(f));
+    }
+
+    Task(Task&& other) noexcept : ops_(nullptr) { moveFrom(other); }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { reset(); }
+
+    void operator()() { ops_->invoke(storage()); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    // True when a callable of type F is stored without a heap allocation.
+    template <typename F>
+    static constexpr bool fitsInline() {
+        return sizeof(F) <= kInlineSize &&
+               alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+private:
+    struct Ops;
+
+public:
+    // Handle to the wrapped task inside an around() decorator. Calling it runs
+    // the task; it is only valid for the duration of the decorator's call.
+    class Inner {
+    public:
+        void operator()() { ops_->invoke(self_); }
+
+    private:
+        friend class Task;
+        Inner(const Ops* ops, void* self) : ops_(ops), self_(self) {}
+        const Ops* ops_;
+        void* self_;
+    };
+
+    // Returns a task that calls decorator(Inner) in place of 'inner'; the
+    // decorator decides when (and whether) to run it. Both share the inline
+    // buffer, so this only allocates when they do not fit together. The
+    // decorator must be nothrow-movable with at most max_align_t alignment.
+    template <typename D>
+    static Task around(Task inner, D decorator) {
+        static_assert(fitsInline<D>() && AroundOps<D>::kOffset + sizeof(void*) <= kInlineSize,
+                      "Task::around decorators must be small and nothrow-movable");
+        if (!inner) {
+            return Task();
+        }
+        if (AroundOps<D>::kOffset + inner.ops_->footprint(inner.storage()) > kInlineSize) {
+            Task* boxed = new Task(std::move(inner));
+            ::new (inner.storage()) Task*(boxed);
+            inner.ops_ = &HeapOps<Task>::ops;
+        }
+        Task out;
+        ::new (out.storage()) typename AroundOps<D>::Header{inner.ops_, std::move(decorator)};
+        inner.ops_->relocate(AroundOps<D>::innerStorage(out.storage()), inner.storage());
+        inner.ops_ = nullptr;
+        out.ops_ = &AroundOps<D>::ops;
+        return out;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* self);
+        void (*relocate)(void* dst, void* src) noexcept; // move into dst, destroy src
+        void (*destroy)(void* self) noexcept;
+        std::size_t (*footprint)(void* self) noexcept;   // inline bytes in use
+    };
+
+    template <typename F>
+    struct InlineOps {
+        static void invoke(void* self) { (*static_cast<F*>(self))(); }
+        static void relocate(void* dst, void* src) noexcept {
+            F* from = static_cast<F*>(src);
+            ::new (dst) F(std::move(*from));
+            from->~F();
+        }
+        static void destroy(void* self) noexcept { static_cast<F*>(self)->~F(); }
+        static std::size_t footprint(void*) noexcept { return sizeof(F); }
+        static const Ops ops;
+    };
+
+    template <typename F>
+    struct HeapOps {
+        static F*& target(void* self) { return *static_cast<F**>(self); }
+        static void invoke(void* self) { (*target(self))(); }
+        static void relocate(void* dst, void* src) noexcept {
+            ::new (dst) F*(target(src));
+        }
+        static void destroy(void* self) noexcept { delete target(self); }
+        static std::size_t footprint(void*) noexcept { return sizeof(F*); }
+        static const Ops ops;
+    };
+
+    // Layout: Header (inner ops + decorator), then the inner callable at the
+    // next max_align_t boundary.
+    template <typename D>
+    struct AroundOps {
+        struct Header {
+            const Ops* inner;
+            D decorator;
+        };
+        static const std::size_t kOffset =
+            (sizeof(Header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+        static Header& header(void* self) { return *static_cast<Header*>(self); }
+        static void* innerStorage(void* self) { return static_cast<char*>(self) + kOffset; }
+
+        static void invoke(void* self) {
+            Header& h = header(self);
+            h.decorator(Inner(h.inner, innerStorage(self)));
+        }
+        static void relocate(void* dst, void* src) noexcept {
+            Header& from = header(src);
+            from.inner->relocate(innerStorage(dst), innerStorage(src));
+            ::new (dst) Header{from.inner, std::move(from.decorator)};
+            from.~Header();
+        }
+        static void destroy(void* self) noexcept {
+            Header& h = header(self);
+            h.inner->destroy(innerStorage(self));
+            h.~Header();
+        }
+        static std::size_t footprint(void* self) noexcept {
+            Header& h = header(self);
+            return kOffset + h.inner->footprint(innerStorage(self));
+        }
+        static const Ops ops;
+    };
+
+    template <typename Fn, typename F>
+    typename std::enable_if<fitsInline<Fn>()>::type emplace(F&& f) {
+        ::new (storage()) Fn(std::forward<F>(f));
+        ops_ = &InlineOps<Fn>::ops;
+    }
+
+    template <typename Fn, typename F>
+    typename std::enable_if<!fitsInline<Fn>()>::type emplace(F&& f) {
+        ::new (storage()) Fn*(new Fn(std::forward<F>(f)));
+        ops_ = &HeapOps<Fn>::ops;
+    }
+
+    void moveFrom(Task& other) noexcept {
+        if (other.ops_ != nullptr) {
+            other.ops_->relocate(storage(), other.storage());
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage());
+            ops_ = nullptr;
+        }
+    }
+
+    void* storage() noexcept { return &storage_; }
+
+    typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type storage_;
+    const Ops* ops_;
+};
+
+template <typename F>
+const Task::Ops Task::InlineOps<F>::ops = {
+    &Task::InlineOps<F>::invoke, &Task::InlineOps<F>::relocate, &Task::InlineOps<F>::destroy,
+    &Task::InlineOps<F>::footprint};
+
+template <typename F>
+const Task::Ops Task::HeapOps<F>::ops = {
+    &Task::HeapOps<F>::invoke, &Task::HeapOps<F>::relocate, &Task::HeapOps<F>::destroy,
+    &Task::HeapOps<F>::footprint};
+
+template <typename D>
+const std::size_t Task::AroundOps<D>::kOffset;
+
+template <typename D>
+const Task::Ops Task::AroundOps<D>::ops = {
+    &Task::AroundOps<D>::invoke, &Task::AroundOps<D>::relocate, &Task::AroundOps<D>::destroy,
+    &Task::AroundOps<D>::footprint};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_TASK_HPP
@@ -0,0 +1,24 @@
+//
+//  TaskPriority.hpp
+//  PureMVC Core — Domain (concurrency vocabulary)
+//
+//  Quality-of-service lane for a unit of work. A hint: executors without lanes
+//  treat every priority the same.
+//
+
+#ifndef PUREMVC_CORE_TASK_PRIORITY_HPP
+#define PUREMVC_CORE_TASK_PRIORITY_HPP
+
+namespace core {
+
+enum class TaskPriority {
+    interactive = 0, // the user is waiting on it (login, a visible fetch)
+    normal = 1,      // default
+    background = 2,  // telemetry, prefetch, sync
+};
+
+const int kTaskPriorityCount = 3;
+
+} // namespace core
+
+#endif // PUREMVC_CORE_TASK_PRIORITY_HPP
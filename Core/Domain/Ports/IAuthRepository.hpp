@@ -10,10 +10,18 @@
 #define PUREMVC_CORE_IAUTH_REPOSITORY_HPP
 
 #include <functional>
+#include "../Async/Future.hpp"
 #include "../AuthTypes.hpp"
 
 namespace core {
 
+// The three LoginCallback arguments as one value, for Future<LoginResult>.
+struct LoginResult {
+    bool success = false;
+    AuthSession session;
+    DomainError error;
+};
+
 class IAuthRepository {
 public:
     // Called with success == true and a valid session, or success == false
@@ -24,6 +32,21 @@ public:
 
     virtual void login(const LoginCredentials& credentials, LoginCallback callback) = 0;
 
+    // Future-returning form over the callback one. Implementations that
+    // override login() re-expose it with `using IAuthRepository::login;`.
+    Future<LoginResult> login(const LoginCredentials& credentials) {
+        Promise<LoginResult> promise;
+        Future<LoginResult> future = promise.getFuture();
+        login(credentials, [promise](bool success, const AuthSession& session, const DomainError& error) mutable {
+            LoginResult result;
+            result.success = success;
+            result.session = session;
+            result.error = error;
+            promise.setValue(std::move(result));
+        });
+        return future;
+    }
+
     virtual ~IAuthRepository() = default;
 };
 
@@ -5,21 +5,57 @@
 //  Abstracts "run this work off the caller's thread". Production backs it with
 //  a thread pool / GCD; tests use a synchronous executor for determinism.
 //
+//  An executor may destroy a task without running it: one that sheds load
+//  (BoundedExecutor) when it refuses the task, any executor when it drops its
+//  queue. Work whose caller is waiting for an answer should report that from
+//  its destructor, as HttplibHttpClient's send task does; Rejection::current()
+//  tells a refusal from any other drop.
+//
 
 #ifndef PUREMVC_CORE_IEXECUTOR_HPP
 #define PUREMVC_CORE_IEXECUTOR_HPP
 
-#include <functional>
+#include <utility>
+#include "../Async/Task.hpp"
+#include "../Async/TaskPriority.hpp"
 
 namespace core {
 
 class IExecutor {
 public:
-    using Task = std::function<void()>;
+    // Move-only with inline storage: posting a typical lambda never allocates.
+    using Task = ::core::Task;
 
     virtual void run(Task task) = 0;
 
+    // Same, with a QoS lane hint. Executors without lanes ignore the priority.
+    virtual void run(Task task, TaskPriority priority) {
+        (void)priority;
+        run(std::move(task));
+    }
+
     virtual ~IExecutor() = default;
+
+    // Set on the posting thread while an executor destroys a task it refused.
+    class Rejection {
+    public:
+        explicit Rejection(const char* reason) : previous_(slot()) { slot() = reason; }
+        ~Rejection() { slot() = previous_; }
+
+        Rejection(const Rejection&) = delete;
+        Rejection& operator=(const Rejection&) = delete;
+
+        // Why the task being destroyed was refused; null when it was not.
+        static const char* current() { return slot(); }
+
+    private:
+        static const char*& slot() {
+            thread_local const char* reason = nullptr;
+            return reason;
+        }
+
+        const char* previous_;
+    };
 };
 
 } // namespace core
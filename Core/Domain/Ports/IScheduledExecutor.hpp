@@ -0,0 +1,43 @@
+//
+//  IScheduledExecutor.hpp
+//  PureMVC Core — outbound port (concurrency)
+//
+//  An IExecutor that can also run work later: retries with backoff, refreshing
+//  a token before it expires, polling. Production backs it with a timer wheel;
+//  tests drive a manual clock so "later" happens instantly and deterministically.
+//
+
+#ifndef PUREMVC_CORE_ISCHEDULED_EXECUTOR_HPP
+#define PUREMVC_CORE_ISCHEDULED_EXECUTOR_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include "IExecutor.hpp"
+
+namespace core {
+
+class IScheduledExecutor : public IExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = std::uint64_t; // never 0 for a scheduled timer
+
+    // Runs 'task' no earlier than 'deadline'. A deadline in the past fires on
+    // the next tick.
+    virtual TimerId runAt(Clock::time_point deadline, Task task) = 0;
+
+    virtual TimerId runAfter(Clock::duration delay, Task task) {
+        return runAt(now() + delay, std::move(task));
+    }
+
+    // Returns true when the timer was still pending and now never runs; false
+    // when it already fired, was already cancelled, or is unknown.
+    virtual bool cancel(TimerId id) = 0;
+
+    // The scheduler's notion of "now" (virtual under a manual clock).
+    virtual Clock::time_point now() const = 0;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_ISCHEDULED_EXECUTOR_HPP
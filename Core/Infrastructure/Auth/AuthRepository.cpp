@@ -6,6 +6,7 @@
 #include "Infrastructure/Auth/AuthRepository.hpp"
 #include "Infrastructure/Http/HttpError.hpp"
 
+#include <utility>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -67,12 +68,14 @@ void AuthRepository::login(const LoginCredentials& credentials, LoginCallback ca
     request.path = loginPath_;
     request.contentType = "application/json";
     request.body = requestBody.dump();
+    // The user is waiting on the login screen.
+    request.priority = TaskPriority::interactive;
 
     // The backend does not echo the username; carry it from the request so the
     // resulting session is complete.
     const std::string email = credentials.email;
 
-    httpClient_.send(request, [callback, email](const HttpResponse& response) {
+    httpClient_.send(std::move(request), [callback, email](const HttpResponse& response) {
         if (response.ok()) {
             try {
                 json j = json::parse(response.body);
@@ -21,6 +21,7 @@ public:
     explicit AuthRepository(IHttpClient& httpClient,
                             std::string loginPath = "/api/v1/auth/login");
 
+    using IAuthRepository::login;
     void login(const LoginCredentials& credentials, LoginCallback callback) override;
 
 private:
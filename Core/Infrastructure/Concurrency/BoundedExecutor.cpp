@@ -0,0 +1,138 @@
+//
+//  BoundedExecutor.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Concurrency/BoundedExecutor.hpp"
+#include "Infrastructure/Concurrency/TaskRing.hpp"
+
+#include <mutex>
+#include <utility>
+
+namespace core {
+
+struct BoundedExecutor::State : std::enable_shared_from_this<BoundedExecutor::State> {
+    struct Entry {
+        Task task;
+        TaskPriority priority;
+    };
+
+    State(IExecutor& executor, Options opts) : underlying(executor), options(opts) {
+        if (options.maxConcurrency == 0) {
+            options.maxConcurrency = 1;
+        }
+    }
+
+    IExecutor& underlying;
+    Options options;
+
+    mutable std::mutex mutex;
+    BasicRing<Entry> queue;
+    std::size_t running = 0;
+    std::uint64_t rejected = 0;
+
+    void post(Task task, TaskPriority priority) {
+        Task victim; // released after the lock
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (running < options.maxConcurrency) {
+                ++running;
+                lock.unlock();
+                dispatch(std::move(task), priority);
+                return;
+            }
+            if (queue.size() < options.queueCapacity) {
+                queue.pushBack(Entry{std::move(task), priority});
+                return;
+            }
+            ++rejected;
+            switch (options.policy) {
+            case RejectionPolicy::failFast:
+                victim = std::move(task);
+                break;
+            case RejectionPolicy::callerRuns:
+                lock.unlock();
+                task();
+                return;
+            case RejectionPolicy::dropOldest:
+                if (queue.empty()) {
+                    victim = std::move(task); // no queue to drop from
+                } else {
+                    victim = std::move(queue.popFront().task);
+                    queue.pushBack(Entry{std::move(task), priority});
+                }
+                break;
+            }
+        }
+        IExecutor::Rejection rejection("executor queue is full");
+        victim = nullptr;
+    }
+
+    // One permit, held by a dispatched task until it has run or the
+    // underlying executor destroys it without running it.
+    struct Permit {
+        std::shared_ptr<State> state; // null once moved from or given back
+
+        explicit Permit(std::shared_ptr<State> s) : state(std::move(s)) {}
+        Permit(Permit&& other) noexcept = default;
+
+        ~Permit() {
+            if (state) {
+                state->finished();
+            }
+        }
+
+        void operator()(Task::Inner inner) {
+            inner();
+            std::shared_ptr<State> s = std::move(state);
+            s->finished();
+        }
+    };
+
+    // Hands a task to the underlying executor holding one permit; when it is
+    // done, the permit passes to the oldest queued task or is returned.
+    void dispatch(Task task, TaskPriority priority) {
+        underlying.run(Task::around(std::move(task), Permit(shared_from_this())), priority);
+    }
+
+    void finished() {
+        Entry next;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty()) {
+                --running;
+                return;
+            }
+            next = queue.popFront();
+        }
+        dispatch(std::move(next.task), next.priority);
+    }
+};
+
+BoundedExecutor::BoundedExecutor(IExecutor& underlying, Options options)
+    : state_(std::make_shared<State>(underlying, options)) {}
+
+void BoundedExecutor::run(Task task) {
+    state_->post(std::move(task), TaskPriority::normal);
+}
+
+void BoundedExecutor::run(Task task, TaskPriority priority) {
+    state_->post(std::move(task), priority);
+}
+
+std::size_t BoundedExecutor::queuedCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->queue.size();
+}
+
+std::size_t BoundedExecutor::runningCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->running;
+}
+
+std::uint64_t BoundedExecutor::rejectedCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->rejected;
+}
+
+} // namespace core
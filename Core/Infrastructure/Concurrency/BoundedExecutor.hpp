@@ -0,0 +1,72 @@
+//
+//  BoundedExecutor.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Admission control in front of any IExecutor: at most maxConcurrency tasks
+//  are handed to the underlying executor at once, up to queueCapacity more
+//  wait here, and anything beyond that is rejected according to the policy
+//  instead of piling up as threads or unbounded queues. Under overload the
+//  accepted work keeps a bounded wait, so latency stays flat and the excess
+//  fails fast.
+//
+//  Rejection policies:
+//    failFast   — the new task is destroyed without running;
+//    callerRuns — the new task runs inline on the posting thread, which slows
+//                 the producer down to the pool's pace;
+//    dropOldest — the longest-waiting queued task is destroyed and the new one
+//                 takes its place (fresh work wins, e.g. UI refreshes).
+//  Destroyed tasks report from their destructors (see IExecutor); an HTTP
+//  send answers its callback with a transportError. Rejected tasks are
+//  released on the posting thread, outside the executor's lock, under an
+//  IExecutor::Rejection. A task the underlying executor destroys without
+//  running it gives its permit back like one that ran.
+//
+//  Priority hints are forwarded; the wait queue itself is FIFO.
+//
+
+#ifndef PUREMVC_CORE_BOUNDED_EXECUTOR_HPP
+#define PUREMVC_CORE_BOUNDED_EXECUTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Domain/Ports/IExecutor.hpp"
+
+namespace core {
+
+enum class RejectionPolicy {
+    failFast,
+    callerRuns,
+    dropOldest,
+};
+
+class BoundedExecutor : public IExecutor {
+public:
+    struct Options {
+        std::size_t maxConcurrency = 4; // raised to 1 if 0
+        std::size_t queueCapacity = 64;
+        RejectionPolicy policy = RejectionPolicy::failFast;
+    };
+
+    BoundedExecutor(IExecutor& underlying, Options options);
+
+    BoundedExecutor(const BoundedExecutor&) = delete;
+    BoundedExecutor& operator=(const BoundedExecutor&) = delete;
+
+    void run(Task task) override;
+    void run(Task task, TaskPriority priority) override;
+
+    std::size_t queuedCount() const;
+    std::size_t runningCount() const;
+    // Tasks refused under any policy (callerRuns included) since construction.
+    std::uint64_t rejectedCount() const;
+
+private:
+    struct State; // queue and permits, kept alive by running tasks
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_BOUNDED_EXECUTOR_HPP
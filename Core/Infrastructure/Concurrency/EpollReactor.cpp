@@ -0,0 +1,459 @@
+//
+//  EpollReactor.cpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+
+#include "Infrastructure/Concurrency/EpollReactor.hpp"
+
+#if defined(__linux__)
+
+#include "Infrastructure/Concurrency/TaskRing.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace core {
+namespace {
+
+// Bounded multi-producer ring (Vyukov's sequence-numbered slots) drained by
+// the single loop thread. Producers claim a slot with one CAS on the tail;
+// nothing blocks, and a full ring is reported instead of waited on.
+class PostRing {
+public:
+    explicit PostRing(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        slots_.reset(new Slot[size]);
+        for (std::size_t i = 0; i < size; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(Task& task) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->task = std::move(task);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Loop thread only.
+    bool tryPop(Task& out) {
+        Slot& slot = slots_[head_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return false;
+        }
+        out = std::move(slot.task);
+        slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    bool empty() const {
+        return slots_[head_ & mask_].sequence.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        Task task;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    std::size_t head_ = 0; // consumer only
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+const std::uint64_t kWakeTag = ~std::uint64_t(0);
+const std::uint64_t kTimerTag = ~std::uint64_t(0) - 1;
+
+// The reactor whose loop runs on this thread, if any.
+thread_local const void* tlsOwner = nullptr;
+
+// Setup failures (fd exhaustion) surface like std::thread's: as system_error.
+int checked(int result, const char* what) {
+    if (result < 0) {
+        throw std::system_error(errno, std::generic_category(), std::string("EpollReactor: ") + what);
+    }
+    return result;
+}
+
+} // namespace
+
+struct EpollReactor::State {
+    struct Watch {
+        std::uint32_t events;
+        std::uint32_t generation;
+        IoHandler handler;
+    };
+
+    struct TimerEntry {
+        Clock::time_point deadline;
+        TimerId id;
+        bool operator>(const TimerEntry& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : id > other.id;
+        }
+    };
+
+    explicit State(const Options& options)
+        : epollFd(checked(::epoll_create1(EPOLL_CLOEXEC), "epoll_create1")),
+          wakeFd(checked(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK), "eventfd")),
+          timerFd(checked(::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK), "timerfd_create")),
+          ring(options.queueCapacity) {
+        add(wakeFd, kWakeTag);
+        add(timerFd, kTimerTag);
+    }
+
+    ~State() {
+        ::close(timerFd);
+        ::close(wakeFd);
+        ::close(epollFd);
+    }
+
+    const int epollFd;
+    const int wakeFd;
+    const int timerFd;
+
+    // Posting.
+    PostRing ring;
+    std::atomic<bool> wakePending{false};
+    std::atomic<bool> overflowing{false};
+    std::mutex overflowMutex;
+    TaskRing overflow;
+    std::atomic<std::size_t> submitters{0}; // run() calls past the stop check
+    std::atomic<bool> stopping{false};
+
+    // Timers; shared with runAt()/cancel() callers.
+    std::mutex timerMutex;
+    std::vector<TimerEntry> heap; // min-heap; cancelled entries are skipped lazily
+    std::unordered_map<TimerId, Task> timers;
+    TimerId nextTimerId = 1;
+    Clock::time_point armedFor = Clock::time_point::max();
+
+    // Watches; loop thread only.
+    std::unordered_map<int, Watch> watches;
+    std::uint32_t nextGeneration = 1;
+
+    void add(int fd, std::uint64_t tag) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = tag;
+        checked(::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event), "epoll_ctl");
+    }
+
+    void wake() {
+        if (!wakePending.exchange(true)) {
+            const std::uint64_t one = 1;
+            ssize_t written = ::write(wakeFd, &one, sizeof(one));
+            (void)written; // EAGAIN means the counter is already non-zero
+        }
+    }
+
+    void post(Task task) {
+        // Same stop protocol as WorkStealingExecutor: the loop only exits once
+        // no submitter can still enqueue.
+        submitters.fetch_add(1);
+        if (stopping.load()) {
+            submitters.fetch_sub(1);
+            task();
+            return;
+        }
+        if (overflowing.load() || !ring.tryPush(task)) {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            overflow.pushBack(std::move(task));
+            overflowing.store(true);
+        }
+        submitters.fetch_sub(1);
+        if (tlsOwner != this) {
+            wake();
+        }
+    }
+
+    bool queuesEmpty() const { return ring.empty() && !overflowing.load(); }
+
+    void runPosted() {
+        Task task;
+        while (ring.tryPop(task)) {
+            task();
+            task = nullptr;
+        }
+        // Spilled tasks were posted after everything already in the ring.
+        while (overflowing.load()) {
+            {
+                std::lock_guard<std::mutex> lock(overflowMutex);
+                if (overflow.empty()) {
+                    overflowing.store(false);
+                    break;
+                }
+                task = overflow.popFront();
+            }
+            task();
+            task = nullptr;
+        }
+    }
+
+    void runDueTimers() {
+        std::vector<Task> due;
+        {
+            std::lock_guard<std::mutex> lock(timerMutex);
+            const Clock::time_point now = Clock::now();
+            while (!heap.empty() && heap.front().deadline <= now) {
+                const TimerId id = heap.front().id;
+                std::pop_heap(heap.begin(), heap.end(), std::greater<TimerEntry>());
+                heap.pop_back();
+                auto it = timers.find(id);
+                if (it != timers.end()) {
+                    due.push_back(std::move(it->second));
+                    timers.erase(it);
+                }
+            }
+        }
+        for (Task& task : due) {
+            task();
+        }
+    }
+
+    void armTimer() {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        while (!heap.empty() && timers.find(heap.front().id) == timers.end()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<TimerEntry>());
+            heap.pop_back();
+        }
+        const Clock::time_point next = heap.empty() ? Clock::time_point::max() : heap.front().deadline;
+        if (next == armedFor) {
+            return;
+        }
+        armedFor = next;
+        itimerspec spec{};
+        if (!heap.empty()) {
+            // steady_clock is CLOCK_MONOTONIC on Linux; an all-zero value would
+            // disarm, so never pass the epoch itself.
+            const std::int64_t nanos = std::max<std::int64_t>(
+                1, std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch()).count());
+            spec.it_value.tv_sec = static_cast<time_t>(nanos / 1000000000);
+            spec.it_value.tv_nsec = static_cast<long>(nanos % 1000000000);
+        }
+        ::timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void watch(int fd, std::uint32_t events, IoHandler handler) {
+        if (tlsOwner != this) {
+            handler(closed); // posted after shutdown; the loop is gone
+            return;
+        }
+        epoll_event event{};
+        event.events = EPOLLRDHUP;
+        if (events & readable) {
+            event.events |= EPOLLIN;
+        }
+        if (events & writable) {
+            event.events |= EPOLLOUT;
+        }
+        const std::uint32_t generation = nextGeneration++;
+        event.data.u64 = (static_cast<std::uint64_t>(generation) << 32) | static_cast<std::uint32_t>(fd);
+
+        auto existing = watches.find(fd);
+        const int op = existing == watches.end() ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+        if (::epoll_ctl(epollFd, op, fd, &event) != 0) {
+            // Not pollable (or already closed): report it the way a dead socket is.
+            if (existing != watches.end()) {
+                unwatch(fd);
+            }
+            handler(closed);
+            return;
+        }
+        watches[fd] = Watch{events, generation, std::move(handler)};
+    }
+
+    void unwatch(int fd) {
+        if (tlsOwner == this && watches.erase(fd) != 0) {
+            ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+
+    void dispatch(const epoll_event& event) {
+        const int fd = static_cast<int>(event.data.u64 & 0xffffffffu);
+        const std::uint32_t generation = static_cast<std::uint32_t>(event.data.u64 >> 32);
+        auto it = watches.find(fd);
+        if (it == watches.end() || it->second.generation != generation) {
+            return; // unwatched (or replaced) earlier in this batch
+        }
+        std::uint32_t ready = 0;
+        if (event.events & EPOLLIN) {
+            ready |= readable;
+        }
+        if (event.events & EPOLLOUT) {
+            ready |= writable;
+        }
+        if (event.events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) {
+            ready |= closed;
+        }
+        ready &= it->second.events | closed;
+        if (ready != 0) {
+            // Copy: the handler may unwatch (or re-watch) its own fd.
+            IoHandler handler = it->second.handler;
+            handler(ready);
+        }
+    }
+
+    bool canExit() const {
+        return stopping.load() && submitters.load() == 0 && queuesEmpty();
+    }
+
+    static void loop(std::shared_ptr<State> self);
+};
+
+void EpollReactor::State::loop(std::shared_ptr<State> self) {
+    State& s = *self;
+    tlsOwner = &s;
+    epoll_event events[64];
+    for (;;) {
+        s.runPosted();
+        s.runDueTimers();
+        if (s.canExit()) {
+            break;
+        }
+        // Posters skip the eventfd write while wakePending is set; clear it,
+        // then look once more so a post racing with the clear is not missed.
+        s.wakePending.store(false);
+        if (!s.queuesEmpty() || s.stopping.load()) {
+            continue;
+        }
+        s.armTimer();
+
+        const int count = ::epoll_wait(s.epollFd, events, 64, -1);
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.u64 == kWakeTag) {
+                std::uint64_t value;
+                ssize_t drained = ::read(s.wakeFd, &value, sizeof(value));
+                (void)drained;
+            } else if (events[i].data.u64 == kTimerTag) {
+                std::uint64_t expirations;
+                ssize_t drained = ::read(s.timerFd, &expirations, sizeof(expirations));
+                (void)drained;
+                std::lock_guard<std::mutex> lock(s.timerMutex);
+                s.armedFor = Clock::time_point::max();
+            } else {
+                s.dispatch(events[i]);
+            }
+        }
+    }
+
+    // Drop what can no longer run; their captures may hold resources.
+    s.watches.clear();
+    std::lock_guard<std::mutex> lock(s.timerMutex);
+    s.timers.clear();
+    s.heap.clear();
+    tlsOwner = nullptr;
+}
+
+EpollReactor::EpollReactor() : EpollReactor(Options()) {}
+
+EpollReactor::EpollReactor(Options options) : state_(std::make_shared<State>(options)) {
+    thread_ = std::thread(&State::loop, state_);
+}
+
+EpollReactor::~EpollReactor() {
+    shutdown();
+}
+
+void EpollReactor::run(Task task) {
+    state_->post(std::move(task));
+}
+
+IScheduledExecutor::TimerId EpollReactor::runAt(Clock::time_point deadline, Task task) {
+    State& s = *state_;
+    TimerId id;
+    bool earlier;
+    {
+        std::lock_guard<std::mutex> lock(s.timerMutex);
+        id = s.nextTimerId++;
+        s.timers.emplace(id, std::move(task));
+        s.heap.push_back(State::TimerEntry{deadline, id});
+        std::push_heap(s.heap.begin(), s.heap.end(), std::greater<State::TimerEntry>());
+        earlier = deadline < s.armedFor;
+    }
+    if (earlier && tlsOwner != &s) {
+        s.wake(); // the loop re-arms the timerfd before it sleeps again
+    }
+    return id;
+}
+
+bool EpollReactor::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(state_->timerMutex);
+    return state_->timers.erase(id) != 0;
+}
+
+IScheduledExecutor::Clock::time_point EpollReactor::now() const {
+    return Clock::now();
+}
+
+void EpollReactor::watch(int fd, std::uint32_t events, IoHandler handler) {
+    if (isLoopThread()) {
+        state_->watch(fd, events, std::move(handler));
+        return;
+    }
+    std::shared_ptr<State> state = state_;
+    run([state, fd, events, handler]() mutable { state->watch(fd, events, std::move(handler)); });
+}
+
+void EpollReactor::unwatch(int fd) {
+    if (isLoopThread()) {
+        state_->unwatch(fd);
+        return;
+    }
+    std::shared_ptr<State> state = state_;
+    run([state, fd]() { state->unwatch(fd); });
+}
+
+bool EpollReactor::isLoopThread() const {
+    return tlsOwner == state_.get();
+}
+
+void EpollReactor::shutdown() {
+    std::lock_guard<std::mutex> lock(shutdownMutex_);
+    state_->stopping.store(true);
+    state_->wake();
+    if (!thread_.joinable()) {
+        return;
+    }
+    if (isLoopThread()) {
+        thread_.detach(); // cannot join ourselves; the loop drains and exits
+    } else {
+        thread_.join();
+    }
+}
+
+} // namespace core
+
+#endif // defined(__linux__)
@@ -0,0 +1,92 @@
+//
+//  EpollReactor.hpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  Single-threaded reactor: one event-loop thread built on epoll that runs
+//  posted tasks, fires timers and dispatches readiness of watched file
+//  descriptors, all on that one thread. Use it where callbacks must land on a
+//  known thread (the Linux counterpart of the GCD main-queue hop in
+//  PMVCAuthClient) and as the base for non-blocking I/O.
+//
+//  Cross-thread run() is lock-free: tasks go into a bounded MPSC ring and the
+//  loop is woken through an eventfd only when it may be asleep. If the ring
+//  is full, posts spill into a mutex-guarded overflow queue (FIFO per poster
+//  is preserved). Timers (IScheduledExecutor) use a timerfd armed for the
+//  earliest deadline.
+//
+//  Shutdown mirrors the pools: queued tasks drain, later posts run inline on
+//  the caller, and releasing the last owner from a loop task detaches the
+//  thread instead of joining itself. Pending timers and watches are dropped.
+//
+//  The whole component compiles to nothing outside Linux (and Android).
+//
+
+#ifndef PUREMVC_CORE_EPOLL_REACTOR_HPP
+#define PUREMVC_CORE_EPOLL_REACTOR_HPP
+
+#if defined(__linux__)
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Domain/Ports/IScheduledExecutor.hpp"
+
+namespace core {
+
+class EpollReactor : public IScheduledExecutor {
+public:
+    // Readiness bits passed to watch() and reported to IoHandler.
+    enum IoEvents : std::uint32_t {
+        readable = 1u << 0,
+        writable = 1u << 1,
+        closed = 1u << 2, // peer hang-up or socket error; always reported
+    };
+    using IoHandler = std::function<void(std::uint32_t events)>;
+
+    struct Options {
+        // Slots in the lock-free post ring (rounded up to a power of two).
+        std::size_t queueCapacity = 256;
+    };
+
+    EpollReactor();
+    explicit EpollReactor(Options options);
+    ~EpollReactor() override;
+
+    EpollReactor(const EpollReactor&) = delete;
+    EpollReactor& operator=(const EpollReactor&) = delete;
+
+    using IExecutor::run;
+    void run(Task task) override;
+
+    TimerId runAt(Clock::time_point deadline, Task task) override;
+    bool cancel(TimerId id) override;
+    Clock::time_point now() const override;
+
+    // Level-triggered readiness callbacks on the loop thread. Replaces any
+    // existing watch for 'fd'. Calls made off the loop thread are posted to it,
+    // so they take effect in order with other posted work. The caller keeps
+    // ownership of 'fd' and must unwatch() before closing it.
+    void watch(int fd, std::uint32_t events, IoHandler handler);
+    void unwatch(int fd);
+
+    bool isLoopThread() const;
+
+    // Drains posted tasks and joins the loop thread. Idempotent.
+    void shutdown();
+
+private:
+    struct State; // rings, timers and watches, shared with the loop thread
+
+    std::shared_ptr<State> state_;
+    std::thread thread_;
+    std::mutex shutdownMutex_;
+};
+
+} // namespace core
+
+#endif // defined(__linux__)
+
+#endif // PUREMVC_CORE_EPOLL_REACTOR_HPP
@@ -0,0 +1,117 @@
+//
+//  InstrumentedExecutor.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Concurrency/InstrumentedExecutor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+namespace core {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::size_t kShardCount = 8;
+
+// Threads get a shard round-robin the first time they touch any
+// InstrumentedExecutor; the same index is reused across instances.
+std::size_t shardIndex() {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    return index;
+}
+
+} // namespace
+
+struct InstrumentedExecutor::State {
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> submitted{0};
+        std::atomic<std::uint64_t> completed{0};
+        LatencyHistogram waitTime;
+        LatencyHistogram runTime;
+    };
+
+    Shard shards[kShardCount];
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> inFlight{0};
+    std::atomic<std::size_t> peakQueued{0};
+
+    Shard& local() { return shards[shardIndex()]; }
+
+    void submitted() {
+        local().submitted.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t depth = queued.fetch_add(1, std::memory_order_relaxed) + 1;
+        std::size_t peak = peakQueued.load(std::memory_order_relaxed);
+        while (depth > peak &&
+               !peakQueued.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    // The decorator stored next to each task by Task::around. A task the
+    // underlying executor destroys without running leaves the queue too.
+    struct Measure {
+        std::shared_ptr<State> state; // null once moved from
+        Clock::time_point enqueued;
+        bool started = false;
+
+        Measure(std::shared_ptr<State> s, Clock::time_point at) : state(std::move(s)), enqueued(at) {}
+        Measure(Measure&& other) noexcept = default;
+
+        ~Measure() {
+            if (state && !started) {
+                state->queued.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        void operator()(Task::Inner task) {
+            State& s = *state;
+            const Clock::time_point startedAt = Clock::now();
+            started = true;
+            s.queued.fetch_sub(1, std::memory_order_relaxed);
+            s.inFlight.fetch_add(1, std::memory_order_relaxed);
+            s.local().waitTime.record(startedAt - enqueued);
+
+            task();
+
+            Shard& shard = s.local();
+            shard.runTime.record(Clock::now() - startedAt);
+            shard.completed.fetch_add(1, std::memory_order_relaxed);
+            s.inFlight.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+};
+
+InstrumentedExecutor::InstrumentedExecutor(IExecutor& underlying)
+    : underlying_(underlying), state_(std::make_shared<State>()) {}
+
+void InstrumentedExecutor::run(Task task) {
+    underlying_.run(instrument(std::move(task)));
+}
+
+void InstrumentedExecutor::run(Task task, TaskPriority priority) {
+    underlying_.run(instrument(std::move(task)), priority);
+}
+
+Task InstrumentedExecutor::instrument(Task task) {
+    state_->submitted();
+    return Task::around(std::move(task), State::Measure{state_, Clock::now()});
+}
+
+InstrumentedExecutor::Snapshot InstrumentedExecutor::snapshot() const {
+    Snapshot snapshot;
+    for (const State::Shard& shard : state_->shards) {
+        snapshot.submitted += shard.submitted.load(std::memory_order_relaxed);
+        snapshot.completed += shard.completed.load(std::memory_order_relaxed);
+        snapshot.waitTime.add(shard.waitTime);
+        snapshot.runTime.add(shard.runTime);
+    }
+    snapshot.queued = state_->queued.load(std::memory_order_relaxed);
+    snapshot.inFlight = state_->inFlight.load(std::memory_order_relaxed);
+    snapshot.peakQueued = state_->peakQueued.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+} // namespace core
@@ -0,0 +1,60 @@
+//
+//  InstrumentedExecutor.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Decorator that measures any IExecutor: how long each task waited between
+//  run() and starting (enqueue-to-start), how long it held the worker, how
+//  many tasks are queued and running, and the deepest the queue has been.
+//  Priority hints are forwarded unchanged.
+//
+//  Built to stay on in production: a task is wrapped with Task::around (no
+//  extra allocation), counters and histograms are sharded per thread and
+//  updated with relaxed atomics, and only the queue-depth gauges are shared.
+//  snapshot() sums the shards on the caller.
+//
+
+#ifndef PUREMVC_CORE_INSTRUMENTED_EXECUTOR_HPP
+#define PUREMVC_CORE_INSTRUMENTED_EXECUTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Domain/Ports/IExecutor.hpp"
+#include "Infrastructure/Concurrency/LatencyHistogram.hpp"
+
+namespace core {
+
+class InstrumentedExecutor : public IExecutor {
+public:
+    struct Snapshot {
+        std::uint64_t submitted = 0;
+        std::uint64_t completed = 0;
+        std::size_t queued = 0;     // posted, not started or dropped yet
+        std::size_t inFlight = 0;   // running right now
+        std::size_t peakQueued = 0; // since construction
+        HistogramSnapshot waitTime; // enqueue to start
+        HistogramSnapshot runTime;
+    };
+
+    explicit InstrumentedExecutor(IExecutor& underlying);
+
+    InstrumentedExecutor(const InstrumentedExecutor&) = delete;
+    InstrumentedExecutor& operator=(const InstrumentedExecutor&) = delete;
+
+    void run(Task task) override;
+    void run(Task task, TaskPriority priority) override;
+
+    Snapshot snapshot() const;
+
+private:
+    struct State; // shards and gauges, kept alive by queued tasks
+
+    Task instrument(Task task);
+
+    IExecutor& underlying_;
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_INSTRUMENTED_EXECUTOR_HPP
@@ -0,0 +1,230 @@
+//
+//  IoUring.cpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+
+#include "Infrastructure/Concurrency/IoUring.hpp"
+
+#ifdef PUREMVC_CORE_HAS_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace core {
+namespace {
+
+int setup(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int enter(int fd, unsigned submit, unsigned waitFor, unsigned flags, void* arg, std::size_t argSize) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, waitFor, flags, arg, argSize));
+}
+
+int registerWith(int fd, unsigned opcode, void* arg, unsigned count) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+[[noreturn]] void fail(const char* what) {
+    throw std::system_error(errno, std::generic_category(), std::string("IoUring: ") + what);
+}
+
+void* mapRing(int fd, std::size_t size, off_t offset) {
+    void* ring = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return ring == MAP_FAILED ? nullptr : ring;
+}
+
+template <typename T>
+T* at(void* base, unsigned offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+bool IoUring::available(std::initializer_list<std::uint8_t> ops) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int fd = setup(4, params);
+    if (fd < 0) {
+        return false;
+    }
+    bool supported = (params.features & IORING_FEAT_EXT_ARG) != 0 &&
+                     (params.features & IORING_FEAT_CQE_SKIP) != 0;
+    const unsigned slots = 256;
+    std::vector<char> storage(sizeof(io_uring_probe) + slots * sizeof(io_uring_probe_op), 0);
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+    if (supported && registerWith(fd, IORING_REGISTER_PROBE, probe, slots) < 0) {
+        supported = false;
+    }
+    for (std::uint8_t op : ops) {
+        supported = supported && op <= probe->last_op && op < probe->ops_len &&
+                    (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+    }
+    ::close(fd);
+    return supported;
+}
+
+IoUring::IoUring(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    fd_ = setup(entries, params);
+    if (fd_ < 0) {
+        fail("io_uring_setup");
+    }
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+    sqRing_ = mapRing(fd_, sqRingSize_, IORING_OFF_SQ_RING);
+    cqRing_ = (params.features & IORING_FEAT_SINGLE_MMAP) ? sqRing_
+                                                          : mapRing(fd_, cqRingSize_, IORING_OFF_CQ_RING);
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(mapRing(fd_, sqesSize_, IORING_OFF_SQES));
+    if (sqRing_ == nullptr || cqRing_ == nullptr || sqes_ == nullptr) {
+        const int code = errno;
+        release();
+        errno = code;
+        fail("mmap");
+    }
+
+    sqHead_ = at<unsigned>(sqRing_, params.sq_off.head);
+    sqTail_ = at<unsigned>(sqRing_, params.sq_off.tail);
+    sqArray_ = at<unsigned>(sqRing_, params.sq_off.array);
+    sqMask_ = *at<unsigned>(sqRing_, params.sq_off.ring_mask);
+    sqEntries_ = *at<unsigned>(sqRing_, params.sq_off.ring_entries);
+    sqLocalTail_ = *sqTail_;
+
+    cqHead_ = at<unsigned>(cqRing_, params.cq_off.head);
+    cqTail_ = at<unsigned>(cqRing_, params.cq_off.tail);
+    cqes_ = at<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+    cqMask_ = *at<unsigned>(cqRing_, params.cq_off.ring_mask);
+}
+
+IoUring::~IoUring() {
+    release();
+}
+
+void IoUring::release() {
+    if (fd_ >= 0) {
+        ::close(fd_); // the kernel lets go of the buffers before they are freed
+        fd_ = -1;
+    }
+    std::free(buffers_);
+    buffers_ = nullptr;
+    if (sqes_ != nullptr) {
+        ::munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+        ::munmap(cqRing_, cqRingSize_);
+    }
+    if (sqRing_ != nullptr) {
+        ::munmap(sqRing_, sqRingSize_);
+    }
+    cqRing_ = sqRing_ = nullptr;
+}
+
+io_uring_sqe* IoUring::prepare() {
+    if (sqLocalTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_) {
+        submitAndWait(std::chrono::nanoseconds(0));
+    }
+    const unsigned index = sqLocalTail_ & sqMask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqArray_[index] = index;
+    ++sqLocalTail_;
+    ++queued_;
+    return sqe;
+}
+
+void IoUring::submitAndWait(std::chrono::nanoseconds timeout) {
+    __atomic_store_n(sqTail_, sqLocalTail_, __ATOMIC_RELEASE);
+    __kernel_timespec ts;
+    io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+    unsigned flags = IORING_ENTER_EXT_ARG;
+    unsigned waitFor = 0;
+    if (timeout.count() != 0) {
+        flags |= IORING_ENTER_GETEVENTS;
+        waitFor = 1;
+        if (timeout.count() > 0) {
+            ts.tv_sec = timeout.count() / 1000000000;
+            ts.tv_nsec = timeout.count() % 1000000000;
+            arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+        }
+    }
+    for (;;) {
+        const int result = enter(fd_, queued_, waitFor, flags, &arg, sizeof(arg));
+        if (result >= 0) {
+            queued_ -= std::min<unsigned>(queued_, static_cast<unsigned>(result));
+            return;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == ETIME || errno == EAGAIN || errno == EBUSY) {
+            return; // timed out, or completions must be reaped first
+        }
+        fail("io_uring_enter");
+    }
+}
+
+// Synchronous: the completion is waited for here, before any other
+// operation is queued.
+bool IoUring::provideBuffers(std::uint16_t group, unsigned count, unsigned size) {
+    buffers_ = static_cast<char*>(std::malloc(std::size_t(count) * size));
+    if (buffers_ == nullptr) {
+        return false;
+    }
+    bufferSize_ = size;
+    bufferGroup_ = group;
+    io_uring_sqe* sqe = prepare();
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = static_cast<int>(count);
+    sqe->addr = reinterpret_cast<std::uint64_t>(buffers_);
+    sqe->len = size;
+    sqe->off = 0; // first buffer id
+    sqe->buf_group = group;
+    sqe->user_data = kInternal;
+    submitAndWait(std::chrono::nanoseconds(-1));
+    int result = -EAGAIN;
+    unsigned head = *cqHead_;
+    if (head != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+        result = cqes_[head & cqMask_].res;
+        __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+    }
+    if (result < 0) {
+        std::free(buffers_);
+        buffers_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void IoUring::recycle(std::uint16_t id) {
+    io_uring_sqe* sqe = prepare();
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+    sqe->fd = 1;
+    sqe->addr = reinterpret_cast<std::uint64_t>(buffer(id));
+    sqe->len = bufferSize_;
+    sqe->off = id;
+    sqe->buf_group = bufferGroup_;
+    sqe->user_data = kInternal;
+}
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HAS_IO_URING
@@ -0,0 +1,120 @@
+//
+//  IoUring.hpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  Minimal io_uring ring over the raw system calls (no liburing): a
+//  submission queue, a completion queue and one group of provided receive
+//  buffers that the kernel picks from as data arrives, so idle sockets hold
+//  no buffer. Owned and driven by one thread; nothing here is synchronized.
+//
+//  Compiles to nothing unless the kernel headers are new enough (5.17);
+//  available() additionally asks the running kernel.
+//
+
+#ifndef PUREMVC_CORE_IO_URING_HPP
+#define PUREMVC_CORE_IO_URING_HPP
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_FEAT_CQE_SKIP) // 5.17 uapi
+#define PUREMVC_CORE_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifdef PUREMVC_CORE_HAS_IO_URING
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace core {
+
+class IoUring {
+public:
+    // True when the running kernel sets up a ring with extended wait
+    // arguments and skippable completions, and supports every opcode in
+    // 'ops'. False under seccomp filters, io_uring_disabled, or kernels too
+    // old.
+    static bool available(std::initializer_list<std::uint8_t> ops);
+
+    // Throws std::system_error if the ring cannot be created.
+    explicit IoUring(unsigned entries);
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // A zeroed SQE to fill in, queued for the next submit. Submits what is
+    // already queued first if the submission queue is full.
+    io_uring_sqe* prepare();
+
+    // Submits queued SQEs and waits until a completion is available or
+    // 'timeout' passes (negative: no limit). One system call.
+    void submitAndWait(std::chrono::nanoseconds timeout);
+
+    // Calls fn(const io_uring_cqe&) for each available completion.
+    template <typename Fn>
+    std::size_t drain(Fn fn) {
+        unsigned head = *cqHead_;
+        const unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+        std::size_t count = 0;
+        while (head != tail) {
+            const io_uring_cqe cqe = cqes_[head & cqMask_];
+            ++head;
+            __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE); // fn may prepare/submit
+            if (cqe.user_data != kInternal) {
+                fn(cqe);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    // Hands 'count' buffers of 'size' bytes to the kernel as buffer group
+    // 'group', for receives with IOSQE_BUFFER_SELECT. A completion that used
+    // one carries IORING_CQE_F_BUFFER and its id; give it back with recycle()
+    // once its bytes are consumed. False if the kernel refuses.
+    bool provideBuffers(std::uint16_t group, unsigned count, unsigned size);
+    char* buffer(std::uint16_t id) const { return buffers_ + std::size_t(id) * bufferSize_; }
+    void recycle(std::uint16_t id); // queued with the next submit
+
+    // user_data of the ring's own operations; drain() never reports them.
+    static const std::uint64_t kInternal = ~std::uint64_t(0);
+
+private:
+    void release();
+
+    int fd_ = -1;
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    std::size_t sqRingSize_ = 0;
+    std::size_t cqRingSize_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqesSize_ = 0;
+
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned sqLocalTail_ = 0;
+    unsigned queued_ = 0;
+
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned cqMask_ = 0;
+
+    char* buffers_ = nullptr;
+    unsigned bufferSize_ = 0;
+    std::uint16_t bufferGroup_ = 0;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HAS_IO_URING
+
+#endif // PUREMVC_CORE_IO_URING_HPP
@@ -0,0 +1,153 @@
+//
+//  LatencyHistogram.hpp
+//  PureMVC Core — Infrastructure
+//
+//  HDR-style latency histogram: log-linear buckets (16 per power of two, so any
+//  recorded value is reported within ~6%) from 1 ns up to ~18 minutes, in a
+//  fixed array of counters. record() is a couple of relaxed atomic adds, safe
+//  from any thread and never allocates; readers copy the counters into a
+//  HistogramSnapshot and ask it for percentiles.
+//
+
+#ifndef PUREMVC_CORE_LATENCY_HISTOGRAM_HPP
+#define PUREMVC_CORE_LATENCY_HISTOGRAM_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+class LatencyHistogram {
+public:
+    static const int kSubBucketBits = 4;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+    // Values at or above 2^kMaxExponent ns are counted in the last bucket.
+    static const int kMaxExponent = 40;
+    static const int kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    LatencyHistogram() {
+        for (std::atomic<std::uint64_t>& count : counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(std::chrono::nanoseconds value) {
+        const std::int64_t nanos = value.count() < 0 ? 0 : value.count();
+        counts_[bucketFor(static_cast<std::uint64_t>(nanos))].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(static_cast<std::uint64_t>(nanos), std::memory_order_relaxed);
+        std::int64_t seen = max_.load(std::memory_order_relaxed);
+        while (nanos > seen &&
+               !max_.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::uint64_t bucketCount(int bucket) const {
+        return counts_[bucket].load(std::memory_order_relaxed);
+    }
+    std::uint64_t totalNanos() const { return total_.load(std::memory_order_relaxed); }
+    std::int64_t maxNanos() const { return max_.load(std::memory_order_relaxed); }
+
+    static int bucketFor(std::uint64_t nanos) {
+        if (nanos < static_cast<std::uint64_t>(kSubBuckets)) {
+            return static_cast<int>(nanos);
+        }
+        int exponent = highestBit(nanos);
+        if (exponent > kMaxExponent) {
+            return kBucketCount - 1;
+        }
+        const int sub = static_cast<int>((nanos >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+        return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+    }
+
+    // Largest value that lands in 'bucket'.
+    static std::int64_t bucketUpperBound(int bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        const int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+        const std::uint64_t sub = static_cast<std::uint64_t>(bucket % kSubBuckets);
+        const int shift = exponent - kSubBucketBits;
+        const std::uint64_t lower = (static_cast<std::uint64_t>(kSubBuckets) + sub) << shift;
+        return static_cast<std::int64_t>(lower + (std::uint64_t(1) << shift) - 1);
+    }
+
+private:
+    static int highestBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#else
+        int bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    std::atomic<std::uint64_t> counts_[kBucketCount];
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::int64_t> max_{0};
+};
+
+// Point-in-time copy of one or more LatencyHistograms. Recording continues
+// while it is taken, so counts from different buckets may be a few samples
+// apart; fine for monitoring.
+class HistogramSnapshot {
+public:
+    HistogramSnapshot() : counts_(LatencyHistogram::kBucketCount, 0) {}
+
+    void add(const LatencyHistogram& histogram) {
+        for (int bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+            const std::uint64_t n = histogram.bucketCount(bucket);
+            counts_[static_cast<std::size_t>(bucket)] += n;
+            count_ += n;
+        }
+        total_ += histogram.totalNanos();
+        if (histogram.maxNanos() > max_) {
+            max_ = histogram.maxNanos();
+        }
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::chrono::nanoseconds max() const { return std::chrono::nanoseconds(max_); }
+    std::chrono::nanoseconds mean() const {
+        return std::chrono::nanoseconds(count_ == 0 ? 0 : static_cast<std::int64_t>(total_ / count_));
+    }
+
+    // p in [0, 100]. Reports the upper edge of the bucket holding that rank
+    // (never above the recorded max); 0 when empty.
+    std::chrono::nanoseconds percentile(double p) const {
+        if (count_ == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(count_) + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+        std::uint64_t seen = 0;
+        for (int bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+            seen += counts_[static_cast<std::size_t>(bucket)];
+            if (seen >= rank) {
+                const std::int64_t upper = LatencyHistogram::bucketUpperBound(bucket);
+                return std::chrono::nanoseconds(upper < max_ ? upper : max_);
+            }
+        }
+        return max();
+    }
+
+private:
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t total_ = 0;
+    std::int64_t max_ = 0;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_LATENCY_HISTOGRAM_HPP
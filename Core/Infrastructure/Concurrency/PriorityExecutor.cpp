@@ -0,0 +1,181 @@
+//
+//  PriorityExecutor.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Concurrency/PriorityExecutor.hpp"
+#include "Infrastructure/Concurrency/TaskRing.hpp"
+
+#include <condition_variable>
+#include <utility>
+
+namespace core {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Entry {
+    Task task;
+    Clock::time_point enqueued;
+};
+
+const int kShared = -1; // lane index of a worker that serves every lane
+
+thread_local const void* tlsOwner = nullptr; // state of the pool running this thread
+
+} // namespace
+
+struct PriorityExecutor::State {
+    explicit State(const Options& opts) : options(opts) {}
+
+    const Options options;
+    mutable std::mutex mutex;
+    BasicRing<Entry> lanes[kTaskPriorityCount];
+    std::condition_variable laneWake[kTaskPriorityCount];
+    std::condition_variable sharedWake;
+    std::size_t idleReserved[kTaskPriorityCount] = {0, 0, 0};
+    std::size_t idleShared = 0;
+    bool stopping = false;
+
+    bool anyQueued() const {
+        for (const BasicRing<Entry>& lane : lanes) {
+            if (!lane.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Lane a shared worker should serve next; -1 when nothing is queued.
+    int pickLane(Clock::time_point now) {
+        // Aged lower-priority work first, most starved lane wins.
+        for (int lane = kTaskPriorityCount - 1; lane > 0; --lane) {
+            if (!lanes[lane].empty() &&
+                now - lanes[lane].front().enqueued >= options.agingThreshold) {
+                return lane;
+            }
+        }
+        for (int lane = 0; lane < kTaskPriorityCount; ++lane) {
+            if (!lanes[lane].empty()) {
+                return lane;
+            }
+        }
+        return -1;
+    }
+
+    void post(Task task, TaskPriority priority) {
+        const int lane = static_cast<int>(priority);
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping) {
+            lock.unlock();
+            task();
+            return;
+        }
+        lanes[lane].pushBack(Entry{std::move(task), Clock::now()});
+        if (idleReserved[lane] > 0) {
+            laneWake[lane].notify_one();
+        } else if (idleShared > 0) {
+            sharedWake.notify_one();
+        }
+    }
+
+    static void workerLoop(std::shared_ptr<State> self, int lane) {
+        State& s = *self;
+        tlsOwner = &s;
+        std::unique_lock<std::mutex> lock(s.mutex);
+        for (;;) {
+            int picked = -1;
+            if (lane == kShared) {
+                picked = s.pickLane(Clock::now());
+            } else if (!s.lanes[lane].empty()) {
+                picked = lane;
+            }
+
+            if (picked >= 0) {
+                Task task = s.lanes[picked].popFront().task;
+                lock.unlock();
+                task();
+                task = nullptr;
+                lock.lock();
+                continue;
+            }
+            if (s.stopping) {
+                return;
+            }
+
+            if (lane == kShared) {
+                ++s.idleShared;
+                s.sharedWake.wait(lock);
+                --s.idleShared;
+            } else {
+                ++s.idleReserved[lane];
+                s.laneWake[lane].wait(lock);
+                --s.idleReserved[lane];
+            }
+        }
+    }
+};
+
+PriorityExecutor::PriorityExecutor() : PriorityExecutor(Options()) {}
+
+PriorityExecutor::PriorityExecutor(Options options)
+    : state_(std::make_shared<State>(options)) {
+    for (int lane = 0; lane < kTaskPriorityCount; ++lane) {
+        for (std::size_t i = 0; i < options.reservedWorkers[lane]; ++i) {
+            threads_.emplace_back(&State::workerLoop, state_, lane);
+        }
+    }
+    std::size_t shared = options.sharedWorkers;
+    for (int lane = 0; lane < kTaskPriorityCount; ++lane) {
+        if (shared == 0 && options.reservedWorkers[lane] == 0) {
+            shared = 1; // every lane needs at least one worker that serves it
+        }
+    }
+    for (std::size_t i = 0; i < shared; ++i) {
+        threads_.emplace_back(&State::workerLoop, state_, kShared);
+    }
+}
+
+PriorityExecutor::~PriorityExecutor() {
+    shutdown();
+}
+
+void PriorityExecutor::run(Task task) {
+    state_->post(std::move(task), TaskPriority::normal);
+}
+
+void PriorityExecutor::run(Task task, TaskPriority priority) {
+    state_->post(std::move(task), priority);
+}
+
+void PriorityExecutor::shutdown() {
+    std::lock_guard<std::mutex> guard(shutdownMutex_);
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopping = true;
+        for (std::condition_variable& wake : state_->laneWake) {
+            wake.notify_all();
+        }
+        state_->sharedWake.notify_all();
+    }
+    // From one of our own tasks we cannot wait for ourselves; detached workers
+    // still drain, holding the shared state.
+    const bool onOwnWorker = tlsOwner == state_.get();
+    for (std::thread& thread : threads_) {
+        if (!thread.joinable()) {
+            continue;
+        }
+        if (onOwnWorker) {
+            thread.detach();
+        } else {
+            thread.join();
+        }
+    }
+}
+
+std::size_t PriorityExecutor::queuedCount(TaskPriority priority) const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->lanes[static_cast<int>(priority)].size();
+}
+
+} // namespace core
@@ -0,0 +1,65 @@
+//
+//  PriorityExecutor.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Thread pool with one FIFO lane per TaskPriority, so a burst of background
+//  sync or telemetry cannot delay a user-visible login. Some workers can be
+//  reserved for a lane (they serve only that lane, so it always has capacity);
+//  the remaining shared workers take the highest-priority work available.
+//
+//  Starvation protection: once the oldest task of a lower lane has waited
+//  longer than agingThreshold, shared workers serve it ahead of higher lanes.
+//
+//  run(task) uses the normal lane. Shutdown mirrors WorkStealingExecutor:
+//  queued work drains, later posts run inline.
+//
+
+#ifndef PUREMVC_CORE_PRIORITY_EXECUTOR_HPP
+#define PUREMVC_CORE_PRIORITY_EXECUTOR_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Domain/Ports/IExecutor.hpp"
+
+namespace core {
+
+class PriorityExecutor : public IExecutor {
+public:
+    struct Options {
+        // Raised to 1 if some lane would otherwise have no worker at all.
+        std::size_t sharedWorkers = 2;
+        // Dedicated workers per lane, indexed by TaskPriority.
+        std::size_t reservedWorkers[kTaskPriorityCount] = {1, 0, 0};
+        std::chrono::milliseconds agingThreshold{500};
+    };
+
+    PriorityExecutor();
+    explicit PriorityExecutor(Options options);
+    ~PriorityExecutor() override;
+
+    PriorityExecutor(const PriorityExecutor&) = delete;
+    PriorityExecutor& operator=(const PriorityExecutor&) = delete;
+
+    void run(Task task) override;
+    void run(Task task, TaskPriority priority) override;
+
+    void shutdown();
+
+    // Tasks waiting in one lane (not counting running ones).
+    std::size_t queuedCount(TaskPriority priority) const;
+
+private:
+    struct State;
+
+    std::shared_ptr<State> state_;
+    std::vector<std::thread> threads_;
+    std::mutex shutdownMutex_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_PRIORITY_EXECUTOR_HPP
@@ -0,0 +1,133 @@
+//
+//  SerialExecutor.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Concurrency/SerialExecutor.hpp"
+#include "Infrastructure/Concurrency/TaskRing.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace core {
+
+struct SerialExecutor::State : std::enable_shared_from_this<SerialExecutor::State> {
+    explicit State(IExecutor& executor) : underlying(executor) {}
+
+    IExecutor& underlying;
+    mutable std::mutex mutex;
+    // A key is present exactly while it has a drain task scheduled or running.
+    std::unordered_map<std::string, TaskRing> queues;
+
+    void post(const std::string& key, Task task) {
+        bool idle = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = queues.find(key);
+            if (it == queues.end()) {
+                it = queues.emplace(key, TaskRing()).first;
+                idle = true;
+            }
+            it->second.pushBack(std::move(task));
+        }
+        if (idle) {
+            scheduleDrain(key);
+        }
+    }
+
+    // Runs one task of its key, or abandons the key if the underlying
+    // executor destroys it without running it (see IExecutor).
+    struct Drain {
+        Drain(std::shared_ptr<State> s, std::string k) : state(std::move(s)), key(std::move(k)) {}
+
+        Drain(Drain&& other) noexcept : state(std::move(other.state)), key(std::move(other.key)) {}
+        Drain& operator=(Drain&&) = delete;
+
+        ~Drain() {
+            if (state) {
+                state->abandon(key);
+            }
+        }
+
+        void operator()() {
+            std::shared_ptr<State> running = std::move(state);
+            running->drainOne(key);
+        }
+
+        std::shared_ptr<State> state;
+        std::string key;
+    };
+
+    void scheduleDrain(const std::string& key) {
+        underlying.run(Drain(shared_from_this(), key));
+    }
+
+    // The drain for 'key' was destroyed unrun: retires the key, so the next
+    // post schedules a fresh drain, and destroys its queued tasks outside
+    // the lock, still under the executor's Rejection if there is one, so
+    // they answer from their destructors.
+    void abandon(const std::string& key) {
+        TaskRing dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = queues.find(key);
+            if (it == queues.end()) {
+                return;
+            }
+            dropped = std::move(it->second);
+            queues.erase(it);
+        }
+    }
+
+    // Runs the oldest task for 'key', then either re-posts itself or retires
+    // the key. The task runs outside the lock; other keys proceed meanwhile.
+    void drainOne(const std::string& key) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = queues.at(key).popFront();
+        }
+        task();
+        task = nullptr;
+
+        bool more = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = queues.find(key);
+            if (it->second.empty()) {
+                queues.erase(it);
+            } else {
+                more = true;
+            }
+        }
+        if (more) {
+            scheduleDrain(key);
+        }
+    }
+};
+
+void SerialExecutor::Strand::run(Task task) {
+    state_->post(key_, std::move(task));
+}
+
+SerialExecutor::SerialExecutor(IExecutor& underlying)
+    : state_(std::make_shared<State>(underlying)) {}
+
+void SerialExecutor::run(const std::string& key, Task task) {
+    state_->post(key, std::move(task));
+}
+
+void SerialExecutor::run(Task task) {
+    state_->post(std::string(), std::move(task));
+}
+
+SerialExecutor::Strand SerialExecutor::strand(std::string key) const {
+    return Strand(state_, std::move(key));
+}
+
+std::size_t SerialExecutor::activeKeyCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->queues.size();
+}
+
+} // namespace core
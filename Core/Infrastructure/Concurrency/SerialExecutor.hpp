@@ -0,0 +1,71 @@
+//
+//  SerialExecutor.hpp
+//  PureMVC Core — Infrastructure
+//
+//  "Strands" over any IExecutor: tasks posted under the same key run in FIFO
+//  order and never overlap, while different keys run in parallel on the
+//  underlying pool. Lets callers serialize e.g. per-account token persistence
+//  or a per-host request stream without holding a lock across the work.
+//
+//  Only one drain task per busy key sits on the underlying executor at a time,
+//  and it re-posts itself after each task so one chatty key cannot monopolize
+//  a worker. Queued work keeps the shared state alive, so the adapter itself
+//  may be destroyed while tasks are still pending. If the underlying
+//  executor destroys a drain without running it (see IExecutor), the key's
+//  queued tasks are destroyed with it, so they answer from their
+//  destructors, and the next post under the key starts afresh.
+//
+
+#ifndef PUREMVC_CORE_SERIAL_EXECUTOR_HPP
+#define PUREMVC_CORE_SERIAL_EXECUTOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include "Domain/Ports/IExecutor.hpp"
+
+namespace core {
+
+class SerialExecutor : public IExecutor {
+    struct State; // per-key queues, shared with the drain tasks
+
+public:
+    // An IExecutor bound to one key of its SerialExecutor, for code that only
+    // knows the IExecutor port.
+    class Strand : public IExecutor {
+    public:
+        using IExecutor::run;
+        void run(Task task) override;
+
+    private:
+        friend class SerialExecutor;
+        Strand(std::shared_ptr<State> state, std::string key)
+            : state_(std::move(state)), key_(std::move(key)) {}
+
+        std::shared_ptr<State> state_;
+        std::string key_;
+    };
+
+    explicit SerialExecutor(IExecutor& underlying);
+
+    using IExecutor::run;
+
+    // FIFO, non-overlapping with every other task posted under 'key'.
+    void run(const std::string& key, Task task);
+
+    // Unkeyed posts share one default strand.
+    void run(Task task) override;
+
+    Strand strand(std::string key) const;
+
+    // Keys with queued or running work (for tests and diagnostics).
+    std::size_t activeKeyCount() const;
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_SERIAL_EXECUTOR_HPP
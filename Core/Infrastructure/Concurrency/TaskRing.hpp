@@ -0,0 +1,67 @@
+//
+//  TaskRing.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Growable circular buffer usable from both ends, mostly of Tasks. Unlike
+//  std::deque (one node per 512-byte Task) it stops allocating once it has
+//  grown to the steady-state backlog. Not synchronized; owners guard it.
+//
+
+#ifndef PUREMVC_CORE_TASK_RING_HPP
+#define PUREMVC_CORE_TASK_RING_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "Domain/Async/Task.hpp"
+
+namespace core {
+
+template <typename T>
+class BasicRing {
+public:
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    void pushBack(T item) {
+        if (size_ == slots_.size()) {
+            grow();
+        }
+        slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(item);
+        ++size_;
+    }
+
+    T& front() { return slots_[head_]; }
+
+    T popBack() {
+        --size_;
+        return std::move(slots_[(head_ + size_) & (slots_.size() - 1)]);
+    }
+
+    T popFront() {
+        T item = std::move(slots_[head_]);
+        head_ = (head_ + 1) & (slots_.size() - 1);
+        --size_;
+        return item;
+    }
+
+private:
+    void grow() {
+        std::vector<T> bigger(slots_.empty() ? 16 : slots_.size() * 2);
+        for (std::size_t i = 0; i < size_; ++i) {
+            bigger[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+        }
+        slots_.swap(bigger);
+        head_ = 0;
+    }
+
+    std::vector<T> slots_; // capacity is always a power of two
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
+
+using TaskRing = BasicRing<Task>;
+
+} // namespace core
+
+#endif // PUREMVC_CORE_TASK_RING_HPP
@@ -17,6 +17,7 @@ namespace core {
 
 class ThreadExecutor : public IExecutor {
 public:
+    using IExecutor::run;
     void run(Task task) override {
         std::thread(std::move(task)).detach();
     }
@@ -0,0 +1,358 @@
+//
+//  TimingWheelScheduler.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace core {
+namespace {
+
+// The wheel proper: tick arithmetic and intrusive slot lists, no clock and no
+// locking. Nodes live in one vector and link by index, so the vector may grow
+// and a timer id can be validated in O(1) with a generation counter.
+class Wheel {
+public:
+    static const int kLevels = 4;
+    static const int kBits = 8;
+    static const std::uint32_t kSlots = 1u << kBits;
+    static const std::uint32_t kNil = std::numeric_limits<std::uint32_t>::max();
+
+    Wheel() {
+        for (std::uint32_t i = 0; i < kLevels * kSlots; ++i) {
+            heads_[i] = kNil;
+            tails_[i] = kNil;
+        }
+    }
+
+    std::uint64_t current() const { return current_; }
+    std::size_t size() const { return size_; }
+
+    IScheduledExecutor::TimerId insert(std::uint64_t expiry, Task task) {
+        std::uint32_t index;
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        Node& node = nodes_[index];
+        node.task = std::move(task);
+        node.expiry = expiry;
+        node.active = true;
+        place(index, current_ + 1);
+        ++size_;
+        return (static_cast<std::uint64_t>(node.generation) << 32) | index;
+    }
+
+    bool cancel(IScheduledExecutor::TimerId id) {
+        const std::uint32_t index = static_cast<std::uint32_t>(id & 0xffffffffu);
+        const std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+        if (index >= nodes_.size()) {
+            return false;
+        }
+        Node& node = nodes_[index];
+        if (!node.active || node.generation != generation) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    // Advances one tick and appends the tasks that became due to 'due'.
+    void step(std::vector<Task>& due) {
+        ++current_;
+        for (int level = 1; level < kLevels; ++level) {
+            // Level N turns over when every level below it has wrapped.
+            if ((current_ & ((std::uint64_t(1) << (kBits * level)) - 1)) != 0) {
+                break;
+            }
+            cascade(slotIndex(level, current_));
+        }
+
+        const std::uint32_t list = slotIndex(0, current_);
+        std::uint32_t index = heads_[list];
+        heads_[list] = kNil;
+        tails_[list] = kNil;
+        while (index != kNil) {
+            Node& node = nodes_[index];
+            const std::uint32_t next = node.next;
+            if (node.expiry <= current_) {
+                due.push_back(std::move(node.task));
+                release(index);
+            } else {
+                place(index, current_ + 1); // clamped placement; not due yet
+            }
+            index = next;
+        }
+    }
+
+    // Ticks from now until the next step that can fire or cascade anything;
+    // 0 when the wheel is empty.
+    std::uint64_t ticksUntilNextEvent() const {
+        if (size_ == 0) {
+            return 0;
+        }
+        const std::uint64_t boundary = (current_ | (kSlots - 1)) + 1;
+        for (std::uint64_t tick = current_ + 1; tick < boundary; ++tick) {
+            if (heads_[slotIndex(0, tick)] != kNil) {
+                return tick - current_;
+            }
+        }
+        return boundary - current_;
+    }
+
+private:
+    struct Node {
+        Task task;
+        std::uint64_t expiry = 0;
+        std::uint32_t prev = kNil;
+        std::uint32_t next = kNil;
+        std::uint32_t list = kNil;
+        std::uint32_t generation = 1;
+        bool active = false;
+    };
+
+    static std::uint32_t slotIndex(int level, std::uint64_t tick) {
+        return static_cast<std::uint32_t>(level) * kSlots +
+               static_cast<std::uint32_t>((tick >> (kBits * level)) & (kSlots - 1));
+    }
+
+    // 'earliest' is the first tick whose level-0 slot has not been processed yet:
+    // current_ + 1 between steps, current_ itself while a step cascades.
+    void place(std::uint32_t index, std::uint64_t earliest) {
+        Node& node = nodes_[index];
+        std::uint64_t expiry = node.expiry > earliest ? node.expiry : earliest;
+        const std::uint64_t horizon = std::uint64_t(1) << (kBits * kLevels);
+        if (expiry - current_ >= horizon) {
+            // Beyond the top level: park it as far out as the wheel reaches; it
+            // is re-placed by its real expiry when that slot cascades.
+            expiry = current_ + horizon - 1;
+        }
+        const std::uint64_t delta = expiry - current_;
+        int level = 0;
+        while (level < kLevels - 1 && delta >= (std::uint64_t(1) << (kBits * (level + 1)))) {
+            ++level;
+        }
+        link(index, slotIndex(level, expiry));
+    }
+
+    void link(std::uint32_t index, std::uint32_t list) {
+        Node& node = nodes_[index];
+        node.list = list;
+        node.next = kNil;
+        node.prev = tails_[list];
+        if (tails_[list] != kNil) {
+            nodes_[tails_[list]].next = index;
+        } else {
+            heads_[list] = index;
+        }
+        tails_[list] = index;
+    }
+
+    void unlink(std::uint32_t index) {
+        Node& node = nodes_[index];
+        if (node.prev != kNil) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            heads_[node.list] = node.next;
+        }
+        if (node.next != kNil) {
+            nodes_[node.next].prev = node.prev;
+        } else {
+            tails_[node.list] = node.prev;
+        }
+    }
+
+    void release(std::uint32_t index) {
+        Node& node = nodes_[index];
+        node.task = nullptr;
+        node.active = false;
+        node.list = kNil;
+        if (++node.generation == 0) {
+            node.generation = 1; // ids are never 0
+        }
+        free_.push_back(index);
+        --size_;
+    }
+
+    // Re-places every timer of one higher-level slot; each lands on a lower
+    // level now that its deadline is closer (or on this very tick).
+    void cascade(std::uint32_t list) {
+        std::uint32_t index = heads_[list];
+        heads_[list] = kNil;
+        tails_[list] = kNil;
+        while (index != kNil) {
+            const std::uint32_t next = nodes_[index].next;
+            place(index, current_);
+            index = next;
+        }
+    }
+
+    std::uint64_t current_ = 0;
+    std::size_t size_ = 0;
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> free_;
+    std::uint32_t heads_[kLevels * kSlots];
+    std::uint32_t tails_[kLevels * kSlots];
+};
+
+} // namespace
+
+struct TimingWheelScheduler::State {
+    State(IExecutor& executor, Options opts)
+        : dispatch(executor), options(opts), epoch(Clock::now()) {}
+
+    IExecutor& dispatch;
+    const Options options;
+    const Clock::time_point epoch;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    Wheel wheel;
+    bool stopping = false;
+    std::uint64_t plannedWakeTick = std::numeric_limits<std::uint64_t>::max();
+    Clock::duration manualNow{0};
+
+    Clock::duration tick() const { return options.tick; }
+
+    // First tick at or after 'deadline'.
+    std::uint64_t tickFor(Clock::time_point deadline) const {
+        if (deadline <= epoch) {
+            return 0;
+        }
+        const Clock::duration since = deadline - epoch;
+        return static_cast<std::uint64_t>((since + tick() - Clock::duration(1)) / tick());
+    }
+
+    // Last tick whose boundary has passed.
+    std::uint64_t elapsedTicks(Clock::time_point at) const {
+        return at <= epoch ? 0 : static_cast<std::uint64_t>((at - epoch) / tick());
+    }
+
+    void dispatchAll(std::vector<Task>& due) {
+        for (Task& task : due) {
+            dispatch.run(std::move(task));
+        }
+        due.clear();
+    }
+};
+
+TimingWheelScheduler::TimingWheelScheduler(IExecutor& dispatch)
+    : TimingWheelScheduler(dispatch, Options()) {}
+
+TimingWheelScheduler::TimingWheelScheduler(IExecutor& dispatch, Options options)
+    : state_(new State(dispatch, options)) {
+    if (!options.manualClock) {
+        thread_ = std::thread([this]() { timerLoop(); });
+    }
+}
+
+TimingWheelScheduler::~TimingWheelScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopping = true;
+    }
+    state_->wake.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void TimingWheelScheduler::run(Task task) {
+    state_->dispatch.run(std::move(task));
+}
+
+IScheduledExecutor::TimerId TimingWheelScheduler::runAt(Clock::time_point deadline, Task task) {
+    const std::uint64_t expiry = state_->tickFor(deadline);
+    TimerId id;
+    bool wakeEarlier = false;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        id = state_->wheel.insert(expiry, std::move(task));
+        wakeEarlier = expiry < state_->plannedWakeTick;
+    }
+    if (wakeEarlier) {
+        state_->wake.notify_one();
+    }
+    return id;
+}
+
+bool TimingWheelScheduler::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->wheel.cancel(id);
+}
+
+IScheduledExecutor::Clock::time_point TimingWheelScheduler::now() const {
+    if (!state_->options.manualClock) {
+        return Clock::now();
+    }
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->epoch + state_->manualNow;
+}
+
+void TimingWheelScheduler::advanceBy(Clock::duration delta) {
+    State& s = *state_;
+    std::vector<Task> due;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    const Clock::duration end = s.manualNow + delta;
+    const std::uint64_t target = s.elapsedTicks(s.epoch + end);
+    while (s.wheel.current() < target) {
+        s.wheel.step(due);
+        // Callbacks see time as of the tick they fire on, so timers they
+        // schedule are placed relative to it.
+        const Clock::duration tickTime = s.tick() * static_cast<Clock::rep>(s.wheel.current());
+        if (tickTime > s.manualNow) {
+            s.manualNow = tickTime;
+        }
+        if (!due.empty()) {
+            lock.unlock();
+            s.dispatchAll(due);
+            lock.lock();
+        }
+    }
+    s.manualNow = end;
+}
+
+std::size_t TimingWheelScheduler::pendingCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->wheel.size();
+}
+
+void TimingWheelScheduler::timerLoop() {
+    State& s = *state_;
+    std::vector<Task> due;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    while (!s.stopping) {
+        const std::uint64_t target = s.elapsedTicks(Clock::now());
+        while (s.wheel.current() < target) {
+            s.wheel.step(due);
+        }
+        if (!due.empty()) {
+            lock.unlock();
+            s.dispatchAll(due);
+            lock.lock();
+            continue;
+        }
+
+        const std::uint64_t ahead = s.wheel.ticksUntilNextEvent();
+        if (ahead == 0) {
+            s.plannedWakeTick = std::numeric_limits<std::uint64_t>::max();
+            s.wake.wait(lock);
+        } else {
+            s.plannedWakeTick = s.wheel.current() + ahead;
+            s.wake.wait_until(lock, s.epoch + s.tick() * static_cast<Clock::rep>(s.plannedWakeTick));
+        }
+    }
+}
+
+} // namespace core
@@ -0,0 +1,73 @@
+//
+//  TimingWheelScheduler.hpp
+//  PureMVC Core — Infrastructure
+//
+//  IScheduledExecutor backed by a hierarchical timing wheel: four levels of 256
+//  slots over a fixed tick (1 ms by default), so inserting and cancelling a
+//  timer are O(1) regardless of how many are pending, and far-off timers
+//  cascade down a level at a time as the wheel turns. One timer thread sleeps
+//  until the next occupied slot; it never runs user work itself — due tasks
+//  are handed to the injected dispatch executor.
+//
+//  With Options::manualClock there is no thread and time only moves through
+//  advanceBy(), which fires due timers on the caller (via the dispatch
+//  executor). Tests use it to step through backoffs and timeouts instantly.
+//
+
+#ifndef PUREMVC_CORE_TIMING_WHEEL_SCHEDULER_HPP
+#define PUREMVC_CORE_TIMING_WHEEL_SCHEDULER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include "Domain/Ports/IScheduledExecutor.hpp"
+
+namespace core {
+
+class TimingWheelScheduler : public IScheduledExecutor {
+public:
+    struct Options {
+        // Timer resolution. Timers fire on the first tick at or after their
+        // deadline, so they are never early and at most one tick late (plus
+        // thread wake-up latency).
+        std::chrono::milliseconds tick{1};
+        // No timer thread; time advances only through advanceBy().
+        bool manualClock = false;
+    };
+
+    explicit TimingWheelScheduler(IExecutor& dispatch);
+    TimingWheelScheduler(IExecutor& dispatch, Options options);
+    ~TimingWheelScheduler() override;
+
+    TimingWheelScheduler(const TimingWheelScheduler&) = delete;
+    TimingWheelScheduler& operator=(const TimingWheelScheduler&) = delete;
+
+    using IExecutor::run;
+
+    // Immediate work goes straight to the dispatch executor.
+    void run(Task task) override;
+
+    TimerId runAt(Clock::time_point deadline, Task task) override;
+    bool cancel(TimerId id) override;
+    Clock::time_point now() const override;
+
+    // Manual clock only: moves virtual time forward, firing every timer that
+    // becomes due, in deadline order, including timers those tasks schedule
+    // inside the window.
+    void advanceBy(Clock::duration delta);
+
+    std::size_t pendingCount() const;
+
+private:
+    struct State;
+
+    void timerLoop();
+
+    std::unique_ptr<State> state_;
+    std::thread thread_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_TIMING_WHEEL_SCHEDULER_HPP
@@ -0,0 +1,211 @@
+//
+//  WorkStealingExecutor.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+#include "Infrastructure/Concurrency/TaskRing.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <utility>
+
+namespace core {
+
+struct WorkStealingExecutor::State {
+    struct Worker {
+        std::mutex mutex;
+        TaskRing tasks;
+    };
+
+    explicit State(std::size_t workerCount) {
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back(new Worker());
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    // Tasks posted from outside the pool, taken oldest first by any worker.
+    Worker injected;
+
+    std::atomic<std::size_t> pending{0};      // queued, not yet picked up
+    std::atomic<std::size_t> submitters{0};   // run() calls past the stop check
+    std::atomic<std::size_t> sleepers{0};
+    std::atomic<bool> stopping{false};
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    void post(Task task);
+    bool popLocal(std::size_t index, Task& out);
+    bool popInjected(Task& out);
+    bool steal(std::size_t thief, Task& out);
+    bool canExit() const {
+        return stopping.load() && submitters.load() == 0 && pending.load() == 0;
+    }
+    void notify(bool all) {
+        // Taking the mutex orders this notify after a sleeper's predicate check.
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        if (all) {
+            wake.notify_all();
+        } else {
+            wake.notify_one();
+        }
+    }
+    static void workerLoop(std::shared_ptr<State> self, std::size_t index);
+};
+
+namespace {
+
+// Identifies the pool (and deque) a worker thread belongs to, so tasks posted
+// from inside a task land on the poster's own deque.
+thread_local const void* tlsOwner = nullptr;
+thread_local std::size_t tlsIndex = 0;
+
+// A worker looks at the injection queue before its own deque once every this
+// many tasks, so one that keeps feeding itself cannot starve outside posts.
+const unsigned kInjectedEvery = 61;
+
+} // namespace
+
+void WorkStealingExecutor::State::post(Task task) {
+    // Registering as a submitter before checking 'stopping' closes the race with
+    // shutdown(): workers only exit once no submitter can still enqueue.
+    submitters.fetch_add(1);
+    if (stopping.load()) {
+        if (submitters.fetch_sub(1) == 1) {
+            notify(true);
+        }
+        task();
+        return;
+    }
+
+    // Count before publishing so 'pending' never underflows when a thief grabs
+    // the task before this thread gets to the increment.
+    pending.fetch_add(1);
+    {
+        Worker& queue = tlsOwner == this ? *workers[tlsIndex] : injected;
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.pushBack(std::move(task));
+    }
+
+    const bool lastSubmitterWhileStopping =
+        submitters.fetch_sub(1) == 1 && stopping.load();
+    if (lastSubmitterWhileStopping) {
+        notify(true);
+    } else if (sleepers.load() > 0) {
+        notify(false);
+    }
+}
+
+bool WorkStealingExecutor::State::popLocal(std::size_t index, Task& out) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    out = worker.tasks.popBack();
+    return true;
+}
+
+bool WorkStealingExecutor::State::popInjected(Task& out) {
+    std::lock_guard<std::mutex> lock(injected.mutex);
+    if (injected.tasks.empty()) {
+        return false;
+    }
+    out = injected.tasks.popFront();
+    return true;
+}
+
+bool WorkStealingExecutor::State::steal(std::size_t thief, Task& out) {
+    const std::size_t count = workers.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers[(thief + offset) % count];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        // Steal the oldest task: the owner works the other end of the deque.
+        out = victim.tasks.popFront();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingExecutor::State::workerLoop(std::shared_ptr<State> self, std::size_t index) {
+    State& state = *self;
+    tlsOwner = &state;
+    tlsIndex = index;
+
+    Task task;
+    unsigned ticks = 0;
+    for (;;) {
+        const bool injectedFirst = ++ticks % kInjectedEvery == 0 && state.popInjected(task);
+        if (injectedFirst || state.popLocal(index, task) || state.popInjected(task) ||
+            state.steal(index, task)) {
+            state.pending.fetch_sub(1);
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state.sleepMutex);
+        state.sleepers.fetch_add(1);
+        // try_to_lock in steal() can skip a contended deque, so re-scan rather
+        // than sleep whenever work is still pending.
+        state.wake.wait(lock, [&state]() { return state.pending.load() > 0 || state.canExit(); });
+        state.sleepers.fetch_sub(1);
+        if (state.canExit()) {
+            tlsOwner = nullptr;
+            return;
+        }
+    }
+}
+
+WorkStealingExecutor::WorkStealingExecutor(std::size_t workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+    }
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+    workerCount_ = workerCount;
+    state_ = std::make_shared<State>(workerCount);
+
+    threads_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        threads_.emplace_back(&State::workerLoop, state_, i);
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    shutdown();
+}
+
+void WorkStealingExecutor::run(Task task) {
+    state_->post(std::move(task));
+}
+
+void WorkStealingExecutor::shutdown() {
+    std::lock_guard<std::mutex> guard(shutdownMutex_);
+    {
+        std::lock_guard<std::mutex> lock(state_->sleepMutex);
+        state_->stopping.store(true);
+    }
+    state_->wake.notify_all();
+
+    const bool onOwnWorker = tlsOwner == state_.get();
+    for (std::thread& thread : threads_) {
+        if (!thread.joinable()) {
+            continue;
+        }
+        if (onOwnWorker) {
+            thread.detach();
+        } else {
+            thread.join();
+        }
+    }
+}
+
+} // namespace core
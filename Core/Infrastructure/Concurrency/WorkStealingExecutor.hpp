@@ -0,0 +1,63 @@
+//
+//  WorkStealingExecutor.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Bounded thread pool behind IExecutor. Each worker owns a deque: tasks posted
+//  from a worker go to its own deque (popped LIFO, cache-warm), tasks posted
+//  from outside go to one shared injection queue that workers take from FIFO
+//  once their own deque is empty (and now and then before it, so a worker
+//  feeding itself cannot starve outside callers), and an idle worker steals
+//  the oldest task from a busy neighbour. Outside callers keep the FIFO start
+//  order ThreadExecutor gave them; callers only ever see IExecutor.
+//
+//  Shutdown is defined: shutdown() (or the destructor) stops accepting work,
+//  lets the workers drain everything already queued, then joins them. A task
+//  posted after shutdown runs inline on the caller, so callbacks always fire.
+//  When the last owner lets go from inside one of the pool's own tasks (e.g. a
+//  bridge object released by its completion lambda), the workers are detached
+//  instead and still drain; their shared state outlives this object.
+//
+
+#ifndef PUREMVC_CORE_WORK_STEALING_EXECUTOR_HPP
+#define PUREMVC_CORE_WORK_STEALING_EXECUTOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Domain/Ports/IExecutor.hpp"
+
+namespace core {
+
+class WorkStealingExecutor : public IExecutor {
+public:
+    // workerCount == 0 => one worker per hardware thread (at least one).
+    explicit WorkStealingExecutor(std::size_t workerCount = 0);
+    ~WorkStealingExecutor() override;
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    using IExecutor::run;
+    void run(Task task) override;
+
+    // Drains queued work and joins the workers. Idempotent. Called from one of
+    // this executor's own tasks it cannot wait for itself, so it detaches the
+    // workers and returns while they drain.
+    void shutdown();
+
+    std::size_t workerCount() const { return workerCount_; }
+
+private:
+    struct State; // deques + sleep/stop bookkeeping, shared with the workers
+
+    std::size_t workerCount_;
+    std::shared_ptr<State> state_;
+    std::vector<std::thread> threads_;
+    std::mutex shutdownMutex_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_WORK_STEALING_EXECUTOR_HPP
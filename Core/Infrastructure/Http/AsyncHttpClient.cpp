@@ -0,0 +1,573 @@
+//
+//  AsyncHttpClient.cpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  Everything about a connection happens on its loop's thread, so loop state
+//  needs no locks; only the counters behind poolStats() are atomics. Reactor
+//  callbacks (I/O and timers) capture the loop and a connection id rather
+//  than a pointer: a connection closed earlier in the same batch is simply
+//  not found. Pooling, queueing, retry and delivery are HttpConnectionPool's;
+//  this file drives the sockets.
+//
+
+#include "Infrastructure/Http/AsyncHttpClient.hpp"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Infrastructure/Concurrency/EpollReactor.hpp"
+#include "Infrastructure/Http/DnsCache.hpp"
+#include "Infrastructure/Http/HttpConnectionPool.hpp"
+#include "Infrastructure/Http/HttpResponseParser.hpp"
+#include "Infrastructure/Security/CertificatePinner.hpp"
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include "Infrastructure/Http/TlsVerification.hpp"
+#else
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+#endif
+
+namespace core {
+namespace {
+
+using Clock = IScheduledExecutor::Clock;
+using TimerId = IScheduledExecutor::TimerId;
+
+struct Connection : PooledConnection {
+    enum class Phase { connecting, handshaking, writing, reading, idle };
+
+    std::uint64_t id = 0;
+    int fd = -1;
+    SSL* ssl = nullptr;
+    Phase phase = Phase::connecting;
+    std::uint32_t watching = 0;     // events registered with the reactor
+    std::size_t sent = 0;
+    TimerId timer = 0;
+    std::uint64_t timerSerial = 0;  // tells a live timer from a cancelled one
+    Clock::time_point lastActivity;
+};
+
+// One event-loop thread and the connections it owns; the pool logic is
+// HttpConnectionPool's. Every member function except the constructor runs
+// on the loop thread.
+class Loop : public HttpConnectionPool {
+public:
+    Loop(const HttpClientConfig& config, SSL_CTX* ctx, DnsCache& dns, IExecutor& callbacks,
+         std::size_t maxConnections, std::size_t maxIdle)
+        : HttpConnectionPool(config, dns, callbacks, maxConnections, maxIdle), ctx_(ctx) {}
+
+    void closeAll(const std::string& reason);
+
+    EpollReactor reactor;
+
+private:
+    using Phase = Connection::Phase;
+
+    Clock::time_point now() const override { return reactor.now(); }
+    void connect(std::unique_ptr<HttpExchange> exchange, const SocketAddress& address) override;
+    void begin(PooledConnection& connection, std::unique_ptr<HttpExchange> exchange) override;
+    void parked(PooledConnection& connection) override;
+    void release(PooledConnection& connection) override;
+    void waitUntil(Clock::time_point deadline) override;
+    void notifyResolved() override;
+
+    void onEvent(std::uint64_t id, std::uint32_t events);
+    void onTimer(std::uint64_t id, std::uint64_t serial);
+    void watchFor(Connection& connection, std::uint32_t events);
+    void armTimer(Connection& connection, Clock::time_point deadline);
+    void cancelTimer(Connection& connection);
+
+    void onConnected(Connection& connection);
+    void handshake(Connection& connection);
+    void write(Connection& connection);
+    void read(Connection& connection);
+    void onIdleEvent(Connection& connection, std::uint32_t events);
+
+    SSL_CTX* const ctx_;
+    std::unordered_map<std::uint64_t, std::unique_ptr<Connection>> connections_;
+    std::uint64_t nextId_ = 0;
+    char buffer_[16 * 1024];
+};
+
+// Hands an exchange to its loop; the reactor runs it on the loop thread.
+struct SubmitTask {
+    SubmitTask(Loop* l, std::unique_ptr<HttpExchange> e) : loop(l), exchange(std::move(e)) {}
+    void operator()() { loop->submit(std::move(exchange)); }
+
+    Loop* loop;
+    std::unique_ptr<HttpExchange> exchange;
+};
+
+void Loop::connect(std::unique_ptr<HttpExchange> exchange, const SocketAddress& address) {
+    const int fd = ::socket(address.family(), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        deliver(std::move(exchange), transportFailure(systemError("Cannot create socket", errno)));
+        return;
+    }
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (::connect(fd, address.get(), address.length) != 0 &&
+        errno != EINPROGRESS) {
+        const int code = errno;
+        ::close(fd);
+        deliver(std::move(exchange), transportFailure(systemError("Connection failed", code)));
+        return;
+    }
+
+    std::unique_ptr<Connection> owned(new Connection);
+    Connection& connection = *owned;
+    connection.id = ++nextId_;
+    connection.fd = fd;
+    connection.exchange = std::move(exchange);
+    connections_[connection.id] = std::move(owned);
+    opened();
+
+    // Covers the TCP connect and the TLS handshake.
+    armTimer(connection, reactor.now() + std::chrono::seconds(config_.connectionTimeoutSec));
+    watchFor(connection, EpollReactor::writable);
+}
+
+// Each queued request arms one timer; one that fires after its request has
+// left the queue finds nothing due.
+void Loop::waitUntil(Clock::time_point deadline) {
+    reactor.runAt(deadline, [this]() { expireWaiting(); });
+}
+
+void Loop::notifyResolved() {
+    reactor.run([this]() { resolved(); });
+}
+
+// Idle sockets stay watched for readable: a well-behaved server sends
+// nothing between responses, so readiness means it closed the connection.
+void Loop::parked(PooledConnection& pooled) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    connection.phase = Phase::idle;
+    watchFor(connection, EpollReactor::readable);
+}
+
+void Loop::closeAll(const std::string& reason) {
+    stop(reason);
+    while (!connections_.empty()) {
+        Connection& connection = *connections_.begin()->second;
+        std::unique_ptr<HttpExchange> exchange = std::move(connection.exchange);
+        close(connection);
+        if (exchange) {
+            deliver(std::move(exchange), transportFailure(reason));
+        }
+    }
+}
+
+// Callers return right after: if the reactor cannot watch the socket it
+// reports 'closed' inline, which closes the connection.
+void Loop::watchFor(Connection& connection, std::uint32_t events) {
+    if (connection.watching == events) {
+        return;
+    }
+    connection.watching = events;
+    const std::uint64_t id = connection.id;
+    reactor.watch(connection.fd, events, [this, id](std::uint32_t ready) { onEvent(id, ready); });
+}
+
+void Loop::armTimer(Connection& connection, Clock::time_point deadline) {
+    cancelTimer(connection);
+    const std::uint64_t id = connection.id;
+    const std::uint64_t serial = ++connection.timerSerial;
+    connection.timer = reactor.runAt(deadline, [this, id, serial]() { onTimer(id, serial); });
+}
+
+void Loop::cancelTimer(Connection& connection) {
+    if (connection.timer != 0) {
+        reactor.cancel(connection.timer);
+        connection.timer = 0;
+        ++connection.timerSerial; // in case it is already due in this batch
+    }
+}
+
+void Loop::onTimer(std::uint64_t id, std::uint64_t serial) {
+    auto found = connections_.find(id);
+    if (found == connections_.end() || found->second->timerSerial != serial) {
+        return;
+    }
+    Connection& connection = *found->second;
+    connection.timer = 0;
+    if (connection.phase == Phase::connecting || connection.phase == Phase::handshaking) {
+        fail(connection, "Connection timed out", false);
+        return;
+    }
+    // Reads and writes share one inactivity timeout; progress pushes it out.
+    const Clock::time_point deadline =
+        connection.lastActivity + std::chrono::seconds(config_.readTimeoutSec);
+    if (reactor.now() >= deadline) {
+        fail(connection, "Read timed out", false);
+        return;
+    }
+    armTimer(connection, deadline);
+}
+
+void Loop::onEvent(std::uint64_t id, std::uint32_t events) {
+    auto found = connections_.find(id);
+    if (found == connections_.end()) {
+        return;
+    }
+    Connection& connection = *found->second;
+    switch (connection.phase) {
+    case Phase::connecting: {
+        int code = 0;
+        socklen_t length = sizeof(code);
+        if (::getsockopt(connection.fd, SOL_SOCKET, SO_ERROR, &code, &length) != 0) {
+            code = errno;
+        }
+        if (code != 0) {
+            fail(connection, systemError("Connection failed", code), false);
+            return;
+        }
+        if ((events & EpollReactor::closed) && !(events & EpollReactor::writable)) {
+            fail(connection, "Connection failed", false);
+            return;
+        }
+        onConnected(connection);
+        return;
+    }
+    case Phase::handshaking:
+        handshake(connection);
+        return;
+    case Phase::writing:
+        write(connection);
+        return;
+    case Phase::reading:
+        read(connection);
+        return;
+    case Phase::idle:
+        onIdleEvent(connection, events);
+        return;
+    }
+}
+
+void Loop::onConnected(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (ctx_ != nullptr) {
+        connection.ssl = SSL_new(ctx_);
+        if (connection.ssl == nullptr) {
+            fail(connection, "TLS setup failed", false);
+            return;
+        }
+        SSL_set_fd(connection.ssl, connection.fd);
+        if (!isIpLiteral(config_.host)) {
+            SSL_set_tlsext_host_name(connection.ssl, config_.host.c_str());
+        }
+        connection.phase = Phase::handshaking;
+        handshake(connection);
+        return;
+    }
+#endif
+    begin(connection, std::move(connection.exchange));
+}
+
+void Loop::handshake(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    ERR_clear_error();
+    const int result = SSL_connect(connection.ssl);
+    if (result == 1) {
+        std::atomic<std::uint64_t>& counter =
+            SSL_session_reused(connection.ssl) ? counters_.resumedHandshakes : counters_.fullHandshakes;
+        counter.fetch_add(1, std::memory_order_relaxed);
+        begin(connection, std::move(connection.exchange));
+        return;
+    }
+    switch (SSL_get_error(connection.ssl, result)) {
+    case SSL_ERROR_WANT_READ:
+        watchFor(connection, EpollReactor::readable);
+        return;
+    case SSL_ERROR_WANT_WRITE:
+        watchFor(connection, EpollReactor::writable);
+        return;
+    default: {
+        const long verified = SSL_get_verify_result(connection.ssl);
+        std::string message = "TLS handshake failed";
+        if (verified != X509_V_OK) {
+            message += std::string(": ") + X509_verify_cert_error_string(verified);
+        } else if (const unsigned long code = ERR_peek_last_error()) {
+            char text[256];
+            ERR_error_string_n(code, text, sizeof(text));
+            message += std::string(": ") + text;
+        }
+        fail(connection, message, false);
+        return;
+    }
+    }
+#else
+    fail(connection, "SSL not supported in this build", false);
+#endif
+}
+
+void Loop::begin(PooledConnection& pooled, std::unique_ptr<HttpExchange> exchange) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    connection.exchange = std::move(exchange);
+    connection.phase = Phase::writing;
+    connection.sent = 0;
+    connection.parser.reset(connection.exchange->head);
+    connection.lastActivity = reactor.now();
+    armTimer(connection,
+             connection.lastActivity + std::chrono::seconds(config_.readTimeoutSec));
+    write(connection);
+}
+
+void Loop::write(Connection& connection) {
+    const std::string& wire = *connection.exchange->wire;
+    while (connection.sent < wire.size()) {
+        const char* data = wire.data() + connection.sent;
+        const std::size_t size = wire.size() - connection.sent;
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        if (connection.ssl != nullptr) {
+            ERR_clear_error();
+            const int written = SSL_write(connection.ssl, data,
+                                          static_cast<int>(std::min<std::size_t>(size, 1 << 30)));
+            if (written > 0) {
+                connection.sent += static_cast<std::size_t>(written);
+                connection.lastActivity = reactor.now();
+                continue;
+            }
+            const int error = SSL_get_error(connection.ssl, written);
+            if (error == SSL_ERROR_WANT_WRITE || error == SSL_ERROR_WANT_READ) {
+                watchFor(connection, error == SSL_ERROR_WANT_WRITE ? EpollReactor::writable
+                                                                   : EpollReactor::readable);
+                return;
+            }
+            fail(connection, "Send failed", true);
+            return;
+        }
+#endif
+        const ssize_t written = ::send(connection.fd, data, size, MSG_NOSIGNAL);
+        if (written >= 0) {
+            connection.sent += static_cast<std::size_t>(written);
+            connection.lastActivity = reactor.now();
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            watchFor(connection, EpollReactor::writable);
+            return;
+        }
+        if (errno != EINTR) {
+            fail(connection, systemError("Send failed", errno), true);
+            return;
+        }
+    }
+    connection.phase = Phase::reading;
+    watchFor(connection, EpollReactor::readable);
+}
+
+// Drains what the socket (and, for TLS, OpenSSL's record buffer, which
+// epoll cannot see) has now; the reactor calls again when more arrives.
+void Loop::read(Connection& connection) {
+    HttpResponseParser& parser = connection.parser;
+    for (;;) {
+        ssize_t received = 0;
+        bool closed = false;
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        if (connection.ssl != nullptr) {
+            ERR_clear_error();
+            const int result = SSL_read(connection.ssl, buffer_, sizeof(buffer_));
+            if (result > 0) {
+                received = result;
+            } else {
+                const int error = SSL_get_error(connection.ssl, result);
+                if (error == SSL_ERROR_WANT_READ) {
+                    watchFor(connection, EpollReactor::readable);
+                    return;
+                }
+                if (error == SSL_ERROR_WANT_WRITE) {
+                    watchFor(connection, EpollReactor::writable);
+                    return;
+                }
+                if (error != SSL_ERROR_ZERO_RETURN &&
+                    !(error == SSL_ERROR_SYSCALL && ERR_peek_error() == 0)) {
+                    fail(connection, "Receive failed: TLS error", true);
+                    return;
+                }
+                closed = true;
+            }
+        } else
+#endif
+        {
+            received = ::recv(connection.fd, buffer_, sizeof(buffer_), 0);
+            if (received < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    watchFor(connection, EpollReactor::readable);
+                    return;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                fail(connection, systemError("Receive failed", errno), true);
+                return;
+            }
+            closed = received == 0;
+        }
+
+        if (closed) {
+            parser.finishOnClose();
+            if (parser.complete()) {
+                complete(connection, false);
+            } else {
+                fail(connection, parser.error(), true);
+            }
+            return;
+        }
+        connection.lastActivity = reactor.now();
+        const std::size_t used = parser.feed(buffer_, static_cast<std::size_t>(received));
+        if (parser.failed()) {
+            fail(connection, "Malformed response: " + parser.error(), false);
+            return;
+        }
+        if (parser.complete()) {
+            // Bytes past the end of the response mean the stream can no
+            // longer be trusted for another request.
+            complete(connection, used == static_cast<std::size_t>(received));
+            return;
+        }
+    }
+}
+
+void Loop::onIdleEvent(Connection& connection, std::uint32_t events) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (connection.ssl != nullptr && !(events & EpollReactor::closed)) {
+        // TLS 1.3 servers send session tickets after the handshake; reading
+        // them consumes no application data.
+        ERR_clear_error();
+        const int result = SSL_read(connection.ssl, buffer_, sizeof(buffer_));
+        if (result <= 0 && SSL_get_error(connection.ssl, result) == SSL_ERROR_WANT_READ) {
+            return;
+        }
+    }
+#else
+    (void)events;
+#endif
+    closeStale(connection);
+}
+
+void Loop::release(PooledConnection& pooled) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    cancelTimer(connection);
+    if (connection.watching != 0) {
+        reactor.unwatch(connection.fd);
+    }
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    SSL_free(connection.ssl); // null-safe
+#endif
+    ::close(connection.fd);
+    connections_.erase(connection.id); // destroys 'connection'
+}
+
+// Ceil(total / parts), but never 0 when total isn't.
+std::size_t share(std::size_t total, std::size_t parts) {
+    return (total + parts - 1) / parts;
+}
+
+} // namespace
+
+struct AsyncHttpClient::Engine {
+    Engine(HttpClientConfig c, IExecutor& callbacks, Options options)
+        : config(std::move(c)), pinner(config.pinnedSpkiSha256Base64),
+          dns(config.dnsCache ? config.dnsCache : DnsCache::shared()), callbackExecutor(callbacks) {
+        setUpTls();
+        const std::size_t count = std::max<std::size_t>(options.loops, 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            loops.emplace_back(new Loop(config, ctx, *dns, callbacks, share(config.maxConnectionsPerHost, count),
+                                        share(config.maxIdleConnections, count)));
+        }
+    }
+
+    ~Engine() {
+        for (auto& loop : loops) {
+            Loop* raw = loop.get();
+            raw->reactor.run([raw]() { raw->closeAll("Request cancelled: client destroyed"); });
+            raw->reactor.shutdown();
+        }
+        loops.clear();
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        SSL_CTX_free(ctx); // null-safe
+#endif
+    }
+
+    void setUpTls() {
+        if (!config.useSSL) {
+            return;
+        }
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        ctx = newClientContext(config, pinner, setupError);
+#else
+        setupError = "SSL not supported in this build";
+#endif
+    }
+
+    const HttpClientConfig config;
+    const CertificatePinner pinner; // referenced by ctx
+    const std::shared_ptr<DnsCache> dns;
+    IExecutor& callbackExecutor;
+    SSL_CTX* ctx = nullptr;
+    std::string setupError;          // every request fails with it
+    std::vector<std::unique_ptr<Loop>> loops;
+    std::atomic<std::size_t> next{0};
+};
+
+AsyncHttpClient::AsyncHttpClient(HttpClientConfig config, IExecutor& callbackExecutor)
+    : AsyncHttpClient(std::move(config), callbackExecutor, Options()) {}
+
+AsyncHttpClient::AsyncHttpClient(HttpClientConfig config, IExecutor& callbackExecutor, Options options)
+    : engine_(new Engine(std::move(config), callbackExecutor, options)) {}
+
+AsyncHttpClient::~AsyncHttpClient() = default;
+
+void AsyncHttpClient::send(const HttpRequest& request, Callback callback) {
+    std::string error = engine_->setupError;
+    std::unique_ptr<HttpExchange> exchange;
+    if (error.empty()) {
+        exchange = HttpConnectionPool::prepare(engine_->config, request, error);
+    }
+    if (!exchange) {
+        HttpConnectionPool::deliver(engine_->callbackExecutor, std::move(callback), transportFailure(error),
+                                    request.priority);
+        return;
+    }
+    exchange->callback = std::move(callback);
+
+    const std::size_t index =
+        engine_->next.fetch_add(1, std::memory_order_relaxed) % engine_->loops.size();
+    Loop* loop = engine_->loops[index].get();
+    loop->reactor.run(SubmitTask(loop, std::move(exchange)));
+}
+
+ConnectionPoolStats AsyncHttpClient::poolStats() const {
+    ConnectionPoolStats stats;
+    for (const auto& loop : engine_->loops) {
+        loop->addStats(stats);
+    }
+    return stats;
+}
+
+void AsyncHttpClient::closeIdleConnections() {
+    for (const auto& loop : engine_->loops) {
+        Loop* raw = loop.get();
+        raw->reactor.run([raw]() { raw->closeIdle(); });
+    }
+}
+
+} // namespace core
+
+#endif // defined(__linux__)
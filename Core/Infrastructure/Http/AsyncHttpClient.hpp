@@ -0,0 +1,72 @@
+//
+//  AsyncHttpClient.hpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  Non-blocking HTTP/1.1 IHttpClient: sockets are driven by EpollReactor
+//  event loops instead of parking a thread per request, so one loop keeps
+//  thousands of requests in flight. Each request is serialised on the
+//  caller's thread, handed to a loop (round-robin), written and parsed there
+//  incrementally (HttpResponseParser), and its callback is run on the
+//  injected IExecutor with the request's priority.
+//
+//  Same HttpClientConfig contract as HttplibHttpClient: keep-alive pool with
+//  idle/per-host limits (shared out evenly between the loops), connect and
+//  read timeouts, one retry of an idempotent request whose reused connection
+//  turned out to be dead. HTTPS (under CPPHTTPLIB_OPENSSL_SUPPORT) runs
+//  OpenSSL in non-blocking mode with the same chain, host name and
+//  CertificatePinner checks, against a trust store parsed once per client.
+//
+//  Destroying the client answers every request still in flight or queued
+//  with a transportError, then stops the loops.
+//
+//  The whole component compiles to nothing outside Linux (and Android).
+//
+
+#ifndef PUREMVC_CORE_ASYNC_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_ASYNC_HTTP_CLIENT_HPP
+
+#if defined(__linux__)
+
+#include <cstddef>
+#include <memory>
+#include "Domain/Ports/IExecutor.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+class AsyncHttpClient : public IHttpClient {
+public:
+    struct Options {
+        // Event-loop threads. One is plenty for I/O-bound traffic; more only
+        // help when TLS or parsing saturates a core.
+        std::size_t loops = 1;
+    };
+
+    AsyncHttpClient(HttpClientConfig config, IExecutor& callbackExecutor);
+    AsyncHttpClient(HttpClientConfig config, IExecutor& callbackExecutor, Options options);
+    ~AsyncHttpClient() override;
+
+    AsyncHttpClient(const AsyncHttpClient&) = delete;
+    AsyncHttpClient& operator=(const AsyncHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+
+    // Summed over the loops; a snapshot, as the loops keep running.
+    ConnectionPoolStats poolStats() const;
+
+    // Closes every idle connection (asynchronously, on the loops).
+    void closeIdleConnections();
+
+private:
+    struct Engine; // SSL_CTX and event loops
+
+    std::unique_ptr<Engine> engine_;
+};
+
+} // namespace core
+
+#endif // defined(__linux__)
+
+#endif // PUREMVC_CORE_ASYNC_HTTP_CLIENT_HPP
@@ -0,0 +1,774 @@
+//
+//  CachingHttpClient.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/CachingHttpClient.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
+
+namespace core {
+namespace {
+
+using Seconds = std::int64_t;
+using VaryValues = std::vector<std::pair<std::string, std::string>>;
+
+const char kFileMagic[] = "PMVC-HTTP-CACHE 1\n";
+const char kFileSuffix[] = ".entry";
+const char kTempSuffix[] = ".tmp";
+const Seconds kMaxHeuristicLifetime = 24 * 60 * 60;
+
+struct CacheControl {
+    bool noStore = false;
+    bool noCache = false;
+    bool mustRevalidate = false;
+    bool isPublic = false;
+    bool sharedMaxAge = false; // s-maxage given
+    Seconds maxAge = -1; // -1: not given
+    Seconds staleWhileRevalidate = 0;
+};
+
+std::string trim(const std::string& s) {
+    std::size_t begin = 0;
+    std::size_t end = s.size();
+    while (begin < end && (s[begin] == ' ' || s[begin] == '\t')) {
+        ++begin;
+    }
+    while (end > begin && (s[end - 1] == ' ' || s[end - 1] == '\t')) {
+        --end;
+    }
+    return s.substr(begin, end - begin);
+}
+
+// Delta-seconds: digits only, saturating instead of overflowing.
+bool parseSeconds(const std::string& s, Seconds& out) {
+    if (s.empty()) {
+        return false;
+    }
+    Seconds value = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = std::min<Seconds>(value * 10 + (c - '0'), 0x7fffffff);
+    }
+    out = value;
+    return true;
+}
+
+// Splits a comma-separated header list, trimming each element.
+template <typename Visit>
+void forEachElement(const HttpHeaders& headers, HttpHeader header, Visit visit) {
+    for (const HttpHeaders::Field& field : headers) {
+        if (!field.is(header)) {
+            continue;
+        }
+        std::size_t pos = 0;
+        while (pos <= field.value.size()) {
+            std::size_t comma = field.value.find(',', pos);
+            if (comma == std::string::npos) {
+                comma = field.value.size();
+            }
+            const std::string element = trim(field.value.substr(pos, comma - pos));
+            if (!element.empty()) {
+                visit(element);
+            }
+            pos = comma + 1;
+        }
+    }
+}
+
+CacheControl parseCacheControl(const HttpHeaders& headers) {
+    CacheControl cc;
+    forEachElement(headers, HttpHeader::cacheControl, [&cc](const std::string& directive) {
+        std::string name = directive;
+        std::string value;
+        const std::size_t eq = directive.find('=');
+        if (eq != std::string::npos) {
+            name = trim(directive.substr(0, eq));
+            value = trim(directive.substr(eq + 1));
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                value = value.substr(1, value.size() - 2);
+            }
+        }
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+        if (name == "no-store") {
+            cc.noStore = true;
+        } else if (name == "no-cache") {
+            cc.noCache = true;
+        } else if (name == "must-revalidate") {
+            cc.mustRevalidate = true;
+        } else if (name == "public") {
+            cc.isPublic = true;
+        } else if (name == "s-maxage") {
+            cc.sharedMaxAge = true;
+        } else if (name == "max-age") {
+            parseSeconds(value, cc.maxAge);
+        } else if (name == "stale-while-revalidate") {
+            parseSeconds(value, cc.staleWhileRevalidate);
+        }
+    });
+    return cc;
+}
+
+bool isStorableStatus(int status) {
+    switch (status) {
+    case 200: case 203: case 204: case 301: case 404: case 410:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Request header names a response varies by; false for Vary: *.
+bool varyNames(const HttpHeaders& response, std::vector<std::string>& names) {
+    bool any = false;
+    forEachElement(response, HttpHeader::vary, [&names, &any](const std::string& name) {
+        any = any || name == "*";
+        names.push_back(name);
+    });
+    return !any;
+}
+
+// Stable across runs and platforms, unlike std::hash.
+std::string fileNameFor(const std::string& key) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : key) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(name) + kFileSuffix;
+}
+
+bool endsWith(const std::string& s, const char* suffix) {
+    const std::size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// Files are a magic line and then length-prefixed fields ("5:hello").
+void putField(std::string& out, const std::string& field) {
+    out += std::to_string(field.size());
+    out += ':';
+    out += field;
+}
+
+bool takeField(const std::string& in, std::size_t& pos, std::string& field) {
+    const std::size_t colon = in.find(':', pos);
+    Seconds length = 0;
+    if (colon == std::string::npos || colon - pos > 10 || !parseSeconds(in.substr(pos, colon - pos), length) ||
+        static_cast<std::size_t>(length) > in.size() - colon - 1) {
+        return false;
+    }
+    field.assign(in, colon + 1, static_cast<std::size_t>(length));
+    pos = colon + 1 + static_cast<std::size_t>(length);
+    return true;
+}
+
+bool takeNumber(const std::string& in, std::size_t& pos, Seconds& number) {
+    std::string field;
+    return takeField(in, pos, field) && parseSeconds(field, number);
+}
+
+} // namespace
+
+struct CachingHttpClient::Entry {
+    std::string key;
+    VaryValues vary; // the request headers it was chosen by
+    HttpResponse response;
+    Seconds storedAt = 0; // received, or last revalidated
+
+    // Derived from the response headers and storedAt by describe().
+    Seconds initialAge = 0;
+    Seconds lifetime = 0;
+    Seconds staleWhileRevalidate = 0;
+    bool alwaysRevalidate = false; // no-cache
+    bool neverStale = false;       // no-cache, must-revalidate
+    bool memoryOnly = false;       // answers an Authorization request
+    std::size_t bytes = 0;         // counted against the budgets
+
+    Seconds age(Seconds now) const { return initialAge + std::max<Seconds>(0, now - storedAt); }
+
+    bool hasValidator() const {
+        return response.headers.contains(HttpHeader::etag) || response.headers.contains(HttpHeader::lastModified);
+    }
+
+    bool matches(const HttpHeaders& request) const {
+        for (const auto& header : vary) {
+            if (request.get(header.first) != header.second) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void describe() {
+        const HttpHeaders& headers = response.headers;
+        const CacheControl cc = parseCacheControl(headers);
+        Seconds date = storedAt;
+        const bool dated = HttpHeaders::parseDate(headers.get(HttpHeader::date), date);
+        Seconds ageHeader = 0;
+        parseSeconds(headers.get(HttpHeader::age), ageHeader);
+        initialAge = std::max(ageHeader, dated ? std::max<Seconds>(0, storedAt - date) : 0);
+
+        Seconds expires = 0;
+        Seconds lastModified = 0;
+        if (cc.maxAge >= 0) {
+            lifetime = cc.maxAge;
+        } else if (headers.contains(HttpHeader::expires)) {
+            // An unparseable Expires ("0") means already expired.
+            const bool valid = HttpHeaders::parseDate(headers.get(HttpHeader::expires), expires);
+            lifetime = valid ? std::max<Seconds>(0, expires - date) : 0;
+        } else if (HttpHeaders::parseDate(headers.get(HttpHeader::lastModified), lastModified)) {
+            lifetime = std::min(kMaxHeuristicLifetime, std::max<Seconds>(0, date - lastModified) / 10);
+        } else {
+            lifetime = 0;
+        }
+        staleWhileRevalidate = cc.staleWhileRevalidate;
+        alwaysRevalidate = cc.noCache;
+        neverStale = cc.noCache || cc.mustRevalidate;
+
+        bytes = sizeof(Entry) + key.size() + response.body.size();
+        for (const HttpHeaders::Field& field : headers) {
+            bytes += sizeof(field) + field.name().size() + field.value.size();
+        }
+        for (const auto& header : vary) {
+            bytes += sizeof(header) + header.first.size() + header.second.size();
+        }
+    }
+
+    std::string encode() const {
+        std::string out(kFileMagic);
+        out.reserve(bytes + 64);
+        putField(out, key);
+        putField(out, std::to_string(storedAt));
+        putField(out, std::to_string(response.status));
+        putField(out, std::to_string(vary.size()));
+        for (const auto& header : vary) {
+            putField(out, header.first);
+            putField(out, header.second);
+        }
+        putField(out, std::to_string(response.headers.size()));
+        for (const HttpHeaders::Field& field : response.headers) {
+            putField(out, field.name());
+            putField(out, field.value);
+        }
+        putField(out, response.body);
+        return out;
+    }
+
+    bool decode(const std::string& in) {
+        const std::size_t magic = sizeof(kFileMagic) - 1;
+        if (in.compare(0, magic, kFileMagic) != 0) {
+            return false;
+        }
+        std::size_t pos = magic;
+        Seconds status = 0, count = 0;
+        if (!takeField(in, pos, key) || !takeNumber(in, pos, storedAt) || !takeNumber(in, pos, status) ||
+            !takeNumber(in, pos, count)) {
+            return false;
+        }
+        response.status = static_cast<int>(status);
+        for (Seconds i = 0; i < count; ++i) {
+            std::pair<std::string, std::string> header;
+            if (!takeField(in, pos, header.first) || !takeField(in, pos, header.second)) {
+                return false;
+            }
+            vary.push_back(std::move(header));
+        }
+        if (!takeNumber(in, pos, count)) {
+            return false;
+        }
+        for (Seconds i = 0; i < count; ++i) {
+            std::string name, value;
+            if (!takeField(in, pos, name) || !takeField(in, pos, value)) {
+                return false;
+            }
+            response.headers.add(name, std::move(value));
+        }
+        if (!takeField(in, pos, response.body) || pos != in.size()) {
+            return false;
+        }
+        describe();
+        return true;
+    }
+};
+
+struct CachingHttpClient::State : std::enable_shared_from_this<CachingHttpClient::State> {
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    struct DiskFile {
+        std::list<std::string>::iterator position;
+        std::size_t bytes;
+    };
+
+    State(IHttpClient& client, Options opts) : inner(client), options(std::move(opts)) {
+        if (!options.now) {
+            options.now = []() { return WallClock::now(); };
+        }
+        if (!options.diskDirectory.empty()) {
+            if (options.diskDirectory.back() != '/') {
+                options.diskDirectory += '/';
+            }
+            loadDiskIndex();
+        }
+    }
+
+    IHttpClient& inner;
+    Options options;
+
+    mutable std::mutex mutex;
+    std::list<EntryPtr> memoryOrder; // most recently used first
+    std::unordered_map<std::string, std::list<EntryPtr>::iterator> memory;
+    std::size_t memoryBytes = 0;
+    std::list<std::string> diskOrder; // file names, most recently used first
+    std::unordered_map<std::string, DiskFile> disk;
+    std::size_t diskBytes = 0;
+    std::set<std::string> revalidating; // keys with a background request out
+    std::uint64_t nextTemp = 0;
+    CacheStats stats;
+
+    bool diskEnabled() const { return !options.diskDirectory.empty(); }
+
+    Seconds now() const {
+        return std::chrono::duration_cast<std::chrono::seconds>(options.now().time_since_epoch()).count();
+    }
+
+    template <typename Request>
+    void send(Request&& request, Callback callback) {
+        if (request.method != "GET") {
+            if (isSafeMethod(request.method)) {
+                inner.send(std::forward<Request>(request), std::move(callback));
+                return;
+            }
+            // A change that went through makes what is stored for it wrong.
+            std::shared_ptr<State> self = shared_from_this();
+            const std::string key = request.path;
+            inner.send(std::forward<Request>(request), [self, key, callback](const HttpResponse& response) {
+                if (!response.transportError && response.status < 400) {
+                    self->remove(key);
+                }
+                callback(response);
+            });
+            return;
+        }
+
+        const CacheControl asked = parseCacheControl(request.headers);
+        if (asked.noStore || request.headers.contains(HttpHeader::ifNoneMatch) ||
+            request.headers.contains(HttpHeader::ifModifiedSince)) {
+            count(&CacheStats::misses);
+            inner.send(std::forward<Request>(request), std::move(callback));
+            return;
+        }
+
+        const EntryPtr entry = lookup(request.path, request.headers);
+        if (!entry) {
+            count(&CacheStats::misses);
+            fetch(std::forward<Request>(request), nullptr, std::move(callback));
+            return;
+        }
+        const Seconds age = entry->age(now());
+        const bool revalidateFirst = asked.noCache || asked.maxAge == 0 || entry->alwaysRevalidate;
+        if (!revalidateFirst && age < entry->lifetime) {
+            count(&CacheStats::hits);
+            callback(entry->response);
+            return;
+        }
+        if (!revalidateFirst && !entry->neverStale && age < entry->lifetime + entry->staleWhileRevalidate) {
+            count(&CacheStats::staleServed);
+            callback(entry->response);
+            if (startBackgroundRevalidation(entry->key)) {
+                fetch(std::forward<Request>(request), entry, nullptr);
+            }
+            return;
+        }
+        if (!entry->hasValidator()) {
+            count(&CacheStats::misses); // nothing to revalidate with
+            fetch(std::forward<Request>(request), nullptr, std::move(callback));
+            return;
+        }
+        fetch(std::forward<Request>(request), entry, std::move(callback));
+    }
+
+    template <typename Request>
+    void sendStreaming(Request&& request, StreamHandler handler) {
+        if (request.method == "GET" && !parseCacheControl(request.headers).noCache) {
+            const EntryPtr entry = lookup(request.path, request.headers);
+            if (entry && !entry->alwaysRevalidate && entry->age(now()) < entry->lifetime) {
+                count(&CacheStats::hits);
+                replayBuffered(handler, entry->response);
+                return;
+            }
+        }
+        if (!isSafeMethod(request.method)) {
+            std::shared_ptr<State> self = shared_from_this();
+            const std::string key = request.path;
+            Callback done = handler.onComplete;
+            handler.onComplete = [self, key, done](const HttpResponse& response) {
+                if (!response.transportError && response.status < 400) {
+                    self->remove(key);
+                }
+                if (done) {
+                    done(response);
+                }
+            };
+        }
+        inner.sendStreaming(std::forward<Request>(request), std::move(handler));
+    }
+
+    // Sends 'request', conditional on 'stale' when there is one. An empty
+    // callback is a background revalidation.
+    template <typename Request>
+    void fetch(Request&& request, EntryPtr stale, Callback callback) {
+        HttpRequest outgoing(std::forward<Request>(request));
+        if (stale) {
+            count(&CacheStats::revalidations);
+            const HttpHeaders& validators = stale->response.headers;
+            if (const std::string* etag = validators.find(HttpHeader::etag)) {
+                outgoing.headers.set(HttpHeader::ifNoneMatch, *etag);
+            }
+            if (const std::string* modified = validators.find(HttpHeader::lastModified)) {
+                outgoing.headers.set(HttpHeader::ifModifiedSince, *modified);
+            }
+        }
+        std::shared_ptr<State> self = shared_from_this();
+        const std::string key = outgoing.path;
+        const HttpHeaders requestHeaders = outgoing.headers;
+        inner.send(std::move(outgoing),
+                   [self, key, requestHeaders, stale, callback](const HttpResponse& response) {
+                       self->finished(key, requestHeaders, stale, response, callback);
+                   });
+    }
+
+    void finished(const std::string& key, const HttpHeaders& requestHeaders, const EntryPtr& stale,
+                  const HttpResponse& response, const Callback& callback) {
+        if (!callback) {
+            std::lock_guard<std::mutex> lock(mutex);
+            revalidating.erase(key);
+        }
+        if (stale && !response.transportError && response.status == 304) {
+            count(&CacheStats::notModified);
+            std::shared_ptr<Entry> refreshed = std::make_shared<Entry>(*stale);
+            for (const HttpHeaders::Field& field : response.headers) {
+                if (!field.is(HttpHeader::contentLength) && !field.is(HttpHeader::transferEncoding) &&
+                    !field.is(HttpHeader::connection) && !field.is(HttpHeader::keepAlive)) {
+                    refreshed->response.headers.set(field.name(), field.value);
+                }
+            }
+            refreshed->storedAt = now();
+            refreshed->describe();
+            remember(refreshed);
+            if (callback) {
+                callback(refreshed->response);
+            }
+            persist(refreshed);
+            return;
+        }
+
+        const CacheControl cc = parseCacheControl(response.headers);
+        std::vector<std::string> names;
+        // RFC 9111, 3.5: an answer to a request with credentials only if the
+        // response allows it.
+        const bool authorized = requestHeaders.contains(HttpHeader::authorization);
+        const bool storable = !response.transportError && !cc.noStore && isStorableStatus(response.status) &&
+                              (!authorized || cc.isPublic || cc.sharedMaxAge || cc.mustRevalidate) &&
+                              varyNames(response.headers, names) &&
+                              (cc.maxAge >= 0 || response.headers.contains(HttpHeader::expires) ||
+                               response.headers.contains(HttpHeader::etag) ||
+                               response.headers.contains(HttpHeader::lastModified));
+        if (!storable) {
+            // A server error leaves the stored answer for next time.
+            if (!response.transportError && response.status < 500) {
+                remove(key);
+            }
+            if (callback) {
+                callback(response);
+            }
+            return;
+        }
+
+        std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+        entry->key = key;
+        for (const std::string& name : names) {
+            entry->vary.emplace_back(name, requestHeaders.get(name));
+        }
+        if (authorized) {
+            // Only for the same credentials, and never on disk in the clear.
+            entry->vary.emplace_back(HttpHeaders::canonicalName(HttpHeader::authorization),
+                                     requestHeaders.get(HttpHeader::authorization));
+            entry->memoryOnly = true;
+        }
+        entry->response = response;
+        entry->storedAt = now();
+        entry->describe();
+        remember(entry);
+        if (callback) {
+            callback(response);
+        }
+        persist(entry);
+    }
+
+    bool startBackgroundRevalidation(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return revalidating.insert(key).second;
+    }
+
+    void count(std::uint64_t CacheStats::*counter) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++(stats.*counter);
+    }
+
+    EntryPtr lookup(const std::string& key, const HttpHeaders& requestHeaders) {
+        std::string fileName;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = memory.find(key);
+            if (it != memory.end()) {
+                memoryOrder.splice(memoryOrder.begin(), memoryOrder, it->second);
+                const EntryPtr entry = *it->second;
+                return entry->matches(requestHeaders) ? entry : nullptr;
+            }
+            if (!diskEnabled()) {
+                return nullptr;
+            }
+            fileName = fileNameFor(key);
+            auto file = disk.find(fileName);
+            if (file == disk.end()) {
+                return nullptr;
+            }
+            diskOrder.splice(diskOrder.begin(), diskOrder, file->second.position);
+        }
+
+        std::ifstream in(options.diskDirectory + fileName, std::ios::binary);
+        const std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::shared_ptr<Entry> loaded = std::make_shared<Entry>();
+        if (!loaded->decode(contents)) {
+            forgetFile(fileName);
+            return nullptr;
+        }
+        if (loaded->key != key) {
+            return nullptr; // another key with the same hash
+        }
+        remember(loaded);
+        return loaded->matches(requestHeaders) ? loaded : nullptr;
+    }
+
+    // Into memory, evicting from the cold end.
+    void remember(const EntryPtr& entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        dropFromMemory(entry->key);
+        if (entry->bytes > options.memoryBytes || options.memoryEntries == 0) {
+            return;
+        }
+        memoryOrder.push_front(entry);
+        memory[entry->key] = memoryOrder.begin();
+        memoryBytes += entry->bytes;
+        while (memoryBytes > options.memoryBytes || memory.size() > options.memoryEntries) {
+            dropFromMemory(memoryOrder.back()->key);
+            ++stats.evictions;
+        }
+    }
+
+    // Under the lock.
+    void dropFromMemory(const std::string& key) {
+        auto it = memory.find(key);
+        if (it == memory.end()) {
+            return;
+        }
+        memoryBytes -= (*it->second)->bytes;
+        memoryOrder.erase(it->second);
+        memory.erase(it);
+    }
+
+    // Onto disk: written aside and renamed over, so a reader never sees half
+    // a file.
+    void persist(const EntryPtr& entry) {
+        if (!diskEnabled()) {
+            return;
+        }
+        if (entry->memoryOnly) {
+            forgetFile(fileNameFor(entry->key)); // an older answer must not outlive it there
+            return;
+        }
+        const std::string contents = entry->encode();
+        if (contents.size() > options.diskBytes) {
+            return;
+        }
+        const std::string fileName = fileNameFor(entry->key);
+        std::string temp;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            temp = options.diskDirectory + fileName + "." + std::to_string(nextTemp++) + kTempSuffix;
+        }
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            if (!out) {
+                std::remove(temp.c_str());
+                return;
+            }
+        }
+        if (std::rename(temp.c_str(), (options.diskDirectory + fileName).c_str()) != 0) {
+            std::remove(temp.c_str());
+            return;
+        }
+
+        std::vector<std::string> evicted;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dropFromDisk(fileName);
+            indexFile(fileName, contents.size(), false);
+            while (diskBytes > options.diskBytes && diskOrder.size() > 1) {
+                evicted.push_back(diskOrder.back());
+                dropFromDisk(diskOrder.back());
+                ++stats.evictions;
+            }
+        }
+        for (const std::string& name : evicted) {
+            std::remove((options.diskDirectory + name).c_str());
+        }
+    }
+
+    // Under the lock.
+    void indexFile(const std::string& fileName, std::size_t bytes, bool coldest) {
+        auto position = coldest ? diskOrder.insert(diskOrder.end(), fileName)
+                                : diskOrder.insert(diskOrder.begin(), fileName);
+        disk[fileName] = DiskFile{position, bytes};
+        diskBytes += bytes;
+    }
+
+    // Under the lock.
+    bool dropFromDisk(const std::string& fileName) {
+        auto it = disk.find(fileName);
+        if (it == disk.end()) {
+            return false;
+        }
+        diskBytes -= it->second.bytes;
+        diskOrder.erase(it->second.position);
+        disk.erase(it);
+        return true;
+    }
+
+    void forgetFile(const std::string& fileName) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!dropFromDisk(fileName)) {
+                return;
+            }
+        }
+        std::remove((options.diskDirectory + fileName).c_str());
+    }
+
+    void remove(const std::string& key) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dropFromMemory(key);
+        }
+        if (diskEnabled()) {
+            forgetFile(fileNameFor(key));
+        }
+    }
+
+    // Indexes what an earlier run left, least recently written coldest.
+    // Only file sizes and times are read here; contents on first use.
+    void loadDiskIndex() {
+        ::mkdir(options.diskDirectory.c_str(), 0700);
+        DIR* dir = ::opendir(options.diskDirectory.c_str());
+        if (dir == nullptr) {
+            return;
+        }
+        std::vector<std::pair<time_t, std::pair<std::string, std::size_t>>> found;
+        while (struct dirent* item = ::readdir(dir)) {
+            const std::string name = item->d_name;
+            const std::string path = options.diskDirectory + name;
+            struct stat info;
+            if (endsWith(name, kTempSuffix)) {
+                std::remove(path.c_str()); // a write that never finished
+            } else if (endsWith(name, kFileSuffix) && ::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+                found.push_back(std::make_pair(info.st_mtime, std::make_pair(name, static_cast<std::size_t>(info.st_size))));
+            }
+        }
+        ::closedir(dir);
+        std::sort(found.begin(), found.end());
+        for (auto it = found.rbegin(); it != found.rend(); ++it) {
+            indexFile(it->second.first, it->second.second, true);
+        }
+        while (diskBytes > options.diskBytes && !diskOrder.empty()) {
+            std::remove((options.diskDirectory + diskOrder.back()).c_str());
+            dropFromDisk(diskOrder.back());
+        }
+    }
+
+    void clear() {
+        std::vector<std::string> files;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            memoryOrder.clear();
+            memory.clear();
+            memoryBytes = 0;
+            files.assign(diskOrder.begin(), diskOrder.end());
+            diskOrder.clear();
+            disk.clear();
+            diskBytes = 0;
+        }
+        for (const std::string& name : files) {
+            std::remove((options.diskDirectory + name).c_str());
+        }
+    }
+};
+
+CachingHttpClient::CachingHttpClient(IHttpClient& inner) : CachingHttpClient(inner, Options()) {}
+
+CachingHttpClient::CachingHttpClient(IHttpClient& inner, Options options)
+    : state_(std::make_shared<State>(inner, std::move(options))) {}
+
+CachingHttpClient::~CachingHttpClient() = default;
+
+void CachingHttpClient::send(const HttpRequest& request, Callback callback) {
+    state_->send(request, std::move(callback));
+}
+
+void CachingHttpClient::send(HttpRequest&& request, Callback callback) {
+    state_->send(std::move(request), std::move(callback));
+}
+
+void CachingHttpClient::sendStreaming(const HttpRequest& request, StreamHandler handler) {
+    state_->sendStreaming(request, std::move(handler));
+}
+
+void CachingHttpClient::sendStreaming(HttpRequest&& request, StreamHandler handler) {
+    state_->sendStreaming(std::move(request), std::move(handler));
+}
+
+void CachingHttpClient::clear() {
+    state_->clear();
+}
+
+CacheStats CachingHttpClient::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    CacheStats stats = state_->stats;
+    stats.memoryEntries = state_->memory.size();
+    stats.memoryBytes = state_->memoryBytes;
+    stats.diskEntries = state_->disk.size();
+    stats.diskBytes = state_->diskBytes;
+    return stats;
+}
+
+} // namespace core
@@ -0,0 +1,108 @@
+//
+//  CachingHttpClient.hpp
+//  PureMVC Core — Infrastructure
+//
+//  A private (single-user) HTTP cache in front of any IHttpClient, so a GET
+//  the server has said is still good never goes over the wire, and one that
+//  has gone stale costs a 304 instead of the whole body.
+//
+//  What is stored: answers to GET with status 200, 203, 204, 301, 404 or
+//  410 that say how long they stay fresh (Cache-Control max-age, Expires)
+//  or carry a validator (ETag, Last-Modified). Not stored: Cache-Control
+//  no-store, Vary: *, and requests that bring their own If-None-Match or
+//  If-Modified-Since. A successful POST, PUT, PATCH or DELETE to a path
+//  drops what is cached for it. The key is the path (with its query); a
+//  client talks to one host (HttpClientConfig). Headers named by Vary must
+//  match the stored request's, else it is a miss.
+//
+//  An answer to a request with Authorization is stored only when the
+//  response says public, s-maxage or must-revalidate (RFC 9111, 3.5), and
+//  then only in memory and only for requests with the same Authorization.
+//
+//  Freshness is max-age, else Expires - Date, else a tenth of the time
+//  since Last-Modified (at most a day). Within it the stored response is
+//  answered on the calling thread. Past it, the request goes out with
+//  If-None-Match / If-Modified-Since; a 304 refreshes the entry and is
+//  answered with the stored body. With stale-while-revalidate=N the stale
+//  response is answered at once for N more seconds while that request runs
+//  in the background. no-cache (from either side) and must-revalidate
+//  always revalidate first.
+//
+//  Two tiers, each with a byte budget and least-recently-used eviction:
+//  memory, and, when Options::diskDirectory is set, one file per entry in
+//  that directory, which outlives the process. Entries are written to both
+//  (those above excepted); a memory miss that hits disk is promoted. An entry larger than a tier's
+//  budget skips that tier.
+//
+//  Streaming requests are answered from a fresh entry when there is one and
+//  otherwise passed through unchanged; they never fill the cache. The inner
+//  client must outlive this one.
+//
+
+#ifndef PUREMVC_CORE_CACHING_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_CACHING_HTTP_CLIENT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+struct CacheStats {
+    std::uint64_t hits = 0;          // answered from a fresh entry
+    std::uint64_t misses = 0;        // nothing usable stored: sent as is
+    std::uint64_t revalidations = 0; // conditional requests sent
+    std::uint64_t notModified = 0;   // ... answered 304
+    std::uint64_t staleServed = 0;   // stale-while-revalidate answers
+    std::uint64_t evictions = 0;     // entries dropped for a budget, either tier
+    std::size_t memoryEntries = 0;
+    std::size_t memoryBytes = 0;
+    std::size_t diskEntries = 0;
+    std::size_t diskBytes = 0;
+};
+
+class CachingHttpClient : public IHttpClient {
+public:
+    using WallClock = std::chrono::system_clock;
+
+    struct Options {
+        std::size_t memoryBytes = 4 * 1024 * 1024;
+        std::size_t memoryEntries = 512;
+        std::string diskDirectory;               // empty: memory only
+        std::size_t diskBytes = 32 * 1024 * 1024;
+        // Wall clock, as Date and Expires are. Tests substitute their own.
+        std::function<WallClock::time_point()> now;
+    };
+
+    explicit CachingHttpClient(IHttpClient& inner);
+    CachingHttpClient(IHttpClient& inner, Options options);
+    ~CachingHttpClient() override;
+
+    CachingHttpClient(const CachingHttpClient&) = delete;
+    CachingHttpClient& operator=(const CachingHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+    void send(HttpRequest&& request, Callback callback) override;
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override;
+    void sendStreaming(HttpRequest&& request, StreamHandler handler) override;
+
+    // Empties both tiers. Call it on logout.
+    void clear();
+
+    CacheStats stats() const;
+
+private:
+    struct State; // both tiers, kept alive by requests in flight
+    struct Entry;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_CACHING_HTTP_CLIENT_HPP
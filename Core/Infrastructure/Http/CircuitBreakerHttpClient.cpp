@@ -0,0 +1,281 @@
+//
+//  CircuitBreakerHttpClient.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/CircuitBreakerHttpClient.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace core {
+namespace {
+
+using Clock = IScheduledExecutor::Clock;
+
+HttpResponse openCircuit() {
+    HttpResponse response;
+    response.transportError = true;
+    response.transportErrorMessage = CircuitBreakerHttpClient::openCircuitMessage();
+    return response;
+}
+
+// A handler abandoning its own stream says nothing about the backend.
+bool isFailure(const HttpResponse& response) {
+    if (response.transportError) {
+        return response.transportErrorMessage != IHttpClient::streamCancelledMessage();
+    }
+    return response.status >= 500;
+}
+
+} // namespace
+
+struct CircuitBreakerHttpClient::State : std::enable_shared_from_this<CircuitBreakerHttpClient::State> {
+    // Why a request was let through, so its outcome lands in the right place.
+    struct Ticket {
+        bool admitted;
+        bool probe;
+        std::uint64_t epoch;
+        Clock::time_point start;
+    };
+
+    // A transition made under the lock, reported after it.
+    struct Change {
+        bool happened = false;
+        CircuitState from = CircuitState::closed;
+        CircuitState to = CircuitState::closed;
+        std::uint64_t epoch = 0;
+    };
+
+    State(IHttpClient& client, IScheduledExecutor& timers, Options opts)
+        : inner(client), scheduler(timers), options(std::move(opts)) {
+        options.windowSize = std::max<std::size_t>(1, options.windowSize);
+        options.minimumCalls = std::min(std::max<std::size_t>(1, options.minimumCalls), options.windowSize);
+        options.halfOpenProbes = std::max<std::size_t>(1, options.halfOpenProbes);
+        window.assign(options.windowSize, 0);
+    }
+
+    static const std::uint8_t kFailed = 1;
+    static const std::uint8_t kSlow = 2;
+
+    IHttpClient& inner;
+    IScheduledExecutor& scheduler;
+    Options options;
+
+    mutable std::mutex mutex;
+    CircuitState current = CircuitState::closed;
+    std::uint64_t epoch = 0; // bumped by every transition
+    std::vector<std::uint8_t> window; // ring of kFailed | kSlow
+    std::size_t next = 0;
+    std::size_t recorded = 0;
+    std::size_t failures = 0;
+    std::size_t slow = 0;
+    std::size_t probesAdmitted = 0;
+    std::size_t probesSucceeded = 0;
+    IScheduledExecutor::TimerId timer = 0; // open -> halfOpen
+    CircuitBreakerStats stats;
+
+    Ticket admit() {
+        Ticket ticket{false, false, 0, scheduler.now()};
+        std::lock_guard<std::mutex> lock(mutex);
+        ticket.epoch = epoch;
+        if (current == CircuitState::closed) {
+            ticket.admitted = true;
+        } else if (current == CircuitState::halfOpen && probesAdmitted < options.halfOpenProbes) {
+            ++probesAdmitted;
+            ticket.admitted = true;
+            ticket.probe = true;
+        } else {
+            ++stats.rejected;
+        }
+        return ticket;
+    }
+
+    void record(const Ticket& ticket, const HttpResponse& response) {
+        const bool failed = isFailure(response);
+        const bool tooSlow = scheduler.now() - ticket.start >= options.slowCallThreshold;
+        Change change;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ticket.epoch != epoch) {
+                return; // admitted under a state that has since changed
+            }
+            if (current == CircuitState::closed) {
+                remember(static_cast<std::uint8_t>((failed ? kFailed : 0) | (tooSlow ? kSlow : 0)));
+                if (recorded >= options.minimumCalls &&
+                    (failures >= options.failureRateThreshold * static_cast<double>(recorded) ||
+                     slow >= options.slowCallRateThreshold * static_cast<double>(recorded))) {
+                    change = transition(CircuitState::open);
+                }
+            } else if (current == CircuitState::halfOpen && ticket.probe) {
+                if (failed || tooSlow) {
+                    change = transition(CircuitState::open);
+                } else if (++probesSucceeded == options.halfOpenProbes) {
+                    change = transition(CircuitState::closed);
+                }
+            }
+        }
+        report(change);
+    }
+
+    // Adds one outcome to the ring, dropping the oldest once it is full.
+    void remember(std::uint8_t outcome) {
+        if (recorded == window.size()) {
+            failures -= (window[next] & kFailed) != 0 ? 1 : 0;
+            slow -= (window[next] & kSlow) != 0 ? 1 : 0;
+        } else {
+            ++recorded;
+        }
+        window[next] = outcome;
+        failures += (outcome & kFailed) != 0 ? 1 : 0;
+        slow += (outcome & kSlow) != 0 ? 1 : 0;
+        next = (next + 1) % window.size();
+    }
+
+    // Under the lock.
+    Change transition(CircuitState to) {
+        Change change;
+        change.happened = true;
+        change.from = current;
+        change.to = to;
+        change.epoch = ++epoch;
+        current = to;
+        stats.state = to;
+        probesAdmitted = 0;
+        probesSucceeded = 0;
+        timer = 0;
+        if (to == CircuitState::open) {
+            ++stats.trips;
+        } else if (to == CircuitState::closed) {
+            std::fill(window.begin(), window.end(), 0);
+            next = recorded = failures = slow = 0;
+        }
+        return change;
+    }
+
+    // Outside the lock: the scheduler has a lock of its own, and the
+    // listener may call back into the client.
+    void report(const Change& change) {
+        if (!change.happened) {
+            return;
+        }
+        if (change.to == CircuitState::open) {
+            std::weak_ptr<State> weak = shared_from_this();
+            const std::uint64_t opened = change.epoch;
+            const IScheduledExecutor::TimerId id = scheduler.runAfter(options.openDuration, [weak, opened]() {
+                if (std::shared_ptr<State> self = weak.lock()) {
+                    self->probe(opened);
+                }
+            });
+            std::lock_guard<std::mutex> lock(mutex);
+            if (epoch == opened) {
+                timer = id;
+            }
+        }
+        if (options.onStateChange) {
+            options.onStateChange(change.from, change.to);
+        }
+    }
+
+    void probe(std::uint64_t opened) {
+        Change change;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (epoch != opened || current != CircuitState::open) {
+                return;
+            }
+            change = transition(CircuitState::halfOpen);
+        }
+        report(change);
+    }
+
+    void stop() {
+        IScheduledExecutor::TimerId pending = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(pending, timer);
+        }
+        if (pending != 0) {
+            scheduler.cancel(pending);
+        }
+    }
+
+    Callback wrap(const Ticket& ticket, Callback callback) {
+        std::shared_ptr<State> self = shared_from_this();
+        return [self, ticket, callback](const HttpResponse& response) {
+            self->record(ticket, response);
+            callback(response);
+        };
+    }
+
+    StreamHandler wrap(const Ticket& ticket, StreamHandler handler) {
+        handler.onComplete = wrap(ticket, handler.onComplete ? std::move(handler.onComplete)
+                                                             : Callback([](const HttpResponse&) {}));
+        return handler;
+    }
+};
+
+CircuitBreakerHttpClient::CircuitBreakerHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler)
+    : CircuitBreakerHttpClient(inner, scheduler, Options()) {}
+
+CircuitBreakerHttpClient::CircuitBreakerHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler,
+                                                   Options options)
+    : state_(std::make_shared<State>(inner, scheduler, std::move(options))) {}
+
+CircuitBreakerHttpClient::~CircuitBreakerHttpClient() {
+    state_->stop();
+}
+
+void CircuitBreakerHttpClient::send(const HttpRequest& request, Callback callback) {
+    const State::Ticket ticket = state_->admit();
+    if (!ticket.admitted) {
+        callback(openCircuit());
+        return;
+    }
+    state_->inner.send(request, state_->wrap(ticket, std::move(callback)));
+}
+
+void CircuitBreakerHttpClient::send(HttpRequest&& request, Callback callback) {
+    const State::Ticket ticket = state_->admit();
+    if (!ticket.admitted) {
+        callback(openCircuit());
+        return;
+    }
+    state_->inner.send(std::move(request), state_->wrap(ticket, std::move(callback)));
+}
+
+void CircuitBreakerHttpClient::sendStreaming(const HttpRequest& request, StreamHandler handler) {
+    const State::Ticket ticket = state_->admit();
+    if (!ticket.admitted) {
+        if (handler.onComplete) {
+            handler.onComplete(openCircuit());
+        }
+        return;
+    }
+    state_->inner.sendStreaming(request, state_->wrap(ticket, std::move(handler)));
+}
+
+void CircuitBreakerHttpClient::sendStreaming(HttpRequest&& request, StreamHandler handler) {
+    const State::Ticket ticket = state_->admit();
+    if (!ticket.admitted) {
+        if (handler.onComplete) {
+            handler.onComplete(openCircuit());
+        }
+        return;
+    }
+    state_->inner.sendStreaming(std::move(request), state_->wrap(ticket, std::move(handler)));
+}
+
+CircuitState CircuitBreakerHttpClient::state() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->current;
+}
+
+CircuitBreakerStats CircuitBreakerHttpClient::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->stats;
+}
+
+} // namespace core
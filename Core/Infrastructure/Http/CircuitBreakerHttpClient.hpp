@@ -0,0 +1,92 @@
+//
+//  CircuitBreakerHttpClient.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Fails fast in front of any IHttpClient while its backend is down, instead
+//  of letting every request wait out connectionTimeoutSec/readTimeoutSec and
+//  tie up a worker meanwhile. A client talks to one host (HttpClientConfig),
+//  so one breaker per client is one breaker per host.
+//
+//  closed    — requests go through; the last windowSize outcomes are kept.
+//              Once minimumCalls are in, too high a share of failures
+//              (transport errors, 5xx) or of slow calls trips the breaker.
+//  open      — every request is answered at once, on the calling thread,
+//              with a transportError carrying openCircuitMessage(). After
+//              openDuration (a timer on the IScheduledExecutor) ...
+//  halfOpen  — ... up to halfOpenProbes requests go through as probes, the
+//              rest still fail fast. All probes succeeding closes the
+//              breaker with an empty window; any failing or slow probe opens
+//              it again.
+//
+//  Outcomes of requests admitted before the latest state change are not
+//  counted. Options::onStateChange is told of every transition, on the
+//  thread that caused it (a completing request or the timer), outside the
+//  breaker's lock. The inner client and the scheduler must outlive this one.
+//
+
+#ifndef PUREMVC_CORE_CIRCUIT_BREAKER_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_CIRCUIT_BREAKER_HTTP_CLIENT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "Domain/Ports/IScheduledExecutor.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+enum class CircuitState {
+    closed,
+    open,
+    halfOpen,
+};
+
+struct CircuitBreakerStats {
+    CircuitState state = CircuitState::closed;
+    std::uint64_t trips = 0;    // closed/halfOpen -> open
+    std::uint64_t rejected = 0; // answered without reaching the inner client
+};
+
+class CircuitBreakerHttpClient : public IHttpClient {
+public:
+    struct Options {
+        std::size_t windowSize = 20;        // outcomes remembered while closed
+        std::size_t minimumCalls = 10;      // before the window may trip
+        double failureRateThreshold = 0.5;  // trips at or above this share
+        std::chrono::milliseconds slowCallThreshold{3000};
+        double slowCallRateThreshold = 0.8; // above 1 disables
+        std::chrono::milliseconds openDuration{10000};
+        std::size_t halfOpenProbes = 2;
+        std::function<void(CircuitState from, CircuitState to)> onStateChange;
+    };
+
+    CircuitBreakerHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler);
+    CircuitBreakerHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options);
+    ~CircuitBreakerHttpClient() override;
+
+    CircuitBreakerHttpClient(const CircuitBreakerHttpClient&) = delete;
+    CircuitBreakerHttpClient& operator=(const CircuitBreakerHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+    void send(HttpRequest&& request, Callback callback) override;
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override;
+    void sendStreaming(HttpRequest&& request, StreamHandler handler) override;
+
+    CircuitState state() const;
+    CircuitBreakerStats stats() const;
+
+    // transportErrorMessage of a request refused by an open breaker.
+    static const char* openCircuitMessage() { return "Circuit open: backend failing, request not sent"; }
+
+private:
+    struct State; // window and state, kept alive by requests in flight and the timer
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_CIRCUIT_BREAKER_HTTP_CLIENT_HPP
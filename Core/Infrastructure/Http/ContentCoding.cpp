@@ -0,0 +1,338 @@
+//
+//  ContentCoding.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/ContentCoding.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "Infrastructure/Http/HttpHeaders.hpp"
+
+#ifdef PUREMVC_CORE_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef PUREMVC_CORE_HAS_BROTLI
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#endif
+#ifdef PUREMVC_CORE_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace core {
+namespace {
+
+// Decoded output is handed on in pieces of this size.
+const std::size_t kChunk = 16 * 1024;
+
+#ifdef PUREMVC_CORE_HAS_ZLIB
+class ZlibDecoder : public ContentDecoder {
+public:
+    ZlibDecoder() {
+        std::memset(&stream_, 0, sizeof(stream_));
+        valid_ = inflateInit2(&stream_, 15 + 32) == Z_OK; // +32: gzip or zlib header
+    }
+
+    ~ZlibDecoder() override {
+        if (valid_) {
+            inflateEnd(&stream_);
+        }
+    }
+
+    bool write(const char* data, std::size_t size, const Sink& sink) override {
+        if (!valid_ || (done_ && size > 0)) {
+            return false;
+        }
+        char out[kChunk];
+        while (size > 0) {
+            const uInt piece = static_cast<uInt>(std::min<std::size_t>(size, std::numeric_limits<uInt>::max()));
+            stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream_.avail_in = piece;
+            do {
+                stream_.next_out = reinterpret_cast<Bytef*>(out);
+                stream_.avail_out = sizeof(out);
+                const int rc = inflate(&stream_, Z_NO_FLUSH);
+                if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) {
+                    return false;
+                }
+                const std::size_t produced = sizeof(out) - stream_.avail_out;
+                if (produced > 0 && !sink(out, produced)) {
+                    return false;
+                }
+                if (rc == Z_BUF_ERROR && produced == 0) {
+                    return stream_.avail_in == 0; // no progress on input left: corrupt
+                }
+                if (rc == Z_STREAM_END) {
+                    done_ = true;
+                    return stream_.avail_in == 0 && size == piece;
+                }
+            } while (stream_.avail_in > 0 || stream_.avail_out == 0);
+            data += piece;
+            size -= piece;
+        }
+        return true;
+    }
+
+    bool finished() const override { return done_; }
+
+private:
+    z_stream stream_;
+    bool valid_ = false;
+    bool done_ = false;
+};
+
+bool zlibCompress(const std::string& in, std::string& out, int level, bool gzip) {
+    if (in.size() > std::numeric_limits<uInt>::max()) {
+        return false;
+    }
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out.resize(deflateBound(&stream, static_cast<uLong>(in.size())) + (gzip ? 18 : 0));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+    stream.avail_in = static_cast<uInt>(in.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    const int rc = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return rc == Z_STREAM_END;
+}
+#endif
+
+#ifdef PUREMVC_CORE_HAS_BROTLI
+class BrotliDecoder : public ContentDecoder {
+public:
+    BrotliDecoder() : state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)) {}
+    ~BrotliDecoder() override { BrotliDecoderDestroyInstance(state_); } // null-safe
+
+    bool write(const char* data, std::size_t size, const Sink& sink) override {
+        if (state_ == nullptr || (done_ && size > 0)) {
+            return false;
+        }
+        const std::uint8_t* next = reinterpret_cast<const std::uint8_t*>(data);
+        std::size_t available = size;
+        std::uint8_t out[kChunk];
+        for (;;) {
+            std::uint8_t* nextOut = out;
+            std::size_t room = sizeof(out);
+            const BrotliDecoderResult rc =
+                BrotliDecoderDecompressStream(state_, &available, &next, &room, &nextOut, nullptr);
+            if (rc == BROTLI_DECODER_RESULT_ERROR) {
+                return false;
+            }
+            const std::size_t produced = sizeof(out) - room;
+            if (produced > 0 && !sink(reinterpret_cast<const char*>(out), produced)) {
+                return false;
+            }
+            if (rc == BROTLI_DECODER_RESULT_SUCCESS) {
+                done_ = true;
+                return available == 0;
+            }
+            if (rc == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) {
+                return true;
+            }
+        }
+    }
+
+    bool finished() const override { return done_; }
+
+private:
+    BrotliDecoderState* state_;
+    bool done_ = false;
+};
+
+bool brotliCompress(const std::string& in, std::string& out, int level) {
+    std::size_t size = BrotliEncoderMaxCompressedSize(in.size());
+    if (size == 0) {
+        return false;
+    }
+    out.resize(size);
+    const bool ok = BrotliEncoderCompress(level, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC, in.size(),
+                                          reinterpret_cast<const std::uint8_t*>(in.data()), &size,
+                                          reinterpret_cast<std::uint8_t*>(&out[0])) == BROTLI_TRUE;
+    out.resize(ok ? size : 0);
+    return ok;
+}
+#endif
+
+#ifdef PUREMVC_CORE_HAS_ZSTD
+// A body may hold several frames back to back; it is complete at the end of
+// one.
+class ZstdDecoder : public ContentDecoder {
+public:
+    ZstdDecoder() : stream_(ZSTD_createDStream()) {
+        if (stream_ != nullptr) {
+            ZSTD_initDStream(stream_);
+        }
+    }
+    ~ZstdDecoder() override { ZSTD_freeDStream(stream_); } // null-safe
+
+    bool write(const char* data, std::size_t size, const Sink& sink) override {
+        if (stream_ == nullptr) {
+            return false;
+        }
+        ZSTD_inBuffer in = {data, size, 0};
+        char out[kChunk];
+        for (;;) {
+            ZSTD_outBuffer buffer = {out, sizeof(out), 0};
+            const std::size_t rc = ZSTD_decompressStream(stream_, &buffer, &in);
+            if (ZSTD_isError(rc)) {
+                return false;
+            }
+            if (buffer.pos > 0 && !sink(out, buffer.pos)) {
+                return false;
+            }
+            if (in.pos == in.size || rc == 0) {
+                done_ = rc == 0;
+            }
+            // Output left in the decoder shows as a full buffer.
+            if (in.pos == in.size && buffer.pos < buffer.size) {
+                return true;
+            }
+        }
+    }
+
+    bool finished() const override { return done_; }
+
+private:
+    ZSTD_DStream* stream_;
+    bool done_ = false;
+};
+
+bool zstdCompress(const std::string& in, std::string& out, int level) {
+    out.resize(ZSTD_compressBound(in.size()));
+    const std::size_t size = ZSTD_compress(&out[0], out.size(), in.data(), in.size(), level);
+    if (ZSTD_isError(size)) {
+        out.clear();
+        return false;
+    }
+    out.resize(size);
+    return true;
+}
+#endif
+
+} // namespace
+
+const char* contentCodingName(ContentCoding coding) {
+    switch (coding) {
+    case ContentCoding::identity: return "identity";
+    case ContentCoding::gzip: return "gzip";
+    case ContentCoding::deflate: return "deflate";
+    case ContentCoding::brotli: return "br";
+    case ContentCoding::zstd: return "zstd";
+    }
+    return "identity";
+}
+
+bool parseContentCoding(const std::string& value, ContentCoding& coding) {
+    static const ContentCoding kAll[] = {ContentCoding::identity, ContentCoding::gzip, ContentCoding::deflate,
+                                         ContentCoding::brotli, ContentCoding::zstd};
+    if (value.empty()) {
+        coding = ContentCoding::identity;
+        return true;
+    }
+    for (ContentCoding candidate : kAll) {
+        if (HttpHeaders::equalsIgnoreCase(value, contentCodingName(candidate))) {
+            coding = candidate;
+            return true;
+        }
+    }
+    if (HttpHeaders::equalsIgnoreCase(value, "x-gzip")) {
+        coding = ContentCoding::gzip;
+        return true;
+    }
+    return false;
+}
+
+bool isContentCodingAvailable(ContentCoding coding) {
+    switch (coding) {
+    case ContentCoding::identity:
+        return true;
+    case ContentCoding::gzip:
+    case ContentCoding::deflate:
+#ifdef PUREMVC_CORE_HAS_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case ContentCoding::brotli:
+#ifdef PUREMVC_CORE_HAS_BROTLI
+        return true;
+#else
+        return false;
+#endif
+    case ContentCoding::zstd:
+#ifdef PUREMVC_CORE_HAS_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+std::string acceptEncodingValue(const std::vector<ContentCoding>& codings) {
+    std::string value;
+    std::vector<ContentCoding> seen;
+    for (ContentCoding coding : codings) {
+        if (coding == ContentCoding::identity || !isContentCodingAvailable(coding) ||
+            std::find(seen.begin(), seen.end(), coding) != seen.end()) {
+            continue;
+        }
+        seen.push_back(coding);
+        value += value.empty() ? "" : ", ";
+        value += contentCodingName(coding);
+    }
+    return value;
+}
+
+bool compressContent(ContentCoding coding, const std::string& in, std::string& out, int level) {
+    switch (coding) {
+    case ContentCoding::identity:
+        out = in;
+        return true;
+#ifdef PUREMVC_CORE_HAS_ZLIB
+    case ContentCoding::gzip:
+    case ContentCoding::deflate:
+        return zlibCompress(in, out, level != 0 ? level : 6, coding == ContentCoding::gzip);
+#endif
+#ifdef PUREMVC_CORE_HAS_BROTLI
+    case ContentCoding::brotli:
+        return brotliCompress(in, out, level != 0 ? level : 5);
+#endif
+#ifdef PUREMVC_CORE_HAS_ZSTD
+    case ContentCoding::zstd:
+        return zstdCompress(in, out, level != 0 ? level : 3);
+#endif
+    default:
+        (void)level;
+        return false;
+    }
+}
+
+std::unique_ptr<ContentDecoder> ContentDecoder::create(ContentCoding coding) {
+    switch (coding) {
+#ifdef PUREMVC_CORE_HAS_ZLIB
+    case ContentCoding::gzip:
+    case ContentCoding::deflate:
+        return std::unique_ptr<ContentDecoder>(new ZlibDecoder());
+#endif
+#ifdef PUREMVC_CORE_HAS_BROTLI
+    case ContentCoding::brotli:
+        return std::unique_ptr<ContentDecoder>(new BrotliDecoder());
+#endif
+#ifdef PUREMVC_CORE_HAS_ZSTD
+    case ContentCoding::zstd:
+        return std::unique_ptr<ContentDecoder>(new ZstdDecoder());
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace core
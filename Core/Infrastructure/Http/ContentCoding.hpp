@@ -0,0 +1,75 @@
+//
+//  ContentCoding.hpp
+//  PureMVC Core — Infrastructure
+//
+//  HTTP content codings (Content-Encoding / Accept-Encoding): compressing a
+//  request body in one go, and decoding a response body piece by piece as it
+//  is read, so the compressed body is never held whole.
+//
+//  Which codecs exist is decided at build time (PUREMVC_CORE_WITH_ZLIB,
+//  _BROTLI, _ZSTD in CMake); none are by default. A coding left out reports
+//  false from isContentCodingAvailable() and is neither offered nor decoded.
+//
+
+#ifndef PUREMVC_CORE_CONTENT_CODING_HPP
+#define PUREMVC_CORE_CONTENT_CODING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class ContentCoding : std::uint8_t {
+    identity,
+    gzip,    // zlib
+    deflate, // zlib (the zlib format, as RFC 9110 defines it)
+    brotli,  // "br"
+    zstd,
+};
+
+// The token in Content-Encoding and Accept-Encoding: "gzip", "br", ...
+const char* contentCodingName(ContentCoding coding);
+
+// One coding, without regard to case; empty is identity. False for an
+// unknown coding or a list of them ("gzip, br").
+bool parseContentCoding(const std::string& value, ContentCoding& coding);
+
+// Whether this build can compress and decode 'coding'. identity always.
+bool isContentCodingAvailable(ContentCoding coding);
+
+// The Accept-Encoding value offering 'codings': those this build has, each
+// once, in the given order. Empty if that leaves none.
+std::string acceptEncodingValue(const std::vector<ContentCoding>& codings);
+
+// Compresses 'in' into 'out' (replacing it). level 0 is the coding's
+// default for request bodies: gzip/deflate 6, brotli 5, zstd 3. False if
+// the coding is unavailable or the codec fails.
+bool compressContent(ContentCoding coding, const std::string& in, std::string& out, int level = 0);
+
+// Decodes one response body incrementally.
+class ContentDecoder {
+public:
+    using Sink = std::function<bool(const char* data, std::size_t size)>;
+
+    // Null for identity and for codings this build lacks.
+    static std::unique_ptr<ContentDecoder> create(ContentCoding coding);
+
+    virtual ~ContentDecoder() = default;
+
+    // Decodes the next piece of the encoded body, handing what comes out to
+    // 'sink' (possibly several times, possibly not at all). False on corrupt
+    // input, bytes past the end of the stream, or when the sink returns false.
+    virtual bool write(const char* data, std::size_t size, const Sink& sink) = 0;
+
+    // True once a complete stream has been decoded: false after the last
+    // write means the body was cut short.
+    virtual bool finished() const = 0;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_CONTENT_CODING_HPP
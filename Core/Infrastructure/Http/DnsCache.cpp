@@ -0,0 +1,323 @@
+//
+//  DnsCache.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/DnsCache.hpp"
+
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+
+#include "Infrastructure/Concurrency/ThreadExecutor.hpp"
+
+namespace core {
+
+SocketAddress::SocketAddress() {
+    std::memset(&storage, 0, sizeof(storage));
+}
+
+std::string SocketAddress::ip() const {
+    char text[INET6_ADDRSTRLEN] = {};
+    if (storage.ss_family == AF_INET) {
+        ::inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(&storage)->sin_addr, text, sizeof(text));
+    } else if (storage.ss_family == AF_INET6) {
+        ::inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6*>(&storage)->sin6_addr, text, sizeof(text));
+    }
+    return text;
+}
+
+int SocketAddress::port() const {
+    if (storage.ss_family == AF_INET) {
+        return ntohs(reinterpret_cast<const sockaddr_in*>(&storage)->sin_port);
+    }
+    if (storage.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&storage)->sin6_port);
+    }
+    return 0;
+}
+
+void SocketAddress::setPort(int port) {
+    const std::uint16_t value = htons(static_cast<std::uint16_t>(port));
+    if (storage.ss_family == AF_INET) {
+        reinterpret_cast<sockaddr_in*>(&storage)->sin_port = value;
+    } else if (storage.ss_family == AF_INET6) {
+        reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port = value;
+    }
+}
+
+bool SocketAddress::parse(const std::string& ip, int port, SocketAddress& address) {
+    address = SocketAddress();
+    sockaddr_in* v4 = reinterpret_cast<sockaddr_in*>(&address.storage);
+    sockaddr_in6* v6 = reinterpret_cast<sockaddr_in6*>(&address.storage);
+    if (::inet_pton(AF_INET, ip.c_str(), &v4->sin_addr) == 1) {
+        v4->sin_family = AF_INET;
+        address.length = sizeof(sockaddr_in);
+    } else if (::inet_pton(AF_INET6, ip.c_str(), &v6->sin6_addr) == 1) {
+        v6->sin6_family = AF_INET6;
+        address.length = sizeof(sockaddr_in6);
+    } else {
+        return false;
+    }
+    address.setPort(port);
+    return true;
+}
+
+struct DnsCache::State : std::enable_shared_from_this<State> {
+    explicit State(Options o) : options(std::move(o)) {
+        if (!options.lookup) {
+            options.lookup = &DnsCache::systemLookup;
+        }
+    }
+
+    // 'expires' is unset until the first lookup for the host completes.
+    struct Entry {
+        std::vector<SocketAddress> addresses; // empty: the lookup failed
+        std::string error;
+        Clock::time_point expires;
+        bool resolving = false;  // a caller is waiting on a lookup
+        bool refreshing = false; // a background lookup is under way
+    };
+
+    Clock::time_point now() const { return options.now ? options.now() : Clock::now(); }
+
+    // Answers from a fresh entry for 'host', setting 'ok'. False if there is
+    // none. Runs under the lock.
+    bool cached(const std::string& host, int port, std::vector<SocketAddress>& addresses, std::string& error,
+                bool& ok) {
+        auto found = entries.find(host);
+        if (found == entries.end()) {
+            return false;
+        }
+        Entry& entry = found->second;
+        const Clock::time_point at = now();
+        if (entry.expires == Clock::time_point() || at >= entry.expires) {
+            return false;
+        }
+        if (entry.addresses.empty()) {
+            ++stats.negativeHits;
+            error = entry.error;
+            ok = false;
+            return true;
+        }
+        ++stats.hits;
+        if (!entry.refreshing && !entry.resolving && at >= entry.expires - options.refreshAhead) {
+            entry.refreshing = true;
+            ++stats.refreshes;
+            startRefresh(host);
+        }
+        answer(entry, port, addresses);
+        ok = true;
+        return true;
+    }
+
+    bool resolve(const std::string& host, int port, std::vector<SocketAddress>& addresses, std::string& error) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            bool ok = false;
+            if (cached(host, port, addresses, error, ok)) {
+                return ok;
+            }
+            auto found = entries.find(host);
+            if (found == entries.end() || !found->second.resolving) {
+                break;
+            }
+            resolved.wait(lock);
+        }
+
+        ++stats.misses;
+        entries[host].resolving = true;
+        lock.unlock();
+        std::vector<SocketAddress> found;
+        std::string failure;
+        const bool ok = lookup(host, found, failure);
+        lock.lock();
+        Entry& entry = entries[host];
+        entry.resolving = false;
+        store(entry, ok, std::move(found), std::move(failure));
+        if (ok) {
+            answer(entry, port, addresses);
+        } else {
+            error = entry.error;
+        }
+        trim(); // may drop 'entry'
+        resolved.notify_all();
+        return ok;
+    }
+
+    // The lookup goes through resolve(), so it is shared with any caller
+    // waiting on the same host.
+    Result resolveWithoutBlocking(const std::string& host, int port, std::vector<SocketAddress>& addresses,
+                                  std::string& error, std::function<void()> done) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            bool ok = false;
+            if (cached(host, port, addresses, error, ok)) {
+                return ok ? Result::resolved : Result::failed;
+            }
+        }
+        std::weak_ptr<State> weak = shared_from_this();
+        executor().run([weak, host, done]() {
+            if (std::shared_ptr<State> self = weak.lock()) {
+                std::vector<SocketAddress> addresses;
+                std::string error;
+                self->resolve(host, 0, addresses, error);
+            }
+            done();
+        });
+        return Result::pending;
+    }
+
+    bool lookup(const std::string& host, std::vector<SocketAddress>& found, std::string& error) {
+        if (!options.lookup(host, found, error)) {
+            return false;
+        }
+        if (found.empty()) {
+            error = "Cannot resolve " + host;
+            return false;
+        }
+        return true;
+    }
+
+    // Runs without the lock; the entry may have been cleared meanwhile.
+    void refresh(const std::string& host) {
+        std::vector<SocketAddress> found;
+        std::string error;
+        const bool ok = lookup(host, found, error);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto entry = entries.find(host);
+        if (entry == entries.end() || !entry->second.refreshing) {
+            return;
+        }
+        entry->second.refreshing = false;
+        if (ok) {
+            store(entry->second, true, std::move(found), std::string());
+        } else {
+            ++stats.failures; // the answer in hand stands until it expires
+        }
+    }
+
+    void startRefresh(const std::string& host) {
+        std::weak_ptr<State> weak = shared_from_this();
+        executor().run([weak, host]() {
+            if (std::shared_ptr<State> self = weak.lock()) {
+                self->refresh(host);
+            }
+        });
+    }
+
+    IExecutor& executor() const {
+        return options.refresher != nullptr ? *options.refresher : backgroundThreads();
+    }
+
+    static IExecutor& backgroundThreads() {
+        static ThreadExecutor executor;
+        return executor;
+    }
+
+    void store(Entry& entry, bool ok, std::vector<SocketAddress> found, std::string failure) {
+        entry.addresses = std::move(found);
+        entry.error = std::move(failure);
+        entry.expires = now() + (ok ? options.ttl : options.negativeTtl);
+        if (!ok) {
+            ++stats.failures;
+        }
+    }
+
+    static void answer(const Entry& entry, int port, std::vector<SocketAddress>& addresses) {
+        addresses = entry.addresses;
+        for (SocketAddress& address : addresses) {
+            address.setPort(port);
+        }
+    }
+
+    // Over the limit, drops the settled entries nearest expiry.
+    void trim() {
+        while (entries.size() > options.maxEntries) {
+            auto victim = entries.end();
+            for (auto it = entries.begin(); it != entries.end(); ++it) {
+                if (!it->second.resolving && (victim == entries.end() || it->second.expires < victim->second.expires)) {
+                    victim = it;
+                }
+            }
+            if (victim == entries.end()) {
+                return;
+            }
+            entries.erase(victim);
+        }
+    }
+
+    Options options;
+    mutable std::mutex mutex;
+    std::condition_variable resolved;
+    std::unordered_map<std::string, Entry> entries;
+    DnsCacheStats stats;
+};
+
+DnsCache::DnsCache() : DnsCache(Options()) {}
+
+DnsCache::DnsCache(Options options) : state_(std::make_shared<State>(std::move(options))) {}
+
+std::shared_ptr<DnsCache> DnsCache::shared() {
+    static std::shared_ptr<DnsCache> cache = std::make_shared<DnsCache>();
+    return cache;
+}
+
+bool DnsCache::systemLookup(const std::string& host, std::vector<SocketAddress>& addresses, std::string& error) {
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    const int status = ::getaddrinfo(host.c_str(), nullptr, &hints, &results);
+    if (status != 0) {
+        error = "Cannot resolve " + host + ": " + ::gai_strerror(status);
+        return false;
+    }
+    addresses.clear();
+    for (addrinfo* entry = results; entry != nullptr; entry = entry->ai_next) {
+        if (entry->ai_addrlen > sizeof(sockaddr_storage)) {
+            continue;
+        }
+        SocketAddress address;
+        std::memcpy(&address.storage, entry->ai_addr, entry->ai_addrlen);
+        address.length = static_cast<socklen_t>(entry->ai_addrlen);
+        addresses.push_back(address);
+    }
+    ::freeaddrinfo(results);
+    return true;
+}
+
+bool DnsCache::resolve(const std::string& host, int port, std::vector<SocketAddress>& addresses,
+                       std::string& error) {
+    return state_->resolve(host, port, addresses, error);
+}
+
+DnsCache::Result DnsCache::resolveWithoutBlocking(const std::string& host, int port,
+                                                  std::vector<SocketAddress>& addresses, std::string& error,
+                                                  std::function<void()> done) {
+    return state_->resolveWithoutBlocking(host, port, addresses, error, std::move(done));
+}
+
+void DnsCache::clear() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    for (auto it = state_->entries.begin(); it != state_->entries.end();) {
+        // A waited-on lookup keeps its entry; its answer is fresh anyway.
+        it = it->second.resolving ? std::next(it) : state_->entries.erase(it);
+    }
+}
+
+DnsCacheStats DnsCache::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    DnsCacheStats snapshot = state_->stats;
+    snapshot.entries = state_->entries.size();
+    return snapshot;
+}
+
+} // namespace core
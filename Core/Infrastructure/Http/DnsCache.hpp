@@ -0,0 +1,121 @@
+//
+//  DnsCache.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Host name resolution shared by the HTTP clients, so a fresh connection
+//  does not pay for a getaddrinfo call (and a slow resolver's timeouts) each
+//  time it is opened.
+//
+//  - Answers are kept for Options::ttl. getaddrinfo does not report the
+//    record's own TTL, so this is a fixed, conservative figure.
+//  - A failure is kept for Options::negativeTtl, so a host that does not
+//    resolve fails fast instead of blocking every request on the resolver.
+//  - A hit within Options::refreshAhead of expiry answers at once and starts
+//    one background lookup on Options::refresher; a busy host never blocks on
+//    the resolver again. A failed refresh keeps the old answer until it
+//    expires.
+//  - Concurrent misses for one host share a single lookup.
+//  - resolveWithoutBlocking() never waits: a miss is looked up on
+//    Options::refresher, and the caller told when the answer is in.
+//
+//  Options::lookup replaces getaddrinfo, for tests.
+//
+
+#ifndef PUREMVC_CORE_DNS_CACHE_HPP
+#define PUREMVC_CORE_DNS_CACHE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include "Domain/Ports/IExecutor.hpp"
+
+namespace core {
+
+// One resolved address, ready for connect().
+struct SocketAddress {
+    sockaddr_storage storage;
+    socklen_t length = 0;
+
+    SocketAddress();
+
+    int family() const { return storage.ss_family; }
+    const sockaddr* get() const { return reinterpret_cast<const sockaddr*>(&storage); }
+    std::string ip() const; // numeric: "192.0.2.1", "2001:db8::1"
+    int port() const;
+    void setPort(int port);
+
+    // A numeric IPv4 or IPv6 address ("127.0.0.1", "::1"). False otherwise.
+    static bool parse(const std::string& ip, int port, SocketAddress& address);
+};
+
+struct DnsCacheStats {
+    std::uint64_t hits = 0;         // answered from the cache
+    std::uint64_t negativeHits = 0; // a cached failure answered again
+    std::uint64_t misses = 0;       // the caller waited for a lookup
+    std::uint64_t refreshes = 0;    // background lookups started
+    std::uint64_t failures = 0;     // lookups that failed, refreshes included
+    std::size_t entries = 0;
+};
+
+class DnsCache {
+public:
+    using Clock = std::chrono::steady_clock;
+    // Resolves 'host' into 'addresses' (ports are set afterwards), or returns
+    // false with 'error' set.
+    using Lookup =
+        std::function<bool(const std::string& host, std::vector<SocketAddress>& addresses, std::string& error)>;
+
+    struct Options {
+        Options() {}
+        std::chrono::seconds ttl = std::chrono::seconds(60);
+        std::chrono::seconds negativeTtl = std::chrono::seconds(5);
+        std::chrono::seconds refreshAhead = std::chrono::seconds(15);
+        std::size_t maxEntries = 256;         // the entries nearest expiry go first
+        Lookup lookup;                        // empty: systemLookup
+        IExecutor* refresher = nullptr;       // null: a thread per refresh
+        std::function<Clock::time_point()> now; // empty: Clock::now
+    };
+
+    DnsCache();
+    explicit DnsCache(Options options);
+
+    DnsCache(const DnsCache&) = delete;
+    DnsCache& operator=(const DnsCache&) = delete;
+
+    // The process-wide cache clients use unless configured with their own.
+    static std::shared_ptr<DnsCache> shared();
+
+    // getaddrinfo, for TCP, in the order it returns (RFC 6724).
+    static bool systemLookup(const std::string& host, std::vector<SocketAddress>& addresses, std::string& error);
+
+    // 'host's addresses with 'port' set, replacing 'addresses'. Blocks on a
+    // miss. False with 'error' set if the host does not resolve.
+    bool resolve(const std::string& host, int port, std::vector<SocketAddress>& addresses, std::string& error);
+
+    enum class Result { resolved, failed, pending };
+
+    // resolve() for a thread that must not block, such as an event loop.
+    // A cached answer (or failure) comes back at once; on a miss the lookup
+    // runs on Options::refresher and 'done' is called there once it has
+    // finished, after which a second call answers from the cache.
+    Result resolveWithoutBlocking(const std::string& host, int port, std::vector<SocketAddress>& addresses,
+                                  std::string& error, std::function<void()> done);
+
+    // Forgets every answer, e.g. after the network changes.
+    void clear();
+
+    DnsCacheStats stats() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> state_; // background refreshes hold it too
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_DNS_CACHE_HPP
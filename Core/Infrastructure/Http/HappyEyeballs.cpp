@@ -0,0 +1,175 @@
+//
+//  HappyEyeballs.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/HappyEyeballs.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace core {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Attempt {
+    int fd;
+    std::size_t index;
+};
+
+bool setBlocking(int fd, bool blocking) {
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK) == 0;
+}
+
+// A socket with its connect under way, or -1 with 'code' set.
+int startConnect(const SocketAddress& address, int& code) {
+    const int fd = ::socket(address.family(), SOCK_STREAM, 0);
+    if (fd < 0) {
+        code = errno;
+        return -1;
+    }
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    if (!setBlocking(fd, false) ||
+        (::connect(fd, address.get(), address.length) != 0 && errno != EINPROGRESS)) {
+        code = errno;
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int pendingError(int fd) {
+    int code = 0;
+    socklen_t length = sizeof(code);
+    if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &code, &length) != 0) {
+        return errno;
+    }
+    return code;
+}
+
+int millisUntil(Clock::time_point deadline, Clock::time_point now) {
+    if (deadline <= now) {
+        return 0;
+    }
+    // Rounded up, so poll() does not wake just short of the deadline.
+    const auto wait = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+    return static_cast<int>(std::min<long long>((wait + 999) / 1000, 60 * 60 * 1000));
+}
+
+} // namespace
+
+std::vector<SocketAddress> interleaveFamilies(const std::vector<SocketAddress>& addresses) {
+    if (addresses.empty()) {
+        return addresses;
+    }
+    const int first = addresses.front().family();
+    std::vector<SocketAddress> preferred;
+    std::vector<SocketAddress> other;
+    for (const SocketAddress& address : addresses) {
+        (address.family() == first ? preferred : other).push_back(address);
+    }
+    std::vector<SocketAddress> ordered;
+    ordered.reserve(addresses.size());
+    for (std::size_t i = 0; i < preferred.size() || i < other.size(); ++i) {
+        if (i < preferred.size()) {
+            ordered.push_back(preferred[i]);
+        }
+        if (i < other.size()) {
+            ordered.push_back(other[i]);
+        }
+    }
+    return ordered;
+}
+
+RacedConnection happyEyeballsConnect(const std::vector<SocketAddress>& addresses,
+                                     std::chrono::milliseconds attemptDelay,
+                                     std::chrono::milliseconds timeout) {
+    const std::vector<SocketAddress> ordered = interleaveFamilies(addresses);
+    const Clock::time_point deadline = Clock::now() + timeout;
+    RacedConnection result;
+    std::vector<Attempt> attempts;
+    std::vector<pollfd> polled;
+    std::size_t next = 0;
+    Clock::time_point nextStart = Clock::now();
+    int lastError = 0;
+
+    while (result.fd < 0) {
+        const Clock::time_point now = Clock::now();
+        if (next < ordered.size() && (attempts.empty() || now >= nextStart) && now < deadline) {
+            int code = 0;
+            const int fd = startConnect(ordered[next], code);
+            if (fd >= 0) {
+                attempts.push_back(Attempt{fd, next});
+                nextStart = now + attemptDelay;
+            } else {
+                lastError = code; // and on to the next address straight away
+            }
+            ++next;
+            continue;
+        }
+        if (attempts.empty()) {
+            result.timedOut = next < ordered.size();
+            break;
+        }
+        if (now >= deadline) {
+            result.timedOut = true;
+            break;
+        }
+
+        polled.clear();
+        for (const Attempt& attempt : attempts) {
+            pollfd entry;
+            entry.fd = attempt.fd;
+            entry.events = POLLOUT;
+            entry.revents = 0;
+            polled.push_back(entry);
+        }
+        const Clock::time_point wake = next < ordered.size() ? std::min(nextStart, deadline) : deadline;
+        if (::poll(polled.data(), polled.size(), millisUntil(wake, now)) < 0 && errno != EINTR) {
+            lastError = errno;
+            break;
+        }
+        // Walk backwards so failed attempts can be erased in place.
+        for (std::size_t i = polled.size(); i-- > 0;) {
+            if (polled[i].revents == 0) {
+                continue;
+            }
+            const int code = pendingError(attempts[i].fd);
+            if (code == 0 && result.fd < 0) {
+                result.fd = attempts[i].fd;
+                result.address = ordered[attempts[i].index];
+            } else {
+                if (code != 0) {
+                    lastError = code;
+                }
+                ::close(attempts[i].fd);
+            }
+            attempts.erase(attempts.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        if (attempts.empty()) {
+            nextStart = Clock::now(); // the last one failed: do not wait out the delay
+        }
+    }
+
+    for (const Attempt& attempt : attempts) {
+        ::close(attempt.fd);
+    }
+    if (result.fd >= 0) {
+        setBlocking(result.fd, true);
+    } else if (ordered.empty()) {
+        result.error = "No address to connect to";
+    } else if (result.timedOut) {
+        result.error = "Connection timed out";
+    } else {
+        result.error = std::string("Connection failed: ") + std::strerror(lastError != 0 ? lastError : ECONNREFUSED);
+    }
+    return result;
+}
+
+} // namespace core
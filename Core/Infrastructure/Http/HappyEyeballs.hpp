@@ -0,0 +1,44 @@
+//
+//  HappyEyeballs.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Connecting to a host that has several addresses, as RFC 8305 describes.
+//  Trying them one after another means a dead first address (typically a
+//  broken IPv6 route on a dual-stack network) costs the whole connect
+//  timeout before the next is tried. Instead the attempts are staggered:
+//  each starts attemptDelay after the previous one, or at once when the
+//  previous one fails, and the first to connect wins. The addresses are
+//  interleaved by family first, so the second attempt is over the other
+//  family.
+//
+
+#ifndef PUREMVC_CORE_HAPPY_EYEBALLS_HPP
+#define PUREMVC_CORE_HAPPY_EYEBALLS_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Infrastructure/Http/DnsCache.hpp"
+
+namespace core {
+
+// RFC 8305 section 4: the first address's family, then the other, in turn;
+// each family keeps its own order.
+std::vector<SocketAddress> interleaveFamilies(const std::vector<SocketAddress>& addresses);
+
+struct RacedConnection {
+    int fd = -1;           // connected, in blocking mode; -1 if none connected
+    SocketAddress address; // the one that connected
+    bool timedOut = false; // none had connected by the timeout
+    std::string error;     // why not
+};
+
+// Blocks until one of 'addresses' connects, all have failed, or 'timeout'
+// passes. The losing attempts are closed.
+RacedConnection happyEyeballsConnect(const std::vector<SocketAddress>& addresses,
+                                     std::chrono::milliseconds attemptDelay,
+                                     std::chrono::milliseconds timeout);
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HAPPY_EYEBALLS_HPP
@@ -0,0 +1,364 @@
+//
+//  HedgingHttpClient.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/HedgingHttpClient.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
+
+namespace core {
+namespace {
+
+using Clock = IScheduledExecutor::Clock;
+
+// The window's percentile is recomputed every this many samples rather
+// than on each one.
+const std::size_t kRecomputeEvery = 8;
+
+} // namespace
+
+// One request and its attempts: 0 is the primary, 1 the hedge. They may
+// answer on different threads at once, hence the mutex.
+struct HedgingHttpClient::Call {
+    HttpRequest request;    // kept for the hedge
+    Callback callback;      // buffered
+    StreamHandler handler;  // streaming
+    bool streaming = false;
+
+    std::mutex mutex;
+    Clock::time_point started[2];
+    int winner = -1;        // the first attempt to deliver a head
+    int inFlight = 0;
+    bool finished = false;  // the answer is decided; no hedge from here on
+    IScheduledExecutor::TimerId timer = 0;
+    HttpResponse head;      // buffered: the winner's, its body gathered below
+    std::string body;
+};
+
+struct HedgingHttpClient::State : std::enable_shared_from_this<HedgingHttpClient::State> {
+    // Times to the response head for one route, newest overwriting oldest.
+    struct Route {
+        std::vector<std::int64_t> window; // nanoseconds
+        std::size_t next = 0;
+        std::size_t recorded = 0;
+        std::size_t sinceRecompute = 0;
+        std::int64_t delay = 0;           // 0 until minimumSamples are in
+    };
+
+    State(IHttpClient& client, IScheduledExecutor& timers, Options opts)
+        : inner(client), scheduler(timers), options(std::move(opts)), tokens(options.budget.maxTokens) {
+        options.windowSize = std::max<std::size_t>(1, options.windowSize);
+        options.minimumSamples = std::min(std::max<std::size_t>(1, options.minimumSamples), options.windowSize);
+        options.percentile = std::min(std::max(options.percentile, 0.0), 1.0);
+    }
+
+    IHttpClient& inner;
+    IScheduledExecutor& scheduler;
+    Options options;
+
+    mutable std::mutex mutex;
+    std::map<std::string, Route> routes; // never erased: Route pointers stay valid
+    std::vector<std::int64_t> scratch;   // for nth_element, reused
+    double tokens;
+    HedgeStats stats;
+    bool stopped = false;
+
+    std::string routeOf(const HttpRequest& request) const {
+        return options.route ? options.route(request) : defaultRoute(request);
+    }
+
+    // Under the lock. Null once maxRoutes are taken and 'key' is not one.
+    Route* routeFor(const std::string& key) {
+        auto it = routes.find(key);
+        if (it != routes.end()) {
+            return &it->second;
+        }
+        if (routes.size() >= options.maxRoutes) {
+            return nullptr;
+        }
+        Route& route = routes[key];
+        route.window.assign(options.windowSize, 0);
+        return &route;
+    }
+
+    void record(Route& route, Clock::duration elapsed) {
+        const std::int64_t sample = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        std::lock_guard<std::mutex> lock(mutex);
+        route.window[route.next] = sample;
+        route.next = (route.next + 1) % route.window.size();
+        route.recorded = std::min(route.recorded + 1, route.window.size());
+        if (route.recorded < options.minimumSamples ||
+            (route.delay != 0 && ++route.sinceRecompute < kRecomputeEvery)) {
+            return;
+        }
+        route.sinceRecompute = 0;
+        scratch.assign(route.window.begin(), route.window.begin() + static_cast<std::ptrdiff_t>(route.recorded));
+        const double rank = std::ceil(options.percentile * static_cast<double>(scratch.size()));
+        const std::size_t index = std::min(scratch.size() - 1, static_cast<std::size_t>(std::max(rank, 1.0)) - 1);
+        std::nth_element(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(index), scratch.end());
+        const std::int64_t floor = std::chrono::duration_cast<std::chrono::nanoseconds>(options.minDelay).count();
+        route.delay = std::max(std::max<std::int64_t>(1, floor), scratch[index]);
+    }
+
+    void start(std::shared_ptr<Call> call, Route& route) {
+        std::int64_t delay = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            delay = route.delay;
+        }
+        {
+            std::lock_guard<std::mutex> lock(call->mutex);
+            call->started[0] = scheduler.now();
+            call->inFlight = 1;
+        }
+        // The primary goes by reference: the request stays for the hedge.
+        inner.sendStreaming(call->request, attempt(call, route, 0));
+        if (delay == 0) {
+            return;
+        }
+
+        std::weak_ptr<State> weakSelf = shared_from_this();
+        std::weak_ptr<Call> weakCall = call;
+        Route* measured = &route;
+        const IScheduledExecutor::TimerId timer =
+            scheduler.runAfter(std::chrono::nanoseconds(delay), [weakSelf, weakCall, measured]() {
+                std::shared_ptr<State> self = weakSelf.lock();
+                std::shared_ptr<Call> pending = weakCall.lock();
+                if (self && pending) {
+                    self->hedge(std::move(pending), *measured);
+                }
+            });
+        bool decided = false;
+        {
+            std::lock_guard<std::mutex> lock(call->mutex);
+            decided = call->finished || call->winner >= 0;
+            if (!decided) {
+                call->timer = timer;
+            }
+        }
+        if (decided) {
+            scheduler.cancel(timer);
+        }
+    }
+
+    void hedge(std::shared_ptr<Call> call, Route& route) {
+        HttpRequest copy;
+        {
+            std::lock_guard<std::mutex> lock(call->mutex);
+            call->timer = 0;
+            if (call->finished || call->winner >= 0 || call->inFlight == 0) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> stateLock(mutex);
+                if (stopped) {
+                    return;
+                }
+                if (tokens < 1) {
+                    ++stats.budgetExhausted;
+                    return;
+                }
+                tokens -= 1;
+                ++stats.hedges;
+            }
+            call->started[1] = scheduler.now();
+            ++call->inFlight;
+            copy = std::move(call->request); // its last use
+        }
+        inner.sendStreaming(std::move(copy), attempt(call, route, 1));
+    }
+
+    // Takes the timer off 'call', to be cancelled outside its lock.
+    static IScheduledExecutor::TimerId takeTimer(Call& call) {
+        IScheduledExecutor::TimerId timer = 0;
+        std::swap(timer, call.timer);
+        return timer;
+    }
+
+    StreamHandler attempt(const std::shared_ptr<Call>& call, Route& route, int index) {
+        std::shared_ptr<State> self = shared_from_this();
+        Route* measured = &route;
+        StreamHandler handler;
+        handler.onHeaders = [self, call, measured, index](const HttpResponse& head) {
+            bool won = false;
+            IScheduledExecutor::TimerId timer = 0;
+            Clock::duration elapsed;
+            {
+                std::lock_guard<std::mutex> lock(call->mutex);
+                elapsed = self->scheduler.now() - call->started[index];
+                if (call->winner < 0 && !call->finished) {
+                    call->winner = index;
+                    won = true;
+                    timer = takeTimer(*call);
+                }
+            }
+            self->record(*measured, elapsed); // the loser's time counts too
+            if (timer != 0) {
+                self->scheduler.cancel(timer);
+            }
+            if (!won) {
+                return false; // abandons the loser
+            }
+            if (index == 1) {
+                std::lock_guard<std::mutex> lock(self->mutex);
+                ++self->stats.hedgeWins;
+            }
+            if (call->streaming) {
+                return !call->handler.onHeaders || call->handler.onHeaders(head);
+            }
+            call->head = head;
+            return true;
+        };
+        // Only the winner gets this far.
+        handler.onBody = [call](const char* data, std::size_t size) {
+            if (call->streaming) {
+                return !call->handler.onBody || call->handler.onBody(data, size);
+            }
+            call->body.append(data, size);
+            return true;
+        };
+        handler.onComplete = [self, call, index](const HttpResponse& response) {
+            bool deliver = false;
+            IScheduledExecutor::TimerId timer = 0;
+            {
+                std::lock_guard<std::mutex> lock(call->mutex);
+                --call->inFlight;
+                if (call->winner == index) {
+                    deliver = true;
+                } else if (call->winner < 0 && !call->finished &&
+                           (!response.transportError || call->inFlight == 0)) {
+                    // No head from anyone: an answer without one wins as it
+                    // is, and an error is final once nothing else is in
+                    // flight; otherwise the other attempt may still answer.
+                    call->winner = index;
+                    deliver = true;
+                }
+                if (deliver) {
+                    call->finished = true;
+                    timer = takeTimer(*call);
+                }
+            }
+            if (timer != 0) {
+                self->scheduler.cancel(timer);
+            }
+            if (deliver) {
+                finish(*call, response);
+            }
+        };
+        return handler;
+    }
+
+    static void finish(Call& call, const HttpResponse& response) {
+        if (call.streaming) {
+            if (call.handler.onComplete) {
+                call.handler.onComplete(response);
+            }
+            return;
+        }
+        if (response.transportError) {
+            call.callback(response);
+            return;
+        }
+        HttpResponse full = std::move(call.head);
+        full.status = response.status;
+        full.headers = response.headers;
+        full.body = std::move(call.body);
+        call.callback(full);
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+};
+
+HedgingHttpClient::HedgingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler)
+    : HedgingHttpClient(inner, scheduler, Options()) {}
+
+HedgingHttpClient::HedgingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options)
+    : state_(std::make_shared<State>(inner, scheduler, std::move(options))) {}
+
+HedgingHttpClient::~HedgingHttpClient() {
+    state_->stop();
+}
+
+void HedgingHttpClient::send(const HttpRequest& request, Callback callback) {
+    if (!isSafeMethod(request.method)) {
+        state_->inner.send(request, std::move(callback));
+        return;
+    }
+    send(HttpRequest(request), std::move(callback));
+}
+
+void HedgingHttpClient::send(HttpRequest&& request, Callback callback) {
+    State::Route* route = nullptr;
+    if (isSafeMethod(request.method)) {
+        const std::string key = state_->routeOf(request);
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        ++state_->stats.requests;
+        state_->tokens = std::min(state_->options.budget.maxTokens,
+                                  state_->tokens + state_->options.budget.depositPerRequest);
+        route = state_->routeFor(key);
+    }
+    if (route == nullptr) {
+        state_->inner.send(std::move(request), std::move(callback));
+        return;
+    }
+    std::shared_ptr<Call> call = std::make_shared<Call>();
+    call->request = std::move(request);
+    call->callback = std::move(callback);
+    state_->start(std::move(call), *route);
+}
+
+void HedgingHttpClient::sendStreaming(const HttpRequest& request, StreamHandler handler) {
+    if (!isSafeMethod(request.method)) {
+        state_->inner.sendStreaming(request, std::move(handler));
+        return;
+    }
+    sendStreaming(HttpRequest(request), std::move(handler));
+}
+
+void HedgingHttpClient::sendStreaming(HttpRequest&& request, StreamHandler handler) {
+    State::Route* route = nullptr;
+    if (isSafeMethod(request.method)) {
+        const std::string key = state_->routeOf(request);
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        ++state_->stats.requests;
+        state_->tokens = std::min(state_->options.budget.maxTokens,
+                                  state_->tokens + state_->options.budget.depositPerRequest);
+        route = state_->routeFor(key);
+    }
+    if (route == nullptr) {
+        state_->inner.sendStreaming(std::move(request), std::move(handler));
+        return;
+    }
+    std::shared_ptr<Call> call = std::make_shared<Call>();
+    call->request = std::move(request);
+    call->handler = std::move(handler);
+    call->streaming = true;
+    state_->start(std::move(call), *route);
+}
+
+std::chrono::nanoseconds HedgingHttpClient::hedgeDelay(const HttpRequest& request) const {
+    if (!isSafeMethod(request.method)) {
+        return std::chrono::nanoseconds(0);
+    }
+    const std::string key = state_->routeOf(request);
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->routes.find(key);
+    return std::chrono::nanoseconds(it != state_->routes.end() ? it->second.delay : 0);
+}
+
+HedgeStats HedgingHttpClient::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->stats;
+}
+
+} // namespace core
@@ -0,0 +1,100 @@
+//
+//  HedgingHttpClient.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Cuts tail latency for safe requests in front of any IHttpClient. When a
+//  GET (or other safe method, see isSafeMethod) has had no response head by
+//  the time most of its route's requests have, a second copy is sent, and
+//  whichever head arrives first wins. Other methods are passed straight
+//  through and never hedged: a POST such as AuthRepository::login must not
+//  reach the server twice, and neither may a PUT or DELETE race itself.
+//
+//  The delay is a percentile (p95 by default) of the time to the response
+//  head over each route's last windowSize requests. A route is method plus
+//  path, without the query. Until minimumSamples are in, its requests are
+//  only measured.
+//
+//  Attempts go through the inner client's sendStreaming, buffered sends
+//  included, so the losing attempt is abandoned at its head (or at its next
+//  piece of body) instead of being read to the end. Committing at the head
+//  means a winner that fails after it fails the request. A transport error
+//  before any head waits for the other attempt, if there is one.
+//
+//  A token bucket bounds hedges overall: each safe request deposits
+//  depositPerRequest (up to maxTokens) and each hedge spends one, so with
+//  the defaults at most about a tenth of requests are sent twice, even when
+//  the backend slows down across the board.
+//
+//  The inner client and the scheduler must outlive this client; destroying
+//  it stops hedges that have not been sent yet.
+//
+
+#ifndef PUREMVC_CORE_HEDGING_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_HEDGING_HTTP_CLIENT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "Domain/Ports/IScheduledExecutor.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+struct HedgeStats {
+    std::uint64_t requests = 0;        // safe requests seen
+    std::uint64_t hedges = 0;          // second copies sent
+    std::uint64_t hedgeWins = 0;       // of those, the ones that answered first
+    std::uint64_t budgetExhausted = 0; // hedges due but refused for lack of tokens
+};
+
+class HedgingHttpClient : public IHttpClient {
+public:
+    struct Budget {
+        double maxTokens = 10;
+        double depositPerRequest = 0.1;
+    };
+
+    struct Options {
+        double percentile = 0.95;
+        std::size_t windowSize = 100;     // latest times kept per route
+        std::size_t minimumSamples = 20;  // before a route is hedged
+        std::chrono::milliseconds minDelay{10};
+        std::size_t maxRoutes = 256;      // further routes are neither measured nor hedged
+        Budget budget;
+        // The route a request's times are pooled under; empty: method and
+        // path without the query.
+        std::function<std::string(const HttpRequest&)> route;
+    };
+
+    HedgingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler);
+    HedgingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options);
+    ~HedgingHttpClient() override;
+
+    HedgingHttpClient(const HedgingHttpClient&) = delete;
+    HedgingHttpClient& operator=(const HedgingHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+    void send(HttpRequest&& request, Callback callback) override;
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override;
+    void sendStreaming(HttpRequest&& request, StreamHandler handler) override;
+
+    // How long 'request' would wait before being hedged; zero while its
+    // route is still being measured.
+    std::chrono::nanoseconds hedgeDelay(const HttpRequest& request) const;
+
+    HedgeStats stats() const;
+
+private:
+    struct State; // routes, budget and stats, kept alive by requests in flight
+    struct Call;  // one request and its attempts
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HEDGING_HTTP_CLIENT_HPP
@@ -8,12 +8,18 @@
 #ifndef PUREMVC_CORE_HTTP_CLIENT_CONFIG_HPP
 #define PUREMVC_CORE_HTTP_CLIENT_CONFIG_HPP
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
+#include "Infrastructure/Http/ContentCoding.hpp"
+#include "Infrastructure/Http/HttpHeaders.hpp"
 
 namespace core {
 
+class DnsCache;
+
 struct HttpClientConfig {
     std::string host;                 // host only, e.g. "api.example.com"
     int port = 443;
@@ -21,7 +27,7 @@ struct HttpClientConfig {
     bool verifySSL = true;            // server certificate chain verification (on)
     int connectionTimeoutSec = 10;
     int readTimeoutSec = 10;
-    std::map<std::string, std::string> defaultHeaders;
+    HttpHeaders defaultHeaders;       // sent unless the request has its own
 
     // Optional path to a CA bundle (PEM). Empty => use the system trust store.
     std::string caCertPath;
@@ -31,6 +37,56 @@ struct HttpClientConfig {
     // against the leaf certificate's SPKI is accepted (supports key rotation
     // by listing current + backup pins).
     std::vector<std::string> pinnedSpkiSha256Base64;
+
+    // Resume TLS sessions from a process-wide cache (keyed by host:port, SNI
+    // and CA bundle) when a new connection is opened, skipping the full
+    // handshake. Only sessions a client with the same CA bundle verified are
+    // resumed, and pins are checked again against the certificate each was
+    // established with. Clients with verifySSL off neither store nor resume.
+    bool tlsSessionResumption = true;
+
+    // Keep-alive connection pool. A client talks to one host:port, so these
+    // limits are per host. Reusing a connection skips the TCP (and TLS)
+    // handshake that otherwise precedes every request.
+    std::size_t maxIdleConnections = 4;    // kept open between requests; 0 disables reuse
+    int idleTimeoutSec = 30;               // idle connections older than this are closed
+    std::size_t maxConnectionsPerHost = 8; // busy + idle; 0 = unlimited. Excess requests
+                                           // wait up to connectionTimeoutSec for a slot.
+
+    // Content-Encoding. Codings offered in Accept-Encoding, in order of
+    // preference; a response in one of them is decoded (HttplibHttpClient as
+    // it is read, the async clients once it is whole, on the callback
+    // executor). Codings this build lacks are left out. Empty: nothing is
+    // offered.
+    std::vector<ContentCoding> acceptEncodings;
+    // Request bodies above compressRequestsAbove bytes are sent in this coding
+    // when that makes them smaller. identity: never. Only for servers known to
+    // accept it; HTTP has no way to ask first.
+    ContentCoding requestEncoding = ContentCoding::identity;
+    std::size_t compressRequestsAbove = 1024;
+    // A request with its own Accept-Encoding or Content-Encoding header is sent
+    // as it is, and its response body handed over undecoded.
+
+    // Where host's addresses come from. Null: the process-wide
+    // DnsCache::shared(). HttplibHttpClient races them (RFC 8305 happy
+    // eyeballs), starting the next address every happyEyeballsDelayMs until
+    // one connects; the async clients connect to the first.
+    std::shared_ptr<DnsCache> dnsCache;
+    int happyEyeballsDelayMs = 250;
+};
+
+// What a client's connection pool has done since construction, plus its
+// current size (HttplibHttpClient::poolStats, AsyncHttpClient::poolStats).
+struct ConnectionPoolStats {
+    std::uint64_t opened = 0;      // new connections created
+    std::uint64_t reused = 0;      // requests served on an idle connection
+    std::uint64_t expired = 0;     // idle connections closed by idleTimeoutSec / maxIdleConnections
+    std::uint64_t stale = 0;       // idle connections found closed by the peer
+    std::uint64_t retried = 0;     // requests retried after a reused connection failed
+    std::uint64_t fullHandshakes = 0;    // TLS only
+    std::uint64_t resumedHandshakes = 0; // TLS only: abbreviated, from a cached session
+    std::size_t open = 0;          // busy + idle right now
+    std::size_t idle = 0;
 };
 
 } // namespace core
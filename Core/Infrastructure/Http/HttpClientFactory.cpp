@@ -0,0 +1,60 @@
+//
+//  HttpClientFactory.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/HttpClientFactory.hpp"
+
+#include <system_error>
+#include <utility>
+#include "Infrastructure/Http/AsyncHttpClient.hpp"
+#include "Infrastructure/Http/HttplibHttpClient.hpp"
+#include "Infrastructure/Http/IoUringHttpClient.hpp"
+
+namespace core {
+
+HttpTransport resolveHttpTransport(HttpTransport preferred) {
+    if (preferred == HttpTransport::automatic) {
+        preferred = HttpTransport::ioUring;
+    }
+#ifdef PUREMVC_CORE_HAS_IO_URING
+    if (preferred == HttpTransport::ioUring && IoUringHttpClient::isSupported()) {
+        return HttpTransport::ioUring;
+    }
+#endif
+#if defined(__linux__)
+    if (preferred != HttpTransport::blocking) {
+        return HttpTransport::epoll;
+    }
+#endif
+    return HttpTransport::blocking;
+}
+
+std::unique_ptr<IHttpClient> makeHttpClient(HttpClientConfig config, IExecutor& executor,
+                                            HttpTransport preferred) {
+    switch (resolveHttpTransport(preferred)) {
+#ifdef PUREMVC_CORE_HAS_IO_URING
+    case HttpTransport::ioUring:
+        try {
+            return std::unique_ptr<IHttpClient>(new IoUringHttpClient(config, executor));
+        } catch (const std::system_error&) {
+            // Out of locked memory or ring slots: the next transport still works.
+        }
+        break;
+#endif
+#if defined(__linux__)
+    case HttpTransport::epoll:
+        return std::unique_ptr<IHttpClient>(new AsyncHttpClient(std::move(config), executor));
+#endif
+    default:
+        break;
+    }
+#if defined(__linux__)
+    if (preferred != HttpTransport::blocking) {
+        return std::unique_ptr<IHttpClient>(new AsyncHttpClient(std::move(config), executor));
+    }
+#endif
+    return std::unique_ptr<IHttpClient>(new HttplibHttpClient(std::move(config), executor));
+}
+
+} // namespace core
@@ -0,0 +1,42 @@
+//
+//  HttpClientFactory.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Picks an IHttpClient transport for the platform it runs on. Callers that
+//  do not care which one they get ask for HttpTransport::automatic; a
+//  transport the platform lacks falls back down the list:
+//
+//    ioUring   IoUringHttpClient  (Linux, kernel with io_uring enabled)
+//    epoll     AsyncHttpClient    (Linux)
+//    blocking  HttplibHttpClient  (everywhere; blocks an executor thread)
+//
+//  All three deliver callbacks on the given executor, and take the same
+//  HttpClientConfig with two differences: only the blocking transport races
+//  a host's addresses (happyEyeballsDelayMs); the others connect to the
+//  first. They also differ in sendStreaming: the blocking transport hands
+//  the body over as it is read, the others once it is whole (IHttpClient's
+//  default). The blocking transport runs its requests on the executor too,
+//  so it needs one that can afford to block.
+//
+
+#ifndef PUREMVC_CORE_HTTP_CLIENT_FACTORY_HPP
+#define PUREMVC_CORE_HTTP_CLIENT_FACTORY_HPP
+
+#include <memory>
+#include "Domain/Ports/IExecutor.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+enum class HttpTransport { automatic, ioUring, epoll, blocking };
+
+// The transport makeHttpClient() would build for 'preferred' here.
+HttpTransport resolveHttpTransport(HttpTransport preferred = HttpTransport::automatic);
+
+std::unique_ptr<IHttpClient> makeHttpClient(HttpClientConfig config, IExecutor& executor,
+                                            HttpTransport preferred = HttpTransport::automatic);
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HTTP_CLIENT_FACTORY_HPP
@@ -0,0 +1,374 @@
+//
+//  HttpConnectionPool.cpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  A request sits in exactly one place at a time (the waiting queue, a
+//  connection, or a task on its way to either), which is what lets every
+//  path answer its callback exactly once.
+//
+
+#include "Infrastructure/Http/HttpConnectionPool.hpp"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "Infrastructure/Http/ContentCoding.hpp"
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
+
+namespace core {
+namespace {
+
+// Decodes a body in a coding this build has, which then loses its
+// Content-Encoding and Content-Length, or turns a corrupt or truncated one
+// into the same failure HttplibHttpClient reports.
+void decodeBody(HttpResponse& response) {
+    ContentCoding coding = ContentCoding::identity;
+    if (response.transportError ||
+        !parseContentCoding(response.headers.get(HttpHeader::contentEncoding), coding)) {
+        return;
+    }
+    std::unique_ptr<ContentDecoder> decoder = ContentDecoder::create(coding);
+    if (!decoder) {
+        return;
+    }
+    if (!response.body.empty()) {
+        std::string decoded;
+        const bool whole = decoder->write(response.body.data(), response.body.size(),
+                                          [&decoded](const char* data, std::size_t size) {
+                                              decoded.append(data, size);
+                                              return true;
+                                          }) &&
+                           decoder->finished();
+        if (!whole) {
+            response = transportFailure(std::string("Content decoding failed: bad ") + contentCodingName(coding) +
+                                        " body");
+            return;
+        }
+        response.body.swap(decoded);
+    }
+    response.headers.erase(HttpHeader::contentEncoding);
+    response.headers.erase(HttpHeader::contentLength);
+}
+
+// Runs a callback on the callback executor. Answers it exactly once: if the
+// executor destroys the task without running it (see BoundedExecutor), the
+// response is delivered inline rather than lost.
+struct DeliverTask {
+    DeliverTask(IHttpClient::Callback cb, HttpResponse r, bool d)
+        : callback(std::move(cb)), response(std::move(r)), decode(d) {}
+
+    DeliverTask(DeliverTask&& other) noexcept
+        : callback(std::move(other.callback)), response(std::move(other.response)), decode(other.decode) {
+        other.callback = nullptr;
+    }
+    DeliverTask& operator=(DeliverTask&&) = delete;
+
+    ~DeliverTask() {
+        if (callback) {
+            (*this)();
+        }
+    }
+
+    void operator()() {
+        IHttpClient::Callback done = std::move(callback);
+        callback = nullptr;
+        if (decode) {
+            decodeBody(response);
+        }
+        done(response);
+    }
+
+    IHttpClient::Callback callback;
+    HttpResponse response;
+    bool decode;
+};
+
+static_assert(Task::fitsInline<DeliverTask>(),
+              "DeliverTask must fit Task's inline buffer so delivery does not allocate");
+
+} // namespace
+
+std::string systemError(const char* what, int code) {
+    return std::string(what) + ": " + std::strerror(code);
+}
+
+bool isIpLiteral(const std::string& host) {
+    unsigned char buffer[sizeof(in6_addr)];
+    return ::inet_pton(AF_INET, host.c_str(), buffer) == 1 ||
+           ::inet_pton(AF_INET6, host.c_str(), buffer) == 1;
+}
+
+std::unique_ptr<HttpExchange> HttpConnectionPool::prepare(const HttpClientConfig& config,
+                                                          const HttpRequest& request, std::string& error) {
+    std::shared_ptr<std::string> wire = std::make_shared<std::string>();
+    bool decode = false;
+    if (!serializeHttpRequest(config, request, *wire, decode, error)) {
+        return nullptr;
+    }
+    std::unique_ptr<HttpExchange> exchange(new HttpExchange);
+    exchange->wire = std::move(wire);
+    exchange->head = request.method == "HEAD";
+    exchange->decode = decode && !exchange->head;
+    exchange->idempotent = isIdempotentMethod(request.method);
+    exchange->priority = request.priority;
+    return exchange;
+}
+
+void HttpConnectionPool::deliver(IExecutor& callbacks, IHttpClient::Callback callback, HttpResponse response,
+                                 TaskPriority priority, bool decode) {
+    callbacks.run(DeliverTask(std::move(callback), std::move(response), decode), priority);
+}
+
+HttpConnectionPool::HttpConnectionPool(const HttpClientConfig& config, DnsCache& dns, IExecutor& callbacks,
+                                       std::size_t maxConnections, std::size_t maxIdle)
+    : config_(config), dns_(dns), callbacks_(callbacks), maxConnections_(maxConnections), maxIdle_(maxIdle),
+      resolution_(std::make_shared<Resolution>()) {
+    resolution_->pool = this;
+}
+
+HttpConnectionPool::~HttpConnectionPool() = default;
+
+void HttpConnectionPool::submit(std::unique_ptr<HttpExchange> exchange) {
+    if (stopping_) {
+        deliver(std::move(exchange), transportFailure("Request cancelled: client destroyed"));
+        return;
+    }
+    if (!exchange->retried) {
+        PooledConnection* connection = takeIdle();
+        if (connection != nullptr) {
+            counters_.reused.fetch_add(1, std::memory_order_relaxed);
+            connection->reused = true;
+            begin(*connection, std::move(exchange));
+            return;
+        }
+    }
+    if (atCap() && !idle_.empty()) {
+        // A retry wants a fresh connection: trade an idle one for it.
+        counters_.expired.fetch_add(1, std::memory_order_relaxed);
+        close(*idle_.front());
+    }
+    if (atCap()) {
+        exchange->deadline = now() + std::chrono::seconds(config_.connectionTimeoutSec);
+        waitUntil(exchange->deadline);
+        waiting_.push_back(std::move(exchange));
+        return;
+    }
+    open(std::move(exchange));
+}
+
+// A miss parks the request until the lookup is in; later ones join it
+// rather than start another.
+void HttpConnectionPool::open(std::unique_ptr<HttpExchange> exchange) {
+    if (!resolving_.empty()) {
+        resolving_.push_back(std::move(exchange));
+        return;
+    }
+    const std::shared_ptr<Resolution> resolution = resolution_;
+    std::string error;
+    switch (dns_.resolveWithoutBlocking(config_.host, config_.port, addresses_, error, [resolution]() {
+        std::lock_guard<std::mutex> lock(resolution->mutex);
+        if (resolution->pool != nullptr) {
+            resolution->pool->notifyResolved();
+        }
+    })) {
+    case DnsCache::Result::resolved:
+        connect(std::move(exchange), addresses_.front());
+        break;
+    case DnsCache::Result::failed:
+        deliver(std::move(exchange), transportFailure(error));
+        break;
+    case DnsCache::Result::pending:
+        resolving_.push_back(std::move(exchange));
+        break;
+    }
+}
+
+// Back through submit(): the cap and the idle connections may have changed
+// while they waited.
+void HttpConnectionPool::resolved() {
+    std::deque<std::unique_ptr<HttpExchange>> ready;
+    ready.swap(resolving_);
+    while (!ready.empty()) {
+        std::unique_ptr<HttpExchange> exchange = std::move(ready.front());
+        ready.pop_front();
+        submit(std::move(exchange));
+    }
+}
+
+void HttpConnectionPool::opened() {
+    ++live_;
+    counters_.opened.fetch_add(1, std::memory_order_relaxed);
+    counters_.open.store(live_, std::memory_order_relaxed);
+}
+
+void HttpConnectionPool::expireWaiting() {
+    const Clock::time_point time = now();
+    while (!waiting_.empty() && waiting_.front()->deadline <= time) {
+        std::unique_ptr<HttpExchange> exchange = std::move(waiting_.front());
+        waiting_.pop_front();
+        deliver(std::move(exchange), transportFailure("Connection pool exhausted: no connection freed in time"));
+    }
+}
+
+// A slot has been freed (or a connection parked): start queued requests.
+void HttpConnectionPool::dispatchWaiting() {
+    while (!waiting_.empty() && (!atCap() || !idle_.empty())) {
+        std::unique_ptr<HttpExchange> exchange = std::move(waiting_.front());
+        waiting_.pop_front();
+        submit(std::move(exchange));
+    }
+}
+
+PooledConnection* HttpConnectionPool::takeIdle() {
+    pruneIdle();
+    if (idle_.empty()) {
+        return nullptr;
+    }
+    PooledConnection* connection = idle_.back();
+    idle_.pop_back();
+    connection->parked = false;
+    counters_.idle.store(idle_.size(), std::memory_order_relaxed);
+    unparked(*connection);
+    return connection;
+}
+
+void HttpConnectionPool::pruneIdle() {
+    const Clock::time_point time = now();
+    const Clock::duration timeout = std::chrono::seconds(config_.idleTimeoutSec);
+    while (!idle_.empty() && (idle_.size() > maxIdle_ || time - idle_.front()->idleSince >= timeout)) {
+        counters_.expired.fetch_add(1, std::memory_order_relaxed);
+        close(*idle_.front());
+    }
+}
+
+void HttpConnectionPool::park(PooledConnection& connection) {
+    connection.parked = true;
+    connection.idleSince = now();
+    connection.exchange.reset();
+    idle_.push_back(&connection);
+    counters_.idle.store(idle_.size(), std::memory_order_relaxed);
+    parked(connection);
+}
+
+void HttpConnectionPool::unpark(PooledConnection& connection) {
+    idle_.erase(std::find(idle_.begin(), idle_.end(), &connection));
+    connection.parked = false;
+    counters_.idle.store(idle_.size(), std::memory_order_relaxed);
+}
+
+void HttpConnectionPool::repark(PooledConnection& connection) {
+    const auto position = std::find_if(idle_.begin(), idle_.end(), [&connection](PooledConnection* other) {
+        return other->idleSince > connection.idleSince;
+    });
+    idle_.insert(position, &connection);
+    connection.parked = true;
+    counters_.idle.store(idle_.size(), std::memory_order_relaxed);
+    parked(connection);
+}
+
+void HttpConnectionPool::closeIdle() {
+    while (!idle_.empty()) {
+        counters_.expired.fetch_add(1, std::memory_order_relaxed);
+        close(*idle_.front());
+    }
+    dispatchWaiting();
+}
+
+void HttpConnectionPool::closeStale(PooledConnection& connection) {
+    counters_.stale.fetch_add(1, std::memory_order_relaxed);
+    close(connection);
+    dispatchWaiting();
+}
+
+void HttpConnectionPool::stop(const std::string& reason) {
+    stopping_ = true;
+    {
+        std::lock_guard<std::mutex> lock(resolution_->mutex);
+        resolution_->pool = nullptr;
+    }
+    for (std::deque<std::unique_ptr<HttpExchange>>* queue : {&waiting_, &resolving_}) {
+        while (!queue->empty()) {
+            std::unique_ptr<HttpExchange> exchange = std::move(queue->front());
+            queue->pop_front();
+            deliver(std::move(exchange), transportFailure(reason));
+        }
+    }
+}
+
+// The connection goes back to work (or away) before the callback is queued,
+// so the pool already reflects this exchange when its caller looks.
+void HttpConnectionPool::complete(PooledConnection& connection, bool reusable) {
+    std::unique_ptr<HttpExchange> exchange = std::move(connection.exchange);
+    HttpResponse response = std::move(connection.parser.response());
+    reusable = reusable && connection.parser.keepAlive() && maxIdle_ > 0 && config_.idleTimeoutSec > 0 &&
+               !stopping_;
+
+    if (!reusable) {
+        close(connection);
+        dispatchWaiting();
+    } else if (!waiting_.empty()) {
+        std::unique_ptr<HttpExchange> next = std::move(waiting_.front());
+        waiting_.pop_front();
+        counters_.reused.fetch_add(1, std::memory_order_relaxed);
+        connection.reused = true;
+        begin(connection, std::move(next));
+    } else {
+        pruneIdle();
+        park(connection);
+    }
+    deliver(callbacks_, std::move(exchange->callback), std::move(response), exchange->priority, exchange->decode);
+}
+
+// Closes the connection and answers its request, or retries it once on a
+// fresh connection when a reused one died before any response byte arrived
+// (the server's keep-alive timeout racing ours). Timeouts are not retried.
+void HttpConnectionPool::fail(PooledConnection& connection, const std::string& message, bool retryable) {
+    std::unique_ptr<HttpExchange> exchange = std::move(connection.exchange);
+    const bool retry = retryable && exchange && connection.reused && !connection.parser.started() &&
+                       exchange->idempotent && !exchange->retried;
+    close(connection);
+    if (exchange) {
+        if (retry) {
+            exchange->retried = true;
+            counters_.retried.fetch_add(1, std::memory_order_relaxed);
+            submit(std::move(exchange));
+        } else {
+            deliver(std::move(exchange), transportFailure(message));
+        }
+    }
+    dispatchWaiting();
+}
+
+void HttpConnectionPool::close(PooledConnection& connection) {
+    if (connection.parked) {
+        unpark(connection);
+    }
+    --live_;
+    counters_.open.store(live_, std::memory_order_relaxed);
+    release(connection); // may destroy 'connection'
+}
+
+void HttpConnectionPool::deliver(std::unique_ptr<HttpExchange> exchange, HttpResponse response) {
+    deliver(callbacks_, std::move(exchange->callback), std::move(response), exchange->priority);
+}
+
+void HttpConnectionPool::addStats(ConnectionPoolStats& stats) const {
+    stats.opened += counters_.opened.load(std::memory_order_relaxed);
+    stats.reused += counters_.reused.load(std::memory_order_relaxed);
+    stats.expired += counters_.expired.load(std::memory_order_relaxed);
+    stats.stale += counters_.stale.load(std::memory_order_relaxed);
+    stats.retried += counters_.retried.load(std::memory_order_relaxed);
+    stats.fullHandshakes += counters_.fullHandshakes.load(std::memory_order_relaxed);
+    stats.resumedHandshakes += counters_.resumedHandshakes.load(std::memory_order_relaxed);
+    stats.open += counters_.open.load(std::memory_order_relaxed);
+    stats.idle += counters_.idle.load(std::memory_order_relaxed);
+}
+
+} // namespace core
+
+#endif // defined(__linux__)
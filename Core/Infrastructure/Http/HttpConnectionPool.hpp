@@ -0,0 +1,199 @@
+//
+//  HttpConnectionPool.hpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  The part of the non-blocking clients (AsyncHttpClient, IoUringHttpClient)
+//  that does not depend on how sockets are driven: the keep-alive pool with
+//  its idle and per-host limits, the queue of requests waiting for a
+//  connection slot, the one retry of an idempotent request whose reused
+//  connection turned out to be dead, and delivery of every answer exactly
+//  once on the callback executor.
+//
+//  A transport derives from HttpConnectionPool, one instance per event
+//  loop, and supplies the socket side through the virtual hooks: connecting
+//  to an address, starting an exchange on a connection, watching an idle
+//  one, and releasing one that is closed. Each transport's connection type
+//  derives from PooledConnection. Except where noted, everything runs on
+//  the loop thread, so nothing here takes a lock. The loop never waits for
+//  DNS: a host not in the cache is looked up on another thread while its
+//  requests wait.
+//
+
+#ifndef PUREMVC_CORE_HTTP_CONNECTION_POOL_HPP
+#define PUREMVC_CORE_HTTP_CONNECTION_POOL_HPP
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Domain/Ports/IExecutor.hpp"
+#include "Infrastructure/Http/DnsCache.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/HttpResponseParser.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+// "what: strerror(code)".
+std::string systemError(const char* what, int code);
+
+// A numeric IPv4 or IPv6 address, which TLS must not send as SNI.
+bool isIpLiteral(const std::string& host);
+
+// One request from send() to its answer. The serialised request is shared
+// with the connection sending it, which may outlive the exchange.
+struct HttpExchange {
+    std::shared_ptr<const std::string> wire;
+    bool head = false;
+    bool idempotent = false;
+    bool retried = false;
+    bool decode = false; // the response body is ours to decode (see serializeHttpRequest)
+    TaskPriority priority = TaskPriority::normal;
+    IHttpClient::Callback callback;
+    std::chrono::steady_clock::time_point deadline; // while waiting for a connection slot
+};
+
+// What the pool needs of every transport's connection.
+struct PooledConnection {
+    bool reused = false; // the current exchange did not open it
+    bool parked = false; // in the idle list
+    std::unique_ptr<HttpExchange> exchange;
+    HttpResponseParser parser;
+    std::chrono::steady_clock::time_point idleSince;
+};
+
+class HttpConnectionPool {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Any thread. The exchange for 'request', still without its callback,
+    // or null with 'error' set if the request cannot be sent.
+    static std::unique_ptr<HttpExchange> prepare(const HttpClientConfig& config, const HttpRequest& request,
+                                                 std::string& error);
+    // With 'decode', a body in a content coding this build has is decoded
+    // there, off the loop thread.
+    static void deliver(IExecutor& callbacks, IHttpClient::Callback callback, HttpResponse response,
+                        TaskPriority priority, bool decode = false);
+
+    // 'maxConnections' and 'maxIdle' are this pool's share of the client's
+    // limits; maxConnections 0 is unlimited. 'config' must outlive the pool.
+    HttpConnectionPool(const HttpClientConfig& config, DnsCache& dns, IExecutor& callbacks,
+                       std::size_t maxConnections, std::size_t maxIdle);
+    virtual ~HttpConnectionPool();
+
+    HttpConnectionPool(const HttpConnectionPool&) = delete;
+    HttpConnectionPool& operator=(const HttpConnectionPool&) = delete;
+
+    // Starts 'exchange' on an idle connection, a new one, or queues it until
+    // a slot frees up. After stop(), answers it as cancelled.
+    void submit(std::unique_ptr<HttpExchange> exchange);
+
+    void closeIdle();
+
+    // A lookup notifyResolved() announced has finished: opens connections
+    // for the requests that waited on it.
+    void resolved();
+
+    // Answers the queued requests whose deadline has passed.
+    void expireWaiting();
+    bool hasWaiting() const { return !waiting_.empty(); }
+    Clock::time_point nextDeadline() const { return waiting_.front()->deadline; }
+
+    bool stopping() const { return stopping_; }
+
+    // Any thread.
+    void addStats(ConnectionPoolStats& stats) const;
+
+protected:
+    struct Counters {
+        std::atomic<std::uint64_t> opened{0};
+        std::atomic<std::uint64_t> reused{0};
+        std::atomic<std::uint64_t> expired{0};
+        std::atomic<std::uint64_t> stale{0};
+        std::atomic<std::uint64_t> retried{0};
+        std::atomic<std::uint64_t> fullHandshakes{0};
+        std::atomic<std::uint64_t> resumedHandshakes{0};
+        std::atomic<std::size_t> open{0};
+        std::atomic<std::size_t> idle{0};
+    };
+
+    // The transport's side.
+    virtual Clock::time_point now() const = 0;
+    // Opens a connection to 'address' for 'exchange' (calling opened() once
+    // it exists), or answers it through deliver().
+    virtual void connect(std::unique_ptr<HttpExchange> exchange, const SocketAddress& address) = 0;
+    // Sends 'exchange' on 'connection', which is connected and not parked.
+    virtual void begin(PooledConnection& connection, std::unique_ptr<HttpExchange> exchange) = 0;
+    // 'connection' has joined the idle list: watch it for the peer closing.
+    virtual void parked(PooledConnection& connection) = 0;
+    // 'connection' has left the idle list for another exchange.
+    virtual void unparked(PooledConnection&) {}
+    // 'connection' is out of the pool's books: close its socket and free it.
+    virtual void release(PooledConnection& connection) = 0;
+    // A request has been queued until 'deadline'; expireWaiting() must run
+    // by then.
+    virtual void waitUntil(Clock::time_point) {}
+    // Any thread: a DNS lookup has finished; resolved() must run on the loop
+    // thread. Not called once stop() has returned.
+    virtual void notifyResolved() = 0;
+
+    // A new connection from connect() counts against the limit.
+    void opened();
+    void complete(PooledConnection& connection, bool reusable);
+    void fail(PooledConnection& connection, const std::string& message, bool retryable);
+    void close(PooledConnection& connection);
+    // An idle connection turned out to be closed by the peer.
+    void closeStale(PooledConnection& connection);
+    // Takes a parked connection off the idle list while it is checked, and
+    // puts it back where its idleSince belongs.
+    void unpark(PooledConnection& connection);
+    void repark(PooledConnection& connection);
+    void deliver(std::unique_ptr<HttpExchange> exchange, HttpResponse response);
+    void dispatchWaiting();
+    // Answers the queued requests with 'reason' and takes no more work; the
+    // transport then closes its connections. Must run before the transport
+    // is destroyed.
+    void stop(const std::string& reason);
+
+    const HttpClientConfig& config_;
+    Counters counters_;
+
+private:
+    // Lets a lookup finishing on another thread reach the pool until stop().
+    struct Resolution {
+        std::mutex mutex;
+        HttpConnectionPool* pool;
+    };
+
+    bool atCap() const { return maxConnections_ != 0 && live_ >= maxConnections_; }
+    void open(std::unique_ptr<HttpExchange> exchange);
+    PooledConnection* takeIdle();
+    void pruneIdle();
+    void park(PooledConnection& connection);
+
+    DnsCache& dns_;
+    IExecutor& callbacks_;
+    const std::size_t maxConnections_;
+    const std::size_t maxIdle_;
+
+    std::size_t live_ = 0;                       // opened and not yet closed
+    std::deque<PooledConnection*> idle_;         // oldest first; reuse takes the newest
+    std::deque<std::unique_ptr<HttpExchange>> waiting_;
+    std::deque<std::unique_ptr<HttpExchange>> resolving_; // non-empty while a lookup is out
+    std::shared_ptr<Resolution> resolution_;
+    std::vector<SocketAddress> addresses_;       // refilled from dns_ per connection
+    bool stopping_ = false;
+};
+
+} // namespace core
+
+#endif // defined(__linux__)
+
+#endif // PUREMVC_CORE_HTTP_CONNECTION_POOL_HPP
@@ -0,0 +1,232 @@
+//
+//  HttpHeaders.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/HttpHeaders.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace core {
+namespace {
+
+const std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+struct KnownName {
+    const char* text;
+    std::size_t size;
+};
+
+template <std::size_t N>
+constexpr KnownName known(const char (&text)[N]) {
+    return KnownName{text, N - 1};
+}
+
+// Indexed by HttpHeader - 1.
+const KnownName kNames[] = {
+    known("Accept"),        known("Accept-Encoding"),   known("Age"),
+    known("Authorization"), known("Cache-Control"),     known("Connection"),
+    known("Content-Encoding"), known("Content-Length"), known("Content-Type"),
+    known("Date"),          known("ETag"),              known("Expires"),
+    known("Host"),          known("If-Modified-Since"), known("If-None-Match"),
+    known("Keep-Alive"),    known("Last-Modified"),     known("Location"),
+    known("Retry-After"),   known("Server"),            known("Set-Cookie"),
+    known("Transfer-Encoding"), known("User-Agent"),    known("Vary"),
+};
+const std::size_t kNameCount = sizeof(kNames) / sizeof(kNames[0]);
+
+char lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool sameLetters(const char* a, const char* b, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        if (lower(a[i]) != lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The HttpHeader 'name' spells, or 0. Length and first letter rule out all
+// but one or two candidates before any string comparison.
+std::uint8_t intern(const std::string& name) {
+    if (name.empty()) {
+        return 0;
+    }
+    const char first = lower(name[0]);
+    for (std::size_t i = 0; i < kNameCount; ++i) {
+        const KnownName& known = kNames[i];
+        if (known.size == name.size() && lower(known.text[0]) == first &&
+            sameLetters(known.text + 1, name.data() + 1, name.size() - 1)) {
+            return static_cast<std::uint8_t>(i + 1);
+        }
+    }
+    return 0;
+}
+
+std::uint8_t idOf(HttpHeader header) {
+    return static_cast<std::uint8_t>(header);
+}
+
+// Days from 1970-01-01 to a proleptic Gregorian date.
+std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2 ? 1 : 0;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+} // namespace
+
+const std::string& HttpHeaders::Field::name() const {
+    return id_ != 0 ? canonicalName(static_cast<HttpHeader>(id_)) : name_;
+}
+
+HttpHeaders::HttpHeaders(std::initializer_list<std::pair<std::string, std::string>> fields) {
+    fields_.reserve(fields.size());
+    for (const auto& field : fields) {
+        set(field.first, field.second);
+    }
+}
+
+const std::string* HttpHeaders::find(const std::string& name) const {
+    const std::size_t index = indexOf(intern(name), name);
+    return index == kNotFound ? nullptr : &fields_[index].value;
+}
+
+const std::string* HttpHeaders::find(HttpHeader header) const {
+    const std::size_t index = indexOf(idOf(header), std::string());
+    return index == kNotFound ? nullptr : &fields_[index].value;
+}
+
+const std::string& HttpHeaders::get(const std::string& name) const {
+    static const std::string none;
+    const std::string* value = find(name);
+    return value != nullptr ? *value : none;
+}
+
+const std::string& HttpHeaders::get(HttpHeader header) const {
+    static const std::string none;
+    const std::string* value = find(header);
+    return value != nullptr ? *value : none;
+}
+
+std::string& HttpHeaders::operator[](const std::string& name) {
+    const std::uint8_t id = intern(name);
+    const std::size_t index = indexOf(id, name);
+    if (index != kNotFound) {
+        return fields_[index].value;
+    }
+    fields_.emplace_back(id, id != 0 ? std::string() : name, std::string());
+    return fields_.back().value;
+}
+
+void HttpHeaders::set(const std::string& name, std::string value) {
+    assign(intern(name), name, std::move(value));
+}
+
+void HttpHeaders::set(HttpHeader header, std::string value) {
+    assign(idOf(header), std::string(), std::move(value));
+}
+
+void HttpHeaders::add(const std::string& name, std::string value) {
+    const std::uint8_t id = intern(name);
+    fields_.emplace_back(id, id != 0 ? std::string() : name, std::move(value));
+}
+
+std::size_t HttpHeaders::erase(const std::string& name) {
+    return eraseFrom(0, intern(name), name);
+}
+
+std::size_t HttpHeaders::erase(HttpHeader header) {
+    return eraseFrom(0, idOf(header), std::string());
+}
+
+void HttpHeaders::mergeDefaults(const HttpHeaders& defaults) {
+    const std::size_t own = fields_.size();
+    fields_.reserve(own + defaults.size());
+    for (const Field& field : defaults) {
+        bool overridden = false;
+        for (std::size_t i = 0; i < own && !overridden; ++i) {
+            overridden = matches(fields_[i], field.id_, field.name_);
+        }
+        if (!overridden) {
+            fields_.push_back(field);
+        }
+    }
+}
+
+const std::string& HttpHeaders::canonicalName(HttpHeader header) {
+    // Built on first use: no static initialization order to worry about.
+    static const std::vector<std::string> names = []() {
+        std::vector<std::string> spelled;
+        for (const KnownName& known : kNames) {
+            spelled.emplace_back(known.text, known.size);
+        }
+        return spelled;
+    }();
+    return names[idOf(header) - 1];
+}
+
+bool HttpHeaders::equalsIgnoreCase(const std::string& a, const std::string& b) {
+    return a.size() == b.size() && sameLetters(a.data(), b.data(), a.size());
+}
+
+bool HttpHeaders::parseDate(const std::string& value, std::int64_t& secondsSinceEpoch) {
+    static const char kMonths[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    char weekday[4] = {0};
+    char month[4] = {0};
+    int day = 0, year = 0, hour = 0, minute = 0, second = 0;
+    if (std::sscanf(value.c_str(), "%3s, %d %3s %d %d:%d:%d GMT", weekday, &day, month, &year, &hour, &minute,
+                    &second) != 7) {
+        return false;
+    }
+    const char* found = std::strstr(kMonths, month);
+    if (found == nullptr || std::strlen(month) != 3 || (found - kMonths) % 3 != 0 || day < 1 || day > 31 ||
+        hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    const unsigned m = static_cast<unsigned>((found - kMonths) / 3 + 1);
+    secondsSinceEpoch =
+        daysFromCivil(year, m, static_cast<unsigned>(day)) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+// 'id' non-zero: the interned field; 'name' is not looked at.
+bool HttpHeaders::matches(const Field& field, std::uint8_t id, const std::string& name) {
+    return field.id_ == id && (id != 0 || equalsIgnoreCase(field.name_, name));
+}
+
+std::size_t HttpHeaders::indexOf(std::uint8_t id, const std::string& name) const {
+    for (std::size_t i = 0; i < fields_.size(); ++i) {
+        if (matches(fields_[i], id, name)) {
+            return i;
+        }
+    }
+    return kNotFound;
+}
+
+void HttpHeaders::assign(std::uint8_t id, const std::string& name, std::string value) {
+    const std::size_t index = indexOf(id, name);
+    if (index == kNotFound) {
+        fields_.emplace_back(id, id != 0 ? std::string() : name, std::move(value));
+        return;
+    }
+    fields_[index].value = std::move(value);
+    eraseFrom(index + 1, id, name);
+}
+
+std::size_t HttpHeaders::eraseFrom(std::size_t first, std::uint8_t id, const std::string& name) {
+    const std::size_t before = fields_.size();
+    fields_.erase(std::remove_if(fields_.begin() + static_cast<std::ptrdiff_t>(first), fields_.end(),
+                                 [id, &name](const Field& field) { return matches(field, id, name); }),
+                  fields_.end());
+    return before - fields_.size();
+}
+
+} // namespace core
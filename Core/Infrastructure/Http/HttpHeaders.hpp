@@ -0,0 +1,140 @@
+//
+//  HttpHeaders.hpp
+//  PureMVC Core — Infrastructure
+//
+//  The header fields of an HttpRequest or HttpResponse: a flat vector of
+//  name/value pairs in insertion (wire) order, looked up by name without
+//  regard to case, as HTTP requires. Messages carry a dozen headers or so,
+//  for which a linear scan over one contiguous block beats a tree of
+//  individually allocated nodes.
+//
+//  Common names (HttpHeader) are interned: such a field stores a one-byte id
+//  instead of its name, and lookups by id compare bytes, not strings.
+//  Setting or finding one of them by its string name interns it the same
+//  way, so "content-type" and HttpHeader::contentType are the same field.
+//  Hot paths use the HttpHeader overloads: a string literal passed by name
+//  becomes a std::string first, which allocates past 15 characters.
+//
+
+#ifndef PUREMVC_CORE_HTTP_HEADERS_HPP
+#define PUREMVC_CORE_HTTP_HEADERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+enum class HttpHeader : std::uint8_t {
+    accept = 1,
+    acceptEncoding,
+    age,
+    authorization,
+    cacheControl,
+    connection,
+    contentEncoding,
+    contentLength,
+    contentType,
+    date,
+    etag,
+    expires,
+    host,
+    ifModifiedSince,
+    ifNoneMatch,
+    keepAlive,
+    lastModified,
+    location,
+    retryAfter,
+    server,
+    setCookie,
+    transferEncoding,
+    userAgent,
+    vary,
+};
+
+class HttpHeaders {
+public:
+    class Field {
+    public:
+        Field(std::uint8_t id, std::string name, std::string v)
+            : value(std::move(v)), name_(std::move(name)), id_(id) {}
+
+        // Canonical spelling for an interned name, as given otherwise.
+        const std::string& name() const;
+        bool is(HttpHeader header) const { return id_ == static_cast<std::uint8_t>(header); }
+
+        std::string value;
+
+    private:
+        friend class HttpHeaders;
+        std::string name_; // empty when interned
+        std::uint8_t id_;  // HttpHeader, or 0
+    };
+
+    using iterator = std::vector<Field>::iterator;
+    using const_iterator = std::vector<Field>::const_iterator;
+
+    HttpHeaders() = default;
+    HttpHeaders(std::initializer_list<std::pair<std::string, std::string>> fields);
+
+    bool empty() const { return fields_.empty(); }
+    std::size_t size() const { return fields_.size(); }
+    void reserve(std::size_t n) { fields_.reserve(n); }
+    void clear() { fields_.clear(); }
+
+    iterator begin() { return fields_.begin(); }
+    iterator end() { return fields_.end(); }
+    const_iterator begin() const { return fields_.begin(); }
+    const_iterator end() const { return fields_.end(); }
+
+    // Value of the first field named 'name', or null.
+    const std::string* find(const std::string& name) const;
+    const std::string* find(HttpHeader header) const;
+    bool contains(const std::string& name) const { return find(name) != nullptr; }
+    bool contains(HttpHeader header) const { return find(header) != nullptr; }
+
+    // The first value, or "" when absent.
+    const std::string& get(const std::string& name) const;
+    const std::string& get(HttpHeader header) const;
+
+    // Like std::map: the first value, added empty when absent.
+    std::string& operator[](const std::string& name);
+
+    // Replaces every field of that name with one, keeping the first's place.
+    void set(const std::string& name, std::string value);
+    void set(HttpHeader header, std::string value);
+
+    // Appends a field even if the name is present (Set-Cookie, Vary, ...).
+    void add(const std::string& name, std::string value);
+
+    // Removes every field of that name; returns how many there were.
+    std::size_t erase(const std::string& name);
+    std::size_t erase(HttpHeader header);
+
+    // Appends the fields of 'defaults' whose names are not present here, so
+    // per-request headers win over a client's defaults. One growth at most.
+    void mergeDefaults(const HttpHeaders& defaults);
+
+    static const std::string& canonicalName(HttpHeader header);
+    static bool equalsIgnoreCase(const std::string& a, const std::string& b);
+
+    // An HTTP-date value (Date, Expires, Retry-After, ...) in IMF-fixdate
+    // form, "Sun, 06 Nov 1994 08:49:37 GMT", the only one servers still
+    // send, as seconds since the epoch.
+    static bool parseDate(const std::string& value, std::int64_t& secondsSinceEpoch);
+
+private:
+    static bool matches(const Field& field, std::uint8_t id, const std::string& name);
+    std::size_t indexOf(std::uint8_t id, const std::string& name) const;
+    void assign(std::uint8_t id, const std::string& name, std::string value);
+    std::size_t eraseFrom(std::size_t first, std::uint8_t id, const std::string& name);
+
+    std::vector<Field> fields_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HTTP_HEADERS_HPP
@@ -0,0 +1,136 @@
+//
+//  HttpRequestSerializer.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
+
+#include "Infrastructure/Http/ContentCoding.hpp"
+
+namespace core {
+namespace {
+
+bool isToken(const std::string& text) {
+    if (text.empty()) {
+        return false;
+    }
+    for (char c : text) {
+        if (c <= ' ' || c >= 127 || c == ':') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool hasLineBreak(const std::string& text) {
+    return text.find_first_of("\r\n") != std::string::npos;
+}
+
+} // namespace
+
+bool serializeHttpRequest(const HttpClientConfig& config, const HttpRequest& request,
+               std::string& wire, bool& decode, std::string& error) {
+    if (!isToken(request.method)) {
+        error = "Unsupported HTTP method: " + request.method;
+        return false;
+    }
+    if (request.path.empty() || request.path[0] != '/' ||
+        request.path.find_first_of(" \r\n") != std::string::npos) {
+        error = "Invalid request path: " + request.path;
+        return false;
+    }
+    // Defaults the request overrides are skipped, not copied and dropped.
+    const HttpHeaders& own = request.headers;
+    auto overridden = [&own](const HttpHeaders::Field& field) { return own.contains(field.name()); };
+    for (const auto& header : config.defaultHeaders) {
+        if (!overridden(header) && (!isToken(header.name()) || hasLineBreak(header.value))) {
+            error = "Invalid header: " + header.name();
+            return false;
+        }
+    }
+    for (const auto& header : own) {
+        if (!isToken(header.name()) || hasLineBreak(header.value)) {
+            error = "Invalid header: " + header.name();
+            return false;
+        }
+    }
+    auto hasHeader = [&own, &config](HttpHeader name) {
+        return own.contains(name) || config.defaultHeaders.contains(name);
+    };
+
+    const bool bodyMethod =
+        request.method == "POST" || request.method == "PUT" || request.method == "PATCH";
+    const bool sendsBody = bodyMethod || !request.body.empty();
+
+    const std::string acceptEncoding =
+        config.acceptEncodings.empty() || hasHeader(HttpHeader::acceptEncoding)
+            ? std::string() : acceptEncodingValue(config.acceptEncodings);
+    decode = !acceptEncoding.empty();
+    const std::string* body = &request.body;
+    std::string compressed;
+    if (config.requestEncoding != ContentCoding::identity && request.body.size() > config.compressRequestsAbove &&
+        request.method != "GET" && request.method != "DELETE" && !hasHeader(HttpHeader::contentEncoding) &&
+        !hasHeader(HttpHeader::contentLength) && compressContent(config.requestEncoding, request.body, compressed) &&
+        compressed.size() < request.body.size()) {
+        body = &compressed;
+    }
+
+    wire.reserve(256 + request.path.size() + body->size());
+    wire.append(request.method).append(" ").append(request.path).append(" HTTP/1.1\r\n");
+    if (!hasHeader(HttpHeader::host)) {
+        const bool defaultPort = config.port == (config.useSSL ? 443 : 80);
+        const bool v6 = config.host.find(':') != std::string::npos;
+        wire.append("Host: ").append(v6 ? "[" + config.host + "]" : config.host);
+        if (!defaultPort) {
+            wire.append(":").append(std::to_string(config.port));
+        }
+        wire.append("\r\n");
+    }
+    if (!hasHeader(HttpHeader::accept)) {
+        wire.append("Accept: */*\r\n");
+    }
+    if (!hasHeader(HttpHeader::connection)) {
+        wire.append(config.maxIdleConnections > 0 ? "Connection: keep-alive\r\n"
+                                                  : "Connection: close\r\n");
+    }
+    if (sendsBody && !request.contentType.empty() && !hasHeader(HttpHeader::contentType)) {
+        if (hasLineBreak(request.contentType)) {
+            error = "Invalid header: Content-Type";
+            return false;
+        }
+        wire.append("Content-Type: ").append(request.contentType).append("\r\n");
+    }
+    if (sendsBody && !hasHeader(HttpHeader::contentLength)) {
+        wire.append("Content-Length: ").append(std::to_string(body->size())).append("\r\n");
+    }
+    if (body == &compressed) {
+        wire.append("Content-Encoding: ").append(contentCodingName(config.requestEncoding)).append("\r\n");
+    }
+    if (decode) {
+        wire.append("Accept-Encoding: ").append(acceptEncoding).append("\r\n");
+    }
+    for (const auto& header : config.defaultHeaders) {
+        if (!overridden(header)) {
+            wire.append(header.name()).append(": ").append(header.value).append("\r\n");
+        }
+    }
+    for (const auto& header : own) {
+        wire.append(header.name()).append(": ").append(header.value).append("\r\n");
+    }
+    wire.append("\r\n").append(*body);
+    return true;
+}
+
+bool isIdempotentMethod(const std::string& method) {
+    return method == "GET" || method == "HEAD" || method == "PUT" || method == "DELETE";
+}
+
+bool isSafeMethod(const std::string& method) {
+    return method == "GET" || method == "HEAD" || method == "OPTIONS" || method == "TRACE";
+}
+
+std::string defaultRoute(const HttpRequest& request) {
+    return request.method + " " + request.path.substr(0, request.path.find('?'));
+}
+
+} // namespace core
@@ -0,0 +1,46 @@
+//
+//  HttpRequestSerializer.hpp
+//  PureMVC Core — Infrastructure
+//
+//  HTTP/1.1 request encoding for the clients that write to sockets
+//  themselves (AsyncHttpClient, IoUringHttpClient). Platform-neutral.
+//
+
+#ifndef PUREMVC_CORE_HTTP_REQUEST_SERIALIZER_HPP
+#define PUREMVC_CORE_HTTP_REQUEST_SERIALIZER_HPP
+
+#include <string>
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/HttpTypes.hpp"
+
+namespace core {
+
+// Appends the request line, headers and body to 'wire' as one buffer, so a
+// small request leaves in one write. Per-request headers replace defaults of
+// the same name, compared case-insensitively as httplib does; Host, Accept,
+// Connection (keep-alive unless maxIdleConnections is 0), Content-Type and
+// Content-Length are added when absent. The content codings are applied as
+// HttplibHttpClient does: config.acceptEncodings are offered unless the
+// request or the defaults name an Accept-Encoding, which sets 'decode' (the
+// response body is the caller's to decode), and a body above
+// compressRequestsAbove is sent in config.requestEncoding when that makes
+// it smaller. Returns false with 'error' set on anything that would let a
+// value break out of its line.
+bool serializeHttpRequest(const HttpClientConfig& config, const HttpRequest& request,
+                          std::string& wire, bool& decode, std::string& error);
+
+// Methods safe to send twice: eligible for the retry after a reused
+// connection turns out to be dead.
+bool isIdempotentMethod(const std::string& method);
+
+// Methods that ask for no change on the server (RFC 9110, 9.2.1): a second
+// copy is harmless, and their responses may be cached.
+bool isSafeMethod(const std::string& method);
+
+// The route decorators key per-endpoint state by: method and path without
+// the query, e.g. "GET /api/v1/me".
+std::string defaultRoute(const HttpRequest& request);
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HTTP_REQUEST_SERIALIZER_HPP
@@ -0,0 +1,345 @@
+//
+//  HttpResponseParser.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/HttpResponseParser.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+namespace {
+
+char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsIgnoreCase(const std::string& a, const char* b) {
+    const std::size_t length = std::strlen(b);
+    if (a.size() != length) {
+        return false;
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+        if (lower(a[i]) != lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Case-insensitive search for a token in a comma-separated list.
+bool listContains(const std::string& list, const char* token) {
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        std::size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::size_t first = start;
+        std::size_t last = end;
+        while (first < last && (list[first] == ' ' || list[first] == '\t')) {
+            ++first;
+        }
+        while (last > first && (list[last - 1] == ' ' || list[last - 1] == '\t')) {
+            --last;
+        }
+        if (equalsIgnoreCase(list.substr(first, last - first), token)) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+bool parseDecimal(const std::string& text, std::uint64_t& value) {
+    if (text.empty() || text.size() > 19) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+    return true;
+}
+
+// Never reserve more than this up front, whatever Content-Length claims.
+const std::uint64_t kMaxReserve = 1024 * 1024;
+
+} // namespace
+
+const std::size_t HttpResponseParser::kMaxLineBytes;
+const std::size_t HttpResponseParser::kMaxHeaderBytes;
+
+void HttpResponseParser::reset(bool headRequest) {
+    response_ = HttpResponse();
+    state_ = State::incomplete;
+    phase_ = Phase::statusLine;
+    error_.clear();
+    line_.clear();
+    headRequest_ = headRequest;
+    started_ = false;
+    keepAlive_ = true;
+    http10_ = false;
+    chunked_ = false;
+    hasLength_ = false;
+    remaining_ = 0;
+    headerBytes_ = 0;
+}
+
+std::size_t HttpResponseParser::feed(const char* data, std::size_t size) {
+    const char* const begin = data;
+    const char* const end = data + size;
+    if (size != 0) {
+        started_ = true;
+    }
+    while (data < end && state_ == State::incomplete) {
+        switch (phase_) {
+        case Phase::statusLine:
+            if (appendLine(data, end)) {
+                onStatusLine();
+            }
+            break;
+        case Phase::headerLine:
+            if (appendLine(data, end)) {
+                onHeaderLine();
+            }
+            break;
+        case Phase::fixedBody:
+        case Phase::chunkData: {
+            const std::size_t take = static_cast<std::size_t>(
+                std::min<std::uint64_t>(remaining_, static_cast<std::uint64_t>(end - data)));
+            response_.body.append(data, take);
+            data += take;
+            remaining_ -= take;
+            if (remaining_ == 0) {
+                if (phase_ == Phase::fixedBody) {
+                    finish();
+                } else {
+                    phase_ = Phase::chunkDataEnd;
+                }
+            }
+            break;
+        }
+        case Phase::chunkDataEnd:
+            if (appendLine(data, end)) {
+                if (!line_.empty()) {
+                    fail("Malformed chunk: data longer than its size");
+                } else {
+                    phase_ = Phase::chunkSize;
+                }
+                line_.clear();
+            }
+            break;
+        case Phase::chunkSize:
+            if (appendLine(data, end)) {
+                onChunkSizeLine();
+            }
+            break;
+        case Phase::trailerLine:
+            if (appendLine(data, end)) {
+                if (line_.empty()) {
+                    finish();
+                }
+                line_.clear();
+            }
+            break;
+        case Phase::untilClose:
+            response_.body.append(data, static_cast<std::size_t>(end - data));
+            data = end;
+            break;
+        case Phase::done:
+            return static_cast<std::size_t>(data - begin);
+        }
+    }
+    return static_cast<std::size_t>(data - begin);
+}
+
+void HttpResponseParser::finishOnClose() {
+    if (state_ != State::incomplete) {
+        return;
+    }
+    if (phase_ == Phase::untilClose) {
+        keepAlive_ = false;
+        finish();
+        return;
+    }
+    fail(started_ ? "Connection closed before the response was complete"
+                  : "Connection closed before any response");
+}
+
+// Accumulates into line_ up to '\n'; true when a whole line (without CRLF)
+// is available.
+bool HttpResponseParser::appendLine(const char*& data, const char* end) {
+    const char* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<std::size_t>(end - data)));
+    const char* stop = newline != nullptr ? newline : end;
+    line_.append(data, static_cast<std::size_t>(stop - data));
+    if (phase_ == Phase::statusLine || phase_ == Phase::headerLine) {
+        headerBytes_ += static_cast<std::size_t>(stop - data) + (newline != nullptr ? 1 : 0);
+    }
+    data = newline != nullptr ? newline + 1 : end;
+    if (line_.size() > kMaxLineBytes) {
+        fail("Response line too long");
+        return false;
+    }
+    if (headerBytes_ > kMaxHeaderBytes) {
+        fail("Response headers too large");
+        return false;
+    }
+    if (newline == nullptr) {
+        return false;
+    }
+    if (!line_.empty() && line_[line_.size() - 1] == '\r') {
+        line_.resize(line_.size() - 1);
+    }
+    return true;
+}
+
+void HttpResponseParser::onStatusLine() {
+    // HTTP/1.x SP 3DIGIT [SP reason]
+    const std::string& line = line_;
+    if (line.size() < 12 || line.compare(0, 7, "HTTP/1.") != 0 || line[8] != ' ' ||
+        (line.size() > 12 && line[12] != ' ')) {
+        fail("Malformed status line");
+        return;
+    }
+    int status = 0;
+    for (std::size_t i = 9; i < 12; ++i) {
+        if (line[i] < '0' || line[i] > '9') {
+            fail("Malformed status line");
+            return;
+        }
+        status = status * 10 + (line[i] - '0');
+    }
+    http10_ = line[7] == '0';
+    keepAlive_ = !http10_;
+    response_.status = status;
+    line_.clear();
+    phase_ = Phase::headerLine;
+}
+
+void HttpResponseParser::onHeaderLine() {
+    if (line_.empty()) {
+        onHeadersDone();
+        return;
+    }
+    if (line_[0] == ' ' || line_[0] == '\t') {
+        fail("Obsolete header line folding");
+        return;
+    }
+    const std::size_t colon = line_.find(':');
+    if (colon == std::string::npos || colon == 0) {
+        fail("Malformed header line");
+        return;
+    }
+    std::string name = line_.substr(0, colon);
+    std::size_t first = colon + 1;
+    std::size_t last = line_.size();
+    while (first < last && (line_[first] == ' ' || line_[first] == '\t')) {
+        ++first;
+    }
+    while (last > first && (line_[last - 1] == ' ' || line_[last - 1] == '\t')) {
+        --last;
+    }
+    std::string value = line_.substr(first, last - first);
+    line_.clear();
+
+    if (equalsIgnoreCase(name, "content-length")) {
+        std::uint64_t length = 0;
+        if (!parseDecimal(value, length) || (hasLength_ && length != remaining_)) {
+            fail("Invalid Content-Length");
+            return;
+        }
+        hasLength_ = true;
+        remaining_ = length;
+    } else if (equalsIgnoreCase(name, "transfer-encoding")) {
+        chunked_ = listContains(value, "chunked");
+    } else if (equalsIgnoreCase(name, "connection")) {
+        if (listContains(value, "close")) {
+            keepAlive_ = false;
+        } else if (listContains(value, "keep-alive")) {
+            keepAlive_ = true;
+        }
+    }
+    response_.headers.add(name, std::move(value));
+}
+
+void HttpResponseParser::onHeadersDone() {
+    const int status = response_.status;
+    if (status >= 100 && status < 200 && status != 101) {
+        // Interim response (100 Continue, 103 Early Hints): the real one follows.
+        const bool head = headRequest_;
+        reset(head);
+        started_ = true;
+        return;
+    }
+    if (headRequest_ || status == 101 || status == 204 || status == 304) {
+        finish();
+        return;
+    }
+    if (chunked_) {
+        phase_ = Phase::chunkSize; // chunked wins over Content-Length
+        return;
+    }
+    if (hasLength_) {
+        if (remaining_ == 0) {
+            finish();
+            return;
+        }
+        response_.body.reserve(static_cast<std::size_t>(std::min(remaining_, kMaxReserve)));
+        phase_ = Phase::fixedBody;
+        return;
+    }
+    keepAlive_ = false; // delimited by the server closing the connection
+    phase_ = Phase::untilClose;
+}
+
+void HttpResponseParser::onChunkSizeLine() {
+    std::uint64_t size = 0;
+    std::size_t digits = 0;
+    for (char c : line_) {
+        int value;
+        if (c >= '0' && c <= '9') {
+            value = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            value = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            value = c - 'A' + 10;
+        } else {
+            break; // chunk extensions (";name=value") and whitespace are ignored
+        }
+        if (++digits > 15) {
+            fail("Chunk size too large");
+            return;
+        }
+        size = size * 16 + static_cast<std::uint64_t>(value);
+    }
+    if (digits == 0) {
+        fail("Malformed chunk size");
+        return;
+    }
+    line_.clear();
+    if (size == 0) {
+        phase_ = Phase::trailerLine;
+        return;
+    }
+    remaining_ = size;
+    phase_ = Phase::chunkData;
+}
+
+void HttpResponseParser::fail(const std::string& message) {
+    state_ = State::failed;
+    error_ = message;
+    keepAlive_ = false;
+}
+
+void HttpResponseParser::finish() {
+    state_ = State::complete;
+    phase_ = Phase::done;
+    line_.clear();
+}
+
+} // namespace core
@@ -0,0 +1,99 @@
+//
+//  HttpResponseParser.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Incremental HTTP/1.1 response parser for non-blocking transports: feed()
+//  it bytes as they arrive, in pieces of any size, and it fills an
+//  HttpResponse. Handles Content-Length, chunked transfer coding (trailers
+//  are read and dropped), bodies delimited by connection close, bodiless
+//  responses (HEAD, 204, 304) and interim 1xx responses, which are skipped.
+//
+//  No I/O and no platform types; the only allocations are the response
+//  itself and one line buffer.
+//
+
+#ifndef PUREMVC_CORE_HTTP_RESPONSE_PARSER_HPP
+#define PUREMVC_CORE_HTTP_RESPONSE_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Infrastructure/Http/HttpTypes.hpp"
+
+namespace core {
+
+class HttpResponseParser {
+public:
+    enum class State { incomplete, complete, failed };
+
+    // Longest status, header, chunk-size or trailer line, and the most
+    // header bytes in one response. Beyond these the response is refused.
+    static const std::size_t kMaxLineBytes = 8 * 1024;
+    static const std::size_t kMaxHeaderBytes = 64 * 1024;
+
+    HttpResponseParser() { reset(false); }
+
+    // Starts a new response. A reply to HEAD has no body whatever its
+    // headers say.
+    void reset(bool headRequest);
+
+    // Consumes bytes up to the end of the current response and returns how
+    // many were used. Anything after that belongs to the next response.
+    std::size_t feed(const char* data, std::size_t size);
+
+    // The peer closed the connection: completes a close-delimited body and
+    // fails a response that was cut short.
+    void finishOnClose();
+
+    State state() const { return state_; }
+    bool complete() const { return state_ == State::complete; }
+    bool failed() const { return state_ == State::failed; }
+    const std::string& error() const { return error_; }
+
+    // Whether the connection may carry another request once complete.
+    bool keepAlive() const { return keepAlive_; }
+
+    // True once any byte of a response has been consumed.
+    bool started() const { return started_; }
+
+    HttpResponse& response() { return response_; }
+
+private:
+    enum class Phase {
+        statusLine,
+        headerLine,
+        fixedBody,
+        chunkSize,
+        chunkData,
+        chunkDataEnd,
+        trailerLine,
+        untilClose,
+        done,
+    };
+
+    bool appendLine(const char*& data, const char* end);
+    void onStatusLine();
+    void onHeaderLine();
+    void onHeadersDone();
+    void onChunkSizeLine();
+    void fail(const std::string& message);
+    void finish();
+
+    HttpResponse response_;
+    State state_ = State::incomplete;
+    Phase phase_ = Phase::statusLine;
+    std::string error_;
+    std::string line_;
+    bool headRequest_ = false;
+    bool started_ = false;
+    bool keepAlive_ = true;
+    bool http10_ = false;
+    bool chunked_ = false;
+    bool hasLength_ = false;
+    std::uint64_t remaining_ = 0;
+    std::size_t headerBytes_ = 0;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HTTP_RESPONSE_PARSER_HPP
@@ -9,23 +9,26 @@
 #ifndef PUREMVC_CORE_HTTP_TYPES_HPP
 #define PUREMVC_CORE_HTTP_TYPES_HPP
 
-#include <map>
 #include <string>
+#include "Domain/Async/TaskPriority.hpp"
+#include "Infrastructure/Http/HttpHeaders.hpp"
 
 namespace core {
 
 struct HttpRequest {
     std::string method;                       // "GET", "POST", ...
     std::string path;                         // e.g. "/api/v1/auth/login"
-    std::map<std::string, std::string> headers;
+    HttpHeaders headers;
     std::string body;
     std::string contentType = "application/json";
+    // Executor lane for the blocking transfer (see PriorityExecutor).
+    TaskPriority priority = TaskPriority::normal;
 };
 
 struct HttpResponse {
     int status = 0;                           // HTTP status; 0 when unreachable
     std::string body;
-    std::map<std::string, std::string> headers;
+    HttpHeaders headers;
 
     // Set when the request never produced an HTTP status (DNS failure, timeout,
     // TLS error, ...). Distinguishes "couldn't connect" from "server said 4xx".
@@ -37,6 +40,15 @@ struct HttpResponse {
     }
 };
 
+// A response for a request that never got an HTTP status, as every client
+// reports one.
+inline HttpResponse transportFailure(const std::string& message) {
+    HttpResponse response;
+    response.transportError = true;
+    response.transportErrorMessage = message;
+    return response;
+}
+
 } // namespace core
 
 #endif // PUREMVC_CORE_HTTP_TYPES_HPP
@@ -3,176 +3,929 @@
 //  PureMVC Core — Infrastructure
 //
 //  NOTE: To enable HTTPS, the build must define CPPHTTPLIB_OPENSSL_SUPPORT
-//  before this include and link OpenSSL (done in the iOS target). The host test
-//  build compiles plain HTTP only; SSL paths are guarded out below.
+//  before this include and link OpenSSL (done in the iOS target and the host
+//  CMake build). Without it, SSL paths are guarded out below.
+//
+//  Each pooled connection is one httplib client object with keep-alive on:
+//  httplib serialises requests per object and reconnects it transparently, so
+//  the pool only decides which object a request borrows and when one is
+//  discarded.
 //
 
 #include "Infrastructure/Http/HttplibHttpClient.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
 #include <httplib.h>
 
-#include "Infrastructure/Security/Base64.hpp"
+#include "Infrastructure/Http/ContentCoding.hpp"
+#include "Infrastructure/Http/DnsCache.hpp"
+#include "Infrastructure/Http/HappyEyeballs.hpp"
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
 #include "Infrastructure/Security/CertificatePinner.hpp"
 
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
-#include <openssl/sha.h>
-#include <openssl/crypto.h>
+#include "Infrastructure/Http/TlsVerification.hpp"
 #endif
 
 namespace core {
 namespace {
 
+// Per-client TLS state shared by all of the client's connections: the trust
+// store (parsed once, swapped by reloadTrustStore), the pins and the handshake
+// counters. OpenSSL callbacks reach it through each connection's SSL_CTX
+// ex_data.
+class TlsContext {
+public:
+    explicit TlsContext(const HttpClientConfig& config);
+    ~TlsContext();
+
+    TlsContext(const TlsContext&) = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-// base64(SHA-256(SubjectPublicKeyInfo DER)) for the given certificate, or "" on
-// failure. This is the value compared against the configured pins.
-std::string computeSpkiSha256Base64(X509* cert) {
-    X509_PUBKEY* pubkey = X509_get_X509_PUBKEY(cert); // internal pointer, do not free
-    unsigned char* der = nullptr;
-    int len = i2d_X509_PUBKEY(pubkey, &der);
-    if (len <= 0 || der == nullptr) {
-        return std::string();
-    }
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256(der, static_cast<size_t>(len), hash);
-    OPENSSL_free(der);
-    return base64Encode(hash, SHA256_DIGEST_LENGTH);
-}
+    // Points a new connection's SSL_CTX at the shared store and callbacks.
+    void configure(SSL_CTX* ctx);
+    bool hasTrustStore() const;
+#endif
+    bool reloadTrustStore();
+
+    // Bumped by every successful reload; older connections are retired.
+    std::uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+    const std::string host;
+    const int port;
+    const bool resume; // verifying clients only: they store and offer sessions
+    const bool verify;
+    const std::string caCertPath;
+    const CertificatePinner pinner;
+    std::atomic<std::uint64_t> full{0};
+    std::atomic<std::uint64_t> resumed{0};
+
+private:
+    std::atomic<std::uint64_t> generation_{0};
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    mutable std::mutex storeMutex_;
+    X509_STORE* store_ = nullptr; // one reference; each SSL_CTX holds its own
 #endif
+};
 
-httplib::Headers mergeHeaders(const std::map<std::string, std::string>& defaults,
-                              const HttpRequest& request) {
-    httplib::Headers headers;
-    for (const auto& kv : defaults) {
-        headers.emplace(kv.first, kv.second);
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+// Client sessions for every origin in the process, least recently stored
+// first out once kCapacity is reached. Holds one SSL_SESSION reference each.
+class TlsSessionCache {
+public:
+    static TlsSessionCache& shared() {
+        static TlsSessionCache cache;
+        return cache;
     }
-    // Per-request headers take precedence.
-    for (const auto& kv : request.headers) {
-        headers.erase(kv.first);
-        headers.emplace(kv.first, kv.second);
+
+    ~TlsSessionCache() { clear(); }
+
+    // Adopts the caller's reference.
+    void put(const std::string& key, SSL_SESSION* session) {
+        SSL_SESSION* replaced = nullptr;
+        SSL_SESSION* evicted = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto found = index_.find(key);
+            if (found != index_.end()) {
+                replaced = found->second->second;
+                entries_.erase(found->second);
+                index_.erase(found);
+            } else if (entries_.size() >= kCapacity) {
+                evicted = entries_.front().second;
+                index_.erase(entries_.front().first);
+                entries_.pop_front();
+            }
+            entries_.emplace_back(key, session);
+            index_[key] = std::prev(entries_.end());
+        }
+        SSL_SESSION_free(replaced); // null-safe
+        SSL_SESSION_free(evicted);
+    }
+
+    // A new reference, or null. TLS 1.3 tickets are single-use (RFC 8446
+    // C.4), so those leave the cache; the resumed connection brings new ones.
+    SSL_SESSION* take(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = index_.find(key);
+        if (found == index_.end()) {
+            return nullptr;
+        }
+        SSL_SESSION* session = found->second->second;
+        if (SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION) {
+            entries_.erase(found->second);
+            index_.erase(found);
+        } else {
+            SSL_SESSION_up_ref(session);
+        }
+        return session;
     }
-    return headers;
+
+    void erase(const std::string& key) {
+        SSL_SESSION* session = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto found = index_.find(key);
+            if (found == index_.end()) {
+                return;
+            }
+            session = found->second->second;
+            entries_.erase(found->second);
+            index_.erase(found);
+        }
+        SSL_SESSION_free(session);
+    }
+
+    void clear() {
+        std::list<Entry> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dropped.swap(entries_);
+            index_.clear();
+        }
+        for (Entry& entry : dropped) {
+            SSL_SESSION_free(entry.second);
+        }
+    }
+
+private:
+    using Entry = std::pair<std::string, SSL_SESSION*>;
+    static const std::size_t kCapacity = 256;
+
+    std::mutex mutex_;
+    std::list<Entry> entries_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+int contextIndex() {
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
 }
 
-HttpResponse toResponse(const httplib::Result& result) {
-    HttpResponse response;
-    if (!result) {
-        response.transportError = true;
-        response.status = 0;
-        response.transportErrorMessage =
-            "Network error: " + httplib::to_string(result.error());
-        return response;
+TlsContext* contextFor(const SSL* ssl) {
+    return static_cast<TlsContext*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), contextIndex()));
+}
+
+// host:port/SNI and the trust store the server was verified against.
+// httplib sends the host as SNI, but key on what was actually sent so a
+// session never crosses names, and on the CA bundle so a session verified
+// against one client's private CA is never resumed by a client that does
+// not trust it.
+std::string sessionKey(const TlsContext& tls, const SSL* ssl) {
+    const char* sni = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    return tls.host + ":" + std::to_string(tls.port) + "/" + (sni != nullptr ? sni : "") + " ca=" +
+           (tls.caCertPath.empty() ? std::string("<system>") : tls.caCertPath);
+}
+
+// httplib offers no hook between SSL_new and SSL_connect, but the info
+// callback fires at the start of SSL_connect, before the ClientHello is
+// built: the last moment a session can still be offered. Resumption skips
+// the certificate exchange, so a session is only offered if the certificate
+// it was established with still satisfies this client's pins.
+void onTlsInfo(const SSL* ssl, int where, int /*ret*/) {
+    TlsContext* tls = contextFor(ssl);
+    if (tls == nullptr) {
+        return;
+    }
+    SSL* mutableSsl = const_cast<SSL*>(ssl);
+    if ((where & SSL_CB_HANDSHAKE_START) && tls->resume && SSL_get_session(ssl) == nullptr) {
+        const std::string key = sessionKey(*tls, ssl);
+        SSL_SESSION* session = TlsSessionCache::shared().take(key);
+        if (session != nullptr) {
+            X509* leaf = SSL_SESSION_get0_peer(session);
+            if (leaf != nullptr && spkiPinMatches(tls->pinner, leaf)) {
+                SSL_set_session(mutableSsl, session);
+                SSL_SESSION_free(session);
+            } else {
+                // Another client's policy accepted it; leave it for them.
+                TlsSessionCache::shared().put(key, session);
+            }
+        }
     }
-    response.status = result->status;
-    response.body = result->body;
-    for (const auto& header : result->headers) {
-        response.headers[header.first] = header.second;
+    if (where & SSL_CB_HANDSHAKE_DONE) {
+        std::atomic<std::uint64_t>& counter =
+            SSL_session_reused(mutableSsl) ? tls->resumed : tls->full;
+        counter.fetch_add(1, std::memory_order_relaxed);
     }
-    return response;
 }
 
-// SSLClient and Client share the same request API, so the dispatch is generic.
-template <typename Client>
-HttpResponse dispatch(Client& client, const HttpRequest& request,
-                      const httplib::Headers& headers) {
-    const std::string& method = request.method;
-    const char* path = request.path.c_str();
-    const char* contentType = request.contentType.c_str();
+// Called once the handshake has completed. Installed only on verifying
+// clients, so only sessions with a server that passed verification (against
+// the trust store in the key) and pinning are ever stored.
+int onNewSession(SSL* ssl, SSL_SESSION* session) {
+    TlsContext* tls = contextFor(ssl);
+    if (tls == nullptr || !SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+    TlsSessionCache::shared().put(sessionKey(*tls, ssl), session);
+    return 1; // the cache keeps the reference
+}
+#endif
 
-    if (method == "GET") {
-        return toResponse(client.Get(path, headers));
+TlsContext::TlsContext(const HttpClientConfig& config)
+    : host(config.host),
+      port(config.port),
+      resume(config.tlsSessionResumption && config.useSSL && config.verifySSL),
+      verify(config.useSSL && config.verifySSL),
+      caCertPath(config.caCertPath),
+      pinner(config.pinnedSpkiSha256Base64) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (verify) {
+        store_ = loadTrustStore(caCertPath);
     }
-    if (method == "POST") {
-        return toResponse(client.Post(path, headers, request.body, contentType));
+#endif
+}
+
+TlsContext::~TlsContext() {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    X509_STORE_free(store_); // null-safe
+#endif
+}
+
+bool TlsContext::reloadTrustStore() {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (!verify) {
+        return false;
+    }
+    X509_STORE* loaded = loadTrustStore(caCertPath); // outside the lock: slow
+    if (loaded == nullptr) {
+        return false;
+    }
+    X509_STORE* previous = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex_);
+        previous = store_;
+        store_ = loaded;
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    X509_STORE_free(previous); // connections still using it hold their own reference
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+bool TlsContext::hasTrustStore() const {
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    return store_ != nullptr;
+}
+
+void TlsContext::configure(SSL_CTX* ctx) {
+    SSL_CTX_set_ex_data(ctx, contextIndex(), this);
+    SSL_CTX_set_info_callback(ctx, onTlsInfo);
+    if (resume) {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, onNewSession);
+    }
+    if (!verify) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(storeMutex_);
+        if (store_ != nullptr) {
+            X509_STORE_up_ref(store_);
+            SSL_CTX_set_cert_store(ctx, store_); // adopts the new reference
+        }
     }
-    if (method == "PUT") {
-        return toResponse(client.Put(path, headers, request.body, contentType));
+    requireVerifiedPeer(ctx, host, pinner);
+}
+#endif
+
+httplib::Headers toHeaders(const HttpHeaders& headers) {
+    httplib::Headers converted;
+    for (const auto& header : headers) {
+        converted.emplace(header.name(), header.value);
+    }
+    return converted;
+}
+
+bool isSupportedMethod(const std::string& method) {
+    return method == "GET" || method == "POST" || method == "PUT" || method == "PATCH" ||
+           method == "DELETE";
+}
+
+// The httplib request for 'request', whose path and header values are moved
+// over. Per-request headers take precedence over the defaults. The body
+// stays in 'request' and is written from there by a content provider:
+// httplib copies the whole Request on every send (to replay it on a
+// redirect), which for req.body would mean a copy of the payload per
+// attempt. 'request' must outlive the returned request. GET and DELETE are
+// sent without a body, as before.
+httplib::Request toHttplibRequest(HttpRequest& request, const httplib::Headers& defaults) {
+    httplib::Request req;
+    req.method = request.method;
+    req.path = std::move(request.path);
+    req.headers = defaults;
+    for (auto& header : request.headers) {
+        req.headers.erase(header.name());
+        req.headers.emplace(header.name(), std::move(header.value));
     }
-    if (method == "PATCH") {
-        return toResponse(client.Patch(path, headers, request.body, contentType));
+    if (request.method != "GET" && request.method != "DELETE" && !request.body.empty()) {
+        const std::string* body = &request.body;
+        req.content_length_ = body->size();
+        req.content_provider_ = [body](std::size_t offset, std::size_t length, httplib::DataSink& sink) {
+            return sink.write(body->data() + offset, length);
+        };
+        if (!req.has_header("Content-Type")) { // httplib's default for a body, as before
+            req.set_header("Content-Type", request.contentType.empty() ? std::string("text/plain")
+                                                                       : request.contentType);
+        }
     }
-    if (method == "DELETE") {
-        return toResponse(client.Delete(path, headers));
+    return req;
+}
+
+// One attempt at 'req' (a retry sends the same one again). Buffered, the
+// response takes httplib's body and header values over. Streaming, the body
+// goes to the handler piece by piece, on this thread, as it is read;
+// 'started' is set once the head has been handed over, after which the
+// request must not be retried. With 'decode', a body in a content coding
+// this build has is decoded on the way, whichever of the two it goes to,
+// and loses its Content-Encoding and Content-Length. SSLClient and Client
+// share the same request API, so this is generic.
+template <typename Client>
+HttpResponse exchange(Client& client, httplib::Request& req, const IHttpClient::StreamHandler* stream,
+                      bool decode, bool& started) {
+    HttpResponse head;
+    bool headSeen = false;
+    bool cancelled = false;
+    std::unique_ptr<ContentDecoder> decoder;
+    ContentCoding coding = ContentCoding::identity;
+    bool encodedBytes = false;
+    bool corrupt = false;
+    if (stream != nullptr || decode) {
+        req.response_handler = [&](const httplib::Response& res) {
+            headSeen = true;
+            head.status = res.status;
+            head.headers.reserve(res.headers.size());
+            for (const auto& header : res.headers) {
+                head.headers.add(header.first, header.second);
+            }
+            if (decode && parseContentCoding(head.headers.get(HttpHeader::contentEncoding), coding)) {
+                decoder = ContentDecoder::create(coding);
+                if (decoder) {
+                    head.headers.erase(HttpHeader::contentEncoding);
+                    head.headers.erase(HttpHeader::contentLength);
+                }
+            }
+            if (stream == nullptr) {
+                return true;
+            }
+            started = true;
+            cancelled = stream->onHeaders && !stream->onHeaders(head);
+            return !cancelled;
+        };
+        const ContentDecoder::Sink deliver = [&](const char* data, std::size_t size) {
+            if (stream == nullptr) {
+                head.body.append(data, size);
+                return true;
+            }
+            cancelled = stream->onBody && !stream->onBody(data, size);
+            return !cancelled;
+        };
+        req.content_receiver = [&, deliver](const char* data, std::size_t size, std::uint64_t, std::uint64_t) {
+            if (!decoder) {
+                return deliver(data, size);
+            }
+            encodedBytes = encodedBytes || size > 0;
+            corrupt = !decoder->write(data, size, deliver) && !cancelled;
+            return !corrupt && !cancelled;
+        };
     }
 
-    HttpResponse response;
-    response.transportError = true;
-    response.transportErrorMessage = "Unsupported HTTP method: " + method;
-    return response;
+    httplib::Response res;
+    httplib::Error error = httplib::Error::Success;
+    const bool sent = client.send(req, res, error);
+    if (corrupt || (sent && decoder && encodedBytes && !decoder->finished())) {
+        return transportFailure(std::string("Content decoding failed: bad ") + contentCodingName(coding) + " body");
+    }
+    if (!sent) {
+        return transportFailure(cancelled ? std::string(IHttpClient::streamCancelledMessage())
+                                          : "Network error: " + httplib::to_string(error));
+    }
+    if (headSeen) {
+        return head;
+    }
+    // Buffered without decoding, or a response httplib gives no handler a
+    // look at (204, HEAD).
+    head.status = res.status;
+    head.body = std::move(res.body);
+    head.headers.reserve(res.headers.size());
+    for (auto& header : res.headers) {
+        head.headers.add(header.first, std::move(header.second));
+    }
+    return head;
 }
 
 template <typename Client>
 void configure(Client& client, const HttpClientConfig& config) {
     client.set_connection_timeout(config.connectionTimeoutSec, 0);
     client.set_read_timeout(config.readTimeoutSec, 0);
+    client.set_keep_alive(config.maxIdleConnections > 0);
+    // Bodies are decoded by exchange(), for the codings this build has;
+    // httplib's own decoding fails every coding it was built without.
+    client.set_decompress(false);
+    // httplib writes headers and body in separate sends. On a reused
+    // connection Nagle holds the second one back until the peer's delayed
+    // ACK (~40 ms), which would cost more than the handshake pooling saves.
+    client.set_tcp_nodelay(true);
 }
 
-HttpResponse perform(const HttpClientConfig& config, const HttpRequest& request) {
-    const httplib::Headers headers = mergeHeaders(config.defaultHeaders, request);
+// Chooses the address new connections go to. httplib would resolve the host
+// itself on every connect and try its addresses one at a time, and its TLS
+// client cannot be handed a connected socket. So addresses come from the
+// DnsCache, several are raced here (happy eyeballs) with the winning probe
+// closed at once, and connections are pointed at the winner until the DNS
+// answer drops it or a new connection to it fails: one extra handshake per
+// answer rather than per connection.
+class AddressPicker {
+public:
+    AddressPicker(const HttpClientConfig& config, DnsCache& dns) : config_(config), dns_(dns) {}
+
+    AddressPicker(const AddressPicker&) = delete;
+    AddressPicker& operator=(const AddressPicker&) = delete;
+
+    // A numeric IP for config.host, or false with 'error' set.
+    bool pick(std::string& ip, std::string& error) {
+        std::vector<SocketAddress> addresses;
+        if (!dns_.resolve(config_.host, config_.port, addresses, error)) {
+            return false;
+        }
+        if (addresses.size() == 1) {
+            ip = addresses.front().ip();
+            return true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const SocketAddress& address : addresses) {
+                if (!winner_.empty() && address.ip() == winner_) {
+                    ip = winner_;
+                    return true;
+                }
+            }
+        }
+        RacedConnection raced = happyEyeballsConnect(addresses, std::chrono::milliseconds(config_.happyEyeballsDelayMs),
+                                                     std::chrono::seconds(config_.connectionTimeoutSec));
+        if (raced.fd < 0) {
+            error = raced.error;
+            return false;
+        }
+        ::close(raced.fd);
+        ip = raced.address.ip();
+        std::lock_guard<std::mutex> lock(mutex_);
+        winner_ = ip;
+        return true;
+    }
 
+    void forget(const std::string& ip) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (winner_ == ip) {
+            winner_.clear();
+        }
+    }
+
+private:
+    const HttpClientConfig& config_;
+    DnsCache& dns_;
+    std::mutex mutex_;
+    std::string winner_; // empty: race again
+};
+
+// A new, not yet connected client for 'ip'; httplib connects on the first
+// request. Host header, SNI and certificate checks still use config.host.
+std::unique_ptr<httplib::ClientImpl> makeConnection(const HttpClientConfig& config,
+                                                    TlsContext& tls, const std::string& ip) {
+    std::map<std::string, std::string> addresses;
+    addresses[config.host] = ip;
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
     if (config.useSSL) {
-        httplib::SSLClient client(config.host, config.port);
-        client.enable_server_certificate_verification(config.verifySSL);
-        if (!config.caCertPath.empty()) {
-            client.set_ca_cert_path(config.caCertPath);
-        }
-
-        CertificatePinner pinner(config.pinnedSpkiSha256Base64);
-        if (pinner.enabled()) {
-            client.set_server_certificate_verifier(
-                [pinner](SSL* ssl) -> httplib::SSLVerifierResponse {
-                    // SSL_get1_peer_certificate is OpenSSL 3.0+; 1.1.1 (e.g. the
-                    // Android NDK prefab) uses SSL_get_peer_certificate. Both
-                    // return an owned cert that must be X509_free'd.
-#if OPENSSL_VERSION_NUMBER >= 0x30000000L
-                    X509* cert = SSL_get1_peer_certificate(ssl);
-#else
-                    X509* cert = SSL_get_peer_certificate(ssl);
-#endif
-                    if (cert == nullptr) {
-                        return httplib::SSLVerifierResponse::CertificateRejected;
-                    }
-                    const std::string pin = computeSpkiSha256Base64(cert);
-                    X509_free(cert);
-                    if (pin.empty() || !pinner.isTrusted(pin)) {
-                        return httplib::SSLVerifierResponse::CertificateRejected;
-                    }
-                    // Pin matches; defer to the built-in chain/host verifier.
-                    return httplib::SSLVerifierResponse::NoDecisionMade;
-                });
-        }
-
-        configure(client, config);
-        return dispatch(client, request, headers);
+        httplib::SSLClient* client = new httplib::SSLClient(config.host, config.port);
+        std::unique_ptr<httplib::ClientImpl> owner(client);
+        // httplib's own verification would load the CA bundle into every
+        // connection's SSL_CTX on its first handshake. OpenSSL verifies
+        // during the handshake instead, against the client's shared store.
+        client->enable_server_certificate_verification(false);
+        tls.configure(client->ssl_context());
+        client->set_hostname_addr_map(std::move(addresses));
+        configure(*client, config);
+        return owner;
     }
 #else
-    if (config.useSSL) {
-        HttpResponse response;
-        response.transportError = true;
-        response.transportErrorMessage = "SSL not supported in this build";
-        return response;
-    }
+    (void)tls;
 #endif
+    std::unique_ptr<httplib::ClientImpl> client(
+        new httplib::ClientImpl(config.host, config.port));
+    client->set_hostname_addr_map(std::move(addresses));
+    configure(*client, config);
+    return client;
+}
 
-    httplib::Client client(config.host, config.port);
-    configure(client, config);
-    return dispatch(client, request, headers);
+// An idle HTTP/1.1 connection has nothing to read, so any readiness (data,
+// EOF, reset) means the server closed it or is about to.
+bool peerClosed(const httplib::ClientImpl& connection) {
+    if (!connection.is_socket_open()) {
+        return true;
+    }
+    pollfd entry;
+    entry.fd = connection.socket();
+    entry.events = POLLIN;
+    entry.revents = 0;
+    return ::poll(&entry, 1, 0) != 0;
 }
 
+// Keep-alive connections to the client's one host:port. acquire() hands out
+// the most recently used idle connection (so the rest age out under light
+// load) or opens a new one, waiting while maxConnectionsPerHost are open.
+// Expired idle connections, and those set up before a trust store reload,
+// are closed lazily on acquire/release; sockets are always closed outside
+// the lock.
+class ConnectionPool {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Connection = std::unique_ptr<httplib::ClientImpl>;
+
+    struct Lease {
+        Lease() : reused(false), generation(0) {}
+        Lease(Connection c, bool r, std::uint64_t g)
+            : connection(std::move(c)), reused(r), generation(g) {}
+        Connection connection; // null: 'error' says why, or else the cap stayed
+                               // reached until the timeout
+        bool reused;
+        std::uint64_t generation; // TlsContext::generation() it was set up under
+        std::string address;      // the IP a new connection was pointed at
+        std::string error;
+    };
+
+    ConnectionPool(const HttpClientConfig& config, TlsContext& tls, AddressPicker& picker)
+        : config_(config), tls_(tls), picker_(picker) {}
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // allowReuse = false forces a fresh connection, evicting an idle one if
+    // that is what it takes to stay under the cap.
+    Lease acquire(bool allowReuse) {
+        std::vector<Connection> closing; // declared first: destroyed after unlock
+        std::unique_lock<std::mutex> lock(mutex_);
+        const Clock::time_point deadline =
+            Clock::now() + std::chrono::seconds(config_.connectionTimeoutSec);
+        for (;;) {
+            pruneExpired(Clock::now(), closing);
+            while (allowReuse && !idle_.empty()) {
+                Idle entry = std::move(idle_.back());
+                idle_.pop_back();
+                Connection& connection = entry.connection;
+                if (!peerClosed(*connection)) {
+                    ++stats_.reused;
+                    return Lease(std::move(connection), true, entry.generation);
+                }
+                ++stats_.stale;
+                --open_;
+                closing.push_back(std::move(connection));
+            }
+            if (!atCap()) {
+                ++open_; // held while the address is picked, which may block
+                lock.unlock();
+                Lease lease;
+                const bool picked = picker_.pick(lease.address, lease.error);
+                lock.lock();
+                if (!picked) {
+                    --open_;
+                    slotFreed_.notify_one();
+                    return lease;
+                }
+                ++stats_.opened;
+                lock.unlock();
+                lease.generation = tls_.generation(); // read before setup
+                lease.connection = makeConnection(config_, tls_, lease.address);
+                return lease;
+            }
+            if (!allowReuse && !idle_.empty()) {
+                closeOldestIdle(closing);
+                continue;
+            }
+            if (slotFreed_.wait_until(lock, deadline) == std::cv_status::timeout) {
+                return Lease();
+            }
+        }
+    }
+
+    // Parks the connection for reuse, or closes it if it failed, the server
+    // asked to close it, or the trust store has been reloaded since.
+    void release(Lease lease, bool reusable) {
+        std::vector<Connection> closing;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (reusable && config_.maxIdleConnections > 0 &&
+                lease.generation == tls_.generation() && lease.connection->is_socket_open()) {
+                Idle entry;
+                entry.connection = std::move(lease.connection);
+                entry.since = Clock::now();
+                entry.generation = lease.generation;
+                idle_.push_back(std::move(entry));
+                pruneExpired(Clock::now(), closing);
+            } else {
+                --open_;
+                closing.push_back(std::move(lease.connection));
+            }
+        }
+        slotFreed_.notify_one();
+    }
+
+    void closeIdle() {
+        std::vector<Connection> closing;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (!idle_.empty()) {
+                closeOldestIdle(closing);
+            }
+        }
+        slotFreed_.notify_all();
+    }
+
+    void noteRetry() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.retried;
+    }
+
+    ConnectionPoolStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ConnectionPoolStats snapshot = stats_;
+        snapshot.open = open_;
+        snapshot.idle = idle_.size();
+        snapshot.fullHandshakes = tls_.full.load(std::memory_order_relaxed);
+        snapshot.resumedHandshakes = tls_.resumed.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+private:
+    struct Idle {
+        Connection connection;
+        Clock::time_point since;
+        std::uint64_t generation;
+    };
+
+    bool atCap() const {
+        return config_.maxConnectionsPerHost != 0 && open_ >= config_.maxConnectionsPerHost;
+    }
+
+    void closeOldestIdle(std::vector<Connection>& closing) {
+        closing.push_back(std::move(idle_.front().connection));
+        idle_.pop_front();
+        --open_;
+        ++stats_.expired;
+    }
+
+    // Oldest connections sit at the front, and a reload outdates them all.
+    void pruneExpired(Clock::time_point now, std::vector<Connection>& closing) {
+        const Clock::duration timeout = std::chrono::seconds(config_.idleTimeoutSec);
+        const std::uint64_t generation = tls_.generation();
+        while (!idle_.empty() &&
+               (idle_.size() > config_.maxIdleConnections || now - idle_.front().since >= timeout ||
+                idle_.front().generation != generation)) {
+            closeOldestIdle(closing);
+        }
+    }
+
+    const HttpClientConfig& config_;
+    TlsContext& tls_;
+    AddressPicker& picker_;
+    mutable std::mutex mutex_;
+    std::condition_variable slotFreed_;
+    std::deque<Idle> idle_;
+    std::size_t open_ = 0;
+    ConnectionPoolStats stats_;
+};
+
 } // namespace
 
+struct HttplibHttpClient::State {
+    explicit State(HttpClientConfig c)
+        : config(std::move(c)), defaultHeaders(toHeaders(config.defaultHeaders)),
+          acceptEncoding(acceptEncodingValue(config.acceptEncodings)),
+          dns(config.dnsCache ? config.dnsCache : DnsCache::shared()), picker(config, *dns), tls(config),
+          pool(config, tls, picker) {}
+
+    // Applies the configured content codings to 'request', unless it chose
+    // its own. Returns whether the response body is to be decoded.
+    bool encode(HttpRequest& request) const {
+        const bool offer = !acceptEncoding.empty() && !request.headers.contains(HttpHeader::acceptEncoding) &&
+                           !config.defaultHeaders.contains(HttpHeader::acceptEncoding);
+        if (offer) {
+            request.headers.set(HttpHeader::acceptEncoding, acceptEncoding);
+        }
+        if (config.requestEncoding != ContentCoding::identity && request.body.size() > config.compressRequestsAbove &&
+            request.method != "GET" && request.method != "DELETE" &&
+            !request.headers.contains(HttpHeader::contentEncoding)) {
+            std::string compressed;
+            if (compressContent(config.requestEncoding, request.body, compressed) &&
+                compressed.size() < request.body.size()) {
+                request.body.swap(compressed);
+                request.headers.set(HttpHeader::contentEncoding, contentCodingName(config.requestEncoding));
+            }
+        }
+        return offer;
+    }
+
+    // 'stream' null: buffered. Consumes 'request'.
+    HttpResponse perform(HttpRequest& request, const IHttpClient::StreamHandler* stream) {
+#ifndef CPPHTTPLIB_OPENSSL_SUPPORT
+        if (config.useSSL) {
+            return transportFailure("SSL not supported in this build");
+        }
+#endif
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        if (tls.verify && !tls.hasTrustStore()) {
+            return transportFailure(config.caCertPath.empty()
+                ? std::string("Cannot load the system CA certificates")
+                : "Cannot load CA certificates from " + config.caCertPath);
+        }
+#endif
+        if (!isSupportedMethod(request.method)) {
+            return transportFailure("Unsupported HTTP method: " + request.method);
+        }
+        const bool decode = encode(request);
+        httplib::Request req = toHttplibRequest(request, defaultHeaders);
+        bool started = false; // streamed bytes cannot be taken back by a retry
+        auto attempt = [&](httplib::ClientImpl& connection) {
+            return exchange(connection, req, stream, decode, started);
+        };
+
+        ConnectionPool::Lease lease = pool.acquire(true);
+        if (!lease.connection) {
+            return noConnection(lease);
+        }
+        HttpResponse response = attempt(*lease.connection);
+        if (response.transportError && lease.reused && !started && isIdempotentMethod(request.method)) {
+            // The server may close an idle connection just after the liveness
+            // check (its keep-alive timeout racing ours). Not the request's
+            // fault, so give it one fresh connection.
+            pool.release(std::move(lease), false);
+            pool.noteRetry();
+            lease = pool.acquire(false);
+            if (!lease.connection) {
+                return noConnection(lease);
+            }
+            response = attempt(*lease.connection);
+        }
+        if (response.transportError && !lease.reused && !started) {
+            picker.forget(lease.address); // maybe unreachable now: race again next time
+        }
+        pool.release(std::move(lease), !response.transportError);
+        return response;
+    }
+
+    static HttpResponse noConnection(const ConnectionPool::Lease& lease) {
+        return transportFailure(lease.error.empty()
+            ? std::string("Connection pool exhausted: no connection freed in time")
+            : lease.error);
+    }
+
+    // The answer for a request whose task the executor destroyed unrun.
+    static HttpResponse droppedUnrun() {
+        const char* reason = IExecutor::Rejection::current();
+        return transportFailure(reason
+            ? std::string("Request rejected: ") + reason
+            : std::string("Request dropped: the executor discarded it without running it"));
+    }
+
+    // The executor hop for one request. Keeps the shared state alive, so it
+    // does not depend on the client's lifetime. Answers its callback exactly
+    // once: with the transfer's result, or with a transportError if the
+    // executor destroys it without running it (see IExecutor).
+    struct SendTask {
+        SendTask(std::shared_ptr<State> s, HttpRequest r, IHttpClient::Callback cb)
+            : state(std::move(s)), request(std::move(r)), callback(std::move(cb)) {}
+
+        SendTask(SendTask&& other) noexcept
+            : state(std::move(other.state)),
+              request(std::move(other.request)),
+              callback(std::move(other.callback)) {
+            other.callback = nullptr;
+        }
+        SendTask& operator=(SendTask&&) = delete;
+
+        ~SendTask() {
+            if (callback) {
+                callback(droppedUnrun());
+            }
+        }
+
+        void operator()() {
+            IHttpClient::Callback done = std::move(callback);
+            callback = nullptr;
+            done(state->perform(request, nullptr));
+        }
+
+        std::shared_ptr<State> state;
+        HttpRequest request;
+        IHttpClient::Callback callback;
+    };
+
+    static_assert(Task::fitsInline<SendTask>(),
+                  "SendTask must fit Task's inline buffer so send() does not allocate");
+
+    // SendTask for sendStreaming(): the handler's callbacks run on the
+    // executor thread doing the transfer.
+    struct StreamTask {
+        StreamTask(std::shared_ptr<State> s, HttpRequest r, IHttpClient::StreamHandler h)
+            : state(std::move(s)), request(std::move(r)), handler(std::move(h)), pending(true) {}
+
+        StreamTask(StreamTask&& other) noexcept
+            : state(std::move(other.state)),
+              request(std::move(other.request)),
+              handler(std::move(other.handler)),
+              pending(other.pending) {
+            other.pending = false;
+        }
+        StreamTask& operator=(StreamTask&&) = delete;
+
+        ~StreamTask() {
+            if (pending && handler.onComplete) {
+                handler.onComplete(droppedUnrun());
+            }
+        }
+
+        void operator()() {
+            pending = false;
+            const HttpResponse response = state->perform(request, &handler);
+            if (handler.onComplete) {
+                handler.onComplete(response);
+            }
+        }
+
+        std::shared_ptr<State> state;
+        HttpRequest request;
+        IHttpClient::StreamHandler handler;
+        bool pending; // onComplete still owed
+    };
+
+    static_assert(Task::fitsInline<StreamTask>(),
+                  "StreamTask must fit Task's inline buffer so sendStreaming() does not allocate");
+
+    const HttpClientConfig config;
+    const httplib::Headers defaultHeaders; // built once, copied into each request
+    const std::string acceptEncoding;      // empty: none offered
+    const std::shared_ptr<DnsCache> dns;
+    AddressPicker picker;
+    TlsContext tls; // before pool: outlives the connections that point at it
+    ConnectionPool pool;
+};
+
 HttplibHttpClient::HttplibHttpClient(HttpClientConfig config, IExecutor& executor)
-    : config_(std::move(config)), executor_(executor) {}
+    : state_(std::make_shared<State>(std::move(config))), executor_(executor) {}
 
 void HttplibHttpClient::send(const HttpRequest& request, Callback callback) {
-    const HttpClientConfig config = config_;
-    HttpRequest requestCopy = request;
-    executor_.run([config, requestCopy, callback]() {
-        callback(perform(config, requestCopy));
-    });
+    executor_.run(State::SendTask(state_, request, std::move(callback)), request.priority);
+}
+
+void HttplibHttpClient::send(HttpRequest&& request, Callback callback) {
+    const TaskPriority priority = request.priority;
+    executor_.run(State::SendTask(state_, std::move(request), std::move(callback)), priority);
+}
+
+void HttplibHttpClient::sendStreaming(const HttpRequest& request, StreamHandler handler) {
+    executor_.run(State::StreamTask(state_, request, std::move(handler)), request.priority);
+}
+
+void HttplibHttpClient::sendStreaming(HttpRequest&& request, StreamHandler handler) {
+    const TaskPriority priority = request.priority;
+    executor_.run(State::StreamTask(state_, std::move(request), std::move(handler)), priority);
+}
+
+ConnectionPoolStats HttplibHttpClient::poolStats() const {
+    return state_->pool.stats();
+}
+
+void HttplibHttpClient::closeIdleConnections() {
+    state_->pool.closeIdle();
+}
+
+bool HttplibHttpClient::reloadTrustStore() {
+    return state_->tls.reloadTrustStore();
+}
+
+void HttplibHttpClient::clearTlsSessionCache() {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    TlsSessionCache::shared().clear();
+#endif
 }
 
 } // namespace core
@@ -10,10 +10,25 @@
 //  concurrency policy (thread-per-request, pool, GCD, or synchronous in tests)
 //  is chosen from the outside.
 //
+//  Connections are kept alive and reused across requests (see the pool
+//  settings in HttpClientConfig). Before an idle connection is handed out it
+//  is checked for a peer close; an idempotent request (GET, PUT, DELETE) that
+//  still fails on a reused connection is retried once on a fresh one.
+//
+//  New HTTPS connections resume a cached TLS session when one is available
+//  (HttpClientConfig::tlsSessionResumption). The cache is process-wide, so
+//  clients for the same origin share sessions.
+//
+//  The CA bundle (caCertPath, or the system locations) is parsed once per
+//  client into a trust store shared by all of its connections.
+//
 
 #ifndef PUREMVC_CORE_HTTPLIB_HTTP_CLIENT_HPP
 #define PUREMVC_CORE_HTTPLIB_HTTP_CLIENT_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include "Domain/Ports/IExecutor.hpp"
 #include "Infrastructure/Http/HttpClientConfig.hpp"
 #include "Infrastructure/Http/IHttpClient.hpp"
@@ -24,10 +39,39 @@ class HttplibHttpClient : public IHttpClient {
 public:
     HttplibHttpClient(HttpClientConfig config, IExecutor& executor);
 
+    // The request travels to the executor by value: copied once from an
+    // lvalue, moved from an rvalue (then on into httplib, body included).
+    using IHttpClient::send;
     void send(const HttpRequest& request, Callback callback) override;
+    void send(HttpRequest&& request, Callback callback) override;
+
+    // The body reaches handler.onBody as httplib reads it, on the executor
+    // thread doing the transfer; the connection is not read ahead of the
+    // handler. A request whose head was delivered is never retried.
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override;
+    void sendStreaming(HttpRequest&& request, StreamHandler handler) override;
+
+    ConnectionPoolStats poolStats() const;
+
+    // Closes every idle connection now (e.g. when the app is backgrounded).
+    // Requests in flight keep theirs.
+    void closeIdleConnections();
+
+    // Re-reads the CA bundle into a new trust store for connections opened
+    // from now on. Requests in flight finish on the store they started with;
+    // idle connections set up under the old one are retired. Returns false
+    // (keeping the current store) if the bundle cannot be loaded, or for
+    // plain HTTP / verifySSL == false.
+    bool reloadTrustStore();
+
+    // Forgets every cached TLS session, for all clients (e.g. after a pin
+    // rotation or on sign-out). Established connections are unaffected.
+    static void clearTlsSessionCache();
 
 private:
-    HttpClientConfig config_;
+    struct State; // config + connection pool, shared with in-flight requests
+
+    std::shared_ptr<State> state_;
     IExecutor& executor_;
 };
 
@@ -10,7 +10,11 @@
 #ifndef PUREMVC_CORE_IHTTP_CLIENT_HPP
 #define PUREMVC_CORE_IHTTP_CLIENT_HPP
 
+#include <cstddef>
 #include <functional>
+#include <string>
+#include <utility>
+#include "Domain/Async/Future.hpp"
 #include "HttpTypes.hpp"
 
 namespace core {
@@ -22,7 +26,84 @@ public:
 
     virtual void send(const HttpRequest& request, Callback callback) = 0;
 
+    // For a request the caller is done with: implementations that keep the
+    // request past the call take its buffers over instead of copying them.
+    virtual void send(HttpRequest&& request, Callback callback) {
+        send(static_cast<const HttpRequest&>(request), std::move(callback));
+    }
+
+    // Future-returning forms over the callback ones. Implementations that
+    // override send() re-expose them with `using IHttpClient::send;`.
+    Future<HttpResponse> send(const HttpRequest& request) {
+        Promise<HttpResponse> promise;
+        Future<HttpResponse> future = promise.getFuture();
+        send(request, [promise](const HttpResponse& response) mutable { promise.setValue(response); });
+        return future;
+    }
+
+    Future<HttpResponse> send(HttpRequest&& request) {
+        Promise<HttpResponse> promise;
+        Future<HttpResponse> future = promise.getFuture();
+        send(std::move(request), [promise](const HttpResponse& response) mutable { promise.setValue(response); });
+        return future;
+    }
+
+    // A response delivered as it arrives. Every member may be left empty.
+    struct StreamHandler {
+        // Once, before any body bytes: status and headers (body empty).
+        // Returning false abandons the response.
+        std::function<bool(const HttpResponse& head)> onHeaders;
+        // Each piece of the body, in order and already de-chunked. Returning
+        // false abandons the response. Until it returns nothing more is read
+        // from the connection, so a slow consumer slows the server down (TCP
+        // flow control) instead of the body piling up in memory.
+        std::function<bool(const char* data, std::size_t size)> onBody;
+        // Exactly once, last: the head again, or a transportError (also when
+        // a handler abandoned the response).
+        Callback onComplete;
+    };
+
+    // Streaming form of send(). Without an override, the response is
+    // buffered by send() and then replayed as a single body piece.
+    virtual void sendStreaming(const HttpRequest& request, StreamHandler handler) {
+        send(request, [handler](const HttpResponse& response) {
+            replayBuffered(handler, response);
+        });
+    }
+
+    virtual void sendStreaming(HttpRequest&& request, StreamHandler handler) {
+        sendStreaming(static_cast<const HttpRequest&>(request), std::move(handler));
+    }
+
+    // transportErrorMessage when a StreamHandler abandoned the response.
+    static const char* streamCancelledMessage() { return "Request cancelled by the stream handler"; }
+
     virtual ~IHttpClient() = default;
+
+protected:
+    static void replayBuffered(const StreamHandler& handler, const HttpResponse& response) {
+        if (response.transportError) {
+            if (handler.onComplete) {
+                handler.onComplete(response);
+            }
+            return;
+        }
+        HttpResponse head;
+        head.status = response.status;
+        head.headers = response.headers;
+        const bool accepted =
+            (!handler.onHeaders || handler.onHeaders(head)) &&
+            (!handler.onBody || response.body.empty() ||
+             handler.onBody(response.body.data(), response.body.size()));
+        if (!accepted) {
+            head = HttpResponse();
+            head.transportError = true;
+            head.transportErrorMessage = streamCancelledMessage();
+        }
+        if (handler.onComplete) {
+            handler.onComplete(head);
+        }
+    }
 };
 
 } // namespace core
@@ -0,0 +1,813 @@
+//
+//  IoUringHttpClient.cpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  One loop thread owns the ring and every connection. Each operation in
+//  flight is tagged with its connection's address plus the operation kind,
+//  and a connection that is closed while operations are still in flight is
+//  only destroyed once the kernel has returned all of them (the buffers
+//  they point into live in the connection). Connect, send and receive carry
+//  linked timeouts, so the kernel enforces connectionTimeoutSec and
+//  readTimeoutSec; idle connections hold a one-shot poll instead of a
+//  receive and no buffer. Pooling, queueing, retry and delivery are
+//  HttpConnectionPool's.
+//
+
+#include "Infrastructure/Http/IoUringHttpClient.hpp"
+
+#ifdef PUREMVC_CORE_HAS_IO_URING
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Infrastructure/Http/DnsCache.hpp"
+#include "Infrastructure/Http/HttpConnectionPool.hpp"
+#include "Infrastructure/Http/HttpResponseParser.hpp"
+#include "Infrastructure/Security/CertificatePinner.hpp"
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include "Infrastructure/Http/TlsVerification.hpp"
+#else
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+typedef struct bio_st BIO;
+#endif
+
+namespace core {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const unsigned kRingEntries = 256;
+const std::uint16_t kBufferGroup = 0;
+const unsigned kBufferCount = 64;
+const unsigned kBufferSize = 16 * 1024;
+
+// Completions that belong to no connection. Link timeouts and cancellations
+// report through the operation they target, so theirs are ignored.
+const std::uint64_t kIgnored = 0;
+const std::uint64_t kWake = 1;
+
+// Low bits of an operation's user_data; the rest is the Connection address.
+enum OpKind : unsigned { opConnect = 1, opSend = 2, opRecv = 3, opPoll = 4 };
+const std::uint64_t kKindMask = 7;
+
+__kernel_timespec seconds(int value) {
+    __kernel_timespec ts;
+    ts.tv_sec = value;
+    ts.tv_nsec = 0;
+    return ts;
+}
+
+struct alignas(8) Connection : PooledConnection {
+    enum class Phase { connecting, handshaking, busy, idle, checking, closed };
+
+    int fd = -1;
+    Phase phase = Phase::connecting;
+    unsigned inFlight = 0;          // bit (1 << OpKind) per operation the kernel holds
+    sockaddr_storage address;
+    socklen_t addressLength = 0;
+
+    // What the send in flight points into: the request itself for plain
+    // HTTP, OpenSSL's output for TLS.
+    std::shared_ptr<const std::string> wire;
+    std::string tlsOut;
+    const char* sendData = nullptr;
+    std::size_t sendSize = 0;
+    std::size_t sent = 0;
+
+    SSL* ssl = nullptr;
+    BIO* rbio = nullptr; // owned by ssl
+    BIO* wbio = nullptr;
+};
+
+// What the pool holds references to, so it is constructed first.
+struct Setup {
+    explicit Setup(HttpClientConfig c)
+        : config(std::move(c)), dns(config.dnsCache ? config.dnsCache : DnsCache::shared()) {}
+
+    const HttpClientConfig config;
+    const std::shared_ptr<DnsCache> dns;
+};
+
+} // namespace
+
+struct IoUringHttpClient::Engine : Setup, HttpConnectionPool {
+    Engine(HttpClientConfig c, IExecutor& callbacks);
+    ~Engine() override;
+
+    // Any thread.
+    void enqueue(std::unique_ptr<HttpExchange> exchange);
+    void requestCloseIdle();
+
+    // Loop thread only, from here on.
+    void loop();
+    void takeInbox();
+    std::chrono::nanoseconds nextTimeout();
+    void onCompletion(const io_uring_cqe& cqe);
+    void closeAll(const std::string& reason);
+
+    Clock::time_point now() const override { return Clock::now(); }
+    void connect(std::unique_ptr<HttpExchange> exchange, const SocketAddress& address) override;
+    void begin(PooledConnection& connection, std::unique_ptr<HttpExchange> exchange) override;
+    void parked(PooledConnection& connection) override;
+    void unparked(PooledConnection& connection) override;
+    void release(PooledConnection& connection) override;
+    void notifyResolved() override;
+
+    io_uring_sqe* prepare(Connection& connection, OpKind kind, std::uint8_t opcode);
+    void linkTimeout(io_uring_sqe* sqe, const __kernel_timespec& timeout);
+    void armWake();
+    void postSend(Connection& connection);
+    void postRecv(Connection& connection, const __kernel_timespec* timeout);
+    void postPoll(Connection& connection);
+    void cancel(Connection& connection, OpKind kind);
+
+    void onConnect(Connection& connection, int result);
+    void onSend(Connection& connection, int result);
+    void onRecv(Connection& connection, int result, const char* data);
+    void onPoll(Connection& connection, int result);
+
+    void handshake(Connection& connection);
+    void readTls(Connection& connection);
+    void checkIdleTls(Connection& connection);
+    void flushTls(Connection& connection);
+    void onClosedByPeer(Connection& connection);
+    void finish(Connection& connection, bool reusable);
+    void destroy(Connection& connection);
+
+    const CertificatePinner pinner; // referenced by ctx
+    IExecutor& callbackExecutor;
+    std::uint64_t wakeValue = 0;    // before ring: the wake read may write it until the ring closes
+    IoUring ring;
+    SSL_CTX* ctx = nullptr;
+    std::string setupError;          // every request fails with it
+    int wakeFd = -1;
+
+    std::mutex inboxMutex;
+    std::vector<std::unique_ptr<HttpExchange>> inbox;
+    bool wakePending = false;
+    bool closeIdleRequested = false;
+    bool resolvedPending = false;
+    bool stopRequested = false;
+
+    // Loop state.
+    std::unordered_map<Connection*, std::unique_ptr<Connection>> connections; // incl. closing
+    const __kernel_timespec connectTimeout;
+    const __kernel_timespec readTimeout;
+    char plaintext[kBufferSize];
+
+    std::thread thread;
+};
+
+IoUringHttpClient::Engine::Engine(HttpClientConfig c, IExecutor& callbacks)
+    : Setup(std::move(c)),
+      HttpConnectionPool(config, *dns, callbacks, config.maxConnectionsPerHost, config.maxIdleConnections),
+      pinner(config.pinnedSpkiSha256Base64),
+      callbackExecutor(callbacks),
+      ring(kRingEntries),
+      connectTimeout(seconds(config.connectionTimeoutSec)),
+      readTimeout(seconds(config.readTimeoutSec)) {
+    if (!ring.provideBuffers(kBufferGroup, kBufferCount, kBufferSize)) {
+        throw std::system_error(ENOSYS, std::generic_category(),
+                                "IoUringHttpClient: provided buffers unsupported");
+    }
+    wakeFd = ::eventfd(0, EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        throw std::system_error(errno, std::generic_category(), "IoUringHttpClient: eventfd");
+    }
+    if (config.useSSL) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        ctx = newClientContext(config, pinner, setupError);
+#else
+        setupError = "SSL not supported in this build";
+#endif
+    }
+    thread = std::thread([this]() { loop(); });
+}
+
+IoUringHttpClient::Engine::~Engine() {
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        stopRequested = true;
+    }
+    const std::uint64_t one = 1;
+    (void)!::write(wakeFd, &one, sizeof(one));
+    thread.join();
+    ::close(wakeFd);
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    SSL_CTX_free(ctx); // null-safe
+#endif
+}
+
+void IoUringHttpClient::Engine::enqueue(std::unique_ptr<HttpExchange> exchange) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        inbox.push_back(std::move(exchange));
+        wake = !wakePending;
+        wakePending = true;
+    }
+    if (wake) {
+        const std::uint64_t one = 1;
+        (void)!::write(wakeFd, &one, sizeof(one));
+    }
+}
+
+void IoUringHttpClient::Engine::requestCloseIdle() {
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        closeIdleRequested = true;
+    }
+    const std::uint64_t one = 1;
+    (void)!::write(wakeFd, &one, sizeof(one));
+}
+
+void IoUringHttpClient::Engine::notifyResolved() {
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        resolvedPending = true;
+    }
+    const std::uint64_t one = 1;
+    (void)!::write(wakeFd, &one, sizeof(one));
+}
+
+void IoUringHttpClient::Engine::loop() {
+    armWake();
+    for (;;) {
+        takeInbox();
+        if (stopping() && connections.empty()) {
+            return;
+        }
+        ring.submitAndWait(nextTimeout());
+        ring.drain([this](const io_uring_cqe& cqe) { onCompletion(cqe); });
+        expireWaiting();
+    }
+}
+
+void IoUringHttpClient::Engine::takeInbox() {
+    std::vector<std::unique_ptr<HttpExchange>> batch;
+    bool closeIdleNow = false;
+    bool resolvedNow = false;
+    bool stop = false;
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        batch.swap(inbox);
+        wakePending = false;
+        closeIdleNow = closeIdleRequested;
+        closeIdleRequested = false;
+        resolvedNow = resolvedPending;
+        resolvedPending = false;
+        stop = stopRequested;
+    }
+    if (closeIdleNow) {
+        closeIdle(); // first: requests sent after the call must not get those
+    }
+    if (resolvedNow) {
+        resolved(); // ahead of the batch, which came later
+    }
+    for (std::unique_ptr<HttpExchange>& exchange : batch) {
+        submit(std::move(exchange));
+    }
+    if (stop && !stopping()) {
+        closeAll("Request cancelled: client destroyed");
+    }
+}
+
+// Until the first queued request times out, or indefinitely.
+std::chrono::nanoseconds IoUringHttpClient::Engine::nextTimeout() {
+    if (!hasWaiting()) {
+        return std::chrono::nanoseconds(-1);
+    }
+    const Clock::duration left = nextDeadline() - Clock::now();
+    return std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(left),
+                    std::chrono::nanoseconds(1));
+}
+
+void IoUringHttpClient::Engine::onCompletion(const io_uring_cqe& cqe) {
+    if (cqe.user_data == kIgnored) {
+        return;
+    }
+    if (cqe.user_data == kWake) {
+        armWake();
+        return;
+    }
+    Connection& connection = *reinterpret_cast<Connection*>(cqe.user_data & ~kKindMask);
+    const unsigned kind = static_cast<unsigned>(cqe.user_data & kKindMask);
+    connection.inFlight &= ~(1u << kind);
+
+    const char* data = nullptr;
+    std::uint16_t bufferId = 0;
+    const bool hasBuffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+    if (hasBuffer) {
+        bufferId = static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        data = ring.buffer(bufferId);
+    }
+
+    if (connection.phase == Connection::Phase::closed) {
+        if (connection.inFlight == 0) {
+            destroy(connection);
+        }
+    } else {
+        switch (kind) {
+        case opConnect: onConnect(connection, cqe.res); break;
+        case opSend: onSend(connection, cqe.res); break;
+        case opRecv: onRecv(connection, cqe.res, data); break;
+        case opPoll: onPoll(connection, cqe.res); break;
+        }
+    }
+    if (hasBuffer) {
+        ring.recycle(bufferId); // the bytes have been parsed or copied by now
+    }
+}
+
+void IoUringHttpClient::Engine::connect(std::unique_ptr<HttpExchange> exchange, const SocketAddress& address) {
+    const int fd = ::socket(address.family(), SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        deliver(std::move(exchange), transportFailure(systemError("Cannot create socket", errno)));
+        return;
+    }
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    std::unique_ptr<Connection> owned(new Connection);
+    Connection& connection = *owned;
+    connection.fd = fd;
+    connection.address = address.storage;
+    connection.addressLength = address.length;
+    connection.exchange = std::move(exchange);
+    connections[&connection] = std::move(owned);
+    opened();
+
+    io_uring_sqe* sqe = prepare(connection, opConnect, IORING_OP_CONNECT);
+    sqe->addr = reinterpret_cast<std::uint64_t>(&connection.address);
+    sqe->off = connection.addressLength;
+    linkTimeout(sqe, connectTimeout);
+}
+
+void IoUringHttpClient::Engine::unparked(PooledConnection& pooled) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    if (connection.inFlight & (1u << opPoll)) {
+        cancel(connection, opPoll);
+    }
+}
+
+// Idle connections hold a poll rather than a receive: readiness means the
+// server closed the connection (or, over TLS, maybe sent a session ticket).
+void IoUringHttpClient::Engine::parked(PooledConnection& pooled) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    connection.phase = Connection::Phase::idle;
+    if (!(connection.inFlight & (1u << opPoll))) {
+        postPoll(connection); // else the cancelled one re-arms when it returns
+    }
+}
+
+void IoUringHttpClient::Engine::closeAll(const std::string& reason) {
+    stop(reason);
+    std::vector<Connection*> all;
+    for (auto& entry : connections) {
+        all.push_back(entry.first);
+    }
+    for (Connection* connection : all) {
+        if (connection->phase == Connection::Phase::closed) {
+            continue;
+        }
+        std::unique_ptr<HttpExchange> exchange = std::move(connection->exchange);
+        close(*connection);
+        if (exchange) {
+            deliver(std::move(exchange), transportFailure(reason));
+        }
+    }
+}
+
+io_uring_sqe* IoUringHttpClient::Engine::prepare(Connection& connection, OpKind kind, std::uint8_t opcode) {
+    io_uring_sqe* sqe = ring.prepare();
+    sqe->opcode = opcode;
+    sqe->fd = connection.fd;
+    sqe->user_data = reinterpret_cast<std::uint64_t>(&connection) | kind;
+    connection.inFlight |= 1u << kind;
+    return sqe;
+}
+
+// Must directly follow 'sqe' in the submission queue.
+void IoUringHttpClient::Engine::linkTimeout(io_uring_sqe* sqe, const __kernel_timespec& timeout) {
+    sqe->flags |= IOSQE_IO_LINK;
+    io_uring_sqe* timer = ring.prepare();
+    timer->opcode = IORING_OP_LINK_TIMEOUT;
+    timer->fd = -1;
+    timer->addr = reinterpret_cast<std::uint64_t>(&timeout);
+    timer->len = 1;
+    timer->user_data = kIgnored;
+}
+
+void IoUringHttpClient::Engine::armWake() {
+    io_uring_sqe* sqe = ring.prepare();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = wakeFd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(&wakeValue);
+    sqe->len = sizeof(wakeValue);
+    sqe->user_data = kWake;
+}
+
+void IoUringHttpClient::Engine::postSend(Connection& connection) {
+    io_uring_sqe* sqe = prepare(connection, opSend, IORING_OP_SEND);
+    sqe->addr = reinterpret_cast<std::uint64_t>(connection.sendData + connection.sent);
+    sqe->len = static_cast<std::uint32_t>(std::min<std::size_t>(connection.sendSize - connection.sent, INT_MAX));
+    sqe->msg_flags = MSG_NOSIGNAL;
+    linkTimeout(sqe, readTimeout);
+}
+
+// The kernel picks a buffer from the provided ring when data arrives.
+void IoUringHttpClient::Engine::postRecv(Connection& connection, const __kernel_timespec* timeout) {
+    if (connection.inFlight & (1u << opRecv)) {
+        return;
+    }
+    io_uring_sqe* sqe = prepare(connection, opRecv, IORING_OP_RECV);
+    sqe->len = kBufferSize;
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = kBufferGroup;
+    if (timeout != nullptr) {
+        linkTimeout(sqe, *timeout);
+    }
+}
+
+void IoUringHttpClient::Engine::postPoll(Connection& connection) {
+    io_uring_sqe* sqe = prepare(connection, opPoll, IORING_OP_POLL_ADD);
+    sqe->poll32_events = POLLIN | POLLRDHUP;
+}
+
+void IoUringHttpClient::Engine::cancel(Connection& connection, OpKind kind) {
+    io_uring_sqe* sqe = ring.prepare();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<std::uint64_t>(&connection) | kind;
+    sqe->user_data = kIgnored;
+}
+
+void IoUringHttpClient::Engine::onConnect(Connection& connection, int result) {
+    if (result < 0) {
+        fail(connection, result == -ECANCELED ? std::string("Connection timed out")
+                                              : systemError("Connection failed", -result), false);
+        return;
+    }
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (ctx != nullptr) {
+        connection.ssl = SSL_new(ctx);
+        connection.rbio = BIO_new(BIO_s_mem());
+        connection.wbio = BIO_new(BIO_s_mem());
+        if (connection.ssl == nullptr || connection.rbio == nullptr || connection.wbio == nullptr) {
+            BIO_free(connection.rbio);
+            BIO_free(connection.wbio);
+            connection.rbio = connection.wbio = nullptr;
+            fail(connection, "TLS setup failed", false);
+            return;
+        }
+        SSL_set_bio(connection.ssl, connection.rbio, connection.wbio); // ssl owns both now
+        SSL_set_connect_state(connection.ssl);
+        if (!isIpLiteral(config.host)) {
+            SSL_set_tlsext_host_name(connection.ssl, config.host.c_str());
+        }
+        connection.phase = Connection::Phase::handshaking;
+        handshake(connection);
+        return;
+    }
+#endif
+    begin(connection, std::move(connection.exchange));
+}
+
+void IoUringHttpClient::Engine::onSend(Connection& connection, int result) {
+    if (result < 0) {
+        if (result == -ECANCELED) {
+            fail(connection, "Write timed out", false);
+        } else {
+            fail(connection, systemError("Send failed", -result), true);
+        }
+        return;
+    }
+    connection.sent += static_cast<std::size_t>(result);
+    if (connection.sent < connection.sendSize) {
+        postSend(connection);
+        return;
+    }
+    if (connection.ssl != nullptr) {
+        flushTls(connection); // OpenSSL may have produced more meanwhile
+    }
+}
+
+void IoUringHttpClient::Engine::onRecv(Connection& connection, int result, const char* data) {
+    using Phase = Connection::Phase;
+    if (result == -ENOBUFS) {
+        postRecv(connection, connection.phase == Phase::checking ? nullptr : &readTimeout);
+        return;
+    }
+    if (result < 0) {
+        if (connection.phase == Phase::checking) {
+            close(connection);
+            dispatchWaiting();
+        } else if (result == -ECANCELED) {
+            fail(connection, connection.phase == Phase::handshaking ? "Connection timed out" : "Read timed out",
+                 false);
+        } else {
+            fail(connection, systemError("Receive failed", -result), true);
+        }
+        return;
+    }
+    if (result == 0) {
+        onClosedByPeer(connection);
+        return;
+    }
+    const std::size_t size = static_cast<std::size_t>(result);
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (connection.ssl != nullptr) {
+        BIO_write(connection.rbio, data, result);
+        if (connection.phase == Phase::handshaking) {
+            handshake(connection);
+        } else if (connection.phase == Phase::checking) {
+            checkIdleTls(connection);
+        } else {
+            readTls(connection);
+        }
+        return;
+    }
+#endif
+    // Plain HTTP: parsed straight out of the kernel-filled buffer.
+    HttpResponseParser& parser = connection.parser;
+    const std::size_t used = parser.feed(data, size);
+    if (parser.failed()) {
+        fail(connection, "Malformed response: " + parser.error(), false);
+    } else if (parser.complete()) {
+        // Bytes past the end of the response mean the stream can no longer
+        // be trusted for another request.
+        finish(connection, used == size);
+    } else {
+        postRecv(connection, &readTimeout);
+    }
+}
+
+void IoUringHttpClient::Engine::onPoll(Connection& connection, int result) {
+    if (connection.phase != Connection::Phase::idle) {
+        return; // cancelled by reuse, or stale readiness from before it
+    }
+    if (result == -ECANCELED) {
+        postPoll(connection); // cancelled for a reuse that has since finished
+        return;
+    }
+    unpark(connection);
+    if (connection.ssl != nullptr && !(result & (POLLHUP | POLLERR | POLLRDHUP))) {
+        connection.phase = Connection::Phase::checking;
+        postRecv(connection, nullptr);
+        return;
+    }
+    closeStale(connection);
+}
+
+void IoUringHttpClient::Engine::begin(PooledConnection& pooled, std::unique_ptr<HttpExchange> exchange) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    connection.exchange = std::move(exchange);
+    connection.phase = Connection::Phase::busy;
+    connection.parser.reset(connection.exchange->head);
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (connection.ssl != nullptr) {
+        const std::string& wire = *connection.exchange->wire;
+        // Memory BIOs never push back, so the whole request is encrypted now.
+        if (SSL_write(connection.ssl, wire.data(), static_cast<int>(wire.size())) <= 0) {
+            fail(connection, "Send failed: TLS error", true);
+            return;
+        }
+        flushTls(connection);
+        postRecv(connection, &readTimeout);
+        return;
+    }
+#endif
+    // Sent straight from the serialised request; the connection keeps it
+    // alive until the kernel is done with it.
+    connection.wire = connection.exchange->wire;
+    connection.sendData = connection.wire->data();
+    connection.sendSize = connection.wire->size();
+    connection.sent = 0;
+    postSend(connection);
+    postRecv(connection, &readTimeout);
+}
+
+void IoUringHttpClient::Engine::handshake(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    ERR_clear_error();
+    const int result = SSL_do_handshake(connection.ssl);
+    flushTls(connection);
+    if (result == 1) {
+        std::atomic<std::uint64_t>& counter =
+            SSL_session_reused(connection.ssl) ? counters_.resumedHandshakes : counters_.fullHandshakes;
+        counter.fetch_add(1, std::memory_order_relaxed);
+        begin(connection, std::move(connection.exchange));
+        return;
+    }
+    if (SSL_get_error(connection.ssl, result) == SSL_ERROR_WANT_READ) {
+        postRecv(connection, &connectTimeout);
+        return;
+    }
+    const long verified = SSL_get_verify_result(connection.ssl);
+    std::string message = "TLS handshake failed";
+    if (verified != X509_V_OK) {
+        message += std::string(": ") + X509_verify_cert_error_string(verified);
+    } else if (const unsigned long code = ERR_peek_last_error()) {
+        char text[256];
+        ERR_error_string_n(code, text, sizeof(text));
+        message += std::string(": ") + text;
+    }
+    fail(connection, message, false);
+#else
+    fail(connection, "SSL not supported in this build", false);
+#endif
+}
+
+// Decrypts what has arrived and feeds the parser; OpenSSL may hold a whole
+// record back until its last byte is in.
+void IoUringHttpClient::Engine::readTls(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    HttpResponseParser& parser = connection.parser;
+    for (;;) {
+        ERR_clear_error();
+        const int result = SSL_read(connection.ssl, plaintext, sizeof(plaintext));
+        if (result <= 0) {
+            const int error = SSL_get_error(connection.ssl, result);
+            flushTls(connection);
+            if (error == SSL_ERROR_WANT_READ) {
+                postRecv(connection, &readTimeout);
+            } else if (error == SSL_ERROR_ZERO_RETURN) {
+                onClosedByPeer(connection);
+            } else {
+                fail(connection, "Receive failed: TLS error", true);
+            }
+            return;
+        }
+        const std::size_t used = parser.feed(plaintext, static_cast<std::size_t>(result));
+        if (parser.failed()) {
+            fail(connection, "Malformed response: " + parser.error(), false);
+            return;
+        }
+        if (parser.complete()) {
+            finish(connection, used == static_cast<std::size_t>(result) && SSL_pending(connection.ssl) == 0 &&
+                                   BIO_ctrl_pending(connection.rbio) == 0);
+            return;
+        }
+    }
+#else
+    (void)connection;
+#endif
+}
+
+// An idle TLS connection turned readable: TLS 1.3 servers send session
+// tickets after the handshake, which carry no application data. Anything
+// else (data, close_notify, errors) means the connection is done.
+void IoUringHttpClient::Engine::checkIdleTls(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    ERR_clear_error();
+    const int result = SSL_read(connection.ssl, plaintext, sizeof(plaintext));
+    if (result <= 0 && SSL_get_error(connection.ssl, result) == SSL_ERROR_WANT_READ) {
+        repark(connection);
+        return;
+    }
+#endif
+    closeStale(connection);
+}
+
+// Sends what OpenSSL has written to the outgoing BIO, one send at a time.
+void IoUringHttpClient::Engine::flushTls(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    if (connection.inFlight & (1u << opSend)) {
+        return; // onSend flushes again
+    }
+    const std::size_t pending = BIO_ctrl_pending(connection.wbio);
+    if (pending == 0) {
+        return;
+    }
+    connection.tlsOut.resize(pending);
+    BIO_read(connection.wbio, &connection.tlsOut[0], static_cast<int>(pending));
+    connection.sendData = connection.tlsOut.data();
+    connection.sendSize = pending;
+    connection.sent = 0;
+    postSend(connection);
+#else
+    (void)connection;
+#endif
+}
+
+void IoUringHttpClient::Engine::onClosedByPeer(Connection& connection) {
+    switch (connection.phase) {
+    case Connection::Phase::busy:
+        connection.parser.finishOnClose();
+        if (connection.parser.complete()) {
+            finish(connection, false);
+        } else {
+            fail(connection, connection.parser.error(), true);
+        }
+        return;
+    case Connection::Phase::handshaking:
+        fail(connection, "TLS handshake failed: connection closed", false);
+        return;
+    default:
+        closeStale(connection);
+        return;
+    }
+}
+
+// A send still in flight (the server answered early) rules out reuse.
+void IoUringHttpClient::Engine::finish(Connection& connection, bool reusable) {
+    complete(connection, reusable && !(connection.inFlight & (1u << opSend)));
+}
+
+// Cancels what the kernel still holds; the connection is destroyed when the
+// last of it comes back.
+void IoUringHttpClient::Engine::release(PooledConnection& pooled) {
+    Connection& connection = static_cast<Connection&>(pooled);
+    connection.phase = Connection::Phase::closed;
+    if (connection.inFlight == 0) {
+        destroy(connection);
+        return;
+    }
+    const OpKind kinds[] = {opConnect, opSend, opRecv, opPoll};
+    for (OpKind kind : kinds) {
+        if (connection.inFlight & (1u << kind)) {
+            cancel(connection, kind);
+        }
+    }
+}
+
+void IoUringHttpClient::Engine::destroy(Connection& connection) {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+    SSL_free(connection.ssl); // null-safe; frees the BIOs
+#endif
+    ::close(connection.fd);
+    connections.erase(&connection);
+}
+
+bool IoUringHttpClient::isSupported() {
+    static const bool supported = []() {
+        if (!IoUring::available({IORING_OP_CONNECT, IORING_OP_SEND, IORING_OP_RECV, IORING_OP_POLL_ADD,
+                                 IORING_OP_ASYNC_CANCEL, IORING_OP_LINK_TIMEOUT, IORING_OP_READ,
+                                 IORING_OP_PROVIDE_BUFFERS})) {
+            return false;
+        }
+        try {
+            IoUring ring(4);
+            return ring.provideBuffers(kBufferGroup, 2, 64);
+        } catch (const std::system_error&) {
+            return false;
+        }
+    }();
+    return supported;
+}
+
+IoUringHttpClient::IoUringHttpClient(HttpClientConfig config, IExecutor& callbackExecutor)
+    : engine_(new Engine(std::move(config), callbackExecutor)) {}
+
+IoUringHttpClient::~IoUringHttpClient() = default;
+
+void IoUringHttpClient::send(const HttpRequest& request, Callback callback) {
+    std::string error = engine_->setupError;
+    std::unique_ptr<HttpExchange> exchange;
+    if (error.empty()) {
+        exchange = HttpConnectionPool::prepare(engine_->config, request, error);
+    }
+    if (!exchange) {
+        HttpConnectionPool::deliver(engine_->callbackExecutor, std::move(callback), transportFailure(error),
+                                    request.priority);
+        return;
+    }
+    exchange->callback = std::move(callback);
+    engine_->enqueue(std::move(exchange));
+}
+
+ConnectionPoolStats IoUringHttpClient::poolStats() const {
+    ConnectionPoolStats stats;
+    engine_->addStats(stats);
+    return stats;
+}
+
+void IoUringHttpClient::closeIdleConnections() {
+    engine_->requestCloseIdle();
+}
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HAS_IO_URING
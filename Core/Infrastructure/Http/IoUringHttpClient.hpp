@@ -0,0 +1,67 @@
+//
+//  IoUringHttpClient.hpp
+//  PureMVC Core — Infrastructure (Linux only)
+//
+//  HTTP/1.1 IHttpClient whose sockets are driven through io_uring: connect,
+//  send and receive are submitted to the kernel in batches, with one system
+//  call per loop iteration to submit the batch and wait for completions.
+//  Responses are received into a pool of provided buffers that the kernel
+//  picks and fills directly, and requests are sent straight from their
+//  serialised form, so neither direction copies through an intermediate
+//  buffer. TLS runs OpenSSL over memory BIOs on the same loop.
+//
+//  Same HttpClientConfig contract as AsyncHttpClient (pool limits, timeouts,
+//  one retry of a dead reused connection, verification and pinning);
+//  callbacks run on the injected IExecutor with the request's priority.
+//
+//  Needs a kernel with io_uring enabled (5.17+, not blocked by seccomp or
+//  io_uring_disabled). Check isSupported(), or let makeHttpClient() pick a
+//  transport and fall back automatically.
+//
+
+#ifndef PUREMVC_CORE_IO_URING_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_IO_URING_HTTP_CLIENT_HPP
+
+#include "Infrastructure/Concurrency/IoUring.hpp"
+
+#ifdef PUREMVC_CORE_HAS_IO_URING
+
+#include <memory>
+#include "Domain/Ports/IExecutor.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+class IoUringHttpClient : public IHttpClient {
+public:
+    // Whether the running kernel provides everything this client submits.
+    // Probed once per process.
+    static bool isSupported();
+
+    // Throws std::system_error if the ring cannot be set up (!isSupported()).
+    IoUringHttpClient(HttpClientConfig config, IExecutor& callbackExecutor);
+    ~IoUringHttpClient() override;
+
+    IoUringHttpClient(const IoUringHttpClient&) = delete;
+    IoUringHttpClient& operator=(const IoUringHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+
+    ConnectionPoolStats poolStats() const;
+
+    // Closes every idle connection (asynchronously, on the loop).
+    void closeIdleConnections();
+
+private:
+    struct Engine; // ring, loop thread and connections
+
+    std::unique_ptr<Engine> engine_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_HAS_IO_URING
+
+#endif // PUREMVC_CORE_IO_URING_HTTP_CLIENT_HPP
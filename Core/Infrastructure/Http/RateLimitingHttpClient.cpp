@@ -0,0 +1,421 @@
+//
+//  RateLimitingHttpClient.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/RateLimitingHttpClient.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
+
+namespace core {
+namespace {
+
+using Clock = IScheduledExecutor::Clock;
+
+HttpResponse rateLimited() {
+    HttpResponse response;
+    response.transportError = true;
+    response.transportErrorMessage = RateLimitingHttpClient::rateLimitedMessage();
+    return response;
+}
+
+bool isDigits(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c)) != 0;
+    });
+}
+
+} // namespace
+
+struct RateLimitingHttpClient::Bucket {
+    Limit limit;
+    double rate = 0;    // limit.ratePerSecond, adapted
+    double tokens = 0;
+    Clock::time_point refilled;    // may be ahead of now while paused
+    Clock::time_point pausedUntil;
+    Clock::time_point lastCut;
+    bool everCut = false;
+
+    bool limited() const { return limit.ratePerSecond > 0; }
+
+    void refill(Clock::time_point now) {
+        if (!limited() || now <= refilled) {
+            return;
+        }
+        const double elapsed = std::chrono::duration<double>(now - refilled).count();
+        tokens = std::min(limit.burst, tokens + rate * elapsed);
+        refilled = now;
+    }
+
+    // When the next token is there, after refill(now).
+    Clock::time_point readyAt(Clock::time_point now) const {
+        Clock::time_point ready = std::max(now, pausedUntil);
+        if (limited() && tokens < 1) {
+            const std::chrono::duration<double> wait((1 - tokens) / rate);
+            ready = std::max(ready, std::max(now, refilled) + std::chrono::duration_cast<Clock::duration>(wait));
+        }
+        return ready;
+    }
+
+    void take() {
+        if (limited()) {
+            tokens -= 1;
+        }
+    }
+};
+
+struct RateLimitingHttpClient::Pending {
+    HttpRequest request;
+    Callback callback;      // buffered
+    StreamHandler handler;  // streaming
+    bool streaming = false;
+    Bucket* route = nullptr; // null when only the host's applies
+    Clock::time_point deadline;
+};
+
+struct RateLimitingHttpClient::State : std::enable_shared_from_this<RateLimitingHttpClient::State> {
+    State(IHttpClient& client, IScheduledExecutor& timers, Options opts)
+        : inner(client), scheduler(timers), options(std::move(opts)) {
+        const Clock::time_point now = scheduler.now();
+        host = bucket(options.host, now);
+        for (const auto& entry : options.routes) {
+            routes[entry.first] = bucket(entry.second, now);
+        }
+        if (!options.wallClock) {
+            options.wallClock = []() { return WallClock::now(); };
+        }
+    }
+
+    IHttpClient& inner;
+    IScheduledExecutor& scheduler;
+    Options options;
+
+    mutable std::mutex mutex;
+    Bucket host;
+    std::map<std::string, Bucket> routes; // fixed after construction
+    std::deque<std::shared_ptr<Pending>> queue;
+    IScheduledExecutor::TimerId timer = 0;
+    Clock::time_point timerAt = Clock::time_point::max(); // max: none pending
+    std::uint64_t timerGeneration = 0;
+    RateLimitStats stats;
+    bool closed = false;
+
+    static Bucket bucket(const Limit& limit, Clock::time_point now) {
+        Bucket b;
+        b.limit = limit;
+        b.limit.burst = std::max(1.0, limit.burst);
+        b.rate = limit.ratePerSecond;
+        b.tokens = b.limit.burst;
+        b.refilled = now;
+        return b;
+    }
+
+    Bucket* routeFor(const HttpRequest& request) {
+        if (routes.empty()) {
+            return nullptr;
+        }
+        auto it = routes.find(options.route ? options.route(request) : defaultRoute(request));
+        return it != routes.end() ? &it->second : nullptr;
+    }
+
+    // Under the lock.
+    Clock::time_point readyAt(const Pending& pending, Clock::time_point now) {
+        host.refill(now);
+        Clock::time_point ready = host.readyAt(now);
+        if (Bucket* route = pending.route) {
+            route->refill(now);
+            ready = std::max(ready, route->readyAt(now));
+        }
+        return ready;
+    }
+
+    // Under the lock.
+    void take(const Pending& pending) {
+        host.take();
+        if (Bucket* route = pending.route) {
+            route->take();
+        }
+        ++stats.sent;
+    }
+
+    void submit(std::shared_ptr<Pending> pending) {
+        bool sendNow = false;
+        bool shed = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const Clock::time_point now = scheduler.now();
+            if (closed) {
+                shed = true;
+            } else if (queue.empty() && readyAt(*pending, now) <= now) {
+                take(*pending);
+                sendNow = true;
+            } else if (queue.size() >= options.maxQueueLength) {
+                shed = true;
+            } else {
+                pending->deadline = now + options.maxQueueDelay;
+                queue.push_back(pending);
+                ++stats.queued;
+            }
+            if (shed) {
+                ++stats.shed;
+            }
+        }
+        if (sendNow) {
+            dispatch(std::move(pending));
+        } else if (shed) {
+            answer(*pending, rateLimited());
+        } else {
+            drain();
+        }
+    }
+
+    // Sends what may go, sheds what waited too long, and sets the timer for
+    // whichever of the rest is due first.
+    void drain() {
+        std::vector<std::shared_ptr<Pending>> ready;
+        std::vector<std::shared_ptr<Pending>> expired;
+        Clock::time_point wake = Clock::time_point::max();
+        IScheduledExecutor::TimerId replaced = 0;
+        std::uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const Clock::time_point now = scheduler.now();
+            for (auto it = queue.begin(); it != queue.end();) {
+                Pending& pending = **it;
+                if (now >= pending.deadline) {
+                    expired.push_back(std::move(*it));
+                    it = queue.erase(it);
+                    continue;
+                }
+                const Clock::time_point at = readyAt(pending, now);
+                if (at <= now) {
+                    take(pending);
+                    ready.push_back(std::move(*it));
+                    it = queue.erase(it);
+                    continue;
+                }
+                wake = std::min(wake, std::min(at, pending.deadline));
+                ++it;
+            }
+            stats.shed += expired.size();
+            if (wake < timerAt) {
+                timerAt = wake;
+                generation = ++timerGeneration;
+                std::swap(replaced, timer);
+            }
+        }
+
+        if (generation != 0) {
+            if (replaced != 0) {
+                scheduler.cancel(replaced);
+            }
+            std::weak_ptr<State> weak = shared_from_this();
+            const IScheduledExecutor::TimerId id = scheduler.runAt(wake, [weak, generation]() {
+                if (std::shared_ptr<State> self = weak.lock()) {
+                    self->fire(generation);
+                }
+            });
+            std::lock_guard<std::mutex> lock(mutex);
+            if (timerGeneration == generation && timerAt != Clock::time_point::max()) {
+                timer = id;
+            }
+        }
+        for (std::shared_ptr<Pending>& pending : expired) {
+            answer(*pending, rateLimited());
+        }
+        for (std::shared_ptr<Pending>& pending : ready) {
+            dispatch(std::move(pending));
+        }
+    }
+
+    void fire(std::uint64_t generation) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (generation != timerGeneration) {
+                return; // replaced by an earlier one
+            }
+            timer = 0;
+            timerAt = Clock::time_point::max();
+        }
+        drain();
+    }
+
+    void dispatch(std::shared_ptr<Pending> pending) {
+        std::shared_ptr<State> self = shared_from_this();
+        Bucket* route = pending->route;
+        if (!pending->streaming) {
+            Callback callback = std::move(pending->callback);
+            inner.send(std::move(pending->request), [self, route, callback](const HttpResponse& response) {
+                if (!response.transportError) {
+                    self->observe(route, response);
+                }
+                callback(response);
+            });
+            return;
+        }
+        StreamHandler handler = std::move(pending->handler);
+        std::function<bool(const HttpResponse&)> onHeaders = std::move(handler.onHeaders);
+        handler.onHeaders = [self, route, onHeaders](const HttpResponse& head) {
+            self->observe(route, head);
+            return !onHeaders || onHeaders(head);
+        };
+        inner.sendStreaming(std::move(pending->request), std::move(handler));
+    }
+
+    void observe(Bucket* route, const HttpResponse& head) {
+        const int status = head.status;
+        if (status >= 200 && status < 300) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const Clock::time_point now = scheduler.now();
+            recover(host, now);
+            if (route != nullptr) {
+                recover(*route, now);
+            }
+            return;
+        }
+        if (status != 429 && status != 503) {
+            return;
+        }
+        const Clock::duration pause = retryAfter(head);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stats.throttled;
+            throttle(status == 429 && route != nullptr ? *route : host, pause, scheduler.now());
+        }
+    }
+
+    // How long the server asked us to wait; 0 when a 503 did not say.
+    Clock::duration retryAfter(const HttpResponse& head) const {
+        const std::string& value = head.headers.get(HttpHeader::retryAfter);
+        std::chrono::seconds asked(-1);
+        if (isDigits(value)) {
+            asked = std::chrono::seconds(value.size() > 9 ? options.maxRetryAfter.count()
+                                                          : std::stoll(value));
+        } else {
+            std::int64_t date = 0;
+            if (!value.empty() && HttpHeaders::parseDate(value, date)) {
+                const std::int64_t now =
+                    std::chrono::duration_cast<std::chrono::seconds>(options.wallClock().time_since_epoch()).count();
+                asked = std::chrono::seconds(std::max<std::int64_t>(0, date - now));
+            }
+        }
+        if (asked.count() < 0) {
+            return head.status == 429 ? Clock::duration(options.retryAfterDefault) : Clock::duration::zero();
+        }
+        return std::min<Clock::duration>(asked, options.maxRetryAfter);
+    }
+
+    // Under the lock.
+    void throttle(Bucket& bucket, Clock::duration pause, Clock::time_point now) {
+        bucket.refill(now);
+        if (pause > Clock::duration::zero() && now + pause > bucket.pausedUntil) {
+            bucket.pausedUntil = now + pause;
+            // One request may go when the pause ends; nothing more is saved up.
+            bucket.tokens = std::min(bucket.tokens, 1.0);
+            bucket.refilled = std::max(bucket.refilled, bucket.pausedUntil);
+        }
+        if (bucket.limited() && (!bucket.everCut || now - bucket.lastCut >= options.adaptInterval)) {
+            bucket.rate = std::max(bucket.limit.ratePerSecond * options.minRateFraction, bucket.rate / 2);
+            bucket.lastCut = now;
+            bucket.everCut = true;
+        }
+    }
+
+    // Under the lock.
+    void recover(Bucket& bucket, Clock::time_point now) {
+        if (!bucket.limited() || bucket.rate >= bucket.limit.ratePerSecond) {
+            return;
+        }
+        bucket.refill(now);
+        bucket.rate = std::min(bucket.limit.ratePerSecond,
+                               bucket.rate + bucket.limit.ratePerSecond * options.recoveryFraction);
+    }
+
+    static void answer(Pending& pending, const HttpResponse& response) {
+        if (!pending.streaming) {
+            pending.callback(response);
+        } else if (pending.handler.onComplete) {
+            pending.handler.onComplete(response);
+        }
+    }
+
+    void close() {
+        std::deque<std::shared_ptr<Pending>> abandoned;
+        IScheduledExecutor::TimerId pending = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            abandoned.swap(queue);
+            stats.shed += abandoned.size();
+            std::swap(pending, timer);
+            timerAt = Clock::time_point::max();
+            ++timerGeneration;
+        }
+        if (pending != 0) {
+            scheduler.cancel(pending);
+        }
+        for (std::shared_ptr<Pending>& entry : abandoned) {
+            answer(*entry, rateLimited());
+        }
+    }
+};
+
+RateLimitingHttpClient::RateLimitingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler)
+    : RateLimitingHttpClient(inner, scheduler, Options()) {}
+
+RateLimitingHttpClient::RateLimitingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options)
+    : state_(std::make_shared<State>(inner, scheduler, std::move(options))) {}
+
+RateLimitingHttpClient::~RateLimitingHttpClient() {
+    state_->close();
+}
+
+void RateLimitingHttpClient::send(const HttpRequest& request, Callback callback) {
+    send(HttpRequest(request), std::move(callback));
+}
+
+void RateLimitingHttpClient::send(HttpRequest&& request, Callback callback) {
+    std::shared_ptr<Pending> pending = std::make_shared<Pending>();
+    pending->route = state_->routeFor(request);
+    pending->request = std::move(request);
+    pending->callback = std::move(callback);
+    state_->submit(std::move(pending));
+}
+
+void RateLimitingHttpClient::sendStreaming(const HttpRequest& request, StreamHandler handler) {
+    sendStreaming(HttpRequest(request), std::move(handler));
+}
+
+void RateLimitingHttpClient::sendStreaming(HttpRequest&& request, StreamHandler handler) {
+    std::shared_ptr<Pending> pending = std::make_shared<Pending>();
+    pending->route = state_->routeFor(request);
+    pending->request = std::move(request);
+    pending->handler = std::move(handler);
+    pending->streaming = true;
+    state_->submit(std::move(pending));
+}
+
+double RateLimitingHttpClient::currentRate(const HttpRequest& request) const {
+    const Bucket* route = state_->routeFor(request);
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    double rate = state_->host.limited() ? state_->host.rate : 0;
+    if (route != nullptr && route->limited()) {
+        rate = rate > 0 ? std::min(rate, route->rate) : route->rate;
+    }
+    return rate;
+}
+
+RateLimitStats RateLimitingHttpClient::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    RateLimitStats stats = state_->stats;
+    stats.waiting = state_->queue.size();
+    return stats;
+}
+
+} // namespace core
@@ -0,0 +1,113 @@
+//
+//  RateLimitingHttpClient.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Paces requests in front of any IHttpClient, and backs off when the server
+//  says it is overloaded, instead of answering a 429 with more requests.
+//
+//  Every request takes a token from the host bucket and, when its route
+//  (method plus path without the query) has a limit of its own, from that
+//  route's bucket too. A client talks to one host (HttpClientConfig), so one
+//  host bucket per client is one per host. Buckets refill at their rate, up
+//  to their burst.
+//
+//  A request without a token waits in a FIFO queue. Nothing blocks: a timer
+//  on the IScheduledExecutor wakes when the next queued request can go, and
+//  it is sent from there. A request still queued after maxQueueDelay, or
+//  arriving to a full queue, is shed: answered with a transportError
+//  carrying rateLimitedMessage() without reaching the inner client.
+//
+//  A 429 pauses the route's bucket (the host's if the route has none) and
+//  a 503 the host's, for Retry-After when the response has one (seconds or
+//  an HTTP-date, capped at maxRetryAfter) and retryAfterDefault otherwise;
+//  a 503 without Retry-After does not pause. Either also halves the bucket's
+//  rate, no more than once per adaptInterval and no lower than
+//  minRateFraction of its limit; each 2xx then earns back recoveryFraction
+//  of it. Requests the inner client answers while a bucket is paused are
+//  unaffected; only the ones still to be sent wait.
+//
+//  The inner client and the scheduler must outlive this client; destroying
+//  it sheds the queue.
+//
+
+#ifndef PUREMVC_CORE_RATE_LIMITING_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_RATE_LIMITING_HTTP_CLIENT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include "Domain/Ports/IScheduledExecutor.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+struct RateLimitStats {
+    std::uint64_t sent = 0;      // handed to the inner client
+    std::uint64_t queued = 0;    // went through the queue
+    std::uint64_t shed = 0;      // answered with rateLimitedMessage()
+    std::uint64_t throttled = 0; // 429 and 503 answers seen
+    std::size_t waiting = 0;     // in the queue now
+};
+
+class RateLimitingHttpClient : public IHttpClient {
+public:
+    using WallClock = std::chrono::system_clock;
+
+    struct Limit {
+        double ratePerSecond = 10; // 0 or less: no limit, pauses only
+        double burst = 10;         // tokens a quiet bucket saves up
+    };
+
+    struct Options {
+        Options() {}
+        Limit host;
+        std::map<std::string, Limit> routes; // by route, e.g. "POST /api/v1/auth/login"
+        // The route of a request; empty: method and path without the query.
+        std::function<std::string(const HttpRequest&)> route;
+        std::chrono::milliseconds maxQueueDelay{10000};
+        std::size_t maxQueueLength = 256;
+        std::chrono::milliseconds retryAfterDefault{1000}; // a 429 without Retry-After
+        std::chrono::seconds maxRetryAfter{300};
+        std::chrono::milliseconds adaptInterval{1000};
+        double minRateFraction = 0.1;
+        double recoveryFraction = 0.05;
+        std::function<WallClock::time_point()> wallClock; // Retry-After dates; empty: WallClock::now
+    };
+
+    RateLimitingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler);
+    RateLimitingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options);
+    ~RateLimitingHttpClient() override;
+
+    RateLimitingHttpClient(const RateLimitingHttpClient&) = delete;
+    RateLimitingHttpClient& operator=(const RateLimitingHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+    void send(HttpRequest&& request, Callback callback) override;
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override;
+    void sendStreaming(HttpRequest&& request, StreamHandler handler) override;
+
+    // transportErrorMessage of a shed request.
+    static const char* rateLimitedMessage() { return "Rate limited: request shed before it was sent"; }
+
+    // The rate 'request' is paced at now, after adapting: the lower of its
+    // route's and the host's; 0 when neither limits it.
+    double currentRate(const HttpRequest& request) const;
+
+    RateLimitStats stats() const;
+
+private:
+    struct Bucket;  // one token bucket: the host's or a route's
+    struct Pending; // one queued request
+    struct State;   // buckets, queue and timer, kept alive by requests in flight
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_RATE_LIMITING_HTTP_CLIENT_HPP
@@ -0,0 +1,276 @@
+//
+//  RetryingHttpClient.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/RetryingHttpClient.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <utility>
+#include "Infrastructure/Http/HttpRequestSerializer.hpp"
+
+namespace core {
+
+// One request and its attempts. Attempts are sequential, so only one thread
+// touches it at a time.
+struct RetryingHttpClient::Call {
+    HttpRequest request;
+    Callback callback;      // buffered
+    StreamHandler handler;  // streaming
+    bool streaming = false;
+    const Policy* policy = nullptr;
+    int attempt = 0;
+    std::chrono::milliseconds delay{0}; // last backoff
+    bool headDelivered = false;         // streaming: nothing may be retried now
+    bool retrying = false;              // streaming: head abandoned for a retry
+    HttpResponse last;                  // answer if the retry never happens
+};
+
+struct RetryingHttpClient::State : std::enable_shared_from_this<RetryingHttpClient::State> {
+    using TimerId = IScheduledExecutor::TimerId;
+
+    struct Pending {
+        std::shared_ptr<Call> call;
+        TimerId timer; // 0 until runAfter() has returned
+    };
+
+    State(IHttpClient& client, IScheduledExecutor& timers, Options opts)
+        : inner(client), scheduler(timers), options(std::move(opts)),
+          tokens(options.budget.maxTokens),
+          random(options.seed != 0 ? options.seed : std::random_device()()) {}
+
+    IHttpClient& inner;
+    IScheduledExecutor& scheduler;
+    const Options options;
+
+    mutable std::mutex mutex;
+    double tokens;
+    std::mt19937 random;
+    RetryStats stats;
+    std::map<std::uint64_t, Pending> pending; // by key, not timer id: see schedule()
+    std::uint64_t nextKey = 1;
+    bool closed = false;
+
+    const Policy& policyFor(const std::string& method) const {
+        auto it = options.methodPolicies.find(method);
+        return it != options.methodPolicies.end() ? it->second : options.defaultPolicy;
+    }
+
+    void start(std::shared_ptr<Call> call) {
+        call->policy = &policyFor(call->request.method);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stats.requests;
+            tokens = std::min(options.budget.maxTokens, tokens + options.budget.depositPerRequest);
+        }
+        attempt(std::move(call));
+    }
+
+    void attempt(std::shared_ptr<Call> call) {
+        ++call->attempt;
+        // Nothing is kept for a retry that cannot happen.
+        const bool lastChance = call->attempt >= call->policy->maxAttempts;
+        std::shared_ptr<State> self = shared_from_this();
+        if (!call->streaming) {
+            Callback done = [self, call](const HttpResponse& response) { self->finished(call, response); };
+            if (lastChance) {
+                inner.send(std::move(call->request), std::move(done));
+            } else {
+                inner.send(call->request, std::move(done));
+            }
+            return;
+        }
+
+        StreamHandler handler;
+        handler.onHeaders = [self, call](const HttpResponse& head) {
+            if (self->shouldRetry(*call, head)) {
+                call->retrying = true;
+                call->last = head;
+                return false;
+            }
+            call->headDelivered = true;
+            return !call->handler.onHeaders || call->handler.onHeaders(head);
+        };
+        handler.onBody = [call](const char* data, std::size_t size) {
+            return !call->handler.onBody || call->handler.onBody(data, size);
+        };
+        handler.onComplete = [self, call](const HttpResponse& response) {
+            if (call->retrying) {
+                call->retrying = false;
+                self->schedule(call);
+            } else if (!call->headDelivered && self->shouldRetry(*call, response)) {
+                call->last = response;
+                self->schedule(call);
+            } else if (call->handler.onComplete) {
+                call->handler.onComplete(response);
+            }
+        };
+        if (lastChance) {
+            inner.sendStreaming(std::move(call->request), std::move(handler));
+        } else {
+            inner.sendStreaming(call->request, std::move(handler));
+        }
+    }
+
+    void finished(const std::shared_ptr<Call>& call, const HttpResponse& response) {
+        if (!shouldRetry(*call, response)) {
+            call->callback(response);
+            return;
+        }
+        call->last = response;
+        schedule(call);
+    }
+
+    // Whether 'response' gets another attempt. A yes spends a retry token.
+    bool shouldRetry(const Call& call, const HttpResponse& response) {
+        const Policy& policy = *call.policy;
+        if (call.attempt >= policy.maxAttempts) {
+            return false;
+        }
+        const bool retryable =
+            response.transportError
+                ? policy.retryTransportErrors &&
+                      response.transportErrorMessage != IHttpClient::streamCancelledMessage()
+                : std::find(policy.retryStatuses.begin(), policy.retryStatuses.end(), response.status) !=
+                      policy.retryStatuses.end();
+        if (!retryable) {
+            return false;
+        }
+        if (!policy.retryNonIdempotent && !isIdempotentMethod(call.request.method) &&
+            !call.request.headers.contains("Idempotency-Key")) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed) {
+            return false;
+        }
+        if (tokens < 1) {
+            ++stats.budgetExhausted;
+            return false;
+        }
+        tokens -= 1;
+        ++stats.retries;
+        return true;
+    }
+
+    std::chrono::milliseconds nextDelay(Call& call) {
+        const Policy& policy = *call.policy;
+        const std::int64_t base = std::max<std::int64_t>(0, policy.baseDelay.count());
+        const std::int64_t ceiling = std::max(base, static_cast<std::int64_t>(call.delay.count()) * 3);
+        std::int64_t drawn = base;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            drawn = std::uniform_int_distribution<std::int64_t>(base, ceiling)(random);
+        }
+        call.delay = std::chrono::milliseconds(std::min<std::int64_t>(drawn, policy.maxDelay.count()));
+        return call.delay;
+    }
+
+    // The timer task looks its call up by key and runs only if it is still
+    // there, so it and the destructor never both answer it. The key exists
+    // before the timer does: a scheduler may fire before runAfter() returns.
+    void schedule(const std::shared_ptr<Call>& call) {
+        const std::chrono::milliseconds delay = nextDelay(*call);
+        std::uint64_t key = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            key = nextKey++;
+            pending[key] = Pending{call, 0};
+        }
+        std::shared_ptr<State> self = shared_from_this();
+        const TimerId timer = scheduler.runAfter(delay, [self, key]() { self->fire(key); });
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pending.find(key);
+        if (it != pending.end()) {
+            it->second.timer = timer;
+        }
+    }
+
+    void fire(std::uint64_t key) {
+        std::shared_ptr<Call> call;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = pending.find(key);
+            if (it == pending.end()) {
+                return; // answered by the destructor
+            }
+            call = std::move(it->second.call);
+            pending.erase(it);
+        }
+        attempt(std::move(call));
+    }
+
+    static void answer(Call& call) {
+        if (!call.streaming) {
+            call.callback(call.last);
+        } else if (call.last.transportError) {
+            if (call.handler.onComplete) {
+                call.handler.onComplete(call.last);
+            }
+        } else {
+            replayBuffered(call.handler, call.last); // the head; its body was not kept
+        }
+    }
+
+    void close() {
+        std::map<std::uint64_t, Pending> abandoned;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            abandoned.swap(pending);
+        }
+        for (auto& entry : abandoned) {
+            if (entry.second.timer != 0) {
+                scheduler.cancel(entry.second.timer);
+            }
+            answer(*entry.second.call);
+        }
+    }
+};
+
+RetryingHttpClient::RetryingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler)
+    : RetryingHttpClient(inner, scheduler, Options()) {}
+
+RetryingHttpClient::RetryingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options)
+    : state_(std::make_shared<State>(inner, scheduler, std::move(options))) {}
+
+RetryingHttpClient::~RetryingHttpClient() {
+    state_->close();
+}
+
+void RetryingHttpClient::send(const HttpRequest& request, Callback callback) {
+    send(HttpRequest(request), std::move(callback));
+}
+
+void RetryingHttpClient::send(HttpRequest&& request, Callback callback) {
+    std::shared_ptr<Call> call = std::make_shared<Call>();
+    call->request = std::move(request);
+    call->callback = std::move(callback);
+    state_->start(std::move(call));
+}
+
+void RetryingHttpClient::sendStreaming(const HttpRequest& request, StreamHandler handler) {
+    sendStreaming(HttpRequest(request), std::move(handler));
+}
+
+void RetryingHttpClient::sendStreaming(HttpRequest&& request, StreamHandler handler) {
+    std::shared_ptr<Call> call = std::make_shared<Call>();
+    call->request = std::move(request);
+    call->handler = std::move(handler);
+    call->streaming = true;
+    state_->start(std::move(call));
+}
+
+RetryStats RetryingHttpClient::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->stats;
+}
+
+double RetryingHttpClient::availableRetryTokens() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->tokens;
+}
+
+} // namespace core
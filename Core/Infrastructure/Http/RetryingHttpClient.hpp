@@ -0,0 +1,100 @@
+//
+//  RetryingHttpClient.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Retries in front of any IHttpClient, so a dropped connection or a 503
+//  during a deploy does not reach the repositories (and the user) as a
+//  failure. Which responses are retried, how often and how far apart is a
+//  Policy, chosen per method. Methods that are not idempotent (POST, PATCH)
+//  are only retried when their policy allows it or the request carries an
+//  Idempotency-Key header.
+//
+//  Backoff is "decorrelated jitter": each delay is drawn between baseDelay
+//  and three times the previous one, capped at maxDelay, which spreads
+//  clients that failed together instead of sending them back in lockstep.
+//  The wait is a timer on the IScheduledExecutor; no thread sleeps.
+//
+//  A token bucket bounds retries overall: every request deposits
+//  depositPerRequest tokens (up to maxTokens) and every retry spends one.
+//  During an outage the bucket drains and requests fail after one attempt,
+//  so retries add at most that fraction to the load instead of multiplying
+//  it.
+//
+//  Streaming requests are retried only before their head reaches the
+//  handler: a response to retry is abandoned at its head, and a transport
+//  error after the head is final.
+//
+//  The inner client and the scheduler must outlive this client. Destroying
+//  it cancels pending retries and answers those requests with the response
+//  that was going to be retried.
+//
+
+#ifndef PUREMVC_CORE_RETRYING_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_RETRYING_HTTP_CLIENT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Domain/Ports/IScheduledExecutor.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+
+namespace core {
+
+struct RetryStats {
+    std::uint64_t requests = 0;         // sent through this client
+    std::uint64_t retries = 0;          // extra attempts made
+    std::uint64_t budgetExhausted = 0;  // retries refused for lack of tokens
+};
+
+class RetryingHttpClient : public IHttpClient {
+public:
+    struct Policy {
+        int maxAttempts = 3; // the first one included; 1 disables retries
+        std::chrono::milliseconds baseDelay{100};
+        std::chrono::milliseconds maxDelay{5000};
+        bool retryTransportErrors = true;
+        std::vector<int> retryStatuses{502, 503, 504};
+        bool retryNonIdempotent = false; // see the Idempotency-Key note above
+    };
+
+    struct Budget {
+        double maxTokens = 10;
+        double depositPerRequest = 0.2; // retries stay under ~20% of traffic
+    };
+
+    struct Options {
+        Policy defaultPolicy;
+        std::map<std::string, Policy> methodPolicies; // by method, e.g. "GET"
+        Budget budget;
+        std::uint32_t seed = 0; // jitter; 0 seeds from std::random_device
+    };
+
+    RetryingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler);
+    RetryingHttpClient(IHttpClient& inner, IScheduledExecutor& scheduler, Options options);
+    ~RetryingHttpClient() override;
+
+    RetryingHttpClient(const RetryingHttpClient&) = delete;
+    RetryingHttpClient& operator=(const RetryingHttpClient&) = delete;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override;
+    void send(HttpRequest&& request, Callback callback) override;
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override;
+    void sendStreaming(HttpRequest&& request, StreamHandler handler) override;
+
+    RetryStats stats() const;
+    double availableRetryTokens() const;
+
+private:
+    struct State; // budget, jitter and pending retries, kept alive by requests in flight
+    struct Call;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace core
+
+#endif // PUREMVC_CORE_RETRYING_HTTP_CLIENT_HPP
@@ -0,0 +1,119 @@
+//
+//  TlsVerification.cpp
+//  PureMVC Core — Infrastructure
+//
+
+#include "Infrastructure/Http/TlsVerification.hpp"
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+#include <openssl/x509v3.h>
+
+#include "Infrastructure/Security/Base64.hpp"
+
+namespace core {
+namespace {
+
+int pinnerIndex() {
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+
+// Chain and host checks are OpenSSL's; this adds the pins on the leaf.
+int onVerify(int preverified, X509_STORE_CTX* storeCtx) {
+    if (preverified != 1 || X509_STORE_CTX_get_error_depth(storeCtx) != 0) {
+        return preverified;
+    }
+    const SSL* ssl = static_cast<const SSL*>(
+        X509_STORE_CTX_get_ex_data(storeCtx, SSL_get_ex_data_X509_STORE_CTX_idx()));
+    const CertificatePinner* pinner = static_cast<const CertificatePinner*>(
+        SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), pinnerIndex()));
+    if (pinner == nullptr || spkiPinMatches(*pinner, X509_STORE_CTX_get_current_cert(storeCtx))) {
+        return 1;
+    }
+    X509_STORE_CTX_set_error(storeCtx, X509_V_ERR_APPLICATION_VERIFICATION);
+    return 0;
+}
+
+} // namespace
+
+std::string computeSpkiSha256Base64(X509* cert) {
+    X509_PUBKEY* pubkey = X509_get_X509_PUBKEY(cert); // internal pointer, do not free
+    unsigned char* der = nullptr;
+    int len = i2d_X509_PUBKEY(pubkey, &der);
+    if (len <= 0 || der == nullptr) {
+        return std::string();
+    }
+    unsigned char hash[SHA256_DIGEST_LENGTH];
+    SHA256(der, static_cast<size_t>(len), hash);
+    OPENSSL_free(der);
+    return base64Encode(hash, SHA256_DIGEST_LENGTH);
+}
+
+bool spkiPinMatches(const CertificatePinner& pinner, X509* leaf) {
+    if (!pinner.enabled()) {
+        return true;
+    }
+    const std::string pin = computeSpkiSha256Base64(leaf);
+    return !pin.empty() && pinner.isTrusted(pin);
+}
+
+X509_STORE* loadTrustStore(const std::string& caCertPath) {
+    X509_STORE* store = X509_STORE_new();
+    if (store == nullptr) {
+        return nullptr;
+    }
+    const int loaded = caCertPath.empty()
+        ? X509_STORE_set_default_paths(store)
+        : X509_STORE_load_locations(store, caCertPath.c_str(), nullptr);
+    if (loaded != 1) {
+        X509_STORE_free(store);
+        return nullptr;
+    }
+    return store;
+}
+
+void requireVerifiedPeer(SSL_CTX* ctx, const std::string& host, const CertificatePinner& pinner) {
+    SSL_CTX_set_ex_data(ctx, pinnerIndex(), const_cast<CertificatePinner*>(&pinner));
+    X509_VERIFY_PARAM* param = SSL_CTX_get0_param(ctx);
+    if (X509_VERIFY_PARAM_set1_ip_asc(param, host.c_str()) != 1) {
+        X509_VERIFY_PARAM_set_hostflags(param, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
+        X509_VERIFY_PARAM_set1_host(param, host.c_str(), 0);
+    }
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, onVerify);
+}
+
+SSL_CTX* newClientContext(const HttpClientConfig& config, const CertificatePinner& pinner,
+                          std::string& error) {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+    if (ctx == nullptr) {
+        error = "TLS setup failed";
+        return nullptr;
+    }
+    SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+    SSL_CTX_set_mode(ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+    SSL_CTX_set_options(ctx, SSL_OP_IGNORE_UNEXPECTED_EOF);
+#endif
+    if (!config.verifySSL) {
+        SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+        return ctx;
+    }
+    X509_STORE* store = loadTrustStore(config.caCertPath);
+    if (store == nullptr) {
+        error = config.caCertPath.empty()
+            ? std::string("Cannot load the system CA certificates")
+            : "Cannot load CA certificates from " + config.caCertPath;
+        SSL_CTX_free(ctx);
+        return nullptr;
+    }
+    SSL_CTX_set_cert_store(ctx, store); // adopts it
+    requireVerifiedPeer(ctx, config.host, pinner);
+    return ctx;
+}
+
+} // namespace core
+
+#endif // CPPHTTPLIB_OPENSSL_SUPPORT
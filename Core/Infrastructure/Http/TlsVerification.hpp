@@ -0,0 +1,56 @@
+//
+//  TlsVerification.hpp
+//  PureMVC Core — Infrastructure
+//
+//  Server verification shared by the OpenSSL-backed clients (HttplibHttpClient,
+//  AsyncHttpClient). OpenSSL does all of it during the handshake: the chain
+//  against an SSL_CTX's trust store, the host name (or IP literal) against
+//  the leaf, and SPKI pinning through CertificatePinner.
+//
+//  Only meaningful when the build enables OpenSSL (CPPHTTPLIB_OPENSSL_SUPPORT);
+//  otherwise this header declares nothing.
+//
+
+#ifndef PUREMVC_CORE_TLS_VERIFICATION_HPP
+#define PUREMVC_CORE_TLS_VERIFICATION_HPP
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+
+#include <string>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Security/CertificatePinner.hpp"
+
+namespace core {
+
+// base64(SHA-256(SubjectPublicKeyInfo DER)) for the given certificate, or "" on
+// failure. This is the value compared against the configured pins.
+std::string computeSpkiSha256Base64(X509* cert);
+
+// True when pinning is off or 'leaf' carries a pinned key.
+bool spkiPinMatches(const CertificatePinner& pinner, X509* leaf);
+
+// A new store (one reference, owned by the caller) with the PEM bundle at
+// 'caCertPath', or the system default locations when it is empty. Null if
+// nothing could be loaded.
+X509_STORE* loadTrustStore(const std::string& caCertPath);
+
+// Makes every handshake on 'ctx' fail unless the chain verifies against the
+// ctx's store, the leaf is valid for 'host', and 'pinner' (which must outlive
+// the ctx) accepts the leaf's key.
+void requireVerifiedPeer(SSL_CTX* ctx, const std::string& host, const CertificatePinner& pinner);
+
+// A TLS 1.2+ client context for the engines that drive OpenSSL themselves
+// (AsyncHttpClient, IoUringHttpClient): its own trust store and the checks
+// above when config.verifySSL, no verification otherwise. Null with 'error'
+// set if the trust store cannot be loaded.
+SSL_CTX* newClientContext(const HttpClientConfig& config, const CertificatePinner& pinner,
+                          std::string& error);
+
+} // namespace core
+
+#endif // CPPHTTPLIB_OPENSSL_SUPPORT
+
+#endif // PUREMVC_CORE_TLS_VERIFICATION_HPP
@@ -0,0 +1,38 @@
+//
+//  BenchUtil.hpp
+//  PureMVC Core benchmarks
+//
+//  Tiny timing helpers shared by the stand-alone benchmark programs. No
+//  framework: each benchmark is a plain main() that prints one line per case.
+//
+
+#ifndef PUREMVC_CORE_BENCH_UTIL_HPP
+#define PUREMVC_CORE_BENCH_UTIL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core { namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline std::int64_t nanosSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// p in [0, 100]. Sorts 'samples' in place.
+inline std::int64_t percentile(std::vector<std::int64_t>& samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    std::size_t rank = static_cast<std::size_t>(p / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(rank, samples.size() - 1)];
+}
+
+}} // namespace core::bench
+
+#endif // PUREMVC_CORE_BENCH_UTIL_HPP
@@ -0,0 +1,115 @@
+//
+//  ConnectionPoolBenchmark.cpp
+//  PureMVC Core benchmarks
+//
+//  Request latency against a loopback httplib server, with the keep-alive
+//  pool on (defaults) and off (maxIdleConnections = 0, a fresh TCP connection
+//  per request). Sequential: one caller. Concurrent: kCallers threads sharing
+//  one client. Plain HTTP, so the gap is the TCP handshake and teardown only;
+//  over TLS a full handshake is added to every unpooled request.
+//
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <httplib.h>
+
+#include "BenchUtil.hpp"
+#include "Infrastructure/Http/HttplibHttpClient.hpp"
+
+using namespace core;
+using namespace core::bench;
+
+namespace {
+
+const int kRequests = 2000;   // per case
+const int kCallers = 8;       // concurrent case
+
+class InlineExecutor : public IExecutor {
+public:
+    using IExecutor::run;
+    void run(Task task) override { task(); }
+};
+
+struct Samples {
+    std::mutex mutex;
+    std::vector<std::int64_t> latencies;
+    int failures = 0;
+};
+
+void issue(HttplibHttpClient& client, int count, Samples& samples) {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = "/ping";
+    std::vector<std::int64_t> local;
+    local.reserve(static_cast<std::size_t>(count));
+    int failures = 0;
+    for (int i = 0; i < count; ++i) {
+        const Clock::time_point start = Clock::now();
+        bool ok = false;
+        client.send(request, [&ok](const HttpResponse& response) { ok = response.ok(); });
+        local.push_back(nanosSince(start));
+        failures += ok ? 0 : 1;
+    }
+    std::lock_guard<std::mutex> lock(samples.mutex);
+    samples.latencies.insert(samples.latencies.end(), local.begin(), local.end());
+    samples.failures += failures;
+}
+
+void measure(const char* name, const HttpClientConfig& config, int callers) {
+    InlineExecutor executor;
+    HttplibHttpClient client(config, executor);
+    Samples samples;
+    samples.latencies.reserve(kRequests);
+
+    const Clock::time_point start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < callers; ++i) {
+        threads.emplace_back([&client, &samples, callers]() {
+            issue(client, kRequests / callers, samples);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const double seconds = nanosSince(start) / 1e9;
+
+    const ConnectionPoolStats stats = client.poolStats();
+    std::printf("%-22s %7.0f req/s  p50 %7.1f us  p99 %7.1f us  connections %5llu  failed %d\n",
+                name, static_cast<double>(samples.latencies.size()) / seconds,
+                percentile(samples.latencies, 50) / 1e3,
+                percentile(samples.latencies, 99) / 1e3,
+                static_cast<unsigned long long>(stats.opened), samples.failures);
+}
+
+} // namespace
+
+int main() {
+    httplib::Server server;
+    server.set_tcp_nodelay(true); // as production servers do; see configure()
+    server.Get("/ping", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("pong", "text/plain");
+    });
+    const int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&server]() { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    HttpClientConfig pooled;
+    pooled.host = "127.0.0.1";
+    pooled.port = port;
+    pooled.useSSL = false;
+    HttpClientConfig unpooled = pooled;
+    unpooled.maxIdleConnections = 0;
+
+    measure("sequential, no pool", unpooled, 1);
+    measure("sequential, pooled", pooled, 1);
+    measure("concurrent, no pool", unpooled, kCallers);
+    measure("concurrent, pooled", pooled, kCallers);
+
+    server.stop();
+    listener.join();
+    return 0;
+}
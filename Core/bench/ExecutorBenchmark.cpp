@@ -0,0 +1,67 @@
+//
+//  ExecutorBenchmark.cpp
+//  PureMVC Core benchmarks
+//
+//  Throughput (tasks/sec) and p99 enqueue-to-start latency of the IExecutor
+//  implementations, for small tasks posted from a single producer.
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "BenchUtil.hpp"
+#include "Infrastructure/Concurrency/ThreadExecutor.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+
+using namespace core;
+using namespace core::bench;
+
+namespace {
+
+void measure(const char* name, IExecutor& executor, int tasks) {
+    std::vector<std::int64_t> latencies(static_cast<std::size_t>(tasks));
+    std::atomic<int> remaining{tasks};
+    std::mutex mutex;
+    std::condition_variable done;
+
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < tasks; ++i) {
+        const Clock::time_point enqueued = Clock::now();
+        std::int64_t* slot = &latencies[static_cast<std::size_t>(i)];
+        executor.run([slot, enqueued, &remaining, &mutex, &done]() {
+            *slot = nanosSince(enqueued);
+            if (remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_one();
+            }
+        });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&remaining]() { return remaining.load() == 0; });
+    }
+    const double seconds = static_cast<double>(nanosSince(start)) / 1e9;
+
+    std::printf("%-24s %8d tasks  %12.0f tasks/s  p50 %8.1f us  p99 %8.1f us\n",
+                name, tasks, tasks / seconds,
+                percentile(latencies, 50) / 1e3, percentile(latencies, 99) / 1e3);
+}
+
+} // namespace
+
+int main() {
+    const int kTasks = 20000;
+    {
+        ThreadExecutor executor;
+        measure("ThreadExecutor", executor, kTasks);
+    }
+    {
+        WorkStealingExecutor executor;
+        measure("WorkStealingExecutor", executor, kTasks);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+//
+//  OverloadBenchmark.cpp
+//  PureMVC Core benchmarks
+//
+//  Synthetic overload: a producer offers fixed-cost tasks at twice the rate
+//  the pool can complete them. Unbounded, every task is accepted and queueing
+//  delay grows for as long as the overload lasts; behind a BoundedExecutor
+//  the excess is refused and accepted work keeps a flat p99.
+//
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "BenchUtil.hpp"
+#include "Infrastructure/Concurrency/BoundedExecutor.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+
+using namespace core;
+using namespace core::bench;
+
+namespace {
+
+const std::size_t kWorkers = 2;
+const std::int64_t kTaskNanos = 100000;  // 100 us of work per task
+const int kOffered = 20000;              // tasks over the run
+
+void spinFor(std::int64_t nanos) {
+    const Clock::time_point start = Clock::now();
+    while (nanosSince(start) < nanos) {
+    }
+}
+
+// Records the latency of each task that completes (rejected ones never do).
+struct Completion {
+    std::mutex mutex;
+    std::vector<std::int64_t> latencies;
+};
+
+struct TimedTask {
+    Completion* completion;
+    Clock::time_point posted;
+    void operator()() {
+        spinFor(kTaskNanos);
+        const std::int64_t latency = nanosSince(posted);
+        std::lock_guard<std::mutex> lock(completion->mutex);
+        completion->latencies.push_back(latency);
+    }
+};
+
+void measure(const char* name, IExecutor& executor, WorkStealingExecutor& pool) {
+    Completion completion;
+    completion.latencies.reserve(kOffered);
+    // Twice the pool's throughput: one task every kTaskNanos / (2 * kWorkers).
+    const std::int64_t interval = kTaskNanos / static_cast<std::int64_t>(2 * kWorkers);
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < kOffered; ++i) {
+        while (nanosSince(start) < interval * i) {
+        }
+        executor.run(TimedTask{&completion, Clock::now()});
+    }
+    pool.shutdown();
+
+    std::printf("%-28s accepted %6zu / %d  p50 %9.1f us  p99 %9.1f us\n",
+                name, completion.latencies.size(), kOffered,
+                percentile(completion.latencies, 50) / 1e3,
+                percentile(completion.latencies, 99) / 1e3);
+}
+
+} // namespace
+
+int main() {
+    {
+        WorkStealingExecutor pool(kWorkers);
+        measure("unbounded", pool, pool);
+    }
+    {
+        WorkStealingExecutor pool(kWorkers);
+        BoundedExecutor::Options options;
+        options.maxConcurrency = kWorkers;
+        options.queueCapacity = 16;
+        options.policy = RejectionPolicy::failFast;
+        BoundedExecutor bounded(pool, options);
+        measure("bounded (failFast, 16)", bounded, pool);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+//
+//  AllocationCounter.cpp
+//  PureMVC Core tests
+//
+//  Replaces the global allocation functions for the test binary. Counting is
+//  per thread and only while an AllocationScope is alive, so background
+//  threads (servers, pools) never perturb a test's numbers.
+//
+
+#include "Mocks/AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local int tlsDepth = 0;
+thread_local std::size_t tlsCount = 0;
+thread_local std::size_t tlsBytes = 0;
+
+void* countedAlloc(std::size_t size) {
+    if (tlsDepth > 0) {
+        ++tlsCount;
+        tlsBytes += size;
+    }
+    void* p = std::malloc(size == 0 ? 1 : size);
+    return p;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* p = countedAlloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace core { namespace test {
+
+AllocationScope::AllocationScope() : startCount_(tlsCount), startBytes_(tlsBytes) {
+    ++tlsDepth;
+}
+
+AllocationScope::~AllocationScope() {
+    --tlsDepth;
+}
+
+std::size_t AllocationScope::count() const { return tlsCount - startCount_; }
+std::size_t AllocationScope::bytes() const { return tlsBytes - startBytes_; }
+
+}} // namespace core::test
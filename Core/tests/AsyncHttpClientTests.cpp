@@ -0,0 +1,70 @@
+//
+//  AsyncHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  What only AsyncHttpClient has: several event loops, each with its own
+//  share of the pool. The contract it shares with IoUringHttpClient is
+//  tested in NonBlockingHttpClientTests.cpp. Linux only.
+//
+
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "Infrastructure/Http/AsyncHttpClient.hpp"
+#include "Mocks/LocalHttpServer.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using test::await;
+using test::get;
+
+class AsyncHttpClientTest : public ::testing::Test {
+protected:
+    test::LocalHttpServer server;
+};
+
+TEST_F(AsyncHttpClientTest, SpreadsRequestsOverSeveralLoops) {
+    test::SyncExecutor executor;
+    AsyncHttpClient::Options options;
+    options.loops = 2;
+    AsyncHttpClient client(server.config(), executor, options);
+
+    EXPECT_TRUE(await(client, get("/port")).ok());
+    EXPECT_TRUE(await(client, get("/port")).ok());
+    EXPECT_TRUE(await(client, get("/port")).ok());
+
+    // Each loop keeps its own connections: two opened, the third reused.
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 2u);
+    EXPECT_EQ(stats.reused, 1u);
+}
+
+TEST_F(AsyncHttpClientTest, SharesTheConnectionCapBetweenLoops) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = server.config();
+    c.maxConnectionsPerHost = 2;
+    AsyncHttpClient::Options options;
+    options.loops = 2;
+    AsyncHttpClient client(c, executor, options);
+
+    // One slot per loop: the third request waits for the first to finish.
+    std::future<HttpResponse> first = test::sendAsync(client, get("/hold"));
+    std::future<HttpResponse> second = test::sendAsync(client, get("/hold"));
+    std::future<HttpResponse> third = test::sendAsync(client, get("/port"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(test::isReady(third));
+
+    server.release();
+
+    EXPECT_TRUE(first.get().ok());
+    EXPECT_TRUE(second.get().ok());
+    EXPECT_TRUE(third.get().ok());
+    EXPECT_EQ(client.poolStats().opened, 2u);
+}
+
+#endif // defined(__linux__)
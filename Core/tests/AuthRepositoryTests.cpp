@@ -48,6 +48,7 @@ TEST(AuthRepository, BuildsPostJsonRequestToLoginPath) {
     EXPECT_EQ(http.lastRequest.method, "POST");
     EXPECT_EQ(http.lastRequest.path, "/api/v1/auth/login");
     EXPECT_EQ(http.lastRequest.contentType, "application/json");
+    EXPECT_EQ(http.lastRequest.priority, TaskPriority::interactive);
 
     json sent = json::parse(http.lastRequest.body);
     EXPECT_EQ(sent.at("email"), "user@example.com");
@@ -0,0 +1,150 @@
+//
+//  BoundedExecutorTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Infrastructure/Concurrency/BoundedExecutor.hpp"
+#include "Mocks/DeferredExecutor.hpp"
+
+using namespace core;
+
+namespace {
+
+// Records whether it ran or was destroyed unrun.
+struct Probe {
+    std::vector<int>* ran;
+    std::vector<int>* dropped;
+    int id;
+    bool armed = true;
+
+    Probe(std::vector<int>* r, std::vector<int>* d, int i) : ran(r), dropped(d), id(i) {}
+    Probe(Probe&& other) noexcept : ran(other.ran), dropped(other.dropped), id(other.id) {
+        other.armed = false;
+    }
+    ~Probe() {
+        if (armed) {
+            dropped->push_back(id);
+        }
+    }
+    void operator()() {
+        armed = false;
+        ran->push_back(id);
+    }
+};
+
+BoundedExecutor::Options options(std::size_t concurrency, std::size_t capacity, RejectionPolicy policy) {
+    BoundedExecutor::Options o;
+    o.maxConcurrency = concurrency;
+    o.queueCapacity = capacity;
+    o.policy = policy;
+    return o;
+}
+
+} // namespace
+
+TEST(BoundedExecutor, LimitsConcurrencyAndQueuesInOrder) {
+    test::DeferredExecutor pool;
+    BoundedExecutor executor(pool, options(2, 10, RejectionPolicy::failFast));
+    std::vector<int> ran, dropped;
+
+    for (int i = 0; i < 5; ++i) {
+        executor.run(Probe(&ran, &dropped, i));
+    }
+    EXPECT_EQ(pool.queued.size(), 2u); // only the permitted ones reach the pool
+    EXPECT_EQ(executor.runningCount(), 2u);
+    EXPECT_EQ(executor.queuedCount(), 3u);
+
+    pool.runAll(); // each completion releases the next queued task
+    EXPECT_EQ(ran, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_TRUE(dropped.empty());
+    EXPECT_EQ(executor.runningCount(), 0u);
+    EXPECT_EQ(executor.rejectedCount(), 0u);
+}
+
+TEST(BoundedExecutor, FailFastDestroysTheNewTask) {
+    test::DeferredExecutor pool;
+    BoundedExecutor executor(pool, options(1, 1, RejectionPolicy::failFast));
+    std::vector<int> ran, dropped;
+
+    executor.run(Probe(&ran, &dropped, 0)); // running
+    executor.run(Probe(&ran, &dropped, 1)); // queued
+    executor.run(Probe(&ran, &dropped, 2)); // rejected
+    EXPECT_EQ(dropped, (std::vector<int>{2}));
+    EXPECT_EQ(executor.rejectedCount(), 1u);
+
+    pool.runAll();
+    EXPECT_EQ(ran, (std::vector<int>{0, 1}));
+}
+
+TEST(BoundedExecutor, ATaskTheUnderlyingExecutorDropsGivesItsPermitBack) {
+    test::DeferredExecutor pool;
+    BoundedExecutor executor(pool, options(1, 1, RejectionPolicy::failFast));
+    std::vector<int> ran, dropped;
+
+    executor.run(Probe(&ran, &dropped, 0)); // running
+    executor.run(Probe(&ran, &dropped, 1)); // queued
+    std::vector<Task> discarded;
+    discarded.swap(pool.queued);
+    discarded.clear(); // e.g. the pool shutting down
+    EXPECT_EQ(dropped, (std::vector<int>{0}));
+    ASSERT_EQ(pool.queued.size(), 1u); // the permit passed to the queued task
+
+    pool.runAll();
+    EXPECT_EQ(ran, (std::vector<int>{1}));
+    EXPECT_EQ(executor.runningCount(), 0u);
+    EXPECT_EQ(executor.rejectedCount(), 0u);
+}
+
+TEST(BoundedExecutor, DropOldestReplacesTheLongestWaitingTask) {
+    test::DeferredExecutor pool;
+    BoundedExecutor executor(pool, options(1, 2, RejectionPolicy::dropOldest));
+    std::vector<int> ran, dropped;
+
+    for (int i = 0; i < 5; ++i) {
+        executor.run(Probe(&ran, &dropped, i));
+    }
+    EXPECT_EQ(dropped, (std::vector<int>{1, 2}));
+    EXPECT_EQ(executor.rejectedCount(), 2u);
+
+    pool.runAll();
+    EXPECT_EQ(ran, (std::vector<int>{0, 3, 4}));
+}
+
+TEST(BoundedExecutor, CallerRunsExecutesInlineOnThePostingThread) {
+    test::DeferredExecutor pool;
+    BoundedExecutor executor(pool, options(1, 0, RejectionPolicy::callerRuns));
+    std::vector<int> ran, dropped;
+
+    executor.run(Probe(&ran, &dropped, 0));
+    executor.run(Probe(&ran, &dropped, 1)); // no room: runs right here
+    EXPECT_EQ(ran, (std::vector<int>{1}));
+    EXPECT_EQ(executor.rejectedCount(), 1u);
+
+    pool.runAll();
+    EXPECT_EQ(ran, (std::vector<int>{1, 0}));
+    EXPECT_TRUE(dropped.empty());
+}
+
+TEST(BoundedExecutor, ForwardsPriorityToTheUnderlyingExecutor) {
+    struct LaneRecorder : IExecutor {
+        std::vector<TaskPriority> lanes;
+        void run(Task task) override { run(std::move(task), TaskPriority::normal); }
+        void run(Task task, TaskPriority priority) override {
+            lanes.push_back(priority);
+            task();
+        }
+    } recorder;
+    BoundedExecutor executor(recorder, options(1, 4, RejectionPolicy::failFast));
+
+    executor.run([]() {}, TaskPriority::interactive);
+    executor.run([]() {});
+
+    EXPECT_EQ(recorder.lanes,
+              (std::vector<TaskPriority>{TaskPriority::interactive, TaskPriority::normal}));
+}
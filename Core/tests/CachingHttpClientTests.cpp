@@ -0,0 +1,344 @@
+//
+//  CachingHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  CachingHttpClient on a test clock: freshness from max-age, Expires and
+//  Last-Modified, revalidation with validators, stale-while-revalidate,
+//  what is never stored, invalidation, Vary, the memory budget, and the
+//  disk tier across client instances.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Infrastructure/Http/CachingHttpClient.hpp"
+#include "Mocks/FakeHttpClient.hpp"
+#include "Mocks/HeldHttpClient.hpp"
+
+using namespace core;
+using std::chrono::seconds;
+
+namespace {
+
+const char kDate[] = "Thu, 01 Jan 2026 00:00:00 GMT"; // the test clock's start
+
+HttpResponse ok(const std::string& body, std::initializer_list<std::pair<std::string, std::string>> headers) {
+    HttpResponse response;
+    response.status = 200;
+    response.body = body;
+    response.headers = HttpHeaders(headers);
+    return response;
+}
+
+HttpResponse notModified() {
+    HttpResponse response;
+    response.status = 304;
+    return response;
+}
+
+HttpRequest get(const std::string& path) {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = path;
+    return request;
+}
+
+} // namespace
+
+class CachingHttpClientTest : public ::testing::Test {
+protected:
+    CachingHttpClient::WallClock::time_point now =
+        CachingHttpClient::WallClock::time_point(seconds(1767225600)); // kDate
+    test::FakeHttpClient inner;
+
+    CachingHttpClient::Options options() {
+        CachingHttpClient::Options o;
+        o.now = [this]() { return now; };
+        return o;
+    }
+
+    static HttpResponse sendNow(IHttpClient& client, const HttpRequest& request) {
+        HttpResponse answer;
+        client.send(request, [&answer](const HttpResponse& r) { answer = r; });
+        return answer;
+    }
+};
+
+TEST_F(CachingHttpClientTest, FreshResponsesNeverReachTheNetworkAndStaleOnesRevalidate) {
+    CachingHttpClient cache(inner, options());
+    inner.script = {ok("profile", {{"Cache-Control", "max-age=60"}, {"ETag", "\"v1\""}})};
+
+    EXPECT_EQ(sendNow(cache, get("/me")).body, "profile");
+    now += seconds(59);
+    EXPECT_EQ(sendNow(cache, get("/me")).body, "profile");
+    EXPECT_EQ(inner.sendCallCount, 1);
+
+    now += seconds(1);
+    inner.script = {notModified()};
+    HttpResponse revalidated = sendNow(cache, get("/me"));
+
+    EXPECT_EQ(inner.sendCallCount, 2);
+    EXPECT_EQ(inner.lastRequest.headers.get(HttpHeader::ifNoneMatch), "\"v1\"");
+    EXPECT_EQ(revalidated.status, 200);
+    EXPECT_EQ(revalidated.body, "profile");
+    EXPECT_EQ(sendNow(cache, get("/me")).body, "profile"); // fresh again
+    EXPECT_EQ(inner.sendCallCount, 2);
+
+    CacheStats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.revalidations, 1u);
+    EXPECT_EQ(stats.notModified, 1u);
+}
+
+TEST_F(CachingHttpClientTest, ExpiresCountsFromDateAndLastModifiedGivesAHeuristic) {
+    CachingHttpClient cache(inner, options());
+    inner.script = {ok("a", {{"Date", kDate}, {"Expires", "Thu, 01 Jan 2026 00:00:30 GMT"}}),
+                    // Modified 1000 s before Date: fresh for a tenth of that.
+                    ok("b", {{"Date", kDate}, {"Last-Modified", "Wed, 31 Dec 2025 23:43:20 GMT"}})};
+    sendNow(cache, get("/a"));
+    sendNow(cache, get("/b"));
+
+    now += seconds(29);
+    sendNow(cache, get("/a"));
+    EXPECT_EQ(inner.sendCallCount, 2);
+    now += seconds(1);
+    sendNow(cache, get("/a")); // no validator: fetched again
+    EXPECT_EQ(inner.sendCallCount, 3);
+    EXPECT_FALSE(inner.lastRequest.headers.contains(HttpHeader::ifNoneMatch));
+
+    now += seconds(69);
+    sendNow(cache, get("/b"));
+    EXPECT_EQ(inner.sendCallCount, 3);
+    now += seconds(1);
+    inner.script = {notModified()};
+    EXPECT_EQ(sendNow(cache, get("/b")).body, "b");
+    EXPECT_EQ(inner.lastRequest.headers.get(HttpHeader::ifModifiedSince), "Wed, 31 Dec 2025 23:43:20 GMT");
+}
+
+TEST_F(CachingHttpClientTest, StaleWhileRevalidateAnswersAtOnceAndRefreshesInTheBackground) {
+    test::HeldHttpClient held;
+    CachingHttpClient cache(held, options());
+    cache.send(get("/feed"), [](const HttpResponse&) {});
+    held.answer(0, ok("old", {{"Cache-Control", "max-age=10, stale-while-revalidate=30"}, {"ETag", "\"1\""}}));
+
+    now += seconds(15);
+    EXPECT_EQ(sendNow(cache, get("/feed")).body, "old");
+    EXPECT_EQ(sendNow(cache, get("/feed")).body, "old");
+    ASSERT_EQ(held.held.size(), 2u); // one background request for both
+    EXPECT_EQ(held.held[1].request.headers.get(HttpHeader::ifNoneMatch), "\"1\"");
+
+    held.answer(1, ok("new", {{"Cache-Control", "max-age=10"}, {"ETag", "\"2\""}}));
+    EXPECT_EQ(sendNow(cache, get("/feed")).body, "new");
+    EXPECT_EQ(cache.stats().staleServed, 2u);
+
+    now += seconds(50); // past the stale window
+    HttpResponse waited;
+    cache.send(get("/feed"), [&waited](const HttpResponse& r) { waited = r; });
+    EXPECT_EQ(waited.status, 0);
+    ASSERT_EQ(held.held.size(), 3u);
+}
+
+TEST_F(CachingHttpClientTest, NoStoreIsNeverKeptAndNoCacheAlwaysRevalidates) {
+    CachingHttpClient cache(inner, options());
+    inner.responseToReturn = ok("secret", {{"Cache-Control", "no-store, max-age=60"}});
+    sendNow(cache, get("/secret"));
+    sendNow(cache, get("/secret"));
+    EXPECT_EQ(inner.sendCallCount, 2);
+
+    inner.script = {ok("checked", {{"Cache-Control", "no-cache"}, {"ETag", "\"c\""}}), notModified()};
+    sendNow(cache, get("/checked"));
+    EXPECT_EQ(sendNow(cache, get("/checked")).body, "checked");
+    EXPECT_EQ(inner.lastRequest.headers.get(HttpHeader::ifNoneMatch), "\"c\"");
+
+    inner.script = {ok("x", {{"Cache-Control", "max-age=60"}}), ok("x", {{"Cache-Control", "max-age=60"}})};
+    sendNow(cache, get("/x"));
+    HttpRequest reload = get("/x");
+    reload.headers.set(HttpHeader::cacheControl, "no-cache");
+    sendNow(cache, reload);
+    EXPECT_EQ(inner.sendCallCount, 6);
+    EXPECT_EQ(cache.stats().memoryEntries, 2u);
+}
+
+TEST_F(CachingHttpClientTest, ASuccessfulChangeDropsTheStoredResponse) {
+    CachingHttpClient cache(inner, options());
+    inner.script = {ok("v1", {{"Cache-Control", "max-age=60"}})};
+    sendNow(cache, get("/items/1"));
+
+    HttpRequest put = get("/items/1");
+    put.method = "PUT";
+    put.body = "{}";
+    inner.script = {ok("", {})};
+    sendNow(cache, put);
+
+    inner.script = {ok("v2", {{"Cache-Control", "max-age=60"}})};
+    EXPECT_EQ(sendNow(cache, get("/items/1")).body, "v2");
+    EXPECT_EQ(inner.sendCallCount, 3);
+}
+
+TEST_F(CachingHttpClientTest, VaryingRequestHeadersMustMatch) {
+    CachingHttpClient cache(inner, options());
+    HttpRequest english = get("/greeting");
+    english.headers.set("Accept-Language", "en");
+    HttpRequest french = get("/greeting");
+    french.headers.set("Accept-Language", "fr");
+    inner.script = {ok("hello", {{"Cache-Control", "max-age=60"}, {"Vary", "Accept-Language"}}),
+                    ok("bonjour", {{"Cache-Control", "max-age=60"}, {"Vary", "Accept-Language"}})};
+
+    EXPECT_EQ(sendNow(cache, english).body, "hello");
+    EXPECT_EQ(sendNow(cache, english).body, "hello");
+    EXPECT_EQ(sendNow(cache, french).body, "bonjour");
+    EXPECT_EQ(inner.sendCallCount, 2);
+}
+
+TEST_F(CachingHttpClientTest, AnswersToAuthorizedRequestsAreKeptOnlyWhenAllowedAndPerCredential) {
+    CachingHttpClient cache(inner, options());
+    HttpRequest ada = get("/me");
+    ada.headers.set(HttpHeader::authorization, "Bearer ada");
+    HttpRequest bob = get("/me");
+    bob.headers.set(HttpHeader::authorization, "Bearer bob");
+
+    inner.responseToReturn = ok("private", {{"Cache-Control", "max-age=60"}});
+    sendNow(cache, ada);
+    sendNow(cache, ada);
+    EXPECT_EQ(inner.sendCallCount, 2);
+    EXPECT_EQ(cache.stats().memoryEntries, 0u);
+
+    inner.script = {ok("ada's", {{"Cache-Control", "public, max-age=60"}}),
+                    ok("bob's", {{"Cache-Control", "public, max-age=60"}})};
+    EXPECT_EQ(sendNow(cache, ada).body, "ada's");
+    EXPECT_EQ(sendNow(cache, ada).body, "ada's");
+    EXPECT_EQ(inner.sendCallCount, 3);
+    EXPECT_EQ(sendNow(cache, bob).body, "bob's"); // never another user's answer
+    EXPECT_EQ(inner.sendCallCount, 4);
+}
+
+TEST_F(CachingHttpClientTest, MemoryBudgetEvictsTheLeastRecentlyUsed) {
+    CachingHttpClient::Options o = options();
+    o.memoryEntries = 2;
+    CachingHttpClient cache(inner, o);
+    inner.responseToReturn = ok("body", {{"Cache-Control", "max-age=60"}});
+
+    sendNow(cache, get("/a"));
+    sendNow(cache, get("/b"));
+    sendNow(cache, get("/a"));
+    sendNow(cache, get("/c")); // evicts /b
+    EXPECT_EQ(inner.sendCallCount, 3);
+    sendNow(cache, get("/a"));
+    EXPECT_EQ(inner.sendCallCount, 3);
+    sendNow(cache, get("/b"));
+    EXPECT_EQ(inner.sendCallCount, 4);
+
+    CacheStats stats = cache.stats();
+    EXPECT_EQ(stats.memoryEntries, 2u);
+    EXPECT_EQ(stats.evictions, 2u);
+
+    o.memoryBytes = 64; // smaller than any entry
+    CachingHttpClient tiny(inner, o);
+    sendNow(tiny, get("/a"));
+    EXPECT_EQ(tiny.stats().memoryEntries, 0u);
+}
+
+TEST_F(CachingHttpClientTest, FreshStreamingRequestsAreReplayedFromTheCache) {
+    CachingHttpClient cache(inner, options());
+    inner.script = {ok("streamed", {{"Cache-Control", "max-age=60"}})};
+    sendNow(cache, get("/file"));
+
+    std::string body;
+    IHttpClient::StreamHandler handler;
+    handler.onBody = [&body](const char* data, std::size_t size) {
+        body.append(data, size);
+        return true;
+    };
+    cache.sendStreaming(get("/file"), handler);
+
+    EXPECT_EQ(body, "streamed");
+    EXPECT_EQ(inner.sendCallCount, 1);
+}
+
+class CachingHttpClientDiskTest : public CachingHttpClientTest {
+protected:
+    std::string directory;
+
+    void SetUp() override {
+        char pattern[] = "/tmp/puremvc-cache-XXXXXX";
+        ASSERT_NE(::mkdtemp(pattern), nullptr);
+        directory = pattern;
+    }
+
+    void TearDown() override {
+        CachingHttpClient::Options o = options();
+        o.diskDirectory = directory;
+        CachingHttpClient(inner, o).clear();
+        ::rmdir(directory.c_str());
+    }
+
+    CachingHttpClient::Options diskOptions() {
+        CachingHttpClient::Options o = options();
+        o.diskDirectory = directory;
+        return o;
+    }
+};
+
+TEST_F(CachingHttpClientDiskTest, EntriesOutliveTheClient) {
+    inner.script = {ok("persisted", {{"Cache-Control", "max-age=60"}, {"ETag", "\"p\""}, {"Vary", "Accept"}})};
+    {
+        CachingHttpClient cache(inner, diskOptions());
+        sendNow(cache, get("/doc"));
+        EXPECT_EQ(cache.stats().diskEntries, 1u);
+    }
+
+    CachingHttpClient reopened(inner, diskOptions());
+    EXPECT_EQ(reopened.stats().diskEntries, 1u);
+    EXPECT_EQ(reopened.stats().memoryEntries, 0u);
+    HttpResponse answer = sendNow(reopened, get("/doc"));
+
+    EXPECT_EQ(answer.body, "persisted");
+    EXPECT_EQ(answer.headers.get(HttpHeader::etag), "\"p\"");
+    EXPECT_EQ(inner.sendCallCount, 1);
+    EXPECT_EQ(reopened.stats().memoryEntries, 1u); // promoted
+}
+
+TEST_F(CachingHttpClientDiskTest, AnswersToAuthorizedRequestsStayOffDisk) {
+    CachingHttpClient cache(inner, diskOptions());
+    inner.script = {ok("anyone's", {{"Cache-Control", "max-age=0"}, {"ETag", "\"1\""}}),
+                    ok("ada's", {{"Cache-Control", "must-revalidate, max-age=60"}})};
+    sendNow(cache, get("/me"));
+    EXPECT_EQ(cache.stats().diskEntries, 1u);
+
+    HttpRequest ada = get("/me");
+    ada.headers.set(HttpHeader::authorization, "Bearer ada");
+    EXPECT_EQ(sendNow(cache, ada).body, "ada's");
+    EXPECT_EQ(sendNow(cache, ada).body, "ada's");
+    EXPECT_EQ(inner.sendCallCount, 2);
+    EXPECT_EQ(cache.stats().diskEntries, 0u); // and the older answer is gone from there too
+
+    cache.clear();
+    EXPECT_EQ(cache.stats().memoryEntries, 0u);
+}
+
+TEST_F(CachingHttpClientDiskTest, DiskBudgetEvictsAndMemoryStillServes) {
+    CachingHttpClient::Options o = diskOptions();
+    o.diskBytes = 300; // one small entry
+    CachingHttpClient cache(inner, o);
+    inner.responseToReturn = ok(std::string(100, 'x'), {{"Cache-Control", "max-age=60"}});
+
+    sendNow(cache, get("/one"));
+    sendNow(cache, get("/two"));
+
+    CacheStats stats = cache.stats();
+    EXPECT_EQ(stats.diskEntries, 1u);
+    EXPECT_LE(stats.diskBytes, 300u);
+    EXPECT_EQ(stats.memoryEntries, 2u);
+    sendNow(cache, get("/one"));
+    EXPECT_EQ(inner.sendCallCount, 2);
+}
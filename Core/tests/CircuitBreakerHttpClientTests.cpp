@@ -0,0 +1,223 @@
+//
+//  CircuitBreakerHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  CircuitBreakerHttpClient on a manual clock: tripping on error rate and on
+//  slow calls, failing fast while open, probing when half-open, and the
+//  transitions it reports.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+#include "Infrastructure/Http/CircuitBreakerHttpClient.hpp"
+#include "Mocks/FakeHttpClient.hpp"
+#include "Mocks/HeldHttpClient.hpp"
+#include "Mocks/HttpResponses.hpp"
+#include "Mocks/ManualClock.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+namespace {
+
+HttpRequest get() {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = "/me";
+    return request;
+}
+
+const char* name(CircuitState state) {
+    switch (state) {
+    case CircuitState::closed: return "closed";
+    case CircuitState::open: return "open";
+    case CircuitState::halfOpen: return "halfOpen";
+    }
+    return "?";
+}
+
+} // namespace
+
+class CircuitBreakerHttpClientTest : public ::testing::Test {
+protected:
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler{dispatch, test::manualClock()};
+    std::vector<std::string> transitions;
+
+    CircuitBreakerHttpClient::Options options() {
+        CircuitBreakerHttpClient::Options o;
+        o.windowSize = 4;
+        o.minimumCalls = 4;
+        o.failureRateThreshold = 0.5;
+        o.slowCallThreshold = seconds(2);
+        o.openDuration = seconds(10);
+        o.halfOpenProbes = 2;
+        o.onStateChange = [this](CircuitState from, CircuitState to) {
+            transitions.push_back(std::string(name(from)) + "->" + name(to));
+        };
+        return o;
+    }
+
+    static HttpResponse sendNow(IHttpClient& client) {
+        HttpResponse answer;
+        client.send(get(), [&answer](const HttpResponse& r) { answer = r; });
+        return answer;
+    }
+
+    // Four answers, half of them failures: enough to trip options().
+    void trip(test::FakeHttpClient& inner, CircuitBreakerHttpClient& breaker) {
+        inner.script = {test::status(200), test::status(503), test::status(200), test::transportError()};
+        for (int i = 0; i < 4; ++i) {
+            sendNow(breaker);
+        }
+    }
+};
+
+TEST_F(CircuitBreakerHttpClientTest, TripsAtTheFailureRateAndThenFailsFast) {
+    test::FakeHttpClient inner;
+    inner.responseToReturn = test::status(200);
+    CircuitBreakerHttpClient breaker(inner, scheduler, options());
+
+    inner.script = {test::status(200), test::status(503), test::status(200)};
+    for (int i = 0; i < 3; ++i) {
+        sendNow(breaker);
+    }
+    EXPECT_EQ(breaker.state(), CircuitState::closed); // under minimumCalls
+    inner.script = {test::transportError()};
+    sendNow(breaker);
+    EXPECT_EQ(breaker.state(), CircuitState::open);
+
+    HttpResponse refused = sendNow(breaker);
+    EXPECT_TRUE(refused.transportError);
+    EXPECT_EQ(refused.transportErrorMessage, CircuitBreakerHttpClient::openCircuitMessage());
+    EXPECT_EQ(inner.sendCallCount, 4);
+    EXPECT_EQ(breaker.stats().rejected, 1u);
+    EXPECT_EQ(transitions, (std::vector<std::string>{"closed->open"}));
+}
+
+TEST_F(CircuitBreakerHttpClientTest, OldOutcomesLeaveTheWindow) {
+    test::FakeHttpClient inner;
+    inner.responseToReturn = test::status(200);
+    CircuitBreakerHttpClient breaker(inner, scheduler, options());
+
+    inner.script = {test::status(500)};
+    for (int i = 0; i < 10; ++i) {
+        sendNow(breaker); // one failure, then successes push it out
+    }
+    inner.script = {test::status(500)};
+    sendNow(breaker);
+
+    EXPECT_EQ(breaker.state(), CircuitState::closed);
+    EXPECT_TRUE(transitions.empty());
+}
+
+TEST_F(CircuitBreakerHttpClientTest, SlowCallsTripIt) {
+    test::HeldHttpClient inner;
+    CircuitBreakerHttpClient::Options o = options();
+    o.minimumCalls = 2;
+    CircuitBreakerHttpClient breaker(inner, scheduler, o);
+
+    breaker.send(get(), [](const HttpResponse&) {});
+    breaker.send(get(), [](const HttpResponse&) {});
+    scheduler.advanceBy(seconds(3));
+    inner.answer(0, 200);
+    EXPECT_EQ(breaker.state(), CircuitState::closed);
+    inner.answer(1, 200);
+
+    EXPECT_EQ(breaker.state(), CircuitState::open);
+}
+
+TEST_F(CircuitBreakerHttpClientTest, HalfOpenLetsLimitedProbesThroughThenCloses) {
+    test::HeldHttpClient inner;
+    CircuitBreakerHttpClient breaker(inner, scheduler, options());
+    for (int i = 0; i < 4; ++i) {
+        breaker.send(get(), [](const HttpResponse&) {});
+    }
+    const int statuses[] = {200, 503, 200, 503};
+    for (std::size_t i = 0; i < 4; ++i) {
+        inner.answer(i, statuses[i]);
+    }
+    inner.held.clear();
+    ASSERT_EQ(breaker.state(), CircuitState::open);
+
+    scheduler.advanceBy(seconds(9));
+    EXPECT_EQ(breaker.state(), CircuitState::open);
+    scheduler.advanceBy(seconds(1));
+    EXPECT_EQ(breaker.state(), CircuitState::halfOpen);
+
+    std::vector<HttpResponse> answers(3);
+    for (std::size_t i = 0; i < answers.size(); ++i) {
+        breaker.send(get(), [&answers, i](const HttpResponse& r) { answers[i] = r; });
+    }
+    ASSERT_EQ(inner.held.size(), 2u); // two probes; the third failed fast
+    EXPECT_EQ(answers[2].transportErrorMessage, CircuitBreakerHttpClient::openCircuitMessage());
+
+    inner.answer(0, 200);
+    EXPECT_EQ(breaker.state(), CircuitState::halfOpen);
+    inner.answer(1, 204);
+    EXPECT_EQ(breaker.state(), CircuitState::closed);
+    EXPECT_EQ(transitions, (std::vector<std::string>{"closed->open", "open->halfOpen", "halfOpen->closed"}));
+}
+
+TEST_F(CircuitBreakerHttpClientTest, FailedProbeOpensItAgain) {
+    test::FakeHttpClient inner;
+    inner.responseToReturn = test::status(200);
+    CircuitBreakerHttpClient breaker(inner, scheduler, options());
+    trip(inner, breaker);
+    scheduler.advanceBy(seconds(10));
+    ASSERT_EQ(breaker.state(), CircuitState::halfOpen);
+
+    inner.script = {test::status(502)};
+    EXPECT_EQ(sendNow(breaker).status, 502);
+
+    EXPECT_EQ(breaker.state(), CircuitState::open);
+    EXPECT_EQ(breaker.stats().trips, 2u);
+    scheduler.advanceBy(seconds(10));
+    EXPECT_EQ(breaker.state(), CircuitState::halfOpen);
+}
+
+// A request let through while closed that answers after the trip says
+// nothing about the half-open probes.
+TEST_F(CircuitBreakerHttpClientTest, OutcomesFromBeforeATransitionAreIgnored) {
+    test::HeldHttpClient inner;
+    CircuitBreakerHttpClient breaker(inner, scheduler, options());
+    for (int i = 0; i < 5; ++i) {
+        breaker.send(get(), [](const HttpResponse&) {});
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        inner.answer(i, 500);
+    }
+    ASSERT_EQ(breaker.state(), CircuitState::open);
+    scheduler.advanceBy(seconds(10));
+
+    inner.answer(4, 500);
+
+    EXPECT_EQ(breaker.state(), CircuitState::halfOpen);
+    EXPECT_EQ(breaker.stats().trips, 1u);
+}
+
+TEST_F(CircuitBreakerHttpClientTest, OpenBreakerCompletesStreamsAtOnce) {
+    test::FakeHttpClient inner;
+    inner.responseToReturn = test::status(200);
+    CircuitBreakerHttpClient breaker(inner, scheduler, options());
+    trip(inner, breaker);
+
+    bool headSeen = false;
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [&headSeen](const HttpResponse&) { return headSeen = true; };
+    handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+    breaker.sendStreaming(get(), handler);
+
+    EXPECT_FALSE(headSeen);
+    EXPECT_EQ(completed.transportErrorMessage, CircuitBreakerHttpClient::openCircuitMessage());
+    EXPECT_EQ(inner.sendCallCount, 4);
+}
@@ -0,0 +1,146 @@
+//
+//  ContentCodingTests.cpp
+//  PureMVC Core tests
+//
+//  Coding names, and for every codec this build has: round trips through
+//  the incremental decoder in small pieces, and the ways a body can be bad.
+//  Codecs left out of the build are checked to be reported as such.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Infrastructure/Http/ContentCoding.hpp"
+
+using namespace core;
+
+namespace {
+
+const ContentCoding kCompressed[] = {ContentCoding::gzip, ContentCoding::deflate, ContentCoding::brotli,
+                                     ContentCoding::zstd};
+
+// Something like a sync response: repetitive JSON.
+std::string payload() {
+    std::string json = "[";
+    for (int i = 0; i < 2000; ++i) {
+        json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " + std::to_string(i * 7919 % 1000) +
+                "\",\"done\":" + (i % 3 == 0 ? "true" : "false") + "},";
+    }
+    json.back() = ']';
+    return json;
+}
+
+std::vector<ContentCoding> available() {
+    std::vector<ContentCoding> codings;
+    for (ContentCoding coding : kCompressed) {
+        if (isContentCodingAvailable(coding)) {
+            codings.push_back(coding);
+        }
+    }
+    return codings;
+}
+
+// Feeds 'encoded' to a decoder 'step' bytes at a time.
+bool decodeInPieces(ContentCoding coding, const std::string& encoded, std::size_t step, std::string& out,
+                    bool& finished) {
+    std::unique_ptr<ContentDecoder> decoder = ContentDecoder::create(coding);
+    const ContentDecoder::Sink sink = [&out](const char* data, std::size_t size) {
+        out.append(data, size);
+        return true;
+    };
+    for (std::size_t offset = 0; offset < encoded.size(); offset += step) {
+        if (!decoder->write(encoded.data() + offset, std::min(step, encoded.size() - offset), sink)) {
+            return false;
+        }
+    }
+    finished = decoder->finished();
+    return true;
+}
+
+} // namespace
+
+TEST(ContentCodingTest, NamesParseWithoutRegardToCase) {
+    ContentCoding coding = ContentCoding::zstd;
+    EXPECT_TRUE(parseContentCoding("", coding));
+    EXPECT_EQ(coding, ContentCoding::identity);
+    EXPECT_TRUE(parseContentCoding("GZip", coding));
+    EXPECT_EQ(coding, ContentCoding::gzip);
+    EXPECT_TRUE(parseContentCoding("x-gzip", coding));
+    EXPECT_EQ(coding, ContentCoding::gzip);
+    EXPECT_TRUE(parseContentCoding("br", coding));
+    EXPECT_EQ(coding, ContentCoding::brotli);
+    EXPECT_STREQ(contentCodingName(ContentCoding::zstd), "zstd");
+
+    EXPECT_FALSE(parseContentCoding("gzip, br", coding));
+    EXPECT_FALSE(parseContentCoding("compress", coding));
+}
+
+TEST(ContentCodingTest, CodecsLeftOutOfTheBuildOfferNothing) {
+    EXPECT_TRUE(isContentCodingAvailable(ContentCoding::identity));
+    EXPECT_EQ(ContentDecoder::create(ContentCoding::identity), nullptr);
+    for (ContentCoding coding : kCompressed) {
+        if (isContentCodingAvailable(coding)) {
+            continue;
+        }
+        std::string out;
+        EXPECT_FALSE(compressContent(coding, "body", out)) << contentCodingName(coding);
+        EXPECT_EQ(ContentDecoder::create(coding), nullptr) << contentCodingName(coding);
+    }
+}
+
+TEST(ContentCodingTest, EveryAvailableCodecRoundTripsInSmallPieces) {
+    const std::string original = payload();
+    for (ContentCoding coding : available()) {
+        std::string encoded;
+        ASSERT_TRUE(compressContent(coding, original, encoded)) << contentCodingName(coding);
+        EXPECT_LT(encoded.size() * 4, original.size()) << contentCodingName(coding);
+
+        for (std::size_t step : {std::size_t(7), std::size_t(4096), encoded.size()}) {
+            std::string decoded;
+            bool finished = false;
+            ASSERT_TRUE(decodeInPieces(coding, encoded, step, decoded, finished)) << contentCodingName(coding);
+            EXPECT_TRUE(finished) << contentCodingName(coding);
+            EXPECT_EQ(decoded, original) << contentCodingName(coding) << " in pieces of " << step;
+        }
+    }
+}
+
+TEST(ContentCodingTest, BadBodiesAreCaught) {
+    const std::string original = payload();
+    for (ContentCoding coding : available()) {
+        std::string encoded;
+        ASSERT_TRUE(compressContent(coding, original, encoded));
+        std::string decoded;
+        bool finished = true;
+
+        ASSERT_TRUE(decodeInPieces(coding, encoded.substr(0, encoded.size() / 2), 512, decoded, finished));
+        EXPECT_FALSE(finished) << contentCodingName(coding) << ": cut short";
+
+        decoded.clear();
+        EXPECT_FALSE(decodeInPieces(coding, encoded + "trailing", 512, decoded, finished))
+            << contentCodingName(coding) << ": bytes past the end";
+
+        std::string garbage(256, '\x5a');
+        decoded.clear();
+        EXPECT_FALSE(decodeInPieces(coding, garbage, 64, decoded, finished) && finished)
+            << contentCodingName(coding) << ": not that coding at all";
+    }
+}
+
+TEST(ContentCodingTest, ASinkReturningFalseStopsDecoding) {
+    for (ContentCoding coding : available()) {
+        std::string encoded;
+        ASSERT_TRUE(compressContent(coding, payload(), encoded));
+        std::unique_ptr<ContentDecoder> decoder = ContentDecoder::create(coding);
+        int calls = 0;
+        EXPECT_FALSE(decoder->write(encoded.data(), encoded.size(), [&calls](const char*, std::size_t) {
+            ++calls;
+            return false;
+        }));
+        EXPECT_EQ(calls, 1) << contentCodingName(coding);
+    }
+}
@@ -0,0 +1,263 @@
+//
+//  DnsCacheTests.cpp
+//  PureMVC Core tests
+//
+//  DnsCache over a stub lookup and a manual clock: TTL and negative TTL,
+//  background refresh and lookups that must not block (on a
+//  DeferredExecutor, run when the test says), shared lookups for concurrent
+//  misses, and the entry limit.
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+
+#include "Infrastructure/Http/DnsCache.hpp"
+#include "Mocks/DeferredExecutor.hpp"
+
+using namespace core;
+
+namespace {
+
+using Clock = DnsCache::Clock;
+
+// Answers every host with 'ip', or fails with 'error' when ip is empty.
+struct StubLookup {
+    std::string ip = "192.0.2.1";
+    std::string error = "Cannot resolve: stub says no";
+    std::atomic<int> calls{0};
+
+    DnsCache::Lookup lookup() {
+        return [this](const std::string&, std::vector<SocketAddress>& addresses, std::string& failure) {
+            ++calls;
+            if (ip.empty()) {
+                failure = error;
+                return false;
+            }
+            SocketAddress address;
+            SocketAddress::parse(ip, 0, address);
+            addresses.assign(1, address);
+            return true;
+        };
+    }
+};
+
+class DnsCacheTest : public ::testing::Test {
+protected:
+    DnsCache::Options options() {
+        DnsCache::Options o;
+        o.lookup = stub.lookup();
+        o.refresher = &refresher;
+        o.now = [this]() { return now; };
+        return o;
+    }
+
+    // The one address 'host' resolves to, or its error.
+    std::string resolve(DnsCache& cache, const std::string& host = "api.example.test", int port = 443) {
+        std::vector<SocketAddress> addresses;
+        std::string error;
+        if (!cache.resolve(host, port, addresses, error)) {
+            return error;
+        }
+        EXPECT_EQ(addresses.size(), 1u);
+        EXPECT_EQ(addresses.front().port(), port);
+        return addresses.front().ip();
+    }
+
+    StubLookup stub;
+    test::DeferredExecutor refresher;
+    Clock::time_point now = Clock::time_point() + std::chrono::hours(1);
+};
+
+} // namespace
+
+TEST_F(DnsCacheTest, AnswersFromTheCacheUntilTheTtlRunsOut) {
+    DnsCache cache(options());
+
+    EXPECT_EQ(resolve(cache), "192.0.2.1");
+    EXPECT_EQ(resolve(cache, "api.example.test", 8080), "192.0.2.1"); // the port is the caller's
+    EXPECT_EQ(stub.calls, 1);
+
+    stub.ip = "192.0.2.2";
+    now += std::chrono::seconds(60);
+    EXPECT_EQ(resolve(cache), "192.0.2.2");
+    EXPECT_EQ(stub.calls, 2);
+
+    const DnsCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST_F(DnsCacheTest, FailuresAreCachedForTheNegativeTtl) {
+    stub.ip.clear();
+    DnsCache cache(options());
+
+    EXPECT_EQ(resolve(cache), "Cannot resolve: stub says no");
+    now += std::chrono::seconds(4);
+    EXPECT_EQ(resolve(cache), "Cannot resolve: stub says no");
+    EXPECT_EQ(stub.calls, 1);
+    EXPECT_EQ(cache.stats().negativeHits, 1u);
+
+    stub.ip = "192.0.2.1";
+    now += std::chrono::seconds(1);
+    EXPECT_EQ(resolve(cache), "192.0.2.1");
+    EXPECT_EQ(stub.calls, 2);
+}
+
+TEST_F(DnsCacheTest, AHitNearExpiryRefreshesInTheBackground) {
+    DnsCache cache(options());
+    resolve(cache);
+
+    now += std::chrono::seconds(50); // inside refreshAhead of the 60 s TTL
+    stub.ip = "192.0.2.2";
+    EXPECT_EQ(resolve(cache), "192.0.2.1"); // answered at once, with what it had
+    EXPECT_EQ(resolve(cache), "192.0.2.1");
+    EXPECT_EQ(refresher.queued.size(), 1u); // one refresh per host at a time
+    EXPECT_EQ(stub.calls, 1);
+
+    refresher.runAll();
+    EXPECT_EQ(stub.calls, 2);
+    now += std::chrono::seconds(40); // past the first answer's expiry
+    EXPECT_EQ(resolve(cache), "192.0.2.2");
+    EXPECT_EQ(stub.calls, 2);
+    EXPECT_EQ(cache.stats().refreshes, 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+}
+
+TEST_F(DnsCacheTest, AFailedRefreshKeepsTheAnswerItHad) {
+    DnsCache cache(options());
+    resolve(cache);
+
+    now += std::chrono::seconds(50);
+    stub.ip.clear();
+    resolve(cache);
+    refresher.runAll();
+
+    EXPECT_EQ(resolve(cache), "192.0.2.1");
+    EXPECT_EQ(cache.stats().failures, 1u);
+    now += std::chrono::seconds(10);
+    EXPECT_EQ(resolve(cache), "Cannot resolve: stub says no"); // expired: asked again, in the foreground
+}
+
+TEST_F(DnsCacheTest, ConcurrentMissesShareOneLookup) {
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool entered = false;
+    bool released = false;
+    std::atomic<int> calls{0};
+    DnsCache::Options o = options();
+    o.lookup = [&](const std::string&, std::vector<SocketAddress>& addresses, std::string&) {
+        ++calls;
+        std::unique_lock<std::mutex> lock(mutex);
+        entered = true;
+        changed.notify_all();
+        changed.wait(lock, [&released]() { return released; });
+        SocketAddress address;
+        SocketAddress::parse("192.0.2.7", 0, address);
+        addresses.assign(1, address);
+        return true;
+    };
+    DnsCache cache(o);
+
+    std::vector<std::string> answers(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < answers.size(); ++i) {
+        threads.emplace_back([&, i]() { answers[i] = resolve(cache); });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&entered]() { return entered; });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // let the others queue up behind it
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    changed.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls, 1);
+    for (const std::string& answer : answers) {
+        EXPECT_EQ(answer, "192.0.2.7");
+    }
+}
+
+TEST_F(DnsCacheTest, ResolvingWithoutBlockingLooksUpAMissOnTheRefresher) {
+    DnsCache cache(options());
+    std::vector<SocketAddress> addresses;
+    std::string error;
+    int done = 0;
+
+    EXPECT_EQ(cache.resolveWithoutBlocking("api.example.test", 443, addresses, error, [&done]() { ++done; }),
+              DnsCache::Result::pending);
+    EXPECT_EQ(stub.calls, 0);
+    refresher.runAll();
+    EXPECT_EQ(stub.calls, 1);
+    EXPECT_EQ(done, 1);
+
+    EXPECT_EQ(cache.resolveWithoutBlocking("api.example.test", 443, addresses, error, [&done]() { ++done; }),
+              DnsCache::Result::resolved);
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_EQ(addresses.front().ip(), "192.0.2.1");
+    EXPECT_EQ(addresses.front().port(), 443);
+    EXPECT_TRUE(refresher.queued.empty());
+
+    stub.ip.clear();
+    EXPECT_EQ(cache.resolveWithoutBlocking("down.example.test", 443, addresses, error, [&done]() { ++done; }),
+              DnsCache::Result::pending);
+    refresher.runAll();
+    EXPECT_EQ(cache.resolveWithoutBlocking("down.example.test", 443, addresses, error, [&done]() { ++done; }),
+              DnsCache::Result::failed);
+    EXPECT_EQ(error, stub.error);
+    EXPECT_EQ(done, 2);
+}
+
+TEST_F(DnsCacheTest, EntriesNearestExpiryGoFirstPastTheLimit) {
+    DnsCache::Options o = options();
+    o.maxEntries = 2;
+    DnsCache cache(o);
+
+    resolve(cache, "a.example.test");
+    now += std::chrono::seconds(1);
+    resolve(cache, "b.example.test");
+    resolve(cache, "c.example.test");
+    EXPECT_EQ(cache.stats().entries, 2u);
+    EXPECT_EQ(stub.calls, 3);
+
+    resolve(cache, "b.example.test");
+    resolve(cache, "c.example.test");
+    EXPECT_EQ(stub.calls, 3);
+    resolve(cache, "a.example.test");
+    EXPECT_EQ(stub.calls, 4);
+}
+
+TEST_F(DnsCacheTest, ClearForgetsEveryAnswer) {
+    DnsCache cache(options());
+    resolve(cache);
+
+    cache.clear();
+    resolve(cache);
+
+    EXPECT_EQ(stub.calls, 2);
+}
+
+TEST(DnsCacheSystemTest, ResolvesNumericHostsWithGetaddrinfo) {
+    DnsCache cache;
+    std::vector<SocketAddress> addresses;
+    std::string error;
+
+    ASSERT_TRUE(cache.resolve("127.0.0.1", 8080, addresses, error)) << error;
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_EQ(addresses.front().family(), AF_INET);
+    EXPECT_EQ(addresses.front().ip(), "127.0.0.1");
+    EXPECT_EQ(addresses.front().port(), 8080);
+}
@@ -0,0 +1,208 @@
+//
+//  EpollReactorTests.cpp
+//  PureMVC Core tests
+//
+
+#if defined(__linux__)
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Infrastructure/Concurrency/EpollReactor.hpp"
+
+using namespace core;
+using std::chrono::milliseconds;
+
+namespace {
+
+const std::chrono::seconds kTimeout(5);
+
+// Parks the loop thread so posts pile up behind it.
+class Gate {
+public:
+    Task blocker() {
+        return [this]() {
+            entered_.set_value();
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return open_; });
+        };
+    }
+    void waitUntilEntered() { entered_.get_future().wait(); }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+    std::promise<void> entered_;
+};
+
+} // namespace
+
+TEST(EpollReactor, RunsEveryPostOnTheLoopThreadInPerProducerOrder) {
+    EpollReactor reactor;
+    const int kProducers = 4;
+    const int kTasksEach = 5000;
+    std::vector<std::vector<int>> seen(kProducers);
+    std::atomic<bool> offLoop{false};
+    std::promise<void> done;
+    std::atomic<int> remaining{kProducers * kTasksEach};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < kTasksEach; ++i) {
+                reactor.run([&, p, i]() {
+                    if (!reactor.isLoopThread()) {
+                        offLoop = true;
+                    }
+                    seen[p].push_back(i); // loop thread only: no lock needed
+                    if (remaining.fetch_sub(1) == 1) {
+                        done.set_value();
+                    }
+                });
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    ASSERT_EQ(done.get_future().wait_for(kTimeout), std::future_status::ready);
+    EXPECT_FALSE(offLoop.load());
+    EXPECT_FALSE(reactor.isLoopThread());
+    for (const std::vector<int>& order : seen) {
+        ASSERT_EQ(order.size(), static_cast<std::size_t>(kTasksEach));
+        for (int i = 0; i < kTasksEach; ++i) {
+            ASSERT_EQ(order[static_cast<std::size_t>(i)], i);
+        }
+    }
+}
+
+TEST(EpollReactor, FullRingSpillsWithoutReordering) {
+    EpollReactor::Options options;
+    options.queueCapacity = 4;
+    EpollReactor reactor(options);
+    Gate gate;
+    reactor.run(gate.blocker());
+    gate.waitUntilEntered();
+
+    std::vector<int> order;
+    for (int i = 0; i < 100; ++i) {
+        reactor.run([&order, i]() { order.push_back(i); });
+    }
+    gate.release();
+    reactor.shutdown();
+
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST(EpollReactor, TimersFireInDeadlineOrderOnTheLoopAndCanBeCancelled) {
+    EpollReactor reactor;
+    std::vector<int> fired;
+    std::atomic<bool> offLoop{false};
+    std::promise<void> done;
+
+    const IScheduledExecutor::Clock::time_point base = reactor.now();
+    reactor.runAt(base + milliseconds(30), [&]() {
+        fired.push_back(3);
+        done.set_value();
+    });
+    reactor.runAt(base + milliseconds(10), [&]() {
+        offLoop = offLoop || !reactor.isLoopThread();
+        fired.push_back(1);
+    });
+    const IScheduledExecutor::TimerId cancelled =
+        reactor.runAt(base + milliseconds(20), [&]() { fired.push_back(2); });
+    reactor.runAfter(milliseconds(15), [&]() { fired.push_back(15); });
+    EXPECT_TRUE(reactor.cancel(cancelled));
+    EXPECT_FALSE(reactor.cancel(cancelled));
+
+    ASSERT_EQ(done.get_future().wait_for(kTimeout), std::future_status::ready);
+    EXPECT_GE(reactor.now() - base, milliseconds(30));
+    EXPECT_FALSE(offLoop.load());
+    reactor.shutdown();
+    EXPECT_EQ(fired, (std::vector<int>{1, 15, 3}));
+}
+
+TEST(EpollReactor, WatchReportsReadabilityAndHangUp) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    EpollReactor reactor;
+    std::promise<char> received;
+    std::promise<void> hungUp;
+    bool gotByte = false;
+
+    reactor.watch(fds[0], EpollReactor::readable, [&](std::uint32_t events) {
+        if (events & EpollReactor::readable) {
+            char byte = 0;
+            if (::read(fds[0], &byte, 1) == 1 && !gotByte) {
+                gotByte = true;
+                received.set_value(byte);
+                return;
+            }
+        }
+        if (events & EpollReactor::closed) {
+            reactor.unwatch(fds[0]);
+            hungUp.set_value();
+        }
+    });
+
+    ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    std::future<char> byte = received.get_future();
+    ASSERT_EQ(byte.wait_for(kTimeout), std::future_status::ready);
+    EXPECT_EQ(byte.get(), 'x');
+
+    ::close(fds[1]);
+    EXPECT_EQ(hungUp.get_future().wait_for(kTimeout), std::future_status::ready);
+    reactor.shutdown();
+    ::close(fds[0]);
+}
+
+TEST(EpollReactor, ShutdownDrainsQueuedWorkAndLaterPostsRunInline) {
+    EpollReactor reactor;
+    Gate gate;
+    reactor.run(gate.blocker());
+    gate.waitUntilEntered();
+    int ran = 0;
+    for (int i = 0; i < 10; ++i) {
+        reactor.run([&ran]() { ++ran; });
+    }
+    gate.release();
+    reactor.shutdown();
+    reactor.shutdown(); // idempotent
+    EXPECT_EQ(ran, 10);
+
+    bool inline_ = false;
+    reactor.run([&inline_]() { inline_ = true; });
+    EXPECT_TRUE(inline_);
+}
+
+TEST(EpollReactor, DestroyedFromItsOwnTaskDoesNotDeadlock) {
+    std::promise<void> destroyed;
+    EpollReactor* reactor = new EpollReactor();
+    reactor->run([reactor, &destroyed]() {
+        delete reactor;
+        destroyed.set_value();
+    });
+    EXPECT_EQ(destroyed.get_future().wait_for(kTimeout), std::future_status::ready);
+}
+
+#endif // defined(__linux__)
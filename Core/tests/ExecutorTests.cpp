@@ -32,3 +32,13 @@ TEST(ThreadExecutor, RunsTaskOffThreadAndCompletes) {
     ASSERT_EQ(future.wait_for(std::chrono::seconds(2)), std::future_status::ready);
     EXPECT_EQ(future.get(), 42);
 }
+
+TEST(SyncExecutor, TakesALaneHintThroughTheConcreteType) {
+    test::SyncExecutor executor;
+    bool ran = false;
+
+    executor.run([&ran]() { ran = true; }, TaskPriority::interactive);
+
+    EXPECT_TRUE(ran);
+    EXPECT_EQ(executor.runCount, 1); // lanes ignored, run(Task) reached
+}
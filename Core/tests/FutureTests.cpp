@@ -0,0 +1,196 @@
+//
+//  FutureTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "Domain/Async/Future.hpp"
+#include "Mocks/AllocationCounter.hpp"
+#include "Mocks/DeferredExecutor.hpp"
+#include "Mocks/FakeAuthRepository.hpp"
+#include "Mocks/FakeHttpClient.hpp"
+
+using namespace core;
+
+TEST(Future, ContinuationRunsInlineOnTheCompletingThread) {
+    Promise<int> promise;
+    Future<int> future = promise.getFuture();
+    EXPECT_FALSE(future.isReady());
+
+    std::thread::id ranOn;
+    int seen = 0;
+    Future<Unit> done = future.then([&](int value) {
+        ranOn = std::this_thread::get_id();
+        seen = value;
+    });
+    EXPECT_FALSE(future.valid()); // consumed
+    EXPECT_FALSE(done.isReady());
+
+    std::thread completer([&promise]() { promise.setValue(7); });
+    const std::thread::id completerId = completer.get_id();
+    completer.join();
+
+    EXPECT_EQ(seen, 7);
+    EXPECT_EQ(ranOn, completerId);
+    EXPECT_TRUE(done.isReady());
+}
+
+TEST(Future, ThenOnAReadyFutureRunsImmediatelyAndChains) {
+    Future<std::string> result = Future<int>::ready(20)
+        .then([](int v) { return v + 1; })
+        .then([](int v) { return std::to_string(v * 2); });
+    ASSERT_TRUE(result.isReady());
+    EXPECT_EQ(result.value(), "42");
+}
+
+TEST(Future, FirstSetterWins) {
+    Promise<int> promise;
+    Promise<int> copy = promise;
+    EXPECT_TRUE(promise.setValue(1));
+    EXPECT_FALSE(copy.setValue(2));
+    Future<int> future = promise.getFuture();
+    EXPECT_EQ(future.value(), 1);
+}
+
+TEST(Future, ExecutorContinuationIsPosted) {
+    test::DeferredExecutor executor;
+    Promise<int> promise;
+    int seen = 0;
+    Future<int> doubled = promise.getFuture().then(executor, [&seen](int v) {
+        seen = v;
+        return v * 2;
+    });
+
+    promise.setValue(5);
+    EXPECT_EQ(seen, 0); // not inline
+    ASSERT_EQ(executor.queued.size(), 1u);
+    executor.runAll();
+    EXPECT_EQ(seen, 5);
+    ASSERT_TRUE(doubled.isReady());
+    EXPECT_EQ(doubled.value(), 10);
+}
+
+TEST(Future, ContinuationReturningAFutureIsFlattened) {
+    Promise<int> inner;
+    Future<int> result = Future<int>::ready(1).then([&inner](int) { return inner.getFuture(); });
+    EXPECT_FALSE(result.isReady());
+    inner.setValue(9);
+    ASSERT_TRUE(result.isReady());
+    EXPECT_EQ(result.value(), 9);
+}
+
+TEST(Future, PairWithInlineContinuationIsOneAllocationEach) {
+    std::size_t allocations = 0;
+    int seen = 0;
+    {
+        test::AllocationScope scope;
+        Promise<int> promise;
+        Future<Unit> done = promise.getFuture().then([&seen](int v) { seen = v; });
+        promise.setValue(3);
+        allocations = scope.count();
+    }
+    EXPECT_EQ(seen, 3);
+    EXPECT_EQ(allocations, 2u); // the promise's state and then()'s result state
+}
+
+TEST(Future, ReleasedPromiseDropsItsContinuation) {
+    std::shared_ptr<int> tracked = std::make_shared<int>(0);
+    bool ran = false;
+    Future<Unit> done;
+    {
+        Promise<int> promise;
+        done = promise.getFuture().then([tracked, &ran](int) { ran = true; });
+        EXPECT_EQ(tracked.use_count(), 2);
+    }
+    EXPECT_FALSE(ran);
+    EXPECT_FALSE(done.isReady());
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(Future, WhenAllKeepsInputOrder) {
+    std::vector<Promise<int>> promises(3);
+    std::vector<Future<int>> futures;
+    for (Promise<int>& p : promises) {
+        futures.push_back(p.getFuture());
+    }
+    Future<std::vector<int>> all = whenAll(std::move(futures));
+
+    promises[2].setValue(30);
+    promises[0].setValue(10);
+    EXPECT_FALSE(all.isReady());
+    promises[1].setValue(20);
+    ASSERT_TRUE(all.isReady());
+    EXPECT_EQ(all.value(), (std::vector<int>{10, 20, 30}));
+
+    EXPECT_TRUE(whenAll(std::vector<Future<int>>()).isReady());
+}
+
+TEST(Future, WhenAllAcrossThreads) {
+    const int kCount = 64;
+    std::vector<Promise<int>> promises(kCount);
+    std::vector<Future<int>> futures;
+    for (Promise<int>& p : promises) {
+        futures.push_back(p.getFuture());
+    }
+    Future<std::vector<int>> all = whenAll(std::move(futures));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kCount; ++i) {
+        threads.emplace_back([&promises, i]() { promises[static_cast<std::size_t>(i)].setValue(i); });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    ASSERT_TRUE(all.isReady());
+    for (int i = 0; i < kCount; ++i) {
+        EXPECT_EQ(all.value()[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST(Future, WhenAnyReportsTheFirstCompletion) {
+    Promise<std::string> slow, fast;
+    std::vector<Future<std::string>> futures;
+    futures.push_back(slow.getFuture());
+    futures.push_back(fast.getFuture());
+    Future<std::pair<std::size_t, std::string>> any = whenAny(std::move(futures));
+
+    fast.setValue("fast");
+    slow.setValue("slow");
+    ASSERT_TRUE(any.isReady());
+    EXPECT_EQ(any.value().first, 1u);
+    EXPECT_EQ(any.value().second, "fast");
+}
+
+TEST(Future, LoginThenFetchProfileAndSettingsInParallel) {
+    test::FakeAuthRepository repository;
+    repository.sessionToReturn.user.username = "ada";
+    test::FakeHttpClient http;
+    http.responseToReturn.status = 200;
+    http.responseToReturn.body = "{}";
+
+    std::string username;
+    int statuses = 0;
+    Future<Unit> done = repository.login(LoginCredentials{"a@b.c", "pw"})
+        .then([&](LoginResult login) {
+            username = login.session.user.username;
+            HttpRequest profile, settings;
+            profile.path = "/profile";
+            settings.path = "/settings";
+            return whenAll(http.send(profile), http.send(settings));
+        })
+        .then([&](std::tuple<HttpResponse, HttpResponse> responses) {
+            statuses = std::get<0>(responses).status + std::get<1>(responses).status;
+        });
+
+    ASSERT_TRUE(done.isReady());
+    EXPECT_EQ(username, "ada");
+    EXPECT_EQ(statuses, 400);
+    EXPECT_EQ(http.sendCallCount, 2);
+}
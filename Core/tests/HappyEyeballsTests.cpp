@@ -0,0 +1,102 @@
+//
+//  HappyEyeballsTests.cpp
+//  PureMVC Core tests
+//
+//  Racing connects against local listeners that accept, refuse, or never
+//  answer (see TestListeners.hpp), and the family interleaving that orders
+//  the attempts.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "Infrastructure/Http/HappyEyeballs.hpp"
+#include "Mocks/TestListeners.hpp"
+
+using namespace core;
+using test::TestListener;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+SocketAddress at(const std::string& ip, int port = 80) {
+    SocketAddress address;
+    SocketAddress::parse(ip, port, address);
+    return address;
+}
+
+long long millisSince(Clock::time_point start) {
+    return std::chrono::duration_cast<milliseconds>(Clock::now() - start).count();
+}
+
+} // namespace
+
+TEST(HappyEyeballsTest, InterleavesFamiliesKeepingEachOnesOrder) {
+    const std::vector<SocketAddress> ordered =
+        interleaveFamilies({at("2001:db8::1"), at("2001:db8::2"), at("192.0.2.1"), at("192.0.2.2"), at("192.0.2.3")});
+
+    std::vector<std::string> texts;
+    for (const SocketAddress& address : ordered) {
+        texts.push_back(address.ip());
+    }
+    EXPECT_EQ(texts, (std::vector<std::string>{"2001:db8::1", "192.0.2.1", "2001:db8::2", "192.0.2.2", "192.0.2.3"}));
+    EXPECT_TRUE(interleaveFamilies({}).empty());
+}
+
+TEST(HappyEyeballsTest, ARefusedAddressMovesOnAtOnce) {
+    TestListener refusing(TestListener::Kind::refusing);
+    TestListener accepting(TestListener::Kind::accepting);
+    const Clock::time_point start = Clock::now();
+
+    RacedConnection raced = happyEyeballsConnect({refusing.address(), accepting.address()}, milliseconds(5000),
+                                                 milliseconds(10000));
+
+    ASSERT_GE(raced.fd, 0) << raced.error;
+    EXPECT_EQ(raced.address.port(), accepting.port());
+    EXPECT_LT(millisSince(start), 1000);
+    ::close(raced.fd);
+}
+
+TEST(HappyEyeballsTest, ASilentAddressIsRacedAfterTheDelay) {
+    TestListener silent(TestListener::Kind::silent);
+    TestListener accepting(TestListener::Kind::accepting);
+    const Clock::time_point start = Clock::now();
+
+    RacedConnection raced = happyEyeballsConnect({silent.address(), accepting.address()}, milliseconds(100),
+                                                 milliseconds(10000));
+
+    ASSERT_GE(raced.fd, 0) << raced.error;
+    EXPECT_EQ(raced.address.port(), accepting.port());
+    const long long elapsed = millisSince(start);
+    EXPECT_GE(elapsed, 90);
+    EXPECT_LT(elapsed, 2000); // not the connect timeout
+    ::close(raced.fd);
+}
+
+TEST(HappyEyeballsTest, NothingAnsweringTimesOut) {
+    TestListener silent(TestListener::Kind::silent);
+
+    RacedConnection raced = happyEyeballsConnect({silent.address()}, milliseconds(50), milliseconds(200));
+
+    EXPECT_EQ(raced.fd, -1);
+    EXPECT_TRUE(raced.timedOut);
+    EXPECT_EQ(raced.error, "Connection timed out");
+}
+
+TEST(HappyEyeballsTest, EveryAddressRefusingFails) {
+    TestListener first(TestListener::Kind::refusing);
+    TestListener second(TestListener::Kind::refusing);
+
+    RacedConnection raced = happyEyeballsConnect({first.address(), second.address()}, milliseconds(5000),
+                                                 milliseconds(5000));
+
+    EXPECT_EQ(raced.fd, -1);
+    EXPECT_FALSE(raced.timedOut);
+    EXPECT_EQ(raced.error, "Connection failed: Connection refused");
+}
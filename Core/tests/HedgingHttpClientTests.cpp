@@ -0,0 +1,214 @@
+//
+//  HedgingHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  HedgingHttpClient on a manual clock, over an inner client that holds each
+//  exchange until the test answers it: learning a route's delay, the hedge
+//  and which attempt wins, the budget, errors, and methods it must leave
+//  alone.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+#include "Infrastructure/Http/HedgingHttpClient.hpp"
+#include "Mocks/HeldHttpClient.hpp"
+#include "Mocks/ManualClock.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using std::chrono::milliseconds;
+
+namespace {
+
+HttpRequest get(const std::string& path = "/me") {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = path;
+    return request;
+}
+
+} // namespace
+
+class HedgingHttpClientTest : public ::testing::Test {
+protected:
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler{dispatch, test::manualClock()};
+    test::HeldHttpClient inner;
+
+    static HedgingHttpClient::Options options() {
+        HedgingHttpClient::Options o;
+        o.percentile = 0.9;
+        o.windowSize = 10;
+        o.minimumSamples = 10;
+        o.minDelay = milliseconds(1);
+        return o;
+    }
+
+    // Ten GETs of /me taking 10, 20, ... 100 ms: a p90 of 90 ms.
+    void warmUp(HedgingHttpClient& client) {
+        for (int i = 1; i <= 10; ++i) {
+            client.send(get(), [](const HttpResponse&) {});
+            scheduler.advanceBy(milliseconds(10 * i));
+            inner.answer(inner.held.size() - 1, 200);
+        }
+        inner.held.clear();
+    }
+};
+
+TEST_F(HedgingHttpClientTest, MeasuresARouteBeforeHedgingIt) {
+    HedgingHttpClient client(inner, scheduler, options());
+
+    for (int i = 0; i < 9; ++i) {
+        client.send(get(), [](const HttpResponse&) {});
+        scheduler.advanceBy(milliseconds(1000));
+        inner.answer(inner.held.size() - 1, 200);
+    }
+    EXPECT_EQ(inner.held.size(), 9u); // none hedged while under minimumSamples
+    EXPECT_EQ(client.hedgeDelay(get()).count(), 0);
+
+    client.send(get(), [](const HttpResponse&) {});
+    scheduler.advanceBy(milliseconds(1000));
+    inner.answer(inner.held.size() - 1, 200);
+    EXPECT_EQ(client.hedgeDelay(get()), milliseconds(1000));
+    EXPECT_EQ(client.hedgeDelay(get("/me?fields=name")), milliseconds(1000)); // the query is not the route
+    EXPECT_EQ(client.hedgeDelay(get("/feed")).count(), 0);
+    EXPECT_EQ(client.stats().hedges, 0u);
+}
+
+TEST_F(HedgingHttpClientTest, HedgesAfterThePercentileAndTheFirstHeadWins) {
+    HedgingHttpClient client(inner, scheduler, options());
+    warmUp(client);
+    ASSERT_EQ(client.hedgeDelay(get()), milliseconds(90));
+
+    std::vector<HttpResponse> answers;
+    client.send(get(), [&answers](const HttpResponse& r) { answers.push_back(r); });
+    scheduler.advanceBy(milliseconds(80));
+    EXPECT_EQ(inner.held.size(), 1u);
+    scheduler.advanceBy(milliseconds(20));
+    ASSERT_EQ(inner.held.size(), 2u);
+    EXPECT_EQ(inner.held[1].request.method, "GET");
+    EXPECT_EQ(inner.held[1].request.path, "/me");
+
+    EXPECT_TRUE(inner.answer(1, 200, "from the hedge"));
+    ASSERT_EQ(answers.size(), 1u);
+    EXPECT_EQ(answers[0].status, 200);
+    EXPECT_EQ(answers[0].body, "from the hedge");
+
+    EXPECT_FALSE(inner.answer(0, 200, "from the primary")); // the loser is abandoned at its head
+    EXPECT_EQ(answers.size(), 1u);
+    const HedgeStats stats = client.stats();
+    EXPECT_EQ(stats.requests, 11u);
+    EXPECT_EQ(stats.hedges, 1u);
+    EXPECT_EQ(stats.hedgeWins, 1u);
+}
+
+TEST_F(HedgingHttpClientTest, APrimaryAnsweringInTimeIsNeverHedged) {
+    HedgingHttpClient client(inner, scheduler, options());
+    warmUp(client);
+
+    HttpResponse answer;
+    client.send(get(), [&answer](const HttpResponse& r) { answer = r; });
+    scheduler.advanceBy(milliseconds(50));
+    inner.answer(0, 200, "on time");
+    scheduler.advanceBy(milliseconds(1000));
+
+    EXPECT_EQ(answer.body, "on time");
+    EXPECT_EQ(inner.held.size(), 1u);
+    EXPECT_EQ(scheduler.pendingCount(), 0u);
+    EXPECT_EQ(client.stats().hedges, 0u);
+}
+
+TEST_F(HedgingHttpClientTest, NeverHedgesAMethodThatIsNotSafe) {
+    HedgingHttpClient client(inner, scheduler, options());
+    warmUp(client);
+
+    for (const char* method : {"POST", "PUT", "PATCH", "DELETE"}) {
+        HttpRequest request = get("/api/v1/auth/login");
+        request.method = method;
+        client.send(request, [](const HttpResponse&) {});
+        EXPECT_EQ(client.hedgeDelay(request).count(), 0);
+    }
+    scheduler.advanceBy(milliseconds(10000));
+
+    EXPECT_EQ(inner.held.size(), 4u);
+    EXPECT_TRUE(inner.held[0].callback); // passed to the inner send() as it was
+    EXPECT_EQ(client.stats().requests, 10u);
+    EXPECT_EQ(client.stats().hedges, 0u);
+}
+
+TEST_F(HedgingHttpClientTest, TheBudgetCapsHedges) {
+    HedgingHttpClient::Options o = options();
+    o.budget.maxTokens = 2;
+    o.budget.depositPerRequest = 0;
+    HedgingHttpClient client(inner, scheduler, o);
+    warmUp(client);
+
+    for (int i = 0; i < 3; ++i) {
+        client.send(get(), [](const HttpResponse&) {});
+    }
+    scheduler.advanceBy(milliseconds(100));
+
+    EXPECT_EQ(inner.held.size(), 5u); // three primaries, two hedges
+    EXPECT_EQ(client.stats().hedges, 2u);
+    EXPECT_EQ(client.stats().budgetExhausted, 1u);
+}
+
+TEST_F(HedgingHttpClientTest, AnErrorIsFinalOnlyWhenNothingElseIsInFlight) {
+    HedgingHttpClient client(inner, scheduler, options());
+    warmUp(client);
+
+    HttpResponse first;
+    client.send(get(), [&first](const HttpResponse& r) { first = r; });
+    scheduler.advanceBy(milliseconds(10));
+    inner.fail(0);
+    EXPECT_TRUE(first.transportError);
+    scheduler.advanceBy(milliseconds(1000));
+    EXPECT_EQ(inner.held.size(), 1u); // no hedge for a request already answered
+
+    std::vector<HttpResponse> answers;
+    client.send(get(), [&answers](const HttpResponse& r) { answers.push_back(r); });
+    scheduler.advanceBy(milliseconds(100));
+    ASSERT_EQ(inner.held.size(), 3u);
+    inner.fail(1);
+    EXPECT_TRUE(answers.empty()); // the hedge may still answer
+    inner.answer(2, 200, "rescued");
+    ASSERT_EQ(answers.size(), 1u);
+    EXPECT_EQ(answers[0].body, "rescued");
+}
+
+TEST_F(HedgingHttpClientTest, StreamsTheWinnerToTheHandler) {
+    HedgingHttpClient client(inner, scheduler, options());
+    warmUp(client);
+
+    int heads = 0;
+    std::string body;
+    std::vector<HttpResponse> completions;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [&heads](const HttpResponse& head) {
+        ++heads;
+        return head.status == 200;
+    };
+    handler.onBody = [&body](const char* data, std::size_t size) {
+        body.append(data, size);
+        return true;
+    };
+    handler.onComplete = [&completions](const HttpResponse& r) { completions.push_back(r); };
+    client.sendStreaming(get(), handler);
+    scheduler.advanceBy(milliseconds(100));
+    ASSERT_EQ(inner.held.size(), 2u);
+
+    EXPECT_TRUE(inner.answer(0, 200, "primary after all"));
+    EXPECT_FALSE(inner.answer(1, 200, "hedge"));
+
+    EXPECT_EQ(heads, 1);
+    EXPECT_EQ(body, "primary after all");
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].status, 200);
+    EXPECT_EQ(client.stats().hedgeWins, 0u);
+}
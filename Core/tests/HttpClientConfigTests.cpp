@@ -18,3 +18,10 @@ TEST(HttpClientConfig, IsSecureByDefault) {
     EXPECT_TRUE(config.caCertPath.empty());              // system trust store
     EXPECT_TRUE(config.pinnedSpkiSha256Base64.empty());  // pinning opt-in
 }
+
+TEST(HttpClientConfig, PoolsConnectionsByDefault) {
+    HttpClientConfig config;
+    EXPECT_GT(config.maxIdleConnections, 0u);
+    EXPECT_GT(config.idleTimeoutSec, 0);
+    EXPECT_GE(config.maxConnectionsPerHost, config.maxIdleConnections);
+}
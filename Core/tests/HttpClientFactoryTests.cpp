@@ -0,0 +1,88 @@
+//
+//  HttpClientFactoryTests.cpp
+//  PureMVC Core tests
+//
+//  makeHttpClient(): transport selection and fallback, and that whichever
+//  transport it picks talks to a local httplib server.
+//
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <httplib.h>
+
+#include "Infrastructure/Http/HttpClientFactory.hpp"
+#include "Infrastructure/Http/IoUringHttpClient.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+
+namespace {
+
+HttpTransport expectedAutomatic() {
+#if defined(PUREMVC_CORE_HAS_IO_URING)
+    if (IoUringHttpClient::isSupported()) {
+        return HttpTransport::ioUring;
+    }
+#endif
+#if defined(__linux__)
+    return HttpTransport::epoll;
+#else
+    return HttpTransport::blocking;
+#endif
+}
+
+} // namespace
+
+TEST(HttpClientFactoryTest, AutomaticPicksTheBestTransportAvailable) {
+    EXPECT_EQ(resolveHttpTransport(), expectedAutomatic());
+    EXPECT_EQ(resolveHttpTransport(HttpTransport::ioUring), expectedAutomatic());
+    EXPECT_EQ(resolveHttpTransport(HttpTransport::blocking), HttpTransport::blocking);
+}
+
+TEST(HttpClientFactoryTest, EpollFallsBackToBlockingOffLinux) {
+#if defined(__linux__)
+    EXPECT_EQ(resolveHttpTransport(HttpTransport::epoll), HttpTransport::epoll);
+#else
+    EXPECT_EQ(resolveHttpTransport(HttpTransport::epoll), HttpTransport::blocking);
+#endif
+}
+
+TEST(HttpClientFactoryTest, EveryTransportServesRequests) {
+    httplib::Server server;
+    server.Post("/login", [](const httplib::Request& req, httplib::Response& res) {
+        res.set_content(req.body, "application/json");
+    });
+    const int port = server.bind_to_any_port("127.0.0.1");
+    std::thread serverThread([&server]() { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    HttpClientConfig config;
+    config.host = "127.0.0.1";
+    config.port = port;
+    config.useSSL = false;
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/login";
+    request.body = R"({"user":"a"})";
+
+    test::SyncExecutor executor; // the blocking transport answers inside send()
+    const HttpTransport transports[] = {HttpTransport::automatic, HttpTransport::ioUring,
+                                        HttpTransport::epoll, HttpTransport::blocking};
+    for (HttpTransport transport : transports) {
+        std::unique_ptr<IHttpClient> client = makeHttpClient(config, executor, transport);
+        std::shared_ptr<std::promise<HttpResponse>> answered = std::make_shared<std::promise<HttpResponse>>();
+        std::future<HttpResponse> future = answered->get_future();
+        client->send(request, [answered](const HttpResponse& response) { answered->set_value(response); });
+        HttpResponse response = future.get();
+        EXPECT_TRUE(response.ok()) << response.transportErrorMessage;
+        EXPECT_EQ(response.body, request.body);
+    }
+
+    server.stop();
+    serverThread.join();
+}
@@ -0,0 +1,118 @@
+//
+//  HttpHeadersTests.cpp
+//  PureMVC Core tests
+//
+//  HttpHeaders: case-insensitive lookup, interned names, replacement versus
+//  appending, defaults merging, and the allocations it saves over std::map.
+//
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "Infrastructure/Http/HttpHeaders.hpp"
+#include "Mocks/AllocationCounter.hpp"
+
+using namespace core;
+
+namespace {
+
+std::vector<std::string> names(const HttpHeaders& headers) {
+    std::vector<std::string> out;
+    for (const auto& header : headers) {
+        out.push_back(header.name());
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(HttpHeaders, LookupIgnoresCase) {
+    HttpHeaders headers;
+    headers.set("X-Request-Id", "42");
+
+    ASSERT_NE(headers.find("x-request-id"), nullptr);
+    EXPECT_EQ(*headers.find("X-REQUEST-ID"), "42");
+    EXPECT_EQ(headers.get("x-Request-Id"), "42");
+    EXPECT_EQ(headers.find("X-Request"), nullptr);
+    EXPECT_EQ(headers.get("Missing"), "");
+}
+
+TEST(HttpHeaders, CommonNamesAreInternedUnderTheirCanonicalSpelling) {
+    HttpHeaders headers;
+    headers.set("content-type", "application/json");
+    headers["ETAG"] = "\"v1\"";
+
+    EXPECT_EQ(headers.get(HttpHeader::contentType), "application/json");
+    EXPECT_EQ(headers.get(HttpHeader::etag), "\"v1\"");
+    EXPECT_TRUE(headers.begin()->is(HttpHeader::contentType));
+    EXPECT_EQ(names(headers), (std::vector<std::string>{"Content-Type", "ETag"}));
+
+    headers.set(HttpHeader::contentType, "text/plain");
+    EXPECT_EQ(headers.size(), 2u);
+    EXPECT_EQ(headers.get("Content-Type"), "text/plain");
+}
+
+TEST(HttpHeaders, SetReplacesEveryFieldOfTheNameInPlace) {
+    HttpHeaders headers;
+    headers.add("Set-Cookie", "a=1");
+    headers.add("X-Trace", "t");
+    headers.add("set-cookie", "b=2");
+    EXPECT_EQ(headers.size(), 3u);
+    EXPECT_EQ(headers.get("Set-Cookie"), "a=1"); // the first
+
+    headers.set("Set-Cookie", "c=3");
+
+    EXPECT_EQ(names(headers), (std::vector<std::string>{"Set-Cookie", "X-Trace"}));
+    EXPECT_EQ(headers.get("Set-Cookie"), "c=3");
+}
+
+TEST(HttpHeaders, EraseRemovesEveryFieldOfTheName) {
+    HttpHeaders headers{{"Vary", "Accept"}, {"X-App", "ios"}};
+    headers.add("vary", "Origin");
+
+    EXPECT_EQ(headers.erase("VARY"), 2u);
+    EXPECT_EQ(headers.erase(HttpHeader::vary), 0u);
+    EXPECT_EQ(names(headers), (std::vector<std::string>{"X-App"}));
+}
+
+TEST(HttpHeaders, MergeDefaultsKeepsTheRequestsOwnValues) {
+    HttpHeaders defaults{{"X-App", "default"}, {"User-Agent", "PureMVC"}, {"Accept", "*/*"}};
+    HttpHeaders request{{"x-app", "mine"}, {"Accept", "application/json"}};
+
+    request.mergeDefaults(defaults);
+
+    EXPECT_EQ(names(request), (std::vector<std::string>{"x-app", "Accept", "User-Agent"}));
+    EXPECT_EQ(request.get("X-App"), "mine");
+    EXPECT_EQ(request.get(HttpHeader::accept), "application/json");
+    EXPECT_EQ(request.get(HttpHeader::userAgent), "PureMVC");
+}
+
+// Names and values that fit std::string's inline buffer cost nothing beyond
+// the one block of fields, where std::map pays one node per header.
+TEST(HttpHeaders, ShortHeadersShareOneAllocation) {
+    HttpHeaders headers;
+    std::size_t allocations = 0;
+    {
+        test::AllocationScope scope;
+        headers.reserve(6);
+        headers.set(HttpHeader::accept, "application/json");
+        headers.set(HttpHeader::contentType, "text/plain");
+        headers.set(HttpHeader::connection, "keep-alive");
+        headers.set(HttpHeader::contentEncoding, "gzip");
+        headers.set("X-App", "ios");
+        headers.set("X-Retry", "1");
+        EXPECT_EQ(headers.get("x-app"), "ios");
+        allocations = scope.count();
+    }
+    EXPECT_EQ(allocations, 2u); // the fields, and "application/json" (16 chars)
+}
+
+TEST(HttpHeaders, ParsesImfFixdates) {
+    std::int64_t seconds = 0;
+    ASSERT_TRUE(HttpHeaders::parseDate("Sun, 06 Nov 1994 08:49:37 GMT", seconds));
+    EXPECT_EQ(seconds, 784111777);
+    EXPECT_FALSE(HttpHeaders::parseDate("120", seconds));
+    EXPECT_FALSE(HttpHeaders::parseDate("Sun, 06 Foo 1994 08:49:37 GMT", seconds));
+}
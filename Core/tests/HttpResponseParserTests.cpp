@@ -0,0 +1,162 @@
+//
+//  HttpResponseParserTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "Infrastructure/Http/HttpResponseParser.hpp"
+
+using namespace core;
+
+namespace {
+
+// Feeds 'wire' in pieces of 'step' bytes (0 = all at once); returns bytes used.
+std::size_t feedAll(HttpResponseParser& parser, const std::string& wire, std::size_t step = 0) {
+    std::size_t used = 0;
+    if (step == 0) {
+        step = wire.size();
+    }
+    for (std::size_t at = 0; at < wire.size() && parser.state() == HttpResponseParser::State::incomplete;
+         at += step) {
+        used += parser.feed(wire.data() + at, std::min(step, wire.size() - at));
+    }
+    return used;
+}
+
+} // namespace
+
+TEST(HttpResponseParser, ParsesAContentLengthResponse) {
+    HttpResponseParser parser;
+    const std::string wire =
+        "HTTP/1.1 201 Created\r\nContent-Type: application/json\r\nContent-Length: 11\r\n\r\n{\"ok\":true}";
+
+    EXPECT_EQ(feedAll(parser, wire), wire.size());
+
+    ASSERT_TRUE(parser.complete());
+    EXPECT_EQ(parser.response().status, 201);
+    EXPECT_EQ(parser.response().body, "{\"ok\":true}");
+    EXPECT_EQ(parser.response().headers["Content-Type"], "application/json");
+    EXPECT_TRUE(parser.keepAlive());
+}
+
+TEST(HttpResponseParser, KeepsRepeatedFields) {
+    HttpResponseParser parser;
+    const std::string wire =
+        "HTTP/1.1 200 OK\r\nSet-Cookie: a=1\r\nVary: Accept\r\nSet-Cookie: b=2\r\n"
+        "Content-Length: 0\r\n\r\n";
+
+    feedAll(parser, wire);
+
+    ASSERT_TRUE(parser.complete());
+    const HttpHeaders& headers = parser.response().headers;
+    EXPECT_EQ(headers.size(), 4u);
+    EXPECT_EQ(headers.get("Set-Cookie"), "a=1");
+    EXPECT_EQ(std::count_if(headers.begin(), headers.end(),
+                            [](const HttpHeaders::Field& f) { return f.value == "b=2"; }),
+              1);
+}
+
+TEST(HttpResponseParser, AcceptsInputOneByteAtATime) {
+    HttpResponseParser parser;
+    const std::string wire =
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n4\r\nWiki\r\n5;ext=1\r\npedia\r\n0\r\nX-Trailer: t\r\n\r\n";
+
+    EXPECT_EQ(feedAll(parser, wire, 1), wire.size());
+
+    ASSERT_TRUE(parser.complete());
+    EXPECT_EQ(parser.response().body, "Wikipedia");
+    EXPECT_TRUE(parser.keepAlive());
+}
+
+TEST(HttpResponseParser, StopsAtTheEndOfTheResponse) {
+    HttpResponseParser parser;
+    const std::string first = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nhi";
+    const std::string wire = first + "HTTP/1.1 200 OK\r\n";
+
+    EXPECT_EQ(parser.feed(wire.data(), wire.size()), first.size());
+    EXPECT_TRUE(parser.complete());
+}
+
+TEST(HttpResponseParser, BodyWithoutLengthEndsWhenTheServerCloses) {
+    HttpResponseParser parser;
+    feedAll(parser, "HTTP/1.1 200 OK\r\n\r\nstreamed until close");
+    EXPECT_EQ(parser.state(), HttpResponseParser::State::incomplete);
+
+    parser.finishOnClose();
+
+    ASSERT_TRUE(parser.complete());
+    EXPECT_EQ(parser.response().body, "streamed until close");
+    EXPECT_FALSE(parser.keepAlive());
+}
+
+TEST(HttpResponseParser, TruncatedResponseFailsOnClose) {
+    HttpResponseParser parser;
+    feedAll(parser, "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nshort");
+
+    parser.finishOnClose();
+
+    EXPECT_TRUE(parser.failed());
+    EXPECT_TRUE(parser.started());
+}
+
+TEST(HttpResponseParser, HeadAnd204And304HaveNoBody) {
+    HttpResponseParser parser;
+    parser.reset(true);
+    feedAll(parser, "HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n");
+    EXPECT_TRUE(parser.complete());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.1 204 No Content\r\n\r\n");
+    EXPECT_TRUE(parser.complete());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.1 304 Not Modified\r\nContent-Length: 50\r\n\r\n");
+    EXPECT_TRUE(parser.complete());
+    EXPECT_TRUE(parser.response().body.empty());
+}
+
+TEST(HttpResponseParser, SkipsInterimResponses) {
+    HttpResponseParser parser;
+    feedAll(parser, "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+
+    ASSERT_TRUE(parser.complete());
+    EXPECT_EQ(parser.response().status, 200);
+    EXPECT_EQ(parser.response().body, "ok");
+}
+
+TEST(HttpResponseParser, KeepAliveFollowsVersionAndConnectionHeader) {
+    HttpResponseParser parser;
+    feedAll(parser, "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 0\r\n\r\n");
+    EXPECT_FALSE(parser.keepAlive());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.0 200 OK\r\nContent-Length: 0\r\n\r\n");
+    EXPECT_FALSE(parser.keepAlive());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.0 200 OK\r\nconnection: Keep-Alive\r\ncontent-length: 0\r\n\r\n");
+    EXPECT_TRUE(parser.keepAlive());
+}
+
+TEST(HttpResponseParser, RejectsMalformedInput) {
+    HttpResponseParser parser;
+    feedAll(parser, "HTTP/2 200 OK\r\n\r\n");
+    EXPECT_TRUE(parser.failed());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.1 200 OK\r\nContent-Length: 5\r\nContent-Length: 6\r\n\r\n");
+    EXPECT_TRUE(parser.failed());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n");
+    EXPECT_TRUE(parser.failed());
+
+    parser.reset(false);
+    feedAll(parser, "HTTP/1.1 200 OK\r\nX-Long: " + std::string(HttpResponseParser::kMaxLineBytes, 'a'));
+    EXPECT_TRUE(parser.failed());
+    EXPECT_FALSE(parser.error().empty());
+}
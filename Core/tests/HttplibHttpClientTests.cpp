@@ -10,18 +10,39 @@
 
 #include <chrono>
 #include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <httplib.h>
 
+#include "Infrastructure/Http/ContentCoding.hpp"
+#include "Infrastructure/Http/DnsCache.hpp"
 #include "Infrastructure/Http/HttplibHttpClient.hpp"
+#include "Infrastructure/Concurrency/BoundedExecutor.hpp"
 #include "Infrastructure/Concurrency/ThreadExecutor.hpp"
+#include "Mocks/AllocationCounter.hpp"
+#include "Mocks/ContentCodings.hpp"
+#include "Mocks/DeferredExecutor.hpp"
+#include "Mocks/HttpResponses.hpp"
+#include "Mocks/RequestRecorder.hpp"
 #include "Mocks/SyncExecutor.hpp"
+#include "Mocks/TestListeners.hpp"
 
 using namespace core;
+using test::firstAvailableCoding;
+using test::RequestRecorder;
+using test::sampleJson;
 
 namespace {
 
+HttpRequest get(const std::string& path) {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = path;
+    return request;
+}
+
 HttpResponse sendSync(HttplibHttpClient& client, const HttpRequest& request) {
     HttpResponse captured;
     client.send(request, [&captured](const HttpResponse& response) {
@@ -30,6 +51,18 @@ HttpResponse sendSync(HttplibHttpClient& client, const HttpRequest& request) {
     return captured; // SyncExecutor guarantees the callback ran inline
 }
 
+// Runs inline and records the lane each task was posted to.
+class LaneRecordingExecutor : public IExecutor {
+public:
+    std::vector<TaskPriority> lanes;
+
+    void run(Task task) override { run(std::move(task), TaskPriority::normal); }
+    void run(Task task, TaskPriority priority) override {
+        lanes.push_back(priority);
+        task();
+    }
+};
+
 } // namespace
 
 class HttplibHttpClientTest : public ::testing::Test {
@@ -37,6 +70,8 @@ protected:
     httplib::Server server;
     std::thread serverThread;
     int port = 0;
+    std::promise<void> opener;
+    std::shared_future<void> gate = opener.get_future().share();
 
     void SetUp() override {
         server.Post("/echo", [](const httplib::Request& req, httplib::Response& res) {
@@ -54,12 +89,86 @@ protected:
             res.set_content(req.get_header_value("X-App"), "text/plain");
         });
 
+        // Reports the client's source port: one value per TCP connection.
+        server.Get("/port", [](const httplib::Request& req, httplib::Response& res) {
+            res.status = 200;
+            res.set_content(std::to_string(req.remote_port), "text/plain");
+        });
+        // Blocks until the test opens 'gate', holding its connection busy.
+        server.Get("/hold", [this](const httplib::Request&, httplib::Response& res) {
+            gate.wait();
+            res.status = 200;
+            res.set_content("held", "text/plain");
+        });
+
+        server.Post("/length", [](const httplib::Request& req, httplib::Response& res) {
+            res.set_content(std::to_string(req.body.size()), "text/plain");
+        });
+        server.Get("/mebibyte", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(std::string(1 << 20, 'm'), "application/octet-stream");
+        });
+        server.Get("/cookies", [](const httplib::Request&, httplib::Response& res) {
+            res.set_header("Set-Cookie", "session=1");
+            res.set_header("Set-Cookie", "theme=dark");
+            res.set_header("Vary", "Accept");
+            res.set_header("Vary", "Accept-Language");
+            res.set_content("ok", "text/plain");
+        });
+        // 16 pieces of 64 KiB, chunked.
+        server.Get("/stream", [](const httplib::Request&, httplib::Response& res) {
+            res.set_chunked_content_provider("application/octet-stream",
+                                             [](size_t offset, httplib::DataSink& sink) {
+                if (offset < 16 * 65536) {
+                    const std::string piece(65536, static_cast<char>('a' + offset / 65536));
+                    sink.write(piece.data(), piece.size());
+                } else {
+                    sink.done();
+                }
+                return true;
+            });
+        });
+        // Sends "first", then blocks on 'gate' before sending "second".
+        server.Get("/trickle", [this](const httplib::Request&, httplib::Response& res) {
+            res.set_chunked_content_provider("text/plain", [this](size_t offset, httplib::DataSink& sink) {
+                if (offset == 0) {
+                    sink.write("first", 5);
+                } else if (offset == 5) {
+                    gate.wait();
+                    sink.write("second", 6);
+                } else {
+                    sink.done();
+                }
+                return true;
+            });
+        });
+
+        // sampleJson() in the coding named by ?coding= (cut in half with
+        // &truncate), and the Accept-Encoding the client offered.
+        server.Get("/encoded", [](const httplib::Request& req, httplib::Response& res) {
+            ContentCoding coding = ContentCoding::identity;
+            parseContentCoding(req.get_param_value("coding"), coding);
+            std::string body;
+            compressContent(coding, sampleJson(), body);
+            if (req.has_param("truncate")) {
+                body.resize(body.size() / 2);
+            }
+            if (coding != ContentCoding::identity) {
+                res.set_header("Content-Encoding", contentCodingName(coding));
+            }
+            res.set_header("X-Seen-Accept-Encoding", req.get_header_value("Accept-Encoding"));
+            res.set_content(body, "application/json");
+        });
+
         port = server.bind_to_any_port("127.0.0.1");
         serverThread = std::thread([this]() { server.listen_after_bind(); });
         server.wait_until_ready();
     }
 
     void TearDown() override {
+        try {
+            opener.set_value();
+        } catch (const std::future_error&) {
+        }
         server.stop();
         if (serverThread.joinable()) {
             serverThread.join();
@@ -95,6 +204,28 @@ TEST_F(HttplibHttpClientTest, PostMapsStatusBodyAndHeaders) {
               std::to_string(request.body.size()));
 }
 
+TEST_F(HttplibHttpClientTest, RepeatedResponseFieldsKeepEveryValue) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+    const std::vector<std::string> cookies{"session=1", "theme=dark"};
+    const std::vector<std::string> vary{"Accept", "Accept-Language"};
+
+    HttpResponse buffered = sendSync(client, get("/cookies"));
+    ASSERT_TRUE(buffered.ok()) << buffered.transportErrorMessage;
+    EXPECT_EQ(test::headerValues(buffered.headers, "Set-Cookie"), cookies);
+    EXPECT_EQ(test::headerValues(buffered.headers, "Vary"), vary);
+
+    HttpResponse head;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [&head](const HttpResponse& h) {
+        head = h;
+        return true;
+    };
+    client.sendStreaming(get("/cookies"), handler);
+    EXPECT_EQ(test::headerValues(head.headers, "Set-Cookie"), cookies);
+    EXPECT_EQ(test::headerValues(head.headers, "Vary"), vary);
+}
+
 TEST_F(HttplibHttpClientTest, NonSuccessStatusAndBodyMapped) {
     test::SyncExecutor executor;
     HttplibHttpClient client(config(), executor);
@@ -175,3 +306,562 @@ TEST_F(HttplibHttpClientTest, RunsThroughThreadExecutorAsynchronously) {
     EXPECT_TRUE(response.ok());
     EXPECT_EQ(response.body, "async-body");
 }
+
+TEST_F(HttplibHttpClientTest, SendEnqueuesWithoutAllocating) {
+    test::DeferredExecutor executor;
+    executor.queued.reserve(1);
+    HttplibHttpClient client(config(), executor);
+
+    // Every string fits the small-string buffer, so copying the request into the
+    // task is allocation-free and any allocation would come from the hop itself.
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/echo";
+    request.body = "small";
+    request.contentType = "text/plain";
+    HttpResponse captured;
+    IHttpClient::Callback callback = [&captured](const HttpResponse& r) { captured = r; };
+
+    std::size_t allocations = 0;
+    {
+        test::AllocationScope scope;
+        client.send(request, std::move(callback));
+        allocations = scope.count();
+    }
+    EXPECT_EQ(allocations, 0u);
+
+    executor.runAll();
+    EXPECT_EQ(captured.body, "small");
+}
+
+TEST_F(HttplibHttpClientTest, PostsOnTheRequestedExecutorLane) {
+    LaneRecordingExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    HttpRequest request;
+    request.method = "GET";
+    request.path = "/whoami";
+    client.send(request, [](const HttpResponse&) {});
+    request.priority = TaskPriority::background;
+    client.send(request, [](const HttpResponse&) {});
+
+    EXPECT_EQ(executor.lanes,
+              (std::vector<TaskPriority>{TaskPriority::normal, TaskPriority::background}));
+}
+
+TEST_F(HttplibHttpClientTest, QueueFullIsReportedThroughTheCallback) {
+    test::DeferredExecutor pool;
+    BoundedExecutor::Options options;
+    options.maxConcurrency = 1;
+    options.queueCapacity = 0;
+    options.policy = RejectionPolicy::failFast;
+    BoundedExecutor bounded(pool, options);
+    HttplibHttpClient client(config(), bounded);
+
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/echo";
+    request.body = "first";
+    HttpResponse first;
+    client.send(request, [&first](const HttpResponse& r) { first = r; });
+
+    int rejectedCalls = 0;
+    HttpResponse rejected;
+    request.body = "second";
+    client.send(request, [&](const HttpResponse& r) {
+        ++rejectedCalls;
+        rejected = r;
+    });
+
+    // Refused synchronously, before the first request has even started.
+    EXPECT_EQ(rejectedCalls, 1);
+    EXPECT_TRUE(rejected.transportError);
+    EXPECT_NE(rejected.transportErrorMessage.find("queue is full"), std::string::npos);
+    EXPECT_EQ(bounded.rejectedCount(), 1u);
+
+    pool.runAll();
+    EXPECT_TRUE(first.ok());
+    EXPECT_EQ(first.body, "first");
+    EXPECT_EQ(rejectedCalls, 1);
+}
+
+TEST_F(HttplibHttpClientTest, ADropThatIsNotARejectionIsNotReportedAsQueueFull) {
+    test::DeferredExecutor pool;
+    HttplibHttpClient client(config(), pool);
+
+    HttpRequest request;
+    request.method = "GET";
+    request.path = "/whoami";
+    HttpResponse answer;
+    client.send(request, [&answer](const HttpResponse& r) { answer = r; });
+    pool.queued.clear(); // e.g. the pool shutting down
+
+    EXPECT_TRUE(answer.transportError);
+    EXPECT_EQ(answer.transportErrorMessage.find("queue is full"), std::string::npos);
+    EXPECT_NE(answer.transportErrorMessage.find("dropped"), std::string::npos);
+}
+
+TEST_F(HttplibHttpClientTest, KeepsOneConnectionAliveAcrossRequests) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    const std::string first = sendSync(client, get("/port")).body;
+    EXPECT_EQ(sendSync(client, get("/port")).body, first);
+    EXPECT_EQ(sendSync(client, get("/port")).body, first);
+
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 1u);
+    EXPECT_EQ(stats.reused, 2u);
+    EXPECT_EQ(stats.open, 1u);
+    EXPECT_EQ(stats.idle, 1u);
+}
+
+TEST_F(HttplibHttpClientTest, ZeroMaxIdleConnectionsDisablesReuse) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.maxIdleConnections = 0;
+    HttplibHttpClient client(c, executor);
+
+    const std::string first = sendSync(client, get("/port")).body;
+    EXPECT_NE(sendSync(client, get("/port")).body, first);
+
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 2u);
+    EXPECT_EQ(stats.reused, 0u);
+    EXPECT_EQ(stats.open, 0u);
+}
+
+TEST_F(HttplibHttpClientTest, IdleConnectionsPastTheTimeoutAreClosed) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.idleTimeoutSec = 0; // every parked connection is already expired
+    HttplibHttpClient client(c, executor);
+
+    EXPECT_TRUE(sendSync(client, get("/port")).ok());
+    EXPECT_TRUE(sendSync(client, get("/port")).ok());
+
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 2u);
+    EXPECT_EQ(stats.expired, 2u);
+    EXPECT_EQ(stats.idle, 0u);
+}
+
+TEST_F(HttplibHttpClientTest, ConnectionClosedByTheServerIsNotReused) {
+    // A separate server whose keep-alive timeout (1 s) is shorter than the
+    // client's, so it hangs up on the idle connection first.
+    httplib::Server impatient;
+    impatient.set_keep_alive_timeout(1);
+    impatient.Get("/port", [](const httplib::Request& req, httplib::Response& res) {
+        res.set_content(std::to_string(req.remote_port), "text/plain");
+    });
+    const int impatientPort = impatient.bind_to_any_port("127.0.0.1");
+    std::thread listener([&impatient]() { impatient.listen_after_bind(); });
+    impatient.wait_until_ready();
+
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.port = impatientPort;
+    HttplibHttpClient client(c, executor);
+
+    const std::string first = sendSync(client, get("/port")).body;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    HttpResponse second = sendSync(client, get("/port"));
+
+    impatient.stop();
+    listener.join();
+
+    EXPECT_TRUE(second.ok());
+    EXPECT_NE(second.body, first);
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.stale, 1u);
+    EXPECT_EQ(stats.opened, 2u);
+    EXPECT_EQ(stats.reused, 0u);
+}
+
+TEST_F(HttplibHttpClientTest, RequestsBeyondTheCapWaitForAFreeConnection) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.maxConnectionsPerHost = 1;
+    HttplibHttpClient client(c, executor);
+
+    std::future<HttpResponse> held = std::async(std::launch::async, [&client]() {
+        return sendSync(client, get("/hold"));
+    });
+    while (client.poolStats().open == 0) {
+        std::this_thread::yield();
+    }
+    std::future<HttpResponse> waiting = std::async(std::launch::async, [&client]() {
+        return sendSync(client, get("/port"));
+    });
+    EXPECT_EQ(waiting.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+
+    opener.set_value();
+    EXPECT_TRUE(held.get().ok());
+    EXPECT_TRUE(waiting.get().ok());
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 1u);
+    EXPECT_EQ(stats.reused, 1u);
+}
+
+TEST_F(HttplibHttpClientTest, CapReachedForLongerThanTheConnectTimeoutFails) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.maxConnectionsPerHost = 1;
+    c.connectionTimeoutSec = 1;
+    HttplibHttpClient client(c, executor);
+
+    std::future<HttpResponse> held = std::async(std::launch::async, [&client]() {
+        return sendSync(client, get("/hold"));
+    });
+    while (client.poolStats().open == 0) {
+        std::this_thread::yield();
+    }
+    HttpResponse refused = sendSync(client, get("/port"));
+    opener.set_value();
+
+    EXPECT_TRUE(refused.transportError);
+    EXPECT_NE(refused.transportErrorMessage.find("pool exhausted"), std::string::npos);
+    EXPECT_TRUE(held.get().ok());
+}
+
+TEST_F(HttplibHttpClientTest, StreamsTheBodyPieceByPiece) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    int status = 0;
+    std::size_t pieces = 0;
+    std::size_t largestPiece = 0;
+    std::string body;
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [&status, &body](const HttpResponse& head) {
+        status = body.empty() ? head.status : -1;
+        return true;
+    };
+    handler.onBody = [&](const char* data, std::size_t size) {
+        ++pieces;
+        largestPiece = std::max(largestPiece, size);
+        body.append(data, size);
+        return true;
+    };
+    handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+    client.sendStreaming(get("/stream"), handler);
+
+    EXPECT_EQ(status, 200);
+    ASSERT_EQ(body.size(), 16u * 65536u);
+    EXPECT_EQ(body.front(), 'a');
+    EXPECT_EQ(body.back(), 'p');
+    EXPECT_GT(pieces, 16u);
+    EXPECT_LE(largestPiece, 65536u); // never the whole body at once
+    EXPECT_TRUE(completed.ok());
+    EXPECT_TRUE(completed.body.empty());
+
+    // The connection is reusable afterwards.
+    EXPECT_TRUE(sendSync(client, get("/port")).ok());
+    EXPECT_EQ(client.poolStats().reused, 1u);
+}
+
+TEST_F(HttplibHttpClientTest, StreamedBodyArrivesBeforeTheResponseEnds) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.readTimeoutSec = 2; // a buffering client would time out waiting for "second"
+    HttplibHttpClient client(c, executor);
+
+    std::string body;
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onBody = [this, &body](const char* data, std::size_t size) {
+        body.append(data, size);
+        if (body == "first") {
+            opener.set_value(); // lets the server send the rest
+        }
+        return true;
+    };
+    handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+    client.sendStreaming(get("/trickle"), handler);
+
+    EXPECT_TRUE(completed.ok()) << completed.transportErrorMessage;
+    EXPECT_EQ(body, "firstsecond");
+}
+
+TEST_F(HttplibHttpClientTest, StreamHandlerCanAbandonTheResponse) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    std::size_t received = 0;
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onBody = [&received](const char*, std::size_t size) {
+        received += size;
+        return false;
+    };
+    handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+    client.sendStreaming(get("/stream"), handler);
+
+    EXPECT_TRUE(completed.transportError);
+    EXPECT_EQ(completed.transportErrorMessage, IHttpClient::streamCancelledMessage());
+    EXPECT_LT(received, 16u * 65536u);
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.open, 0u); // the half-read connection is not pooled
+    EXPECT_EQ(stats.retried, 0u);
+}
+
+TEST_F(HttplibHttpClientTest, StreamingPostSendsTheBody) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/echo";
+    request.body = R"({"hello":"world"})";
+    std::string body;
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onBody = [&body](const char* data, std::size_t size) {
+        body.append(data, size);
+        return true;
+    };
+    handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+    client.sendStreaming(request, handler);
+
+    EXPECT_TRUE(completed.ok()) << completed.transportErrorMessage;
+    EXPECT_EQ(body, request.body);
+    EXPECT_EQ(completed.headers["X-Seen-Body-Length"], std::to_string(request.body.size()));
+    EXPECT_EQ(completed.headers["Content-Type"], "application/json");
+}
+
+// Bytes allocated on the calling thread stand in for bytes copied: every
+// copy of a body-sized buffer shows up as a body-sized allocation.
+TEST_F(HttplibHttpClientTest, MovedRequestBodyIsNeverCopied) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+    ASSERT_TRUE(sendSync(client, get("/port")).ok()); // connection set up outside the scopes
+
+    const std::size_t size = 1 << 20;
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/length";
+    request.body = std::string(size, 'x');
+    HttpRequest copy = request;
+
+    std::string moved;
+    std::size_t movedBytes = 0;
+    {
+        test::AllocationScope scope;
+        client.send(std::move(request), [&moved](const HttpResponse& r) { moved = r.body; });
+        movedBytes = scope.bytes();
+    }
+    std::string copied;
+    std::size_t copiedBytes = 0;
+    {
+        test::AllocationScope scope;
+        client.send(copy, [&copied](const HttpResponse& r) { copied = r.body; });
+        copiedBytes = scope.bytes();
+    }
+
+    EXPECT_EQ(moved, std::to_string(size));
+    EXPECT_EQ(copied, std::to_string(size));
+    EXPECT_LT(movedBytes, size / 8);       // no body-sized buffer at all
+    EXPECT_GE(copiedBytes, size);          // the one copy into the task...
+    EXPECT_LT(copiedBytes, size + size / 8); // ...and no second one into httplib
+    EXPECT_EQ(client.poolStats().opened, 1u);
+}
+
+TEST_F(HttplibHttpClientTest, ResponseBodyIsBufferedOnce) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+    ASSERT_TRUE(sendSync(client, get("/port")).ok());
+
+    std::size_t received = 0;
+    std::size_t bytes = 0;
+    {
+        test::AllocationScope scope;
+        client.send(get("/mebibyte"), [&received](const HttpResponse& r) { received = r.body.size(); });
+        bytes = scope.bytes();
+    }
+
+    EXPECT_EQ(received, 1u << 20);
+    EXPECT_LT(bytes, (1u << 20) + (1u << 20) / 4); // httplib's buffer, handed over
+}
+
+TEST_F(HttplibHttpClientTest, OffersOnlyTheCodingsThisBuildHas) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.acceptEncodings = {ContentCoding::zstd, ContentCoding::identity, ContentCoding::brotli, ContentCoding::gzip,
+                         ContentCoding::zstd};
+    HttplibHttpClient client(c, executor);
+
+    std::string expected;
+    for (ContentCoding coding : {ContentCoding::zstd, ContentCoding::brotli, ContentCoding::gzip}) {
+        if (isContentCodingAvailable(coding)) {
+            expected += (expected.empty() ? "" : ", ") + std::string(contentCodingName(coding));
+        }
+    }
+    HttpResponse response = sendSync(client, get("/encoded"));
+
+    ASSERT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(response.headers.get("X-Seen-Accept-Encoding"), expected);
+    EXPECT_EQ(response.body, sampleJson());
+}
+
+TEST_F(HttplibHttpClientTest, EncodedResponsesAreDecodedBufferedAndStreamed) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.acceptEncodings = {ContentCoding::gzip, ContentCoding::brotli, ContentCoding::zstd};
+    HttplibHttpClient client(c, executor);
+    ContentCoding any;
+    if (!firstAvailableCoding(any)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+
+    for (ContentCoding coding : c.acceptEncodings) {
+        if (!isContentCodingAvailable(coding)) {
+            continue;
+        }
+        const std::string path = std::string("/encoded?coding=") + contentCodingName(coding);
+        HttpResponse buffered = sendSync(client, get(path));
+        ASSERT_TRUE(buffered.ok()) << buffered.transportErrorMessage;
+        EXPECT_EQ(buffered.body, sampleJson()) << contentCodingName(coding);
+        EXPECT_FALSE(buffered.headers.contains(HttpHeader::contentEncoding));
+
+        std::string streamed;
+        HttpResponse completed;
+        IHttpClient::StreamHandler handler;
+        handler.onBody = [&streamed](const char* data, std::size_t size) {
+            streamed.append(data, size);
+            return true;
+        };
+        handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+        client.sendStreaming(get(path), handler);
+        EXPECT_TRUE(completed.ok()) << completed.transportErrorMessage;
+        EXPECT_EQ(streamed, sampleJson()) << contentCodingName(coding);
+    }
+}
+
+TEST_F(HttplibHttpClientTest, ARequestChoosingItsOwnEncodingGetsTheBodyAsSent) {
+    ContentCoding coding;
+    if (!firstAvailableCoding(coding)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.acceptEncodings = {coding};
+    HttplibHttpClient client(c, executor);
+    HttpRequest request = get(std::string("/encoded?coding=") + contentCodingName(coding));
+    request.headers.set(HttpHeader::acceptEncoding, contentCodingName(coding));
+
+    HttpResponse response = sendSync(client, request);
+
+    std::string encoded;
+    ASSERT_TRUE(compressContent(coding, sampleJson(), encoded));
+    EXPECT_EQ(response.body, encoded);
+    EXPECT_EQ(response.headers.get(HttpHeader::contentEncoding), contentCodingName(coding));
+}
+
+TEST_F(HttplibHttpClientTest, ABodyCutShortFailsToDecode) {
+    ContentCoding coding;
+    if (!firstAvailableCoding(coding)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.acceptEncodings = {coding};
+    HttplibHttpClient client(c, executor);
+
+    HttpResponse response =
+        sendSync(client, get(std::string("/encoded?truncate=1&coding=") + contentCodingName(coding)));
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_EQ(response.transportErrorMessage.find("Content decoding failed"), 0u) << response.transportErrorMessage;
+}
+
+TEST_F(HttplibHttpClientTest, LargeRequestBodiesAreCompressed) {
+    ContentCoding coding;
+    if (!firstAvailableCoding(coding)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+    HttpRequest post;
+    post.method = "POST";
+    post.path = "/sync";
+
+    for (const std::string& body : {sampleJson(), std::string("{\"small\":true}")}) {
+        RequestRecorder recorder;
+        test::SyncExecutor executor;
+        HttpClientConfig c = config();
+        c.port = recorder.port;
+        c.requestEncoding = coding;
+        HttplibHttpClient client(c, executor);
+        post.body = body;
+
+        EXPECT_EQ(sendSync(client, post).status, 204);
+        recorder.wait();
+
+        const bool compressed = body.size() > c.compressRequestsAbove;
+        const std::string field = std::string("Content-Encoding: ") + contentCodingName(coding) + "\r\n";
+        EXPECT_EQ(recorder.head.find(field) != std::string::npos, compressed) << recorder.head;
+        std::string sent = recorder.body;
+        if (compressed) {
+            EXPECT_LT(sent.size(), body.size() / 4);
+            std::unique_ptr<ContentDecoder> decoder = ContentDecoder::create(coding);
+            sent.clear();
+            ASSERT_TRUE(decoder->write(recorder.body.data(), recorder.body.size(),
+                                       [&sent](const char* data, std::size_t size) {
+                                           sent.append(data, size);
+                                           return true;
+                                       }));
+        }
+        EXPECT_EQ(sent, body);
+    }
+}
+
+TEST_F(HttplibHttpClientTest, ResolvesThroughItsDnsCacheAndRacesPastASilentAddress) {
+    // Same port, another loopback address: the DNS answer carries no ports.
+    test::TestListener silent(test::TestListener::Kind::silent, "127.0.0.2", port);
+    int lookups = 0;
+    DnsCache::Options dns;
+    dns.lookup = [&lookups](const std::string& host, std::vector<SocketAddress>& addresses, std::string&) {
+        ++lookups;
+        EXPECT_EQ(host, "api.example.test");
+        addresses.resize(2);
+        SocketAddress::parse("127.0.0.2", 0, addresses[0]);
+        SocketAddress::parse("127.0.0.1", 0, addresses[1]);
+        return true;
+    };
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.host = "api.example.test";
+    c.maxIdleConnections = 0; // a new connection per request
+    c.happyEyeballsDelayMs = 50;
+    c.dnsCache = std::make_shared<DnsCache>(dns);
+    HttplibHttpClient client(c, executor);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 2; ++i) {
+        HttpResponse response = sendSync(client, get("/whoami"));
+        EXPECT_TRUE(response.ok()) << response.transportErrorMessage;
+    }
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(c.connectionTimeoutSec));
+    EXPECT_EQ(lookups, 1);
+    EXPECT_EQ(client.poolStats().opened, 2u);
+    EXPECT_EQ(c.dnsCache->stats().hits, 1u);
+}
+
+TEST_F(HttplibHttpClientTest, AHostThatDoesNotResolveFailsWithTheResolverError) {
+    DnsCache::Options dns;
+    dns.lookup = [](const std::string&, std::vector<SocketAddress>&, std::string& error) {
+        error = "Cannot resolve api.example.test: Name or service not known";
+        return false;
+    };
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.host = "api.example.test";
+    c.dnsCache = std::make_shared<DnsCache>(dns);
+    HttplibHttpClient client(c, executor);
+
+    HttpResponse response = sendSync(client, get("/whoami"));
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_EQ(response.transportErrorMessage, "Cannot resolve api.example.test: Name or service not known");
+    EXPECT_EQ(client.poolStats().open, 0u);
+}
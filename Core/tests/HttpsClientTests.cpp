@@ -0,0 +1,314 @@
+//
+//  HttpsClientTests.cpp
+//  PureMVC Core tests
+//
+//  HttplibHttpClient over TLS against a local httplib::SSLServer with a
+//  generated self-signed certificate (trusted via caCertPath). Covers
+//  verification against the shared trust store and its reload, TLS session
+//  resumption (never of a session verified under another policy), and
+//  pinning on resumed handshakes.
+//
+
+#include <gtest/gtest.h>
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <httplib.h>
+
+#include "Infrastructure/Http/HttplibHttpClient.hpp"
+#include "Mocks/SyncExecutor.hpp"
+#include "Mocks/TestCertificate.hpp"
+
+using namespace core;
+
+namespace {
+
+HttpResponse get(HttplibHttpClient& client, const std::string& path) {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = path;
+    HttpResponse captured;
+    client.send(request, [&captured](const HttpResponse& response) { captured = response; });
+    return captured; // SyncExecutor ran it inline
+}
+
+// A private copy of 'path', so a test can delete or replace it.
+std::string copyOf(const std::string& path) {
+    static int counter = 0;
+    const std::string copy = path + ".copy" + std::to_string(++counter);
+    std::ifstream in(path, std::ios::binary);
+    std::ofstream out(copy, std::ios::binary);
+    out << in.rdbuf();
+    return copy;
+}
+
+} // namespace
+
+class HttpsClientTest : public ::testing::Test {
+protected:
+    test::TestCertificate certificate;
+    std::unique_ptr<httplib::SSLServer> server;
+    std::thread serverThread;
+    int port = 0;
+
+    void SetUp() override {
+        server.reset(new httplib::SSLServer(certificate.certPath().c_str(),
+                                            certificate.keyPath().c_str()));
+        ASSERT_TRUE(server->is_valid());
+        server->Get("/hello", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content("hello", "text/plain");
+        });
+        port = server->bind_to_any_port("127.0.0.1");
+        serverThread = std::thread([this]() { server->listen_after_bind(); });
+        server->wait_until_ready();
+    }
+
+    void TearDown() override {
+        server->stop();
+        if (serverThread.joinable()) {
+            serverThread.join();
+        }
+        HttplibHttpClient::clearTlsSessionCache();
+    }
+
+    // Reuse off: every request opens (and handshakes) a new connection.
+    HttpClientConfig config() const {
+        HttpClientConfig c;
+        c.host = "127.0.0.1";
+        c.port = port;
+        c.caCertPath = certificate.certPath();
+        c.maxIdleConnections = 0;
+        return c;
+    }
+};
+
+TEST_F(HttpsClientTest, VerifiesAgainstTheConfiguredCaBundle) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    HttpResponse response = get(client, "/hello");
+
+    EXPECT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(response.body, "hello");
+}
+
+TEST_F(HttpsClientTest, NewConnectionsResumeTheCachedSession) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    ASSERT_TRUE(get(client, "/hello").ok());
+    ASSERT_TRUE(get(client, "/hello").ok());
+    ASSERT_TRUE(get(client, "/hello").ok());
+
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 3u);
+    EXPECT_EQ(stats.fullHandshakes, 1u);
+    EXPECT_EQ(stats.resumedHandshakes, 2u);
+}
+
+TEST_F(HttpsClientTest, Tls12SessionsAreResumedRepeatedly) {
+    // TLS 1.2 sessions are not single-use, so one cached entry serves every
+    // later connection.
+    SSL_CTX_set_max_proto_version(server->ssl_context(), TLS1_2_VERSION);
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(get(client, "/hello").ok());
+    }
+
+    EXPECT_EQ(client.poolStats().fullHandshakes, 1u);
+    EXPECT_EQ(client.poolStats().resumedHandshakes, 3u);
+}
+
+TEST_F(HttpsClientTest, SessionsAreSharedAcrossClientsForTheSameOrigin) {
+    test::SyncExecutor executor;
+    HttplibHttpClient first(config(), executor);
+    HttplibHttpClient second(config(), executor);
+
+    ASSERT_TRUE(get(first, "/hello").ok());
+    ASSERT_TRUE(get(second, "/hello").ok());
+
+    EXPECT_EQ(second.poolStats().fullHandshakes, 0u);
+    EXPECT_EQ(second.poolStats().resumedHandshakes, 1u);
+}
+
+TEST_F(HttpsClientTest, ResumptionCanBeTurnedOff) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.tlsSessionResumption = false;
+    HttplibHttpClient client(c, executor);
+
+    ASSERT_TRUE(get(client, "/hello").ok());
+    ASSERT_TRUE(get(client, "/hello").ok());
+
+    EXPECT_EQ(client.poolStats().fullHandshakes, 2u);
+    EXPECT_EQ(client.poolStats().resumedHandshakes, 0u);
+}
+
+TEST_F(HttpsClientTest, ClearingTheCacheForcesAFullHandshake) {
+    test::SyncExecutor executor;
+    HttplibHttpClient client(config(), executor);
+
+    ASSERT_TRUE(get(client, "/hello").ok());
+    HttplibHttpClient::clearTlsSessionCache();
+    ASSERT_TRUE(get(client, "/hello").ok());
+
+    EXPECT_EQ(client.poolStats().fullHandshakes, 2u);
+}
+
+TEST_F(HttpsClientTest, PinningRunsOnResumedHandshakes) {
+    test::SyncExecutor executor;
+    HttpClientConfig trusting = config();
+    trusting.pinnedSpkiSha256Base64 = {certificate.spkiPin()};
+    HttplibHttpClient pinned(trusting, executor);
+    ASSERT_TRUE(get(pinned, "/hello").ok());
+
+    // Same origin, so the cached session is a candidate, but its certificate
+    // fails these pins: it is not offered, and the full handshake is refused.
+    HttpClientConfig rotated = config();
+    rotated.pinnedSpkiSha256Base64 = {"AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA="};
+    HttplibHttpClient mismatched(rotated, executor);
+    HttpResponse refused = get(mismatched, "/hello");
+
+    EXPECT_TRUE(refused.transportError);
+    EXPECT_EQ(mismatched.poolStats().resumedHandshakes, 0u);
+
+    // The session stays available to the client whose pins it satisfies.
+    ASSERT_TRUE(get(pinned, "/hello").ok());
+    EXPECT_EQ(pinned.poolStats().resumedHandshakes, 1u);
+}
+
+TEST_F(HttpsClientTest, RejectsAServerOutsideTheCaBundle) {
+    test::TestCertificate stranger;
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.caCertPath = stranger.certPath();
+    HttplibHttpClient client(c, executor);
+
+    EXPECT_TRUE(get(client, "/hello").transportError);
+}
+
+TEST_F(HttpsClientTest, AVerifyingClientNeverResumesAnUnverifiedSession) {
+    test::TestCertificate stranger;
+    test::SyncExecutor executor;
+    HttpClientConfig trusting = config();
+    trusting.verifySSL = false;
+    HttplibHttpClient unverified(trusting, executor);
+    ASSERT_TRUE(get(unverified, "/hello").ok());
+
+    HttpClientConfig c = config();
+    c.caCertPath = stranger.certPath();
+    HttplibHttpClient verifying(c, executor);
+
+    EXPECT_TRUE(get(verifying, "/hello").transportError);
+    EXPECT_EQ(verifying.poolStats().resumedHandshakes, 0u);
+}
+
+TEST_F(HttpsClientTest, SessionsAreNotSharedAcrossCaBundles) {
+    test::TestCertificate stranger;
+    test::SyncExecutor executor;
+    HttplibHttpClient trusting(config(), executor);
+    ASSERT_TRUE(get(trusting, "/hello").ok());
+
+    HttpClientConfig c = config();
+    c.caCertPath = stranger.certPath();
+    HttplibHttpClient other(c, executor);
+
+    EXPECT_TRUE(get(other, "/hello").transportError);
+    EXPECT_EQ(other.poolStats().resumedHandshakes, 0u);
+}
+
+TEST_F(HttpsClientTest, RejectsACertificateForAnotherHost) {
+    test::TestCertificate elsewhere("DNS:api.example.com");
+    httplib::SSLServer impostor(elsewhere.certPath().c_str(), elsewhere.keyPath().c_str());
+    impostor.Get("/hello", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("hello", "text/plain");
+    });
+    const int impostorPort = impostor.bind_to_any_port("127.0.0.1");
+    std::thread listener([&impostor]() { impostor.listen_after_bind(); });
+    impostor.wait_until_ready();
+
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.port = impostorPort;
+    c.caCertPath = elsewhere.certPath(); // trusted, but not for 127.0.0.1
+    HttplibHttpClient client(c, executor);
+    HttpResponse response = get(client, "/hello");
+
+    impostor.stop();
+    listener.join();
+    EXPECT_TRUE(response.transportError);
+}
+
+TEST_F(HttpsClientTest, CaBundleIsReadOnceAtConstruction) {
+    const std::string bundle = copyOf(certificate.certPath());
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.caCertPath = bundle;
+    HttplibHttpClient client(c, executor);
+    std::remove(bundle.c_str());
+
+    // Reuse is off, so each request verifies a new connection.
+    EXPECT_TRUE(get(client, "/hello").ok());
+    EXPECT_TRUE(get(client, "/hello").ok());
+    EXPECT_EQ(client.poolStats().opened, 2u);
+}
+
+TEST_F(HttpsClientTest, UnreadableCaBundleFailsRequestsWithAClearError) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.caCertPath = "/nonexistent/ca.pem";
+    HttplibHttpClient client(c, executor);
+
+    HttpResponse response = get(client, "/hello");
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_NE(response.transportErrorMessage.find("Cannot load CA certificates"),
+              std::string::npos);
+    EXPECT_FALSE(client.reloadTrustStore());
+}
+
+TEST_F(HttpsClientTest, ReloadAppliesToNewConnectionsOnly) {
+    std::promise<void> opener;
+    std::shared_future<void> gate = opener.get_future().share();
+    server->Get("/hold", [gate](const httplib::Request&, httplib::Response& res) {
+        gate.wait();
+        res.set_content("held", "text/plain");
+    });
+    const std::string bundle = copyOf(certificate.certPath());
+    test::SyncExecutor executor;
+    HttpClientConfig c = config();
+    c.caCertPath = bundle;
+    c.maxIdleConnections = 4;
+    c.tlsSessionResumption = false;
+    HttplibHttpClient client(c, executor);
+    ASSERT_TRUE(get(client, "/hello").ok()); // leaves one idle connection
+
+    std::future<HttpResponse> inFlight =
+        std::async(std::launch::async, [&client]() { return get(client, "/hold"); });
+    while (client.poolStats().idle != 0) {
+        std::this_thread::yield();
+    }
+
+    // The new bundle no longer trusts the server.
+    test::TestCertificate replacement;
+    std::remove(bundle.c_str());
+    ASSERT_EQ(std::rename(copyOf(replacement.certPath()).c_str(), bundle.c_str()), 0);
+    EXPECT_TRUE(client.reloadTrustStore());
+    opener.set_value();
+
+    EXPECT_TRUE(inFlight.get().ok()); // finished on the store it started with
+    EXPECT_EQ(client.poolStats().idle, 0u); // ...and was retired, not parked
+    EXPECT_TRUE(get(client, "/hello").transportError);
+    std::remove(bundle.c_str());
+}
+
+#endif // CPPHTTPLIB_OPENSSL_SUPPORT
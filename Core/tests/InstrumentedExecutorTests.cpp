@@ -0,0 +1,193 @@
+//
+//  InstrumentedExecutorTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "Infrastructure/Concurrency/InstrumentedExecutor.hpp"
+#include "Infrastructure/Concurrency/LatencyHistogram.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+#include "Mocks/AllocationCounter.hpp"
+#include "Mocks/DeferredExecutor.hpp"
+
+using namespace core;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+TEST(LatencyHistogram, PercentilesAreWithinOneSubBucket) {
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(microseconds(i));
+    }
+    HistogramSnapshot snapshot;
+    snapshot.add(histogram);
+
+    EXPECT_EQ(snapshot.count(), 1000u);
+    EXPECT_EQ(snapshot.max(), microseconds(1000));
+    EXPECT_NEAR(static_cast<double>(snapshot.mean().count()), 500500.0, 1.0);
+
+    const double expected[][2] = {{50, 500e3}, {90, 900e3}, {99, 990e3}};
+    for (const auto& row : expected) {
+        const double reported = static_cast<double>(snapshot.percentile(row[0]).count());
+        EXPECT_GE(reported, row[1]) << "p" << row[0];
+        EXPECT_LE(reported, row[1] * (1.0 + 1.0 / LatencyHistogram::kSubBuckets)) << "p" << row[0];
+    }
+    EXPECT_EQ(snapshot.percentile(100), microseconds(1000));
+}
+
+TEST(LatencyHistogram, BucketsCoverTheRangeWithoutGaps) {
+    EXPECT_EQ(LatencyHistogram::bucketFor(0), 0);
+    for (int bucket = 0; bucket + 1 < LatencyHistogram::kBucketCount; ++bucket) {
+        const std::uint64_t upper = static_cast<std::uint64_t>(LatencyHistogram::bucketUpperBound(bucket));
+        ASSERT_EQ(LatencyHistogram::bucketFor(upper), bucket);
+        ASSERT_EQ(LatencyHistogram::bucketFor(upper + 1), bucket + 1);
+    }
+    EXPECT_EQ(LatencyHistogram::bucketFor(~std::uint64_t(0) >> 1), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(InstrumentedExecutor, TracksQueueDepthInFlightAndCompletion) {
+    test::DeferredExecutor deferred;
+    InstrumentedExecutor executor(deferred);
+
+    std::size_t inFlightSeen = 0;
+    for (int i = 0; i < 3; ++i) {
+        executor.run([&]() { inFlightSeen = executor.snapshot().inFlight; });
+    }
+
+    InstrumentedExecutor::Snapshot before = executor.snapshot();
+    EXPECT_EQ(before.submitted, 3u);
+    EXPECT_EQ(before.completed, 0u);
+    EXPECT_EQ(before.queued, 3u);
+    EXPECT_EQ(before.peakQueued, 3u);
+    EXPECT_EQ(before.inFlight, 0u);
+
+    EXPECT_EQ(deferred.runAll(), 3u);
+    EXPECT_EQ(inFlightSeen, 1u);
+
+    InstrumentedExecutor::Snapshot after = executor.snapshot();
+    EXPECT_EQ(after.completed, 3u);
+    EXPECT_EQ(after.queued, 0u);
+    EXPECT_EQ(after.inFlight, 0u);
+    EXPECT_EQ(after.peakQueued, 3u);
+    EXPECT_EQ(after.waitTime.count(), 3u);
+    EXPECT_EQ(after.runTime.count(), 3u);
+}
+
+TEST(InstrumentedExecutor, ATaskDroppedUnrunLeavesTheQueue) {
+    test::DeferredExecutor deferred;
+    InstrumentedExecutor executor(deferred);
+
+    bool ran = false;
+    executor.run([&ran]() { ran = true; });
+    executor.run([]() {});
+    EXPECT_EQ(executor.snapshot().queued, 2u);
+
+    deferred.queued.pop_back(); // dropped, e.g. by an executor shutting down
+    EXPECT_EQ(executor.snapshot().queued, 1u);
+    deferred.runAll();
+
+    InstrumentedExecutor::Snapshot snapshot = executor.snapshot();
+    EXPECT_TRUE(ran);
+    EXPECT_EQ(snapshot.queued, 0u);
+    EXPECT_EQ(snapshot.completed, 1u);
+    EXPECT_EQ(snapshot.inFlight, 0u);
+}
+
+TEST(InstrumentedExecutor, MeasuresWaitAndRunTime) {
+    test::DeferredExecutor deferred;
+    InstrumentedExecutor executor(deferred);
+
+    executor.run([]() { std::this_thread::sleep_for(milliseconds(5)); });
+    std::this_thread::sleep_for(milliseconds(5)); // queued, not started
+    deferred.runAll();
+
+    InstrumentedExecutor::Snapshot snapshot = executor.snapshot();
+    EXPECT_GE(snapshot.waitTime.max(), milliseconds(5));
+    EXPECT_GE(snapshot.runTime.percentile(50), milliseconds(5));
+    EXPECT_LT(snapshot.runTime.percentile(50), milliseconds(500));
+}
+
+TEST(InstrumentedExecutor, ForwardsPriorityAndDoesNotAllocatePerTask) {
+    struct LaneRecorder : IExecutor {
+        std::vector<Task> queued;
+        std::vector<TaskPriority> lanes;
+        void run(Task task) override { run(std::move(task), TaskPriority::normal); }
+        void run(Task task, TaskPriority priority) override {
+            queued.push_back(std::move(task));
+            lanes.push_back(priority);
+        }
+    } recorder;
+    recorder.queued.reserve(4);
+    recorder.lanes.reserve(4);
+    InstrumentedExecutor executor(recorder);
+
+    // Same captures as HttplibHttpClient's executor hop.
+    HttpClientConfig config;
+    config.host = "api.example.com";
+    HttpRequest request;
+    int delivered = 0;
+    IHttpClient::Callback callback = [&delivered](const HttpResponse&) { ++delivered; };
+    auto hop = [config, request, callback]() { callback(HttpResponse{}); };
+
+    std::size_t allocations = 0;
+    {
+        test::AllocationScope scope;
+        executor.run(std::move(hop), TaskPriority::interactive);
+        executor.run([]() {});
+        recorder.queued[0]();
+        recorder.queued[1]();
+        allocations = scope.count();
+    }
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(delivered, 1);
+    ASSERT_EQ(recorder.lanes.size(), 2u);
+    EXPECT_EQ(recorder.lanes[0], TaskPriority::interactive);
+    EXPECT_EQ(recorder.lanes[1], TaskPriority::normal);
+}
+
+TEST(InstrumentedExecutor, CountsEveryTaskAcrossThreads) {
+    WorkStealingExecutor pool(4);
+    InstrumentedExecutor executor(pool);
+    const int kProducers = 4;
+    const int kTasksEach = 2000;
+    std::atomic<int> ran{0};
+    std::promise<void> done;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < kTasksEach; ++i) {
+                executor.run([&]() {
+                    if (ran.fetch_add(1) + 1 == kProducers * kTasksEach) {
+                        done.set_value();
+                    }
+                });
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    pool.shutdown();
+
+    InstrumentedExecutor::Snapshot snapshot = executor.snapshot();
+    const std::uint64_t total = static_cast<std::uint64_t>(kProducers * kTasksEach);
+    EXPECT_EQ(snapshot.submitted, total);
+    EXPECT_EQ(snapshot.completed, total);
+    EXPECT_EQ(snapshot.waitTime.count(), total);
+    EXPECT_EQ(snapshot.queued, 0u);
+    EXPECT_EQ(snapshot.inFlight, 0u);
+    EXPECT_GE(snapshot.peakQueued, 1u);
+}
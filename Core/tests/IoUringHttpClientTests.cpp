@@ -0,0 +1,55 @@
+//
+//  IoUringHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  What only IoUringHttpClient has: bodies larger than one of the provided
+//  receive buffers, in both directions. The contract it shares with
+//  AsyncHttpClient is tested in NonBlockingHttpClientTests.cpp. Skipped
+//  where the kernel does not offer io_uring.
+//
+
+#include <gtest/gtest.h>
+
+#include "Infrastructure/Http/IoUringHttpClient.hpp"
+
+#ifdef PUREMVC_CORE_HAS_IO_URING
+
+#include <memory>
+#include <string>
+
+#include "Mocks/LocalHttpServer.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using test::await;
+using test::get;
+
+class IoUringHttpClientTest : public ::testing::Test {
+protected:
+    std::unique_ptr<test::LocalHttpServer> server;
+
+    void SetUp() override {
+        if (!IoUringHttpClient::isSupported()) {
+            GTEST_SKIP() << "io_uring unavailable on this kernel";
+        }
+        server.reset(new test::LocalHttpServer);
+    }
+};
+
+TEST_F(IoUringHttpClientTest, BodiesLargerThanOneReceiveBufferRoundTrip) {
+    test::SyncExecutor executor;
+    IoUringHttpClient client(server->config(), executor);
+
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/echo";
+    request.body = std::string(1 << 20, 'x');
+    HttpResponse response = await(client, request);
+
+    ASSERT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(response.body.size(), request.body.size());
+    EXPECT_EQ(await(client, get("/chunked")).body,
+              std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c'));
+}
+
+#endif // PUREMVC_CORE_HAS_IO_URING
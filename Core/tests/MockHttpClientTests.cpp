@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "Infrastructure/Http/MockHttpClient.hpp"
 #include "Mocks/SyncExecutor.hpp"
 
@@ -22,3 +24,48 @@ TEST(MockHttpClient, ReturnsCannedLoginSuccess) {
     EXPECT_NE(captured.body.find("mock-access-token"), std::string::npos);
     EXPECT_NE(captured.body.find("refresh_token"), std::string::npos);
 }
+
+// MockHttpClient keeps IHttpClient's default sendStreaming(): the buffered
+// response replayed as head, one body piece, completion.
+TEST(MockHttpClient, StreamingReplaysTheBufferedResponse) {
+    test::SyncExecutor executor;
+    MockHttpClient client(executor);
+
+    std::string events;
+    std::string body;
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [&events](const HttpResponse& head) {
+        events += "head " + std::to_string(head.status) + ";";
+        return head.body.empty();
+    };
+    handler.onBody = [&events, &body](const char* data, std::size_t size) {
+        events += "body;";
+        body.append(data, size);
+        return true;
+    };
+    handler.onComplete = [&events, &completed](const HttpResponse& r) {
+        events += "done;";
+        completed = r;
+    };
+    client.sendStreaming(HttpRequest{}, handler);
+
+    EXPECT_EQ(events, "head 200;body;done;");
+    EXPECT_NE(body.find("mock-access-token"), std::string::npos);
+    EXPECT_TRUE(completed.ok());
+    EXPECT_TRUE(completed.body.empty());
+}
+
+TEST(MockHttpClient, StreamingHandlerCanAbandonTheResponse) {
+    test::SyncExecutor executor;
+    MockHttpClient client(executor);
+
+    HttpResponse completed;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [](const HttpResponse&) { return false; };
+    handler.onComplete = [&completed](const HttpResponse& r) { completed = r; };
+    client.sendStreaming(HttpRequest{}, handler);
+
+    EXPECT_TRUE(completed.transportError);
+    EXPECT_EQ(completed.transportErrorMessage, IHttpClient::streamCancelledMessage());
+}
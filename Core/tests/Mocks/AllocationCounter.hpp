@@ -0,0 +1,36 @@
+//
+//  AllocationCounter.hpp
+//  PureMVC Core tests
+//
+//  Counts global operator new calls made by the current thread while a scope is
+//  alive, so tests can assert that a hot path does not allocate. The counting
+//  operator new/delete replacements live in tests/AllocationCounter.cpp.
+//
+
+#ifndef PUREMVC_CORE_ALLOCATION_COUNTER_HPP
+#define PUREMVC_CORE_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace core { namespace test {
+
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    // Allocations (and bytes requested) on this thread since construction.
+    std::size_t count() const;
+    std::size_t bytes() const;
+
+private:
+    std::size_t startCount_;
+    std::size_t startBytes_;
+};
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,40 @@
+//
+//  ContentCodings.hpp
+//  PureMVC Core tests
+//
+//  A body worth compressing, and which coding to try it with in a build
+//  whose codecs are chosen at configure time.
+//
+
+#ifndef PUREMVC_CORE_TEST_CONTENT_CODINGS_HPP
+#define PUREMVC_CORE_TEST_CONTENT_CODINGS_HPP
+
+#include <string>
+#include "Infrastructure/Http/ContentCoding.hpp"
+
+namespace core { namespace test {
+
+// Compresses well, as JSON does.
+inline std::string sampleJson() {
+    std::string json = "[";
+    for (int i = 0; i < 500; ++i) {
+        json += "{\"id\":" + std::to_string(i) + ",\"title\":\"note " + std::to_string(i) + "\"},";
+    }
+    json.back() = ']';
+    return json;
+}
+
+// The first compressed coding this build has, if any.
+inline bool firstAvailableCoding(ContentCoding& coding) {
+    for (ContentCoding candidate : {ContentCoding::gzip, ContentCoding::brotli, ContentCoding::zstd}) {
+        if (isContentCodingAvailable(candidate)) {
+            coding = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_CONTENT_CODINGS_HPP
@@ -0,0 +1,46 @@
+//
+//  DeferredExecutor.hpp
+//  PureMVC Core tests
+//
+//  Queues tasks instead of running them, so a test controls exactly when (and
+//  in which order) posted work executes.
+//
+
+#ifndef PUREMVC_CORE_DEFERRED_EXECUTOR_HPP
+#define PUREMVC_CORE_DEFERRED_EXECUTOR_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "Domain/Ports/IExecutor.hpp"
+
+namespace core { namespace test {
+
+class DeferredExecutor : public IExecutor {
+public:
+    std::vector<Task> queued;
+
+    using IExecutor::run;
+    void run(Task task) override {
+        queued.push_back(std::move(task));
+    }
+
+    // Runs everything queued so far, including work those tasks post.
+    // Returns how many tasks ran.
+    std::size_t runAll() {
+        std::size_t ran = 0;
+        while (!queued.empty()) {
+            std::vector<Task> batch;
+            batch.swap(queued);
+            for (Task& task : batch) {
+                task();
+                ++ran;
+            }
+        }
+        return ran;
+    }
+};
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_DEFERRED_EXECUTOR_HPP
@@ -25,6 +25,7 @@ public:
     int loginCallCount = 0;
     LoginCredentials lastCredentials;
 
+    using IAuthRepository::login;
     void login(const LoginCredentials& credentials, LoginCallback callback) override {
         ++loginCallCount;
         lastCredentials = credentials;
@@ -2,12 +2,14 @@
 //  FakeHttpClient.hpp
 //  PureMVC Core tests
 //
-//  Records the request and replies synchronously with a canned response.
+//  Records the request and replies synchronously with a canned response:
+//  the scripted ones first, in order, then responseToReturn.
 //
 
 #ifndef PUREMVC_CORE_FAKE_HTTP_CLIENT_HPP
 #define PUREMVC_CORE_FAKE_HTTP_CLIENT_HPP
 
+#include <deque>
 #include "Infrastructure/Http/IHttpClient.hpp"
 
 namespace core { namespace test {
@@ -15,13 +17,21 @@ namespace core { namespace test {
 class FakeHttpClient : public IHttpClient {
 public:
     HttpResponse responseToReturn;
+    std::deque<HttpResponse> script;
     int sendCallCount = 0;
     HttpRequest lastRequest;
 
+    using IHttpClient::send;
     void send(const HttpRequest& request, Callback callback) override {
         ++sendCallCount;
         lastRequest = request;
-        callback(responseToReturn);
+        if (script.empty()) {
+            callback(responseToReturn);
+            return;
+        }
+        const HttpResponse next = script.front();
+        script.pop_front();
+        callback(next);
     }
 };
 
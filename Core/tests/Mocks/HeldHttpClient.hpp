@@ -0,0 +1,76 @@
+//
+//  HeldHttpClient.hpp
+//  PureMVC Core tests
+//
+//  Keeps every exchange, buffered or streaming, until the test answers it,
+//  so a test decides when (and in which order) responses arrive.
+//
+
+#ifndef PUREMVC_CORE_HELD_HTTP_CLIENT_HPP
+#define PUREMVC_CORE_HELD_HTTP_CLIENT_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Infrastructure/Http/IHttpClient.hpp"
+#include "Mocks/HttpResponses.hpp"
+
+namespace core { namespace test {
+
+class HeldHttpClient : public IHttpClient {
+public:
+    struct Exchange {
+        HttpRequest request;
+        Callback callback;     // send()
+        StreamHandler handler; // sendStreaming()
+    };
+    std::vector<Exchange> held;
+
+    using IHttpClient::send;
+    void send(const HttpRequest& request, Callback callback) override {
+        held.push_back(Exchange{request, std::move(callback), StreamHandler()});
+    }
+
+    void sendStreaming(const HttpRequest& request, StreamHandler handler) override {
+        held.push_back(Exchange{request, Callback(), std::move(handler)});
+    }
+
+    // Answers exchange i. False when a streaming caller abandoned the
+    // response at its head or body.
+    bool answer(std::size_t i, HttpResponse response) {
+        if (held[i].callback) {
+            held[i].callback(response);
+            return true;
+        }
+        const StreamHandler handler = held[i].handler;
+        const std::string body = std::move(response.body);
+        response.body.clear();
+        const bool accepted = handler.onHeaders(response) && handler.onBody(body.data(), body.size());
+        if (!accepted) {
+            response = HttpResponse();
+            response.transportError = true;
+            response.transportErrorMessage = streamCancelledMessage();
+        }
+        handler.onComplete(response);
+        return accepted;
+    }
+
+    bool answer(std::size_t i, int code, const std::string& body = std::string()) {
+        HttpResponse response = status(code);
+        response.body = body;
+        return answer(i, std::move(response));
+    }
+
+    void fail(std::size_t i) {
+        if (held[i].callback) {
+            held[i].callback(transportError());
+        } else {
+            held[i].handler.onComplete(transportError());
+        }
+    }
+};
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_HELD_HTTP_CLIENT_HPP
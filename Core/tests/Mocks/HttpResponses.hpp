@@ -0,0 +1,47 @@
+//
+//  HttpResponses.hpp
+//  PureMVC Core tests
+//
+//  Canned answers for scripting fake and held clients, and a look at the
+//  fields a response carries.
+//
+
+#ifndef PUREMVC_CORE_TEST_HTTP_RESPONSES_HPP
+#define PUREMVC_CORE_TEST_HTTP_RESPONSES_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Infrastructure/Http/HttpTypes.hpp"
+
+namespace core { namespace test {
+
+inline HttpResponse status(int code) {
+    HttpResponse response;
+    response.status = code;
+    return response;
+}
+
+inline HttpResponse transportError() {
+    HttpResponse response;
+    response.transportError = true;
+    response.transportErrorMessage = "Read timed out";
+    return response;
+}
+
+// Every value of the fields named 'name', sorted: httplib's test server
+// does not keep the order repeated fields were set in.
+inline std::vector<std::string> headerValues(const HttpHeaders& headers, const std::string& name) {
+    std::vector<std::string> values;
+    for (const HttpHeaders::Field& field : headers) {
+        if (HttpHeaders::equalsIgnoreCase(field.name(), name)) {
+            values.push_back(field.value);
+        }
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_HTTP_RESPONSES_HPP
@@ -0,0 +1,208 @@
+//
+//  LocalHttpServer.hpp
+//  PureMVC Core tests
+//
+//  httplib servers on 127.0.0.1 for the end-to-end tests of the socket
+//  transports, with the routes they share, plus helpers to wait for an
+//  IHttpClient's answer. /hold answers only once release() is called (or
+//  the server is destroyed), which keeps a connection busy on demand.
+//
+
+#ifndef PUREMVC_CORE_TEST_LOCAL_HTTP_SERVER_HPP
+#define PUREMVC_CORE_TEST_LOCAL_HTTP_SERVER_HPP
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <httplib.h>
+
+#include "Infrastructure/Http/ContentCoding.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+#include "Mocks/ContentCodings.hpp"
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+#include "Mocks/TestCertificate.hpp"
+#endif
+
+namespace core { namespace test {
+
+inline HttpRequest get(const std::string& path) {
+    HttpRequest request;
+    request.method = "GET";
+    request.path = path;
+    return request;
+}
+
+// The future carries the response back to the test from whichever thread
+// the callback runs on.
+inline std::future<HttpResponse> sendAsync(IHttpClient& client, const HttpRequest& request) {
+    std::shared_ptr<std::promise<HttpResponse>> promise = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> future = promise->get_future();
+    client.send(request, [promise](const HttpResponse& response) { promise->set_value(response); });
+    return future;
+}
+
+inline HttpResponse await(IHttpClient& client, const HttpRequest& request) {
+    return sendAsync(client, request).get();
+}
+
+inline bool isReady(const std::future<HttpResponse>& future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// /echo (POST: the body back, and the Content-Type it came with as
+// X-Seen-Content-Type), /whoami (the X-App header), /port (the client's
+// port, which tells connections apart), /chunked (3000 bytes in three
+// chunks), /cookies (repeated Set-Cookie and Vary), /encoded (sampleJson()
+// in the coding named by ?coding=, cut in half with &truncate, and the
+// Accept-Encoding offered as X-Seen-Accept-Encoding), /hold.
+class LocalHttpServer {
+public:
+    LocalHttpServer() {
+        server_.set_tcp_nodelay(true);
+        server_.Post("/echo", [](const httplib::Request& req, httplib::Response& res) {
+            res.set_content(req.body, "application/json");
+            res.set_header("X-Seen-Content-Type", req.get_header_value("Content-Type"));
+        });
+        server_.Get("/whoami", [](const httplib::Request& req, httplib::Response& res) {
+            res.set_content(req.get_header_value("X-App"), "text/plain");
+        });
+        server_.Get("/port", [](const httplib::Request& req, httplib::Response& res) {
+            res.set_content(std::to_string(req.remote_port), "text/plain");
+        });
+        server_.Get("/chunked", [](const httplib::Request&, httplib::Response& res) {
+            res.set_chunked_content_provider("text/plain", [](size_t offset, httplib::DataSink& sink) {
+                if (offset < 3 * 1000) {
+                    const std::string piece(1000, static_cast<char>('a' + offset / 1000));
+                    sink.write(piece.data(), piece.size());
+                } else {
+                    sink.done();
+                }
+                return true;
+            });
+        });
+        server_.Get("/cookies", [](const httplib::Request&, httplib::Response& res) {
+            res.set_header("Set-Cookie", "session=1");
+            res.set_header("Set-Cookie", "theme=dark");
+            res.set_header("Vary", "Accept");
+            res.set_header("Vary", "Accept-Language");
+            res.set_content("ok", "text/plain");
+        });
+        server_.Get("/encoded", [](const httplib::Request& req, httplib::Response& res) {
+            ContentCoding coding = ContentCoding::identity;
+            parseContentCoding(req.get_param_value("coding"), coding);
+            std::string body;
+            compressContent(coding, sampleJson(), body);
+            if (req.has_param("truncate")) {
+                body.resize(body.size() / 2);
+            }
+            if (coding != ContentCoding::identity) {
+                res.set_header("Content-Encoding", contentCodingName(coding));
+            }
+            res.set_header("X-Seen-Accept-Encoding", req.get_header_value("Accept-Encoding"));
+            res.set_content(body, "application/json");
+        });
+        server_.Get("/hold", [this](const httplib::Request&, httplib::Response& res) {
+            gate_.wait();
+            res.set_content("held", "text/plain");
+        });
+        port_ = server_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        server_.wait_until_ready();
+    }
+
+    ~LocalHttpServer() {
+        release();
+        server_.stop();
+        thread_.join();
+    }
+
+    LocalHttpServer(const LocalHttpServer&) = delete;
+    LocalHttpServer& operator=(const LocalHttpServer&) = delete;
+
+    int port() const { return port_; }
+
+    // Plain HTTP to this server.
+    HttpClientConfig config() const {
+        HttpClientConfig c;
+        c.host = "127.0.0.1";
+        c.port = port_;
+        c.useSSL = false;
+        return c;
+    }
+
+    // Lets every /hold request, present and future, answer.
+    void release() {
+        try {
+            opener_.set_value();
+        } catch (const std::future_error&) {
+        }
+    }
+
+private:
+    httplib::Server server_;
+    std::thread thread_;
+    int port_ = 0;
+    std::promise<void> opener_;
+    std::shared_future<void> gate_ = opener_.get_future().share();
+};
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+
+// HTTPS with a throwaway certificate: /hello, and /large (100000 bytes,
+// several TLS records).
+class LocalHttpsServer {
+public:
+    LocalHttpsServer() : server_(certificate.certPath().c_str(), certificate.keyPath().c_str()) {
+        if (!server_.is_valid()) {
+            return; // valid() tells the test
+        }
+        server_.set_tcp_nodelay(true);
+        server_.Get("/hello", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content("hello", "text/plain");
+        });
+        server_.Get("/large", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(std::string(100000, 'z'), "text/plain");
+        });
+        port_ = server_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        server_.wait_until_ready();
+    }
+
+    ~LocalHttpsServer() {
+        server_.stop();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    LocalHttpsServer(const LocalHttpsServer&) = delete;
+    LocalHttpsServer& operator=(const LocalHttpsServer&) = delete;
+
+    bool valid() const { return server_.is_valid(); }
+
+    // Verified against the server's certificate.
+    HttpClientConfig config() const {
+        HttpClientConfig c;
+        c.host = "127.0.0.1";
+        c.port = port_;
+        c.caCertPath = certificate.certPath();
+        return c;
+    }
+
+    TestCertificate certificate; // before server_, which loads it
+
+private:
+    httplib::SSLServer server_;
+    std::thread thread_;
+    int port_ = 0;
+};
+
+#endif // CPPHTTPLIB_OPENSSL_SUPPORT
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_LOCAL_HTTP_SERVER_HPP
@@ -0,0 +1,25 @@
+//
+//  ManualClock.hpp
+//  PureMVC Core tests
+//
+//  Options for a TimingWheelScheduler whose time only moves when the test
+//  calls advanceBy(). Paired with a SyncExecutor, due timers fire on the
+//  test's thread before advanceBy() returns.
+//
+
+#ifndef PUREMVC_CORE_TEST_MANUAL_CLOCK_HPP
+#define PUREMVC_CORE_TEST_MANUAL_CLOCK_HPP
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+
+namespace core { namespace test {
+
+inline TimingWheelScheduler::Options manualClock() {
+    TimingWheelScheduler::Options options;
+    options.manualClock = true;
+    return options;
+}
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_MANUAL_CLOCK_HPP
@@ -0,0 +1,93 @@
+//
+//  RequestRecorder.hpp
+//  PureMVC Core tests
+//
+
+#ifndef PUREMVC_CORE_TEST_REQUEST_RECORDER_HPP
+#define PUREMVC_CORE_TEST_REQUEST_RECORDER_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace core { namespace test {
+
+// Reads one request off a plain socket and answers 204. httplib's server
+// refuses a compressed request body unless it was built with that codec.
+class RequestRecorder {
+public:
+    RequestRecorder() : listener_(::socket(AF_INET, SOCK_STREAM, 0)) {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        ::bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        ::listen(listener_, 1);
+        ::getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+        thread_ = std::thread([this]() { serve(); });
+    }
+
+    ~RequestRecorder() {
+        wait();
+        ::close(listener_);
+    }
+
+    // After this, head and body hold what was read.
+    void wait() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    int port = 0;
+    std::string head; // request line and headers
+    std::string body;
+
+private:
+    void serve() {
+        const int fd = ::accept(listener_, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        std::string data;
+        std::size_t headEnd = std::string::npos;
+        std::size_t contentLength = 0;
+        char buffer[4096];
+        while (headEnd == std::string::npos || data.size() < headEnd + 4 + contentLength) {
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            data.append(buffer, static_cast<std::size_t>(n));
+            if (headEnd == std::string::npos && (headEnd = data.find("\r\n\r\n")) != std::string::npos) {
+                head = data.substr(0, headEnd + 2);
+                std::string lower = head;
+                std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+                const std::size_t field = lower.find("\r\ncontent-length:");
+                if (field != std::string::npos) {
+                    contentLength = std::stoul(lower.substr(field + 17));
+                }
+            }
+        }
+        if (headEnd != std::string::npos) {
+            body = data.substr(headEnd + 4, contentLength);
+        }
+        const char reply[] = "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n";
+        ::send(fd, reply, sizeof(reply) - 1, MSG_NOSIGNAL);
+        ::close(fd);
+    }
+
+    int listener_;
+    std::thread thread_;
+};
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_REQUEST_RECORDER_HPP
@@ -16,6 +16,7 @@ class SyncExecutor : public IExecutor {
 public:
     int runCount = 0;
 
+    using IExecutor::run;
     void run(Task task) override {
         ++runCount;
         task();
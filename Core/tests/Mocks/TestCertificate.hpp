@@ -0,0 +1,126 @@
+//
+//  TestCertificate.hpp
+//  PureMVC Core tests
+//
+//  Generates a throwaway self-signed P-256 certificate (for 127.0.0.1 and
+//  localhost unless other subject alt names are given) and writes it (and its key) to temporary PEM files, so TLS tests
+//  can run a local httplib::SSLServer and trust it through caCertPath. The
+//  files are removed when the object is destroyed. Needs OpenSSL.
+//
+
+#ifndef PUREMVC_CORE_TEST_CERTIFICATE_HPP
+#define PUREMVC_CORE_TEST_CERTIFICATE_HPP
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/sha.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include "Infrastructure/Security/Base64.hpp"
+
+namespace core { namespace test {
+
+class TestCertificate {
+public:
+    explicit TestCertificate(const char* subjectAltNames = "IP:127.0.0.1,DNS:localhost") {
+        EVP_PKEY* key = generateKey();
+        X509* cert = selfSign(key, subjectAltNames);
+        spkiPin_ = computePin(cert);
+        certPath_ = writePem("cert", [cert](FILE* file) { return PEM_write_X509(file, cert); });
+        keyPath_ = writePem("key", [key](FILE* file) {
+            return PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr);
+        });
+        X509_free(cert);
+        EVP_PKEY_free(key);
+    }
+
+    ~TestCertificate() {
+        std::remove(certPath_.c_str());
+        std::remove(keyPath_.c_str());
+    }
+
+    TestCertificate(const TestCertificate&) = delete;
+    TestCertificate& operator=(const TestCertificate&) = delete;
+
+    const std::string& certPath() const { return certPath_; }
+    const std::string& keyPath() const { return keyPath_; }
+    // base64(SHA-256(SPKI DER)), the form HttpClientConfig pins take.
+    const std::string& spkiPin() const { return spkiPin_; }
+
+private:
+    static EVP_PKEY* generateKey() {
+        EVP_PKEY* key = nullptr;
+        EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        if (ctx == nullptr || EVP_PKEY_keygen_init(ctx) <= 0 ||
+            EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1) <= 0 ||
+            EVP_PKEY_keygen(ctx, &key) <= 0) {
+            EVP_PKEY_CTX_free(ctx);
+            throw std::runtime_error("TestCertificate: key generation failed");
+        }
+        EVP_PKEY_CTX_free(ctx);
+        return key;
+    }
+
+    static X509* selfSign(EVP_PKEY* key, const char* subjectAltNames) {
+        X509* cert = X509_new();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), -60);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 60 * 60);
+        X509_set_pubkey(cert, key);
+        X509_NAME* name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(cert, name);
+
+        X509V3_CTX v3;
+        X509V3_set_ctx_nodb(&v3);
+        X509V3_set_ctx(&v3, cert, cert, nullptr, nullptr, 0);
+        X509_EXTENSION* san = X509V3_EXT_conf_nid(nullptr, &v3, NID_subject_alt_name,
+                                                  subjectAltNames);
+        X509_add_ext(cert, san, -1);
+        X509_EXTENSION_free(san);
+
+        if (X509_sign(cert, key, EVP_sha256()) <= 0) {
+            X509_free(cert);
+            throw std::runtime_error("TestCertificate: signing failed");
+        }
+        return cert;
+    }
+
+    static std::string computePin(X509* cert) {
+        unsigned char* der = nullptr;
+        const int len = i2d_X509_PUBKEY(X509_get_X509_PUBKEY(cert), &der);
+        unsigned char hash[SHA256_DIGEST_LENGTH];
+        SHA256(der, static_cast<size_t>(len), hash);
+        OPENSSL_free(der);
+        return base64Encode(hash, SHA256_DIGEST_LENGTH);
+    }
+
+    template <typename Write>
+    static std::string writePem(const char* kind, Write write) {
+        std::string path = std::string("/tmp/puremvc-") + kind + "-XXXXXX";
+        const int fd = ::mkstemp(&path[0]);
+        FILE* file = fd >= 0 ? ::fdopen(fd, "w") : nullptr;
+        if (file == nullptr || write(file) != 1) {
+            throw std::runtime_error("TestCertificate: cannot write " + path);
+        }
+        std::fclose(file);
+        return path;
+    }
+
+    std::string certPath_;
+    std::string keyPath_;
+    std::string spkiPin_;
+};
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_CERTIFICATE_HPP
@@ -0,0 +1,78 @@
+//
+//  TestListeners.hpp
+//  PureMVC Core tests
+//
+//  Local stand-ins for the addresses a connect can meet: one that accepts
+//  (the kernel completes the handshake without an accept() call), one that
+//  refuses, and one that never answers. The silent one is a listener with a
+//  backlog of zero, already full with one unaccepted connection, so the
+//  kernel drops further SYNs the way a black-holed route would.
+//
+
+#ifndef PUREMVC_CORE_TEST_LISTENERS_HPP
+#define PUREMVC_CORE_TEST_LISTENERS_HPP
+
+#include <cstdint>
+#include <string>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Infrastructure/Http/DnsCache.hpp"
+
+namespace core { namespace test {
+
+class TestListener {
+public:
+    enum class Kind { accepting, refusing, silent };
+
+    // port 0: any free port.
+    explicit TestListener(Kind kind, const std::string& ip = "127.0.0.1", int port = 0)
+        : fd_(::socket(AF_INET, SOCK_STREAM, 0)) {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<std::uint16_t>(port));
+        ::inet_pton(AF_INET, ip.c_str(), &address.sin_addr);
+        socklen_t length = sizeof(address);
+        const int one = 1;
+        ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+        SocketAddress::parse(ip, port_, address_);
+        if (kind == Kind::refusing) {
+            return; // bound, never listening: connects are reset
+        }
+        ::listen(fd_, kind == Kind::silent ? 0 : 16);
+        if (kind == Kind::silent) {
+            filler_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            ::fcntl(filler_, F_SETFL, O_NONBLOCK);
+            ::connect(filler_, address_.get(), address_.length);
+        }
+    }
+
+    ~TestListener() {
+        if (filler_ >= 0) {
+            ::close(filler_);
+        }
+        ::close(fd_);
+    }
+
+    TestListener(const TestListener&) = delete;
+    TestListener& operator=(const TestListener&) = delete;
+
+    int port() const { return port_; }
+    const SocketAddress& address() const { return address_; }
+
+private:
+    int fd_;
+    int filler_ = -1;
+    int port_ = 0;
+    SocketAddress address_;
+};
+
+}} // namespace core::test
+
+#endif // PUREMVC_CORE_TEST_LISTENERS_HPP
@@ -0,0 +1,515 @@
+//
+//  NonBlockingHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  The contract AsyncHttpClient (epoll) and IoUringHttpClient share, run
+//  end-to-end against a local httplib server on 127.0.0.1 for each of
+//  them: request/response mapping, keep-alive reuse, chunked bodies,
+//  timeouts, the per-host cap, many requests in flight, DNS lookups kept
+//  off the loop, content codings (in builds with a codec), and (with
+//  OpenSSL) verification and pinning. What only one transport has is tested
+//  in AsyncHttpClientTests.cpp and IoUringHttpClientTests.cpp. io_uring runs
+//  are skipped where the kernel does not offer it. Linux only.
+//
+
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Infrastructure/Http/AsyncHttpClient.hpp"
+#include "Infrastructure/Http/ContentCoding.hpp"
+#include "Infrastructure/Http/DnsCache.hpp"
+#include "Infrastructure/Http/IoUringHttpClient.hpp"
+#include "Mocks/ContentCodings.hpp"
+#include "Mocks/HttpResponses.hpp"
+#include "Mocks/LocalHttpServer.hpp"
+#include "Mocks/RequestRecorder.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using test::await;
+using test::get;
+using test::isReady;
+using test::sendAsync;
+
+namespace {
+
+template <typename Client>
+bool transportAvailable() {
+    return true;
+}
+
+#ifdef PUREMVC_CORE_HAS_IO_URING
+template <>
+bool transportAvailable<IoUringHttpClient>() {
+    return IoUringHttpClient::isSupported();
+}
+
+using Transports = ::testing::Types<AsyncHttpClient, IoUringHttpClient>;
+#else
+using Transports = ::testing::Types<AsyncHttpClient>;
+#endif
+
+// "Epoll" and "IoUring" in test names rather than 0 and 1.
+struct TransportName {
+    template <typename Client>
+    static std::string GetName(int) {
+        return std::is_same<Client, AsyncHttpClient>::value ? "Epoll" : "IoUring";
+    }
+};
+
+// A DnsCache whose lookups answer 127.0.0.1 only once release() is called
+// (or the HeldDns goes away).
+class HeldDns {
+public:
+    HeldDns() {
+        std::shared_future<void> gate = gate_;
+        DnsCache::Options options;
+        options.lookup = [gate](const std::string&, std::vector<SocketAddress>& addresses, std::string&) {
+            gate.wait();
+            SocketAddress address;
+            SocketAddress::parse("127.0.0.1", 0, address);
+            addresses.assign(1, address);
+            return true;
+        };
+        cache = std::make_shared<DnsCache>(options);
+    }
+
+    ~HeldDns() { release(); }
+
+    void release() {
+        try {
+            opener_.set_value();
+        } catch (const std::future_error&) {
+        }
+    }
+
+    std::shared_ptr<DnsCache> cache;
+
+private:
+    std::promise<void> opener_;
+    std::shared_future<void> gate_ = opener_.get_future().share();
+};
+
+} // namespace
+
+template <typename Client>
+class NonBlockingHttpClientTest : public ::testing::Test {
+protected:
+    std::unique_ptr<test::LocalHttpServer> server;
+
+    void SetUp() override {
+        if (!transportAvailable<Client>()) {
+            GTEST_SKIP() << "io_uring unavailable on this kernel";
+        }
+        server.reset(new test::LocalHttpServer);
+    }
+
+    HttpClientConfig config() const { return server->config(); }
+};
+
+TYPED_TEST_SUITE(NonBlockingHttpClientTest, Transports, TransportName);
+
+TYPED_TEST(NonBlockingHttpClientTest, PostMapsStatusBodyAndHeaders) {
+    test::SyncExecutor executor;
+    TypeParam client(this->config(), executor);
+
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/echo";
+    request.body = R"({"hello":"world"})";
+    HttpResponse response = await(client, request);
+
+    EXPECT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(response.status, 200);
+    EXPECT_EQ(response.body, request.body);
+    EXPECT_EQ(response.headers["X-Seen-Content-Type"], "application/json");
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, RepeatedResponseFieldsKeepEveryValue) {
+    test::SyncExecutor executor;
+    TypeParam client(this->config(), executor);
+
+    HttpResponse response = await(client, get("/cookies"));
+
+    ASSERT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(test::headerValues(response.headers, "Set-Cookie"),
+              (std::vector<std::string>{"session=1", "theme=dark"}));
+    EXPECT_EQ(test::headerValues(response.headers, "Vary"),
+              (std::vector<std::string>{"Accept", "Accept-Language"}));
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, RequestHeadersOverrideDefaults) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.defaultHeaders["X-App"] = "default";
+    TypeParam client(c, executor);
+
+    EXPECT_EQ(await(client, get("/whoami")).body, "default");
+
+    HttpRequest request = get("/whoami");
+    request.headers["x-app"] = "override";
+    EXPECT_EQ(await(client, request).body, "override");
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, KeepsOneConnectionAliveAcrossRequests) {
+    test::SyncExecutor executor;
+    TypeParam client(this->config(), executor);
+
+    const std::string first = await(client, get("/port")).body;
+    EXPECT_EQ(await(client, get("/port")).body, first);
+    EXPECT_EQ(await(client, get("/port")).body, first);
+
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.opened, 1u);
+    EXPECT_EQ(stats.reused, 2u);
+    EXPECT_EQ(stats.idle, 1u);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, ClosedIdleConnectionsAreReplaced) {
+    test::SyncExecutor executor;
+    TypeParam client(this->config(), executor);
+
+    const std::string first = await(client, get("/port")).body;
+    client.closeIdleConnections();
+    const std::string second = await(client, get("/port")).body;
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(client.poolStats().opened, 2u);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, ReassemblesChunkedBodies) {
+    test::SyncExecutor executor;
+    TypeParam client(this->config(), executor);
+
+    HttpResponse response = await(client, get("/chunked"));
+
+    ASSERT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(response.body, std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c'));
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, ThousandRequestsInFlight) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.maxConnectionsPerHost = 8;
+    c.connectionTimeoutSec = 30; // queued behind the cap for a while
+    TypeParam client(c, executor);
+
+    const int total = 1000;
+    int succeeded = 0; // callbacks all run on the one loop thread
+    int answered = 0;
+    std::size_t mostOpen = 0;
+    std::promise<void> allDone;
+    for (int i = 0; i < total; ++i) {
+        client.send(get("/port"), [&](const HttpResponse& response) {
+            succeeded += response.ok() ? 1 : 0;
+            mostOpen = std::max(mostOpen, client.poolStats().open);
+            if (++answered == total) {
+                allDone.set_value();
+            }
+        });
+    }
+    allDone.get_future().wait();
+
+    EXPECT_EQ(succeeded, total);
+    EXPECT_LE(mostOpen, 8u);
+    EXPECT_GT(client.poolStats().reused, 900u);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, SlowResponseFailsAfterTheReadTimeout) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.readTimeoutSec = 1;
+    TypeParam client(c, executor);
+
+    HttpResponse response = await(client, get("/hold"));
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_EQ(response.transportErrorMessage, "Read timed out");
+    EXPECT_EQ(client.poolStats().open, 0u);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, UnreachableServerYieldsTransportError) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.port = 1; // nothing listens there
+    TypeParam client(c, executor);
+
+    HttpResponse response = await(client, get("/port"));
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_EQ(response.status, 0);
+    EXPECT_NE(response.transportErrorMessage.find("Connection failed"), std::string::npos);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, RequestsBeyondTheCapWaitForAFreeConnection) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.maxConnectionsPerHost = 1;
+    TypeParam client(c, executor);
+
+    std::future<HttpResponse> held = sendAsync(client, get("/hold"));
+    std::future<HttpResponse> queued = sendAsync(client, get("/port"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(isReady(queued));
+
+    this->server->release();
+
+    EXPECT_TRUE(held.get().ok());
+    EXPECT_TRUE(queued.get().ok());
+    EXPECT_EQ(client.poolStats().opened, 1u);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, CapReachedForLongerThanTheConnectTimeoutFails) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.maxConnectionsPerHost = 1;
+    c.connectionTimeoutSec = 1;
+    TypeParam client(c, executor);
+
+    std::future<HttpResponse> held = sendAsync(client, get("/hold"));
+    HttpResponse queued = await(client, get("/port"));
+
+    EXPECT_TRUE(queued.transportError);
+    EXPECT_NE(queued.transportErrorMessage.find("pool exhausted"), std::string::npos);
+    this->server->release();
+    EXPECT_TRUE(held.get().ok());
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, DestroyingTheClientAnswersRequestsInFlight) {
+    test::SyncExecutor executor;
+    std::unique_ptr<TypeParam> client(new TypeParam(this->config(), executor));
+    std::future<HttpResponse> held = sendAsync(*client, get("/hold"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    client.reset();
+
+    ASSERT_TRUE(isReady(held));
+    EXPECT_TRUE(held.get().transportError);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, RequestsWaitingForDnsShareOneLookup) {
+    HeldDns dns;
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.host = "held.test";
+    c.dnsCache = dns.cache;
+    TypeParam client(c, executor);
+
+    std::future<HttpResponse> first = sendAsync(client, get("/port"));
+    std::future<HttpResponse> second = sendAsync(client, get("/port"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(isReady(first));
+    EXPECT_FALSE(isReady(second));
+
+    dns.release();
+
+    EXPECT_TRUE(first.get().ok());
+    EXPECT_TRUE(second.get().ok());
+    EXPECT_EQ(dns.cache->stats().misses, 1u);
+}
+
+// The loop is not stuck in the lookup: it answers the request and shuts
+// down while the lookup is still out.
+TYPED_TEST(NonBlockingHttpClientTest, DestroyingTheClientDoesNotWaitForDns) {
+    HeldDns dns;
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.host = "held.test";
+    c.dnsCache = dns.cache;
+    std::unique_ptr<TypeParam> client(new TypeParam(c, executor));
+    std::future<HttpResponse> pending = sendAsync(*client, get("/port"));
+
+    std::future<void> destroyed = std::async(std::launch::async, [&client]() { client.reset(); });
+    const bool prompt = destroyed.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    dns.release();
+    destroyed.get();
+
+    EXPECT_TRUE(prompt);
+    ASSERT_TRUE(isReady(pending));
+    EXPECT_TRUE(pending.get().transportError);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, RejectsHeaderValuesThatWouldSplitTheRequest) {
+    test::SyncExecutor executor;
+    TypeParam client(this->config(), executor);
+
+    HttpRequest request = get("/whoami");
+    request.headers["X-App"] = "a\r\nX-Injected: 1";
+    HttpResponse response = await(client, request);
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_EQ(client.poolStats().opened, 0u);
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, OffersAndDecodesTheCodingsThisBuildHas) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.acceptEncodings = {ContentCoding::zstd, ContentCoding::identity, ContentCoding::brotli, ContentCoding::gzip};
+    TypeParam client(c, executor);
+
+    HttpResponse plain = await(client, get("/encoded"));
+    ASSERT_TRUE(plain.ok()) << plain.transportErrorMessage;
+    EXPECT_EQ(plain.headers.get("X-Seen-Accept-Encoding"), acceptEncodingValue(c.acceptEncodings));
+    EXPECT_EQ(plain.body, test::sampleJson());
+
+    for (ContentCoding coding : c.acceptEncodings) {
+        if (coding == ContentCoding::identity || !isContentCodingAvailable(coding)) {
+            continue;
+        }
+        HttpResponse response = await(client, get(std::string("/encoded?coding=") + contentCodingName(coding)));
+        ASSERT_TRUE(response.ok()) << response.transportErrorMessage;
+        EXPECT_EQ(response.body, test::sampleJson()) << contentCodingName(coding);
+        EXPECT_FALSE(response.headers.contains(HttpHeader::contentEncoding));
+        EXPECT_FALSE(response.headers.contains(HttpHeader::contentLength));
+    }
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, ARequestChoosingItsOwnEncodingGetsTheBodyAsSent) {
+    ContentCoding coding;
+    if (!test::firstAvailableCoding(coding)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.acceptEncodings = {coding};
+    TypeParam client(c, executor);
+    HttpRequest request = get(std::string("/encoded?coding=") + contentCodingName(coding));
+    request.headers.set(HttpHeader::acceptEncoding, contentCodingName(coding));
+
+    HttpResponse response = await(client, request);
+
+    std::string encoded;
+    ASSERT_TRUE(compressContent(coding, test::sampleJson(), encoded));
+    EXPECT_EQ(response.body, encoded);
+    EXPECT_EQ(response.headers.get(HttpHeader::contentEncoding), contentCodingName(coding));
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, ABodyCutShortFailsToDecode) {
+    ContentCoding coding;
+    if (!test::firstAvailableCoding(coding)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.acceptEncodings = {coding};
+    TypeParam client(c, executor);
+
+    HttpResponse response =
+        await(client, get(std::string("/encoded?truncate=1&coding=") + contentCodingName(coding)));
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_EQ(response.transportErrorMessage.find("Content decoding failed"), 0u) << response.transportErrorMessage;
+}
+
+TYPED_TEST(NonBlockingHttpClientTest, LargeRequestBodiesAreCompressed) {
+    ContentCoding coding;
+    if (!test::firstAvailableCoding(coding)) {
+        GTEST_SKIP() << "built without content codecs";
+    }
+    HttpRequest post;
+    post.method = "POST";
+    post.path = "/sync";
+
+    for (const std::string& body : {test::sampleJson(), std::string("{\"small\":true}")}) {
+        test::RequestRecorder recorder;
+        test::SyncExecutor executor;
+        HttpClientConfig c = this->config();
+        c.port = recorder.port;
+        c.requestEncoding = coding;
+        TypeParam client(c, executor);
+        post.body = body;
+
+        EXPECT_EQ(await(client, post).status, 204);
+        recorder.wait();
+
+        const bool compressed = body.size() > c.compressRequestsAbove;
+        const std::string field = std::string("Content-Encoding: ") + contentCodingName(coding) + "\r\n";
+        EXPECT_EQ(recorder.head.find(field) != std::string::npos, compressed) << recorder.head;
+        std::string sent = recorder.body;
+        if (compressed) {
+            EXPECT_LT(sent.size(), body.size() / 4);
+            std::unique_ptr<ContentDecoder> decoder = ContentDecoder::create(coding);
+            sent.clear();
+            ASSERT_TRUE(decoder->write(recorder.body.data(), recorder.body.size(),
+                                       [&sent](const char* data, std::size_t size) {
+                                           sent.append(data, size);
+                                           return true;
+                                       }));
+        }
+        EXPECT_EQ(sent, body);
+    }
+}
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+
+template <typename Client>
+class NonBlockingHttpsClientTest : public ::testing::Test {
+protected:
+    std::unique_ptr<test::LocalHttpsServer> server;
+
+    void SetUp() override {
+        if (!transportAvailable<Client>()) {
+            GTEST_SKIP() << "io_uring unavailable on this kernel";
+        }
+        server.reset(new test::LocalHttpsServer);
+        ASSERT_TRUE(server->valid());
+    }
+
+    HttpClientConfig config() const { return server->config(); }
+};
+
+TYPED_TEST_SUITE(NonBlockingHttpsClientTest, Transports, TransportName);
+
+TYPED_TEST(NonBlockingHttpsClientTest, VerifiesAndReusesTheTlsConnection) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.pinnedSpkiSha256Base64 = {this->server->certificate.spkiPin()};
+    TypeParam client(c, executor);
+
+    HttpResponse first = await(client, get("/hello"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // let session tickets arrive while idle
+    HttpResponse second = await(client, get("/large"));
+
+    EXPECT_TRUE(first.ok()) << first.transportErrorMessage;
+    EXPECT_EQ(first.body, "hello");
+    EXPECT_EQ(second.body, std::string(100000, 'z'));
+    ConnectionPoolStats stats = client.poolStats();
+    EXPECT_EQ(stats.fullHandshakes, 1u);
+    EXPECT_EQ(stats.reused, 1u);
+}
+
+TYPED_TEST(NonBlockingHttpsClientTest, PinMismatchFailsTheHandshake) {
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.pinnedSpkiSha256Base64 = {"AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA="};
+    TypeParam client(c, executor);
+
+    HttpResponse response = await(client, get("/hello"));
+
+    EXPECT_TRUE(response.transportError);
+    EXPECT_NE(response.transportErrorMessage.find("TLS handshake failed"), std::string::npos);
+}
+
+TYPED_TEST(NonBlockingHttpsClientTest, RejectsAServerOutsideTheCaBundle) {
+    test::TestCertificate stranger;
+    test::SyncExecutor executor;
+    HttpClientConfig c = this->config();
+    c.caCertPath = stranger.certPath();
+    TypeParam client(c, executor);
+
+    EXPECT_TRUE(await(client, get("/hello")).transportError);
+}
+
+#endif // CPPHTTPLIB_OPENSSL_SUPPORT
+
+#endif // defined(__linux__)
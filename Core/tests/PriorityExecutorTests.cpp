@@ -0,0 +1,132 @@
+//
+//  PriorityExecutorTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Infrastructure/Concurrency/PriorityExecutor.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+
+namespace {
+
+// Holds a worker hostage until release() so a test can stack up queued work.
+class Gate {
+public:
+    Task blocker() {
+        return [this]() {
+            entered_.set_value();
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return open_; });
+        };
+    }
+    void waitUntilEntered() { entered_.get_future().wait(); }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::promise<void> entered_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+};
+
+PriorityExecutor::Options sharedOnly(std::size_t workers) {
+    PriorityExecutor::Options options;
+    options.sharedWorkers = workers;
+    options.reservedWorkers[0] = 0;
+    return options;
+}
+
+} // namespace
+
+TEST(PriorityExecutor, SharedWorkerTakesInteractiveAheadOfQueuedBackground) {
+    PriorityExecutor executor(sharedOnly(1));
+    Gate gate;
+    std::vector<std::string> order;
+
+    executor.run(gate.blocker(), TaskPriority::background);
+    gate.waitUntilEntered();
+    executor.run([&order]() { order.push_back("background"); }, TaskPriority::background);
+    executor.run([&order]() { order.push_back("normal"); });
+    executor.run([&order]() { order.push_back("interactive"); }, TaskPriority::interactive);
+    EXPECT_EQ(executor.queuedCount(TaskPriority::background), 1u);
+
+    gate.release();
+    executor.shutdown();
+    EXPECT_EQ(order, (std::vector<std::string>{"interactive", "normal", "background"}));
+}
+
+TEST(PriorityExecutor, ReservedInteractiveWorkerIsNotBlockedByBackgroundBurst) {
+    PriorityExecutor::Options options;
+    options.sharedWorkers = 1;
+    options.reservedWorkers[static_cast<int>(TaskPriority::interactive)] = 1;
+    PriorityExecutor executor(options);
+    Gate gate;
+
+    executor.run(gate.blocker(), TaskPriority::background);
+    gate.waitUntilEntered();
+    for (int i = 0; i < 50; ++i) {
+        executor.run([]() {}, TaskPriority::background);
+    }
+
+    std::promise<void> loggedIn;
+    executor.run([&loggedIn]() { loggedIn.set_value(); }, TaskPriority::interactive);
+    EXPECT_EQ(loggedIn.get_future().wait_for(std::chrono::seconds(2)),
+              std::future_status::ready);
+
+    gate.release();
+    executor.shutdown();
+}
+
+TEST(PriorityExecutor, AgedBackgroundWorkIsNotStarved) {
+    PriorityExecutor::Options options = sharedOnly(1);
+    options.agingThreshold = std::chrono::milliseconds(20);
+    PriorityExecutor executor(options);
+    Gate gate;
+    std::vector<std::string> order;
+
+    executor.run(gate.blocker(), TaskPriority::interactive);
+    gate.waitUntilEntered();
+    executor.run([&order]() { order.push_back("background"); }, TaskPriority::background);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    executor.run([&order]() { order.push_back("interactive"); }, TaskPriority::interactive);
+
+    gate.release();
+    executor.shutdown();
+    EXPECT_EQ(order, (std::vector<std::string>{"background", "interactive"}));
+}
+
+TEST(PriorityExecutor, PostAfterShutdownRunsInline) {
+    PriorityExecutor executor;
+    executor.shutdown();
+    bool ran = false;
+    executor.run([&ran]() { ran = true; }, TaskPriority::background);
+    EXPECT_TRUE(ran);
+}
+
+TEST(PriorityExecutor, ExecutorsWithoutLanesIgnoreThePriority) {
+    test::SyncExecutor executor;
+    IExecutor& port = executor;
+    bool ran = false;
+
+    port.run([&ran]() { ran = true; }, TaskPriority::background);
+
+    EXPECT_TRUE(ran);
+    EXPECT_EQ(executor.runCount, 1);
+}
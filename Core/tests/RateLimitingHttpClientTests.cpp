@@ -0,0 +1,209 @@
+//
+//  RateLimitingHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  RateLimitingHttpClient on a manual clock: pacing by the host and route
+//  buckets, the queue released by the timer, pauses for 429 and 503 with
+//  Retry-After, the rate adapting down and back, and shedding.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+#include "Infrastructure/Http/RateLimitingHttpClient.hpp"
+#include "Mocks/FakeHttpClient.hpp"
+#include "Mocks/HttpResponses.hpp"
+#include "Mocks/ManualClock.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+namespace {
+
+HttpResponse retryAfter(int code, const std::string& value) {
+    HttpResponse response = test::status(code);
+    response.headers.set(HttpHeader::retryAfter, value);
+    return response;
+}
+
+HttpRequest request(const std::string& method, const std::string& path) {
+    HttpRequest r;
+    r.method = method;
+    r.path = path;
+    return r;
+}
+
+HttpRequest get() {
+    return request("GET", "/me");
+}
+
+HttpRequest login() {
+    return request("POST", "/api/v1/auth/login");
+}
+
+} // namespace
+
+class RateLimitingHttpClientTest : public ::testing::Test {
+protected:
+    RateLimitingHttpClientTest() { inner.responseToReturn = test::status(200); }
+
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler{dispatch, test::manualClock()};
+    test::FakeHttpClient inner;
+    std::vector<HttpResponse> answers;
+
+    static RateLimitingHttpClient::Options options(double rate, double burst) {
+        RateLimitingHttpClient::Options o;
+        o.host.ratePerSecond = rate;
+        o.host.burst = burst;
+        return o;
+    }
+
+    void send(IHttpClient& client, const HttpRequest& r = get()) {
+        client.send(r, [this](const HttpResponse& response) { answers.push_back(response); });
+    }
+};
+
+TEST_F(RateLimitingHttpClientTest, PacesRequestsAtTheHostRate) {
+    RateLimitingHttpClient client(inner, scheduler, options(2, 2));
+
+    for (int i = 0; i < 4; ++i) {
+        send(client);
+    }
+    EXPECT_EQ(inner.sendCallCount, 2); // the burst
+    EXPECT_EQ(client.stats().waiting, 2u);
+
+    scheduler.advanceBy(milliseconds(490));
+    EXPECT_EQ(inner.sendCallCount, 2);
+    scheduler.advanceBy(milliseconds(20));
+    EXPECT_EQ(inner.sendCallCount, 3);
+    scheduler.advanceBy(milliseconds(500));
+    EXPECT_EQ(inner.sendCallCount, 4);
+
+    EXPECT_EQ(answers.size(), 4u);
+    const RateLimitStats stats = client.stats();
+    EXPECT_EQ(stats.sent, 4u);
+    EXPECT_EQ(stats.queued, 2u);
+    EXPECT_EQ(stats.waiting, 0u);
+}
+
+TEST_F(RateLimitingHttpClientTest, ARouteLimitAppliesOnTopOfTheHosts) {
+    RateLimitingHttpClient::Options o = options(100, 100);
+    o.routes["POST /api/v1/auth/login"].ratePerSecond = 1;
+    o.routes["POST /api/v1/auth/login"].burst = 1;
+    RateLimitingHttpClient client(inner, scheduler, o);
+
+    send(client, login());
+    send(client, login());
+    send(client, get());
+    EXPECT_EQ(inner.sendCallCount, 2); // the GET does not wait for the login's route
+    EXPECT_EQ(inner.lastRequest.path, "/me");
+
+    scheduler.advanceBy(milliseconds(1000));
+    EXPECT_EQ(inner.sendCallCount, 3);
+    EXPECT_EQ(inner.lastRequest.path, "/api/v1/auth/login");
+    EXPECT_DOUBLE_EQ(client.currentRate(login()), 1);
+    EXPECT_DOUBLE_EQ(client.currentRate(get()), 100);
+}
+
+TEST_F(RateLimitingHttpClientTest, A429PausesForRetryAfterAndHalvesTheRate) {
+    RateLimitingHttpClient client(inner, scheduler, options(10, 10));
+    inner.script = {retryAfter(429, "3")};
+
+    send(client);
+    EXPECT_EQ(answers.back().status, 429); // passed on as it is
+    EXPECT_DOUBLE_EQ(client.currentRate(get()), 5);
+
+    send(client);
+    scheduler.advanceBy(milliseconds(2990));
+    EXPECT_EQ(inner.sendCallCount, 1);
+    scheduler.advanceBy(milliseconds(20));
+    EXPECT_EQ(inner.sendCallCount, 2);
+    EXPECT_EQ(client.stats().throttled, 1u);
+
+    for (int i = 0; i < 10; ++i) {
+        scheduler.advanceBy(milliseconds(200));
+        send(client);
+    }
+    EXPECT_DOUBLE_EQ(client.currentRate(get()), 10); // each 2xx earns back 5% of the limit
+}
+
+TEST_F(RateLimitingHttpClientTest, A429WithoutRetryAfterPausesForTheDefault) {
+    RateLimitingHttpClient::Options o = options(10, 10);
+    o.retryAfterDefault = milliseconds(400);
+    RateLimitingHttpClient client(inner, scheduler, o);
+    inner.script = {test::status(429), test::status(429)};
+
+    send(client);
+    send(client);
+    EXPECT_EQ(inner.sendCallCount, 1);
+    scheduler.advanceBy(milliseconds(410));
+    EXPECT_EQ(inner.sendCallCount, 2);
+    EXPECT_DOUBLE_EQ(client.currentRate(get()), 5); // a second 429 within adaptInterval cuts nothing more
+}
+
+TEST_F(RateLimitingHttpClientTest, A503PausesTheHostUntilARetryAfterDate) {
+    RateLimitingHttpClient::Options o = options(0, 0); // no pacing, pauses only
+    o.routes["POST /api/v1/auth/login"].ratePerSecond = 5;
+    o.wallClock = []() {
+        return RateLimitingHttpClient::WallClock::time_point(seconds(784111777 - 2)); // 2 s before the date
+    };
+    RateLimitingHttpClient client(inner, scheduler, o);
+    inner.script = {retryAfter(503, "Sun, 06 Nov 1994 08:49:37 GMT")};
+
+    IHttpClient::StreamHandler handler;
+    int heads = 0;
+    handler.onHeaders = [&heads](const HttpResponse&) {
+        ++heads;
+        return true;
+    };
+    client.sendStreaming(get(), handler);
+    EXPECT_EQ(heads, 1);
+
+    send(client, login()); // the host's pause holds every route
+    send(client);
+    scheduler.advanceBy(milliseconds(1990));
+    EXPECT_EQ(inner.sendCallCount, 1);
+    scheduler.advanceBy(milliseconds(20));
+    EXPECT_EQ(inner.sendCallCount, 3);
+    EXPECT_DOUBLE_EQ(client.currentRate(get()), 0);
+}
+
+TEST_F(RateLimitingHttpClientTest, ShedsWhatWaitsPastItsDeadlineOrFindsTheQueueFull) {
+    RateLimitingHttpClient::Options o = options(1, 1);
+    o.maxQueueDelay = milliseconds(500);
+    o.maxQueueLength = 1;
+    RateLimitingHttpClient client(inner, scheduler, o);
+
+    send(client);
+    send(client);
+    send(client);
+    ASSERT_EQ(answers.size(), 2u);
+    EXPECT_TRUE(answers[1].transportError); // no room in the queue
+    EXPECT_EQ(answers[1].transportErrorMessage, RateLimitingHttpClient::rateLimitedMessage());
+
+    scheduler.advanceBy(milliseconds(500));
+    ASSERT_EQ(answers.size(), 3u);
+    EXPECT_EQ(answers[2].transportErrorMessage, RateLimitingHttpClient::rateLimitedMessage());
+    EXPECT_EQ(inner.sendCallCount, 1);
+    EXPECT_EQ(client.stats().shed, 2u);
+}
+
+TEST_F(RateLimitingHttpClientTest, DestroyingTheClientShedsItsQueue) {
+    {
+        RateLimitingHttpClient client(inner, scheduler, options(1, 1));
+        send(client);
+        send(client);
+        EXPECT_EQ(answers.size(), 1u);
+    }
+    ASSERT_EQ(answers.size(), 2u);
+    EXPECT_EQ(answers[1].transportErrorMessage, RateLimitingHttpClient::rateLimitedMessage());
+    scheduler.advanceBy(milliseconds(2000));
+    EXPECT_EQ(inner.sendCallCount, 1);
+}
@@ -0,0 +1,315 @@
+//
+//  RetryingHttpClientTests.cpp
+//  PureMVC Core tests
+//
+//  RetryingHttpClient over a scripted fake client on a manual clock (which
+//  responses are retried, when, and how the budget caps them), then over
+//  HttplibHttpClient against a local server that injects faults.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <httplib.h>
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+#include "Infrastructure/Http/HttplibHttpClient.hpp"
+#include "Infrastructure/Http/RetryingHttpClient.hpp"
+#include "Mocks/FakeHttpClient.hpp"
+#include "Mocks/HttpResponses.hpp"
+#include "Mocks/ManualClock.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using std::chrono::milliseconds;
+
+namespace {
+
+HttpRequest request(const std::string& method) {
+    HttpRequest r;
+    r.method = method;
+    r.path = "/items";
+    return r;
+}
+
+RetryingHttpClient::Options fastRetries() {
+    RetryingHttpClient::Options options;
+    options.defaultPolicy.baseDelay = milliseconds(100);
+    options.defaultPolicy.maxDelay = milliseconds(1000);
+    options.seed = 7;
+    return options;
+}
+
+HttpRequest flaky() {
+    HttpRequest r = request("GET");
+    r.path = "/flaky";
+    return r;
+}
+
+HttpResponse await(IHttpClient& client, const HttpRequest& request) {
+    std::shared_ptr<std::promise<HttpResponse>> answered = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> future = answered->get_future();
+    client.send(request, [answered](const HttpResponse& response) { answered->set_value(response); });
+    return future.get();
+}
+
+struct Answer {
+    bool answered = false;
+    HttpResponse response;
+
+    IHttpClient::Callback callback() {
+        return [this](const HttpResponse& r) {
+            answered = true;
+            response = r;
+        };
+    }
+};
+
+} // namespace
+
+class RetryingHttpClientTest : public ::testing::Test {
+protected:
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler{dispatch, test::manualClock()};
+    test::FakeHttpClient inner;
+
+    void SetUp() override { inner.responseToReturn = test::status(200); }
+};
+
+TEST_F(RetryingHttpClientTest, RetriesTransportErrorsAndRetryableStatuses) {
+    RetryingHttpClient client(inner, scheduler, fastRetries());
+    inner.script = {test::transportError(), test::status(503)};
+
+    Answer answer;
+    client.send(request("GET"), answer.callback());
+    EXPECT_FALSE(answer.answered);
+    scheduler.advanceBy(std::chrono::seconds(5));
+
+    ASSERT_TRUE(answer.answered);
+    EXPECT_EQ(answer.response.status, 200);
+    EXPECT_EQ(inner.sendCallCount, 3);
+    EXPECT_EQ(client.stats().retries, 2u);
+}
+
+// First delay is baseDelay; each later one is drawn from
+// [baseDelay, 3 x previous], never above maxDelay.
+TEST_F(RetryingHttpClientTest, BackoffIsDecorrelatedJitterWithinBounds) {
+    RetryingHttpClient::Options options = fastRetries();
+    options.defaultPolicy.maxAttempts = 3;
+    RetryingHttpClient client(inner, scheduler, options);
+    inner.script = {test::status(503), test::status(503)};
+
+    Answer answer;
+    client.send(request("GET"), answer.callback());
+    scheduler.advanceBy(milliseconds(99));
+    EXPECT_EQ(inner.sendCallCount, 1);
+    scheduler.advanceBy(milliseconds(1));
+    EXPECT_EQ(inner.sendCallCount, 2);
+
+    scheduler.advanceBy(milliseconds(99));
+    EXPECT_EQ(inner.sendCallCount, 2);
+    scheduler.advanceBy(milliseconds(201));
+    EXPECT_EQ(inner.sendCallCount, 3);
+    EXPECT_EQ(answer.response.status, 200);
+}
+
+TEST_F(RetryingHttpClientTest, NonRetryableResponsesAreReturnedAtOnce) {
+    RetryingHttpClient client(inner, scheduler, fastRetries());
+    inner.script = {test::status(404)};
+
+    Answer answer;
+    client.send(request("GET"), answer.callback());
+
+    ASSERT_TRUE(answer.answered);
+    EXPECT_EQ(answer.response.status, 404);
+    EXPECT_EQ(inner.sendCallCount, 1);
+    EXPECT_EQ(scheduler.pendingCount(), 0u);
+}
+
+TEST_F(RetryingHttpClientTest, PostIsRetriedOnlyWithAnIdempotencyKeyOrAnOptIn) {
+    RetryingHttpClient plain(inner, scheduler, fastRetries());
+    inner.script = {test::status(503)};
+    Answer once;
+    plain.send(request("POST"), once.callback());
+    EXPECT_EQ(once.response.status, 503);
+    EXPECT_EQ(inner.sendCallCount, 1);
+
+    HttpRequest keyed = request("POST");
+    keyed.headers["Idempotency-Key"] = "3f9c";
+    inner.script = {test::status(503)};
+    Answer withKey;
+    plain.send(keyed, withKey.callback());
+    scheduler.advanceBy(std::chrono::seconds(1));
+    EXPECT_EQ(withKey.response.status, 200);
+    EXPECT_EQ(inner.sendCallCount, 3);
+
+    RetryingHttpClient::Options options = fastRetries();
+    options.methodPolicies["POST"].retryNonIdempotent = true;
+    options.methodPolicies["POST"].retryStatuses = {429};
+    RetryingHttpClient optedIn(inner, scheduler, options);
+    inner.script = {test::status(429)};
+    Answer posted;
+    optedIn.send(request("POST"), posted.callback());
+    scheduler.advanceBy(std::chrono::seconds(1));
+    EXPECT_EQ(posted.response.status, 200);
+    EXPECT_EQ(inner.sendCallCount, 5);
+}
+
+TEST_F(RetryingHttpClientTest, BudgetStopsRetriesFromAmplifyingAnOutage) {
+    RetryingHttpClient::Options options = fastRetries();
+    options.budget.maxTokens = 2;
+    options.budget.depositPerRequest = 0.5;
+    RetryingHttpClient client(inner, scheduler, options);
+    inner.responseToReturn = test::status(503);
+
+    for (int i = 0; i < 4; ++i) {
+        client.send(request("GET"), [](const HttpResponse&) {});
+        scheduler.advanceBy(std::chrono::seconds(5));
+    }
+
+    // The bucket starts full (2) and refills 0.5 per request: three retries
+    // over four requests instead of eight.
+    EXPECT_EQ(inner.sendCallCount, 7);
+    RetryStats stats = client.stats();
+    EXPECT_EQ(stats.requests, 4u);
+    EXPECT_EQ(stats.retries, 3u);
+    EXPECT_GE(stats.budgetExhausted, 2u);
+    EXPECT_LT(client.availableRetryTokens(), 1.0);
+}
+
+TEST_F(RetryingHttpClientTest, DestroyingTheClientAnswersPendingRetries) {
+    std::unique_ptr<RetryingHttpClient> client(new RetryingHttpClient(inner, scheduler, fastRetries()));
+    inner.script = {test::status(503)};
+    Answer answer;
+    client->send(request("GET"), answer.callback());
+    EXPECT_FALSE(answer.answered);
+
+    client.reset();
+
+    ASSERT_TRUE(answer.answered);
+    EXPECT_EQ(answer.response.status, 503);
+    scheduler.advanceBy(std::chrono::seconds(5));
+    EXPECT_EQ(inner.sendCallCount, 1);
+}
+
+// FakeHttpClient streams through IHttpClient's default (buffered, replayed):
+// the 503 is abandoned at its head, the handler only sees the retry.
+TEST_F(RetryingHttpClientTest, StreamingRetriesHappenBeforeTheHead) {
+    RetryingHttpClient client(inner, scheduler, fastRetries());
+    inner.script = {test::status(503)};
+    inner.responseToReturn.body = "recovered";
+
+    std::string events;
+    IHttpClient::StreamHandler handler;
+    handler.onHeaders = [&events](const HttpResponse& head) {
+        events += "head " + std::to_string(head.status) + ";";
+        return true;
+    };
+    handler.onBody = [&events](const char* data, std::size_t size) {
+        events += std::string(data, size) + ";";
+        return true;
+    };
+    handler.onComplete = [&events](const HttpResponse& r) { events += r.ok() ? "done;" : "failed;"; };
+    client.sendStreaming(request("GET"), handler);
+    scheduler.advanceBy(std::chrono::seconds(1));
+
+    EXPECT_EQ(events, "head 200;recovered;done;");
+    EXPECT_EQ(inner.sendCallCount, 2);
+}
+
+// A stand-in server that fails the first requests according to a script:
+// a status code, or "stall" (answers after the client's read timeout).
+class RetryingHttpClientFaultTest : public ::testing::Test {
+protected:
+    httplib::Server server;
+    std::thread serverThread;
+    int port = 0;
+    std::mutex mutex;
+    std::deque<std::string> faults;
+    int hits = 0;
+
+    void SetUp() override {
+        server.set_tcp_nodelay(true);
+        server.Get("/flaky", [this](const httplib::Request&, httplib::Response& res) {
+            std::string fault;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++hits;
+                if (!faults.empty()) {
+                    fault = faults.front();
+                    faults.pop_front();
+                }
+            }
+            if (fault == "stall") {
+                std::this_thread::sleep_for(milliseconds(1500));
+            } else if (!fault.empty()) {
+                res.status = std::stoi(fault);
+                return;
+            }
+            res.set_content("recovered", "text/plain");
+        });
+        port = server.bind_to_any_port("127.0.0.1");
+        serverThread = std::thread([this]() { server.listen_after_bind(); });
+        server.wait_until_ready();
+    }
+
+    void TearDown() override {
+        server.stop();
+        serverThread.join();
+    }
+
+    int hitCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    HttpClientConfig config() const {
+        HttpClientConfig c;
+        c.host = "127.0.0.1";
+        c.port = port;
+        c.useSSL = false;
+        c.readTimeoutSec = 1;
+        c.maxIdleConnections = 0; // no pool, so no retry of HttplibHttpClient's own
+        return c;
+    }
+};
+
+TEST_F(RetryingHttpClientFaultTest, RecoversFromStatusesAndATimeout) {
+    faults = {"503", "stall", "502"};
+    test::SyncExecutor executor;
+    HttplibHttpClient http(config(), executor);
+    TimingWheelScheduler scheduler(executor);
+    RetryingHttpClient::Options options;
+    options.defaultPolicy.maxAttempts = 4;
+    options.defaultPolicy.baseDelay = milliseconds(10);
+    RetryingHttpClient client(http, scheduler, options);
+
+    HttpResponse response = await(client, flaky());
+
+    EXPECT_TRUE(response.ok()) << response.transportErrorMessage;
+    EXPECT_EQ(response.body, "recovered");
+    EXPECT_EQ(hitCount(), 4);
+    EXPECT_EQ(client.stats().retries, 3u);
+}
+
+TEST_F(RetryingHttpClientFaultTest, GivesUpAfterMaxAttempts) {
+    faults = {"503", "503", "503"};
+    test::SyncExecutor executor;
+    HttplibHttpClient http(config(), executor);
+    TimingWheelScheduler scheduler(executor);
+    RetryingHttpClient::Options options;
+    options.defaultPolicy.baseDelay = milliseconds(10);
+    RetryingHttpClient client(http, scheduler, options);
+
+    HttpResponse response = await(client, flaky());
+
+    EXPECT_EQ(response.status, 503);
+    EXPECT_EQ(hitCount(), 3);
+}
@@ -0,0 +1,188 @@
+//
+//  SerialExecutorTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Infrastructure/Concurrency/BoundedExecutor.hpp"
+#include "Infrastructure/Concurrency/SerialExecutor.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+#include "Infrastructure/Security/SecureTokenStore.hpp"
+#include "Mocks/DeferredExecutor.hpp"
+#include "Mocks/FakeSecureStore.hpp"
+
+using namespace core;
+
+namespace {
+
+// Records whether it ran or was destroyed unrun, and why.
+struct Probe {
+    std::vector<std::string>* log;
+    std::string name;
+    bool armed = true;
+
+    Probe(std::vector<std::string>* l, std::string n) : log(l), name(std::move(n)) {}
+    Probe(Probe&& other) noexcept : log(other.log), name(std::move(other.name)) { other.armed = false; }
+    ~Probe() {
+        if (armed) {
+            log->push_back(name + (IExecutor::Rejection::current() != nullptr ? " refused" : " dropped"));
+        }
+    }
+    void operator()() {
+        armed = false;
+        log->push_back(name + " ran");
+    }
+};
+
+} // namespace
+
+TEST(SerialExecutor, KeepsOneDrainPerBusyKeyOnTheUnderlyingExecutor) {
+    test::DeferredExecutor underlying;
+    SerialExecutor serial(underlying);
+    std::vector<std::string> order;
+
+    serial.run("a", [&order]() { order.push_back("a1"); });
+    serial.run("a", [&order]() { order.push_back("a2"); });
+    serial.run("b", [&order]() { order.push_back("b1"); });
+
+    EXPECT_EQ(underlying.queued.size(), 2u); // one per key, not per task
+    EXPECT_EQ(serial.activeKeyCount(), 2u);
+
+    underlying.runAll();
+    EXPECT_EQ(order, (std::vector<std::string>{"a1", "b1", "a2"}));
+    EXPECT_EQ(serial.activeKeyCount(), 0u);
+}
+
+TEST(SerialExecutor, SameKeyRunsInOrderWithoutOverlap) {
+    WorkStealingExecutor pool(4);
+    SerialExecutor serial(pool);
+
+    const int kTasks = 500;
+    std::atomic<int> inside{0};
+    std::atomic<bool> overlapped{false};
+    std::vector<int> order;
+    std::promise<void> done;
+
+    for (int i = 0; i < kTasks; ++i) {
+        serial.run("account-1", [&, i]() {
+            if (inside.fetch_add(1) != 0) {
+                overlapped = true;
+            }
+            order.push_back(i); // unsynchronized on purpose: the strand serializes
+            inside.fetch_sub(1);
+            if (i == kTasks - 1) {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_FALSE(overlapped.load());
+    ASSERT_EQ(order.size(), static_cast<std::size_t>(kTasks));
+    for (int i = 0; i < kTasks; ++i) {
+        EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST(SerialExecutor, DifferentKeysRunInParallel) {
+    WorkStealingExecutor pool(2);
+    SerialExecutor serial(pool);
+    std::promise<void> aStarted;
+    std::promise<void> bStarted;
+    std::shared_future<void> aReady = aStarted.get_future().share();
+    std::shared_future<void> bReady = bStarted.get_future().share();
+    std::promise<bool> aSawB;
+
+    // Each task waits for the other to start: only possible if both run at once.
+    serial.run("host-a", [&]() {
+        aStarted.set_value();
+        aSawB.set_value(bReady.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    });
+    serial.run("host-b", [&]() {
+        bStarted.set_value();
+        aReady.wait_for(std::chrono::seconds(5));
+    });
+
+    EXPECT_TRUE(aSawB.get_future().get());
+}
+
+TEST(SerialExecutor, StrandSerializesTokenPersistence) {
+    WorkStealingExecutor pool(4);
+    SerialExecutor serial(pool);
+    SerialExecutor::Strand strand = serial.strand("user@example.com");
+    IExecutor& persistence = strand;
+
+    test::FakeSecureStore storage;
+    SecureTokenStore store(storage);
+    std::promise<void> done;
+
+    Token token;
+    token.accessToken = "access";
+    token.refreshToken = "refresh";
+    // A save() followed by a clear() from different callbacks: the strand keeps
+    // them in posting order, so the account ends up logged out.
+    persistence.run([&store, token]() { store.save(token); });
+    persistence.run([&store]() { store.clear(); });
+    persistence.run([&done]() { done.set_value(); });
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_TRUE(store.load().empty());
+    EXPECT_EQ(storage.setCount, 1);
+    EXPECT_EQ(storage.removeCount, 1);
+}
+
+TEST(SerialExecutor, QueuedWorkOutlivesTheAdapter) {
+    test::DeferredExecutor underlying;
+    bool ran = false;
+    {
+        SerialExecutor serial(underlying);
+        serial.run([&ran]() { ran = true; });
+    }
+    underlying.runAll();
+    EXPECT_TRUE(ran);
+}
+
+TEST(SerialExecutor, ARefusedDrainAnswersItsTasksAndLaterPostsStillRun) {
+    test::DeferredExecutor pool;
+    BoundedExecutor::Options options;
+    options.maxConcurrency = 1;
+    options.queueCapacity = 0;
+    options.policy = RejectionPolicy::failFast;
+    BoundedExecutor bounded(pool, options);
+    SerialExecutor serial(bounded);
+    std::vector<std::string> log;
+
+    bounded.run([]() {}); // takes the only permit
+    serial.run("a", Probe(&log, "a1"));
+    serial.run("a", Probe(&log, "a2"));
+    EXPECT_EQ(log, (std::vector<std::string>{"a1 refused", "a2 refused"}));
+    EXPECT_EQ(serial.activeKeyCount(), 0u);
+
+    pool.runAll(); // the permit comes back
+    serial.run("a", Probe(&log, "a3"));
+    pool.runAll();
+    EXPECT_EQ(log.back(), "a3 ran");
+    EXPECT_EQ(serial.activeKeyCount(), 0u);
+}
+
+TEST(SerialExecutor, ADroppedDrainAnswersEveryQueuedTask) {
+    test::DeferredExecutor pool;
+    SerialExecutor serial(pool);
+    std::vector<std::string> log;
+
+    serial.run("a", Probe(&log, "a1"));
+    serial.run("a", Probe(&log, "a2"));
+    pool.queued.clear(); // e.g. the pool shutting down
+
+    EXPECT_EQ(log, (std::vector<std::string>{"a1 dropped", "a2 dropped"}));
+    EXPECT_EQ(serial.activeKeyCount(), 0u);
+}
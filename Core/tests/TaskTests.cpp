@@ -0,0 +1,183 @@
+//
+//  TaskTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Domain/Async/Task.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+#include "Infrastructure/Http/HttpClientConfig.hpp"
+#include "Infrastructure/Http/IHttpClient.hpp"
+#include "Mocks/AllocationCounter.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+
+TEST(Task, DefaultIsEmptyAndAssignedTaskRuns) {
+    Task task;
+    EXPECT_FALSE(static_cast<bool>(task));
+
+    int calls = 0;
+    task = [&calls]() { ++calls; };
+    ASSERT_TRUE(static_cast<bool>(task));
+    task();
+    task();
+    EXPECT_EQ(calls, 2);
+
+    task = nullptr;
+    EXPECT_FALSE(static_cast<bool>(task));
+}
+
+TEST(Task, AcceptsMoveOnlyCaptures) {
+    std::unique_ptr<int> value(new int(7));
+    int seen = 0;
+    Task task([&seen, p = std::move(value)]() { seen = *p; });
+
+    Task moved(std::move(task));
+    EXPECT_FALSE(static_cast<bool>(task));
+    moved();
+    EXPECT_EQ(seen, 7);
+}
+
+TEST(Task, DestroysCapturesExactlyOnce) {
+    std::shared_ptr<int> tracked = std::make_shared<int>(0);
+    {
+        Task a([tracked]() {});
+        Task b(std::move(a));
+        Task c;
+        c = std::move(b);
+        EXPECT_EQ(tracked.use_count(), 2);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(Task, SmallCallablesAndMovesDoNotAllocate) {
+    int calls = 0;
+    test::AllocationScope scope;
+
+    Task task([&calls]() { ++calls; });
+    Task moved(std::move(task));
+    moved();
+
+    EXPECT_EQ(scope.count(), 0u);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(Task, OversizedCallableFallsBackToOneAllocation) {
+    std::array<char, Task::kInlineSize + 1> big{};
+    big[0] = 'x';
+    char seen = 0;
+    auto callable = [big, &seen]() { seen = big[0]; };
+    static_assert(!Task::fitsInline<decltype(callable)>(), "expected heap fallback");
+
+    test::AllocationScope scope;
+    Task task(callable);
+    Task moved(std::move(task)); // moves the pointer, not the callable
+    moved();
+
+    EXPECT_EQ(scope.count(), 1u);
+    EXPECT_EQ(seen, 'x');
+}
+
+TEST(Task, HttpSizedHopThroughSyncExecutorDoesNotAllocate) {
+    // Same captures as HttplibHttpClient's executor hop.
+    HttpClientConfig config;
+    config.host = "api.example.com";
+    HttpRequest request;
+    request.method = "POST";
+    request.path = "/api/v1/auth/login";
+    int delivered = 0;
+    IHttpClient::Callback callback = [&delivered](const HttpResponse&) { ++delivered; };
+    auto hop = [config, request, callback]() { callback(HttpResponse{}); };
+    static_assert(Task::fitsInline<decltype(hop)>(), "HTTP hop must fit inline");
+
+    test::SyncExecutor executor;
+    test::AllocationScope scope;
+    executor.run(std::move(hop));
+
+    EXPECT_EQ(scope.count(), 0u);
+    EXPECT_EQ(delivered, 1);
+}
+
+TEST(Task, WorkStealingExecutorPostDoesNotAllocateOnceWarm) {
+    WorkStealingExecutor executor(1);
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    std::promise<void> blocked;
+
+    // Park the only worker so posted tasks accumulate in its ring.
+    executor.run([&]() {
+        blocked.set_value();
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&release]() { return release; });
+    });
+    blocked.get_future().wait();
+
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 8; ++i) { // grows the ring once
+        executor.run([&ran]() { ++ran; });
+    }
+    std::size_t allocations = 0;
+    {
+        test::AllocationScope scope;
+        for (int i = 0; i < 8; ++i) {
+            executor.run([&ran]() { ++ran; });
+        }
+        allocations = scope.count();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    executor.shutdown();
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(ran.load(), 16);
+}
+
+TEST(Task, AroundRunsDecoratorAndWrappedTaskWithoutAllocating) {
+    std::vector<int> order;
+    order.reserve(8);
+    Task inner([&order]() { order.push_back(2); });
+
+    test::AllocationScope scope;
+    Task wrapped = Task::around(std::move(inner), [&order](Task::Inner run) {
+        order.push_back(1);
+        run();
+        order.push_back(3);
+    });
+    Task moved(std::move(wrapped));
+    moved();
+
+    EXPECT_EQ(scope.count(), 0u);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(Task, AroundBoxesATaskThatNoLongerFitsInline) {
+    std::array<char, Task::kInlineSize - 8> big{};
+    big[0] = 'y';
+    char seen = 0;
+    std::shared_ptr<int> tracked = std::make_shared<int>(0);
+    Task inner([big, &seen]() { seen = big[0]; });
+    {
+        test::AllocationScope scope;
+        Task wrapped = Task::around(std::move(inner), [tracked](Task::Inner run) { run(); });
+        Task moved(std::move(wrapped));
+        moved();
+        EXPECT_EQ(scope.count(), 1u);
+        EXPECT_EQ(tracked.use_count(), 2);
+    }
+    EXPECT_EQ(seen, 'y');
+    EXPECT_EQ(tracked.use_count(), 1);
+}
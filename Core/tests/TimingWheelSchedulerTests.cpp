@@ -0,0 +1,182 @@
+//
+//  TimingWheelSchedulerTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Infrastructure/Concurrency/TimingWheelScheduler.hpp"
+#include "Mocks/ManualClock.hpp"
+#include "Mocks/SyncExecutor.hpp"
+
+using namespace core;
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+TEST(TimingWheelScheduler, ManualClockFiresTimersInDeadlineOrder) {
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler(dispatch, test::manualClock());
+    std::vector<std::string> fired;
+
+    scheduler.runAfter(milliseconds(10), [&fired]() { fired.push_back("10ms"); });
+    scheduler.runAfter(milliseconds(5), [&fired]() { fired.push_back("5ms"); });
+    scheduler.runAfter(milliseconds(20), [&fired]() { fired.push_back("20ms"); });
+    EXPECT_EQ(scheduler.pendingCount(), 3u);
+
+    scheduler.advanceBy(milliseconds(4));
+    EXPECT_TRUE(fired.empty());
+
+    scheduler.advanceBy(milliseconds(1));
+    EXPECT_EQ(fired, (std::vector<std::string>{"5ms"}));
+
+    scheduler.advanceBy(seconds(1));
+    EXPECT_EQ(fired, (std::vector<std::string>{"5ms", "10ms", "20ms"}));
+    EXPECT_EQ(scheduler.pendingCount(), 0u);
+}
+
+TEST(TimingWheelScheduler, RunGoesStraightToTheDispatchExecutor) {
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler(dispatch, test::manualClock());
+    bool ran = false;
+
+    scheduler.run([&ran]() { ran = true; });
+
+    EXPECT_TRUE(ran);
+    EXPECT_EQ(dispatch.runCount, 1);
+}
+
+TEST(TimingWheelScheduler, CancelledTimerNeverRuns) {
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler(dispatch, test::manualClock());
+    bool cancelledRan = false;
+    bool keptRan = false;
+
+    IScheduledExecutor::TimerId cancelled =
+        scheduler.runAfter(milliseconds(300), [&cancelledRan]() { cancelledRan = true; });
+    IScheduledExecutor::TimerId kept =
+        scheduler.runAfter(milliseconds(300), [&keptRan]() { keptRan = true; });
+    EXPECT_NE(cancelled, 0u);
+
+    EXPECT_TRUE(scheduler.cancel(cancelled));
+    EXPECT_FALSE(scheduler.cancel(cancelled)); // already cancelled
+
+    scheduler.advanceBy(seconds(1));
+    EXPECT_FALSE(cancelledRan);
+    EXPECT_TRUE(keptRan);
+    EXPECT_FALSE(scheduler.cancel(kept)); // already fired
+}
+
+TEST(TimingWheelScheduler, TimersScheduledByCallbacksFireWithinTheSameAdvance) {
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler(dispatch, test::manualClock());
+    std::vector<long long> firedAtMs;
+    const IScheduledExecutor::Clock::time_point start = scheduler.now();
+
+    auto elapsedMs = [&]() {
+        return static_cast<long long>(
+            std::chrono::duration_cast<milliseconds>(scheduler.now() - start).count());
+    };
+    scheduler.runAfter(milliseconds(100), [&]() {
+        firedAtMs.push_back(elapsedMs());
+        scheduler.runAfter(milliseconds(100), [&]() { firedAtMs.push_back(elapsedMs()); });
+    });
+
+    scheduler.advanceBy(milliseconds(250));
+    EXPECT_EQ(firedAtMs, (std::vector<long long>{100, 200}));
+    EXPECT_EQ(elapsedMs(), 250);
+}
+
+TEST(TimingWheelScheduler, FarTimersCascadeDownTheLevels) {
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler::Options options = test::manualClock();
+    options.tick = milliseconds(1000);
+    TimingWheelScheduler scheduler(dispatch, options);
+    int fired = 0;
+
+    // 70 days at 1 s ticks is past the 2^32-tick horizon of the top level.
+    scheduler.runAfter(hours(24 * 70), [&fired]() { ++fired; });
+    scheduler.runAfter(hours(2), [&fired]() { ++fired; });
+
+    scheduler.advanceBy(hours(2) - seconds(1));
+    EXPECT_EQ(fired, 0);
+    scheduler.advanceBy(seconds(1));
+    EXPECT_EQ(fired, 1);
+    scheduler.advanceBy(hours(24 * 70) - hours(2) - seconds(1));
+    EXPECT_EQ(fired, 1);
+    scheduler.advanceBy(seconds(1));
+    EXPECT_EQ(fired, 2);
+}
+
+TEST(TimingWheelScheduler, HandlesOneHundredThousandPendingTimers) {
+    test::SyncExecutor dispatch;
+    TimingWheelScheduler scheduler(dispatch, test::manualClock());
+    const IScheduledExecutor::Clock::time_point start = scheduler.now();
+    const int kTimers = 100000;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> delayMs(1, 600000); // up to 10 minutes
+    std::vector<IScheduledExecutor::TimerId> ids;
+    ids.reserve(kTimers);
+    int fired = 0;
+    int early = 0;
+    int late = 0;
+    for (int i = 0; i < kTimers; ++i) {
+        const IScheduledExecutor::Clock::time_point deadline = start + milliseconds(delayMs(rng));
+        ids.push_back(scheduler.runAt(deadline, [&, deadline]() {
+            ++fired;
+            const IScheduledExecutor::Clock::time_point now = scheduler.now();
+            if (now < deadline) {
+                ++early;
+            } else if (now - deadline >= milliseconds(1)) {
+                ++late;
+            }
+        }));
+    }
+    EXPECT_EQ(scheduler.pendingCount(), static_cast<std::size_t>(kTimers));
+
+    int cancelled = 0;
+    for (std::size_t i = 0; i < ids.size(); i += 2) {
+        cancelled += scheduler.cancel(ids[i]) ? 1 : 0;
+    }
+    EXPECT_EQ(cancelled, kTimers / 2);
+
+    scheduler.advanceBy(std::chrono::minutes(11));
+    EXPECT_EQ(fired, kTimers - cancelled);
+    EXPECT_EQ(early, 0);
+    EXPECT_EQ(late, 0);
+    EXPECT_EQ(scheduler.pendingCount(), 0u);
+}
+
+TEST(TimingWheelScheduler, RealClockFiresAfterTheDelay) {
+    test::SyncExecutor dispatch; // runs on the timer thread
+    TimingWheelScheduler scheduler(dispatch);
+    std::promise<IScheduledExecutor::Clock::time_point> firedAt;
+    const IScheduledExecutor::Clock::time_point start = IScheduledExecutor::Clock::now();
+
+    scheduler.runAfter(milliseconds(30), [&firedAt]() {
+        firedAt.set_value(IScheduledExecutor::Clock::now());
+    });
+
+    std::future<IScheduledExecutor::Clock::time_point> result = firedAt.get_future();
+    ASSERT_EQ(result.wait_for(seconds(2)), std::future_status::ready);
+    const auto elapsed = result.get() - start;
+    EXPECT_GE(elapsed, milliseconds(30));
+    EXPECT_LT(elapsed, milliseconds(500));
+}
+
+TEST(TimingWheelScheduler, DestructionDropsPendingTimers) {
+    test::SyncExecutor dispatch;
+    bool ran = false;
+    {
+        TimingWheelScheduler scheduler(dispatch);
+        scheduler.runAfter(seconds(60), [&ran]() { ran = true; });
+    }
+    EXPECT_FALSE(ran);
+}
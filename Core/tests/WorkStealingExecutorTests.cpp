@@ -0,0 +1,187 @@
+//
+//  WorkStealingExecutorTests.cpp
+//  PureMVC Core tests
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
+
+using namespace core;
+
+TEST(WorkStealingExecutor, RunsEveryTaskOffTheCallingThread) {
+    WorkStealingExecutor executor(4);
+    EXPECT_EQ(executor.workerCount(), 4u);
+
+    const int kTasks = 1000;
+    std::atomic<int> ran{0};
+    std::atomic<bool> ranOnCaller{false};
+    std::promise<void> done;
+    const std::thread::id caller = std::this_thread::get_id();
+
+    for (int i = 0; i < kTasks; ++i) {
+        executor.run([&]() {
+            if (std::this_thread::get_id() == caller) {
+                ranOnCaller = true;
+            }
+            if (ran.fetch_add(1) + 1 == kTasks) {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(ran.load(), kTasks);
+    EXPECT_FALSE(ranOnCaller.load());
+}
+
+TEST(WorkStealingExecutor, UsesABoundedNumberOfThreads) {
+    WorkStealingExecutor executor(2);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> ran{0};
+    std::promise<void> done;
+
+    for (int i = 0; i < 200; ++i) {
+        executor.run([&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            }
+            if (ran.fetch_add(1) + 1 == 200) {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_LE(threads.size(), 2u);
+}
+
+TEST(WorkStealingExecutor, IdleWorkerStealsFromABlockedWorker) {
+    WorkStealingExecutor executor(2);
+    const int kChildren = 10;
+    std::atomic<int> children{0};
+    std::mutex mutex;
+    std::condition_variable allDone;
+    std::promise<bool> parentResult;
+
+    // The parent posts its children onto its own deque and then blocks; they can
+    // only complete if the other worker steals them.
+    executor.run([&]() {
+        for (int i = 0; i < kChildren; ++i) {
+            executor.run([&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++children;
+                allDone.notify_all();
+            });
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        bool ok = allDone.wait_for(lock, std::chrono::seconds(5),
+                                   [&]() { return children.load() == kChildren; });
+        parentResult.set_value(ok);
+    });
+
+    std::future<bool> result = parentResult.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(6)), std::future_status::ready);
+    EXPECT_TRUE(result.get());
+}
+
+TEST(WorkStealingExecutor, OutsidePostsStartInOrderOnASaturatedPool) {
+    WorkStealingExecutor executor(1);
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    executor.run([opened]() { opened.wait(); }); // the only worker is busy
+
+    const int kTasks = 100;
+    std::vector<int> order; // the one worker runs them one at a time
+    std::promise<void> done;
+    for (int i = 0; i < kTasks; ++i) {
+        executor.run([&, i]() {
+            order.push_back(i);
+            if (i == kTasks - 1) {
+                done.set_value();
+            }
+        });
+    }
+    gate.set_value();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    std::vector<int> expected(kTasks);
+    for (int i = 0; i < kTasks; ++i) {
+        expected[i] = i;
+    }
+    EXPECT_EQ(order, expected);
+}
+
+TEST(WorkStealingExecutor, AWorkerFeedingItselfDoesNotStarveOutsidePosts) {
+    WorkStealingExecutor executor(1);
+    std::atomic<bool> outsideRan{false};
+    std::atomic<int> rounds{0};
+    std::promise<void> chainEnded;
+    std::function<void()> step = [&]() {
+        if (outsideRan.load() || ++rounds == 1000000) {
+            chainEnded.set_value();
+            return;
+        }
+        executor.run([&step]() { step(); }); // onto its own deque
+    };
+
+    executor.run([&step]() { step(); });
+    while (rounds.load() < 10) {
+        std::this_thread::yield();
+    }
+    executor.run([&outsideRan]() { outsideRan = true; });
+
+    ASSERT_EQ(chainEnded.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_TRUE(outsideRan.load());
+}
+
+TEST(WorkStealingExecutor, ShutdownDrainsQueuedWork) {
+    std::atomic<int> ran{0};
+    {
+        WorkStealingExecutor executor(1);
+        for (int i = 0; i < 100; ++i) {
+            executor.run([&ran]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                ++ran;
+            });
+        }
+        executor.shutdown();
+        EXPECT_EQ(ran.load(), 100);
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
+
+TEST(WorkStealingExecutor, TaskPostedAfterShutdownRunsInline) {
+    WorkStealingExecutor executor(2);
+    executor.shutdown();
+    executor.shutdown(); // idempotent
+
+    bool ran = false;
+    executor.run([&ran]() { ran = true; });
+    EXPECT_TRUE(ran);
+}
+
+TEST(WorkStealingExecutor, DestroyedFromItsOwnTaskDoesNotDeadlock) {
+    std::promise<void> destroyed;
+    WorkStealingExecutor* executor = new WorkStealingExecutor(2);
+
+    executor->run([executor, &destroyed]() {
+        delete executor;
+        destroyed.set_value();
+    });
+
+    EXPECT_EQ(destroyed.get_future().wait_for(std::chrono::seconds(5)),
+              std::future_status::ready);
+}
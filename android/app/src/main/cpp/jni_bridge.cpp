@@ -19,7 +19,7 @@
 #include "Infrastructure/Http/IHttpClient.hpp"
 #include "Infrastructure/Http/HttplibHttpClient.hpp"
 #include "Infrastructure/Http/MockHttpClient.hpp"
-#include "Infrastructure/Concurrency/ThreadExecutor.hpp"
+#include "Infrastructure/Concurrency/WorkStealingExecutor.hpp"
 #include "Infrastructure/Security/ISecureStorage.hpp"
 #include "Infrastructure/Security/SecureTokenStore.hpp"
 
@@ -127,7 +127,7 @@ HttpClientConfig makeConfig(const std::string& host, int port) {
 // Native object graph mirroring iOS PMVCAuthClient (real HTTPS via httplib, or a
 // mock client for the offline demo; token storage via the Android Keystore).
 struct AndroidAuthClient {
-    ThreadExecutor executor;
+    WorkStealingExecutor executor{4}; // bounded pool; see PMVCAuthClient.mm
     std::unique_ptr<IHttpClient> http;
     std::unique_ptr<AuthRepository> repository;
     JniSecureStorage storage;